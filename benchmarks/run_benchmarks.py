@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Run the Osprey-DPD performance benchmarks and report the results as JSON.
+
+Each benchmark is a control data file, dmpci.<name>, in this directory. The
+script copies it to a scratch directory and sets the run length and output
+periods to the requested number of steps. It also appends a
+TogglePerformanceOutput command so the simulation writes its per-phase
+timings to dmpcpf.<name>. It then runs the dpd executable and reports:
+
+  wall_s             wall-clock time of the whole process including set-up
+  loop_s             time spent in the timestep loop, from the performance log
+  steps_per_s        timesteps per second of loop time
+  ns_per_bead_step   loop time per bead per step in nanoseconds
+  peak_rss_kb        peak resident set size of the dpd process
+  phases_ms          mean milliseconds per step in each phase of the loop
+  pairs_per_step     bead pairs examined by CCNTCell::UpdateForce per step
+  ns_per_pair        UpdateForce time per examined pair in nanoseconds
+
+The kernel benchmarks, named kernel-rho<density>, rerun the pure solvent
+input at several bead densities. This changes the cell occupancy seen by
+CCNTCell::UpdateForce, so ns_per_pair for these runs measures the
+non-bonded force kernel in isolation from system set-up.
+
+Usage: run_benchmarks.py --dpd path/to/dpd [--steps N] [--output file.json] [names...]
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+BENCHMARK_DIR = os.path.dirname(os.path.abspath(__file__))
+
+SYSTEMS = ["water", "bilayer", "melt", "charged"]
+KERNEL_DENSITIES = [3, 5, 8]
+
+PERIOD_TOKENS = ["Time", "SamplePeriod", "AnalysisPeriod", "DensityPeriod",
+                 "DisplayPeriod", "RestartPeriod"]
+
+
+def make_input(template, steps, density=None):
+    """Return the control data file text with the run length overwritten."""
+    text = template
+    for token in PERIOD_TOKENS:
+        text = re.sub(r"(?m)^(%s\s+)\d+" % token, r"\g<1>%d" % steps, text)
+    if density is not None:
+        text = re.sub(r"(?m)^(Density\s+)\S+", r"\g<1>%g" % density, text)
+    period = max(1, steps // 10)
+    return text.rstrip() + "\n\nCommand TogglePerformanceOutput  1  %d\n" % period
+
+
+def bead_total(text):
+    box = re.search(r"(?m)^Box\s+(\d+)\s+(\d+)\s+(\d+)", text)
+    density = re.search(r"(?m)^Density\s+(\S+)", text)
+    return int(int(box.group(1)) * int(box.group(2)) * int(box.group(3)) * float(density.group(1)))
+
+
+def read_performance_log(path):
+    """Average the per-period lines of a dmpcpf file."""
+    with open(path) as f:
+        header = f.readline().lstrip("#").split()
+        rows = [list(map(float, line.split())) for line in f if line.strip()]
+    if not rows:
+        return None
+    means = [sum(col) / len(rows) for col in zip(*rows)]
+    return dict(zip(header, means))
+
+
+def run_one(dpd, name, text, steps):
+    workdir = tempfile.mkdtemp(prefix="dpdbench-")
+    try:
+        with open(os.path.join(workdir, "dmpci." + name), "w") as f:
+            f.write(text)
+
+        # wait4() gives the resource usage of this child alone, so the peak
+        # RSS is not confused with that of earlier benchmarks.
+        start = time.time()
+        proc = subprocess.Popen([dpd, name], cwd=workdir,
+                                stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        _, status, usage = os.wait4(proc.pid, 0)
+        proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+        wall = time.time() - start
+
+        result = {"name": name, "steps": steps, "beads": bead_total(text),
+                  "wall_s": round(wall, 3), "peak_rss_kb": usage.ru_maxrss,
+                  "returncode": proc.returncode}
+
+        log_path = os.path.join(workdir, "dmpcpf." + name)
+        log = read_performance_log(log_path) if os.path.exists(log_path) else None
+        if proc.returncode != 0 or log is None:
+            result["error"] = "dpd exited with status %d" % proc.returncode if proc.returncode != 0 \
+                              else "no performance log written"
+            return result
+
+        ms_per_step = log["Total"]
+        result["loop_s"] = round(ms_per_step * steps / 1000.0, 3)
+        result["steps_per_s"] = round(1000.0 / ms_per_step, 3)
+        result["ns_per_bead_step"] = round(1.0e6 * ms_per_step / result["beads"], 3)
+        result["phases_ms"] = {k: round(v, 4) for k, v in log.items()
+                               if k not in ("Time", "Total", "Pairs", "Migrations")}
+        result["pairs_per_step"] = int(log["Pairs"])
+        result["migrations_per_step"] = int(log["Migrations"])
+        if log["Pairs"] > 0:
+            result["ns_per_pair"] = round(1.0e6 * log["UpdateForce"] / log["Pairs"], 3)
+        return result
+    finally:
+        shutil.rmtree(workdir, ignore_errors=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--dpd", required=True, help="path to the dpd executable")
+    parser.add_argument("--steps", type=int, default=1000, help="timesteps per benchmark")
+    parser.add_argument("--output", help="write the JSON report to this file")
+    parser.add_argument("names", nargs="*", help="subset of benchmarks to run")
+    args = parser.parse_args()
+
+    dpd = os.path.abspath(args.dpd)
+    cases = []
+    for name in SYSTEMS:
+        with open(os.path.join(BENCHMARK_DIR, "dmpci." + name)) as f:
+            cases.append((name, make_input(f.read(), args.steps)))
+    with open(os.path.join(BENCHMARK_DIR, "dmpci.water")) as f:
+        water = f.read()
+    for rho in KERNEL_DENSITIES:
+        cases.append(("kernel-rho%d" % rho, make_input(water, args.steps, rho)))
+
+    if args.names:
+        cases = [c for c in cases if c[0] in args.names]
+
+    results = []
+    for name, text in cases:
+        result = run_one(dpd, name, text, args.steps)
+        results.append(result)
+        print("%-16s %s" % (name, result.get("steps_per_s", result.get("error"))), file=sys.stderr)
+
+    report = json.dumps({"steps": args.steps, "benchmarks": results}, indent=2)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(report + "\n")
+    else:
+        print(report)
+
+    return 0 if all("error" not in r for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
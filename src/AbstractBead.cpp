@@ -21,6 +21,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Polymer.h"
 #include "xxParallelBase.h"
 
+// In the lean bead layout, the stress tensor is summed over all beads in a 
+// single class-wide array. Each thread running a simulation has its own copy.
+
+#if EnableLeanBeadStorage == SimMiscEnabled
+SimThreadLocal double CAbstractBead::m_Stress[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+#endif
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -51,16 +57,19 @@ CAbstractBead::CAbstractBead() : m_id(0), m_Type(0), m_bIsVisible(true), m_bIsMo
 		m_Pos[i]		= 0.0;
 		m_Mom[i]		= 0.0;
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		m_InitialPos[i]	= 0.0;
+#endif
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
 		m_Stress[3*i+2]	= 0.0;
+#endif
 	}
 }
 
@@ -99,16 +108,19 @@ CAbstractBead::CAbstractBead(long type) : m_id(-1), m_Type(type),
 		m_Pos[i]		= 0.0;
 		m_Mom[i]		= 0.0;
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		m_InitialPos[i]	= 0.0;
+#endif
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
 		m_Stress[3*i+2]	= 0.0;
+#endif
 	}
 }
 
@@ -145,16 +157,19 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable,
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		m_InitialPos[i]	= 0.0;
+#endif
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
 		m_Stress[3*i+2]	= 0.0;
+#endif
 	}
 }
 
@@ -189,16 +204,19 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable, double radius,
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		m_InitialPos[i]	= 0.0;
+#endif
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
 		m_Stress[3*i+2]	= 0.0;
+#endif
 	}
 }
 
@@ -225,16 +243,19 @@ CAbstractBead::CAbstractBead(long id, long type, bool movable, double radius, do
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		m_InitialPos[i]	= 0.0;
+#endif
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
 		m_Stress[3*i+2]	= 0.0;
+#endif
 	}
 }
 #endif
@@ -257,16 +278,19 @@ CAbstractBead::CAbstractBead(CPolymer* const pPolymer, long id, long type, bool
 		m_Pos[i]		= x0[i];	// Note non-zero initial values!
 		m_Mom[i]		= v0[i];
 		m_Force[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 		m_oldForce[i]	= 0.0;
 		m_unPBCPos[i]	= 0.0;
-		m_InitialPos[i]	= 0.0;
 		m_dPos[i]		= 0.0;
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		m_InitialPos[i]	= 0.0;
+#endif
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_Stress[3*i]	= 0.0;
 		m_Stress[3*i+1]	= 0.0;
 		m_Stress[3*i+2]	= 0.0;
+#endif
 	}
 }
 #endif
@@ -302,18 +326,21 @@ CAbstractBead::CAbstractBead(const CAbstractBead& oldBead) : m_id(oldBead.m_id),
 		m_Pos[i]		= oldBead.m_Pos[i];
 		m_Mom[i]		= oldBead.m_Mom[i];
 		m_Force[i]		= oldBead.m_Force[i];
-		m_AngMom[i]		= oldBead.m_AngMom[i];
 
 		m_oldPos[i]		= oldBead.m_oldPos[i];
 		m_oldMom[i]		= oldBead.m_oldMom[i];
 		m_oldForce[i]	= oldBead.m_oldForce[i];
 
-		m_InitialPos[i]	= oldBead.m_InitialPos[i];
 		m_unPBCPos[i]	= oldBead.m_unPBCPos[i];
 		m_dPos[i]		= oldBead.m_dPos[i];
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		m_InitialPos[i]	= oldBead.m_InitialPos[i];
+#endif
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_Stress[3*i]	= oldBead.m_Stress[3*i];
 		m_Stress[3*i+1]	= oldBead.m_Stress[3*i+1];
 		m_Stress[3*i+2]	= oldBead.m_Stress[3*i+2];
+#endif
 	}
 }
 
@@ -321,6 +348,19 @@ CAbstractBead::~CAbstractBead()
 {
 }
 
+#if EnableLeanBeadStorage == SimMiscEnabled
+// Function used by the CSimBox to zero the stress tensor summed over all beads
+// before the force loops of a new time step add to it.
+
+void CAbstractBead::ZeroTotalStress()
+{
+	for(short int j=0; j<9; j++)
+	{
+		m_Stress[j] = 0.0;
+	}
+}
+#endif
+
 // Function used in the parallel code to set the bead's owning polymer. This allows
 // beads to navigate upwards via their polymers. We only compile this in for a
 // parallel executable as the member variable is not defined in the serial code.
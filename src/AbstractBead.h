@@ -20,6 +20,7 @@ class CPolymer;
 #include "SimDefs.h"
 #include "ExperimentDefs.h"
 #include "SimMPSFlags.h"
+#include "SimMiscellaneousFlags.h"
 
 class CAbstractBead  
 {
@@ -35,6 +36,7 @@ class CAbstractBead
 	friend class CExternalCNTCell;
 	friend class CForceTarget;
 	friend class CMonitor;
+	friend class CNanoparticle;		// Rigid nanoparticles set their beads' momenta
 	friend class CSimBox;
 	friend class taForceDecorator;	// Needed by command target force decorators
 
@@ -105,16 +107,25 @@ public:
 	inline double GetYForce()	const {return m_Force[1];}
 	inline double GetZForce()	const {return m_Force[2];}
 
-	inline double GetXAngMom()	const {return m_AngMom[0];}
-	inline double GetYAngMom()	const {return m_AngMom[1];}
-	inline double GetZAngMom()	const {return m_AngMom[2];}
+	// The angular momentum is calculated when needed instead of being 
+	// stored in every bead and updated every time step
+
+	inline double GetXAngMom()	const {return  m_Pos[1]*m_Mom[2] - m_Pos[2]*m_Mom[1];}
+	inline double GetYAngMom()	const {return -m_Pos[0]*m_Mom[2] + m_Pos[2]*m_Mom[0];}
+	inline double GetZAngMom()	const {return  m_Pos[0]*m_Mom[1] - m_Pos[1]*m_Mom[0];}
 
 	inline double GetunPBCXPos()	const {return m_unPBCPos[0];}
 	inline double GetunPBCYPos()	const {return m_unPBCPos[1];}
 	inline double GetunPBCZPos()	const {return m_unPBCPos[2];}
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
 	inline double GetInitialXPos()	const {return m_InitialPos[0];}
 	inline double GetInitialYPos()	const {return m_InitialPos[1];}
 	inline double GetInitialZPos()	const {return m_InitialPos[2];}
+#else
+	inline double GetInitialXPos()	const {return 0.0;}
+	inline double GetInitialYPos()	const {return 0.0;}
+	inline double GetInitialZPos()	const {return 0.0;}
+#endif
 
     // Functions to returned bead coordinates shifted to whole simulation Space
 
@@ -163,6 +174,25 @@ public:
 
 	inline long GetForceCounter() const {return m_ForceCounter;}
 
+	// Function to zero the bead's stress tensor before the force loops add to
+	// it. In the lean layout the stress is summed over all beads instead, and
+	// the CSimBox zeroes the sum once per step using ZeroTotalStress().
+
+	inline void ZeroStress()
+	{
+#if EnableLeanBeadStorage == SimMiscDisabled
+		for(short int j=0; j<9; j++)
+		{
+			m_Stress[j] = 0.0;
+		}
+#endif
+	}
+
+#if EnableLeanBeadStorage == SimMiscEnabled
+	static void ZeroTotalStress();
+	static const double* GetTotalStress() {return m_Stress;}
+#endif
+
 	// Public functions to set bead state and coordinates
 
 	inline void   SetId(long id)			{m_id			= id;}
@@ -194,9 +224,15 @@ public:
 	inline void	  SetunPBCXPos(double x)	{m_unPBCPos[0] = x;}
 	inline void   SetunPBCYPos(double y)	{m_unPBCPos[1] = y;}
 	inline void   SetunPBCZPos(double z)	{m_unPBCPos[2] = z;}
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
 	inline void   SetInitialXPos(double x)	{m_InitialPos[0] = x;}
 	inline void   SetInitialYPos(double y)	{m_InitialPos[1] = y;}
 	inline void   SetInitialZPos(double z)	{m_InitialPos[2] = z;}
+#else
+	inline void   SetInitialXPos(double)	{}
+	inline void   SetInitialYPos(double)	{}
+	inline void   SetInitialZPos(double)	{}
+#endif
 	inline void   SetdXPos(double x)		{m_dPos[0] = x;}
 	inline void   SetdYPos(double y)		{m_dPos[1] = y;}
 	inline void   SetdZPos(double z)		{m_dPos[2] = z;}
@@ -246,16 +282,28 @@ protected:
 	double m_Pos[3];		// Current coordinates
 	double m_Mom[3];
 	double m_Force[3];
-	double m_AngMom[3];
 
 	double m_oldPos[3];		// Coordinates at previous time step
 	double m_oldMom[3];
 	double m_oldForce[3];
 
 	double m_unPBCPos[3];
-	double m_InitialPos[3];
 	double m_dPos[3];		// Differential position coordinates
+
+	// The lean layout replaces the per-bead stress tensor by its sum over all
+	// beads, which is all that the CMonitor uses. It only stores the initial 
+	// position, which is used solely for the bead MSDs, if EnableLeanBeadMSD
+	// is set; otherwise the builders' calls to set it do nothing.
+
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+	double m_InitialPos[3];
+#endif
+
+#if EnableLeanBeadStorage == SimMiscEnabled
+	static SimThreadLocal double m_Stress[9];	// Stress tensor summed over all beads
+#else
 	double m_Stress[9];
+#endif
     
 #if EnableParallelSimBox == SimMPSEnabled
     CPolymer* m_pPolymer;   // Parent polymer needed for trans-processor messaging
@@ -29,7 +29,7 @@ public:
 	inline double   GetTRYCoord()   const {return m_TRCoord[1];}
 	inline double   GetTRZCoord()   const {return m_TRCoord[2];}
 	
-	inline BeadList GetBeads()		const {return m_lBeads;}
+	inline const BeadList& GetBeads()	const {return m_lBeads;}
 
 	inline void SetId(long id) {m_id = id;}
 
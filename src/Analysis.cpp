@@ -28,7 +28,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable and function definitions
 //////////////////////////////////////////////////////////////////////
 
-long CAnalysis::m_AggregateTotal = 0;
+SimThreadLocal long CAnalysis::m_AggregateTotal = 0;
 
 long CAnalysis::GetAggregateTotal()
 {
@@ -143,6 +143,18 @@ bool CAnalysis::TimeToAnalyse(long simTime, long analysisPeriod) const
 		return false;
 }
 
+// Default implementation of the in-situ analysis functions: aggregates are
+// updated from the CSimState unless they override these functions.
+
+bool CAnalysis::CanUpdateFromSnapshot() const
+{
+	return false;
+}
+
+void CAnalysis::UpdateStateFromSnapshot(const CInSituSnapshot& rSnapshot)
+{
+}
+
 // Forwarding unction to the enclosed aggregate state object.
 
 bool CAnalysis::Serialize() const
@@ -16,6 +16,7 @@ class CAnalysisTool;
 class aaStressTensor;
 class CSliceProfile;
 class CSlice;
+class CInSituSnapshot;
 
 // Include files
 
@@ -93,6 +94,21 @@ public:
 
 	virtual void ConvertNames(const CAnalysisState& raState) = 0;
 
+	// ****************************************
+	// Functions used by the in-situ analysis mode. An aggregate that can be 
+	// updated from a copy of the bead data returns true from CanUpdateFromSnapshot()
+	// once it has been initialised by a call to UpdateState(), and is then updated 
+	// on the CMonitor's analysis thread instead. It must not use the CSimState,
+	// ISimBox or any other simulation object while doing so.
+	//
+	// Only CMicelle and CCluster implement these so far. CBilayer and 
+	// CCompositeBilayer partition beads using the CNT cells, read the monitor's
+	// stress profile and run their tools against the ISimBox, so they are still
+	// analysed in the timestep loop, as are regions and density fields.
+
+	virtual bool CanUpdateFromSnapshot() const;
+	virtual void UpdateStateFromSnapshot(const CInSituSnapshot& rSnapshot);
+
 	// ****************************************
 	// Function to tell the enclosed aggregate state object to write its data to file
 
@@ -121,7 +137,7 @@ protected:
 	// Static member variables
 
 private:
-	static long m_AggregateTotal;		// Number of aggregates created
+	static SimThreadLocal long m_AggregateTotal;		// Number of aggregates created
 
 
 	// Local member variables
@@ -44,12 +44,14 @@ CAnalysisState::CAnalysisState(const CInputData& rData) : xxState(xxBase::GetASP
 														m_GridYCellNo(rData.GetGridYCellNo()),
 														m_GridZCellNo(rData.GetGridZCellNo()),
 														m_TotalMCTime(rData.GetTotalMCTime()),
+														m_MCThreadNo(rData.GetMCThreadNo()),
 														m_TotalTime(rData.GetTotalTime()),
 														m_SamplePeriod(rData.GetSamplePeriod()),
 														m_AnalysisPeriod(rData.GetAnalysisPeriod()),
 														m_DensityPeriod(rData.GetDensityPeriod()),
 														m_DisplayPeriod(rData.GetDisplayPeriod()),
 														m_RestartPeriod(rData.GetRestartPeriod()),
+														m_SnapshotPrecision(rData.GetSnapshotPrecision()),
 														m_Lambda(rData.GetLambda()),
 														m_RCutOff(rData.GetCutOffRadius()),
 														m_MCStepSize(rData.GetMCStepSize()),
@@ -69,6 +69,7 @@ public:
 	inline long GetGridZCellNo()	const {return m_GridZCellNo;}
 
 	inline long GetTotalMCTime()	const {return m_TotalMCTime;}
+	inline long GetMCThreadNo()		const {return m_MCThreadNo;}
 	inline long GetTotalTime()		const {return m_TotalTime;}
 	inline long GetSamplePeriod()	const {return m_SamplePeriod;}
 	inline long GetAnalysisPeriod() const {return m_AnalysisPeriod;}
@@ -76,6 +77,8 @@ public:
 	inline long GetDisplayPeriod()	const {return m_DisplayPeriod;}
 	inline long GetRestartPeriod()	const {return m_RestartPeriod;}
 
+	inline double GetSnapshotPrecision() const {return m_SnapshotPrecision;}
+
 	inline double GetLambda()			const {return m_Lambda;}
 	inline double GetMCStepSize()		const {return m_MCStepSize;}
 	inline double GetIntegrationStep()	const {return m_StepSize;}
@@ -181,6 +184,7 @@ private:
 	const long m_GridZCellNo;
 
 	const long m_TotalMCTime;
+	const long m_MCThreadNo;
 
 	long m_TotalTime;			// May be changed by command
 	long m_SamplePeriod;
@@ -189,6 +193,8 @@ private:
 	long m_DisplayPeriod;		// May be changed by command
 	long m_RestartPeriod;		// May be changed by command
 
+	const double m_SnapshotPrecision;	// Grid spacing of compressed snapshot coordinates
+
 	const double m_Lambda;
 	const double m_RCutOff;
 	const double m_MCStepSize;
@@ -87,7 +87,6 @@ CBead::CBead(const CBead &oldBead) : CAbstractBead(oldBead)
 //		m_Pos[i]		= oldBead.m_Pos[i];			// CAbstractBead members
 //		m_Mom[i]		= oldBead.m_Mom[i];
 //		m_Force[i]		= oldBead.m_Force[i];
-//		m_AngMom[i]		= oldBead.m_AngMom[i];
 //		m_oldPos[i]		= oldBead.m_oldPos[i];
 //		m_oldMom[i]		= oldBead.m_oldMom[i];
 //		m_oldForce[i]	= oldBead.m_oldForce[i];
@@ -147,7 +146,6 @@ bool CBead::SetFrozen()
 	for(short int i=0; i<3; i++)
 	{
 		m_Mom[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldPos[i]		= m_Pos[i];
 		m_oldMom[i]		= 0.0;
 	}
@@ -166,7 +164,6 @@ bool CBead::SetNotFrozen()
 	for(short int i=0; i<3; i++)
 	{
 		m_Mom[i]		= 0.0;
-		m_AngMom[i]		= 0.0;
 		m_oldMom[i]		= 0.0;
 	}
 
@@ -40,7 +40,7 @@ bool operator==(const CBeadType& a, const CBeadType& b)
 // Static member definitions
 //////////////////////////////////////////////////////////////////////
 
-long CBeadType::m_BeadTypeTotal = 0;	// No of bead types created so far
+SimThreadLocal long CBeadType::m_BeadTypeTotal = 0;	// No of bead types created so far
 
 long CBeadType::GetTotal()
 {
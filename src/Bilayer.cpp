@@ -1034,7 +1034,7 @@ void CBilayer::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 
 	for(cSliceVectorIterator iterSlice=m_pLipidSP->Begin(); iterSlice!=m_pLipidSP->End(); iterSlice++)
 	{
-		BeadList lBeads = (*iterSlice)->GetBeads();
+		const BeadList& lBeads = (*iterSlice)->GetBeads();
 
 		cBeadListIterator iterBead = find_if(lBeads.begin(), lBeads.end(), aaBeadType2(m_LipidHeadType, m_LipidTailType));
 
@@ -150,6 +150,17 @@ void CBond::AddForce()
 	// calculation in CMonitor.
 	// Changed the sign of the stress after checking it in notes, p42ff.
 
+	AddStress();
+}
+
+// Function to add the stress tensor contribution of the bond force to the 
+// head bead without adding the force itself. It uses the bond vector and 
+// force from the last call to AddForce(). The CSimBox's RESPA integration 
+// calls AddForce() several times per timestep, before the beads' stress 
+// is zeroed, so it adds the stress once using this function instead.
+
+void CBond::AddStress()
+{
 	m_pHead->m_Stress[0] += m_dx*m_fx;
 	m_pHead->m_Stress[1] += m_dy*m_fx;
 	m_pHead->m_Stress[2] += m_dz*m_fx;
@@ -161,6 +172,31 @@ void CBond::AddForce()
 	m_pHead->m_Stress[8] += m_dz*m_fz;
 }
 
+// Function to store a bond vector and force calculated outside the bond, and 
+// add the force to the head and tail beads as AddForce() does. The CSimBox's
+// bond kernel evaluates all polymer bonds together in flat arrays and uses 
+// this to write the results back so that CBondPair and the stress functions 
+// see the same bond state as after a call to AddForce(). No stress is added.
+
+void CBond::ApplyForce(double dx, double dy, double dz, double length, double fx, double fy, double fz)
+{
+	m_dx     = dx;
+	m_dy     = dy;
+	m_dz     = dz;
+	m_Length = length;
+	m_fx     = fx;
+	m_fy     = fy;
+	m_fz     = fz;
+
+	m_pHead->m_Force[0]+= m_fx;
+	m_pHead->m_Force[1]+= m_fy;
+	m_pHead->m_Force[2]+= m_fz;
+
+	m_pTail->m_Force[0]-= m_fx;
+	m_pTail->m_Force[1]-= m_fy;
+	m_pTail->m_Force[2]-= m_fz;
+}
+
 // Function to calculate the bond force using bead coordinates that are 
 // restricted to the primary simulation box image. If any component of the 
 // bond length is greater than one half of the simulation box size in 
@@ -223,15 +259,7 @@ void CBond::AddPBCForce()
 		// calculation in CMonitor.
 		// Changed the sign of the stress after checking it in notes, p42ff.
 
-		m_pHead->m_Stress[0] += m_dx*m_fx;
-		m_pHead->m_Stress[1] += m_dy*m_fx;
-		m_pHead->m_Stress[2] += m_dz*m_fx;
-		m_pHead->m_Stress[3] += m_dx*m_fy;
-		m_pHead->m_Stress[4] += m_dy*m_fy;
-		m_pHead->m_Stress[5] += m_dz*m_fy;
-		m_pHead->m_Stress[6] += m_dx*m_fz;
-		m_pHead->m_Stress[7] += m_dy*m_fz;
-		m_pHead->m_Stress[8] += m_dz*m_fz;
+		AddStress();
 	}
 #endif
 
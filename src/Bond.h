@@ -76,6 +76,8 @@ public:
 	void SetTailBead(CAbstractBead* pTail);
 
 	void	AddForce();
+	void	AddStress();
+	void	ApplyForce(double dx, double dy, double dz, double length, double fx, double fy, double fz);
 	void    AddPBCForce();
 	double  AddPotentialEnergy();
 
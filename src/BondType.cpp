@@ -42,7 +42,7 @@ bool operator==(const CBondType& a, const CBondType& b)
 // Static member definitions
 //////////////////////////////////////////////////////////////////////
 
-long CBondType::m_BondTypeTotal = 0;	// No of bond types created so far
+SimThreadLocal long CBondType::m_BondTypeTotal = 0;	// No of bond types created so far
 
 long CBondType::GetTotal()
 {
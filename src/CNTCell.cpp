@@ -39,70 +39,81 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable and function definitions
 //////////////////////////////////////////////////////////////////////
 
-bool   CCNTCell::m_bReadFileOnce  = true;
-long   CCNTCell::m_NextRNIndex    = 0;
-zDoubleVector CCNTCell::m_RandomNumbers;
-long          CCNTCell::m_StringSize = 8;
+SimThreadLocal bool   CCNTCell::m_bReadFileOnce  = true;
+SimThreadLocal long   CCNTCell::m_NextRNIndex    = 0;
+SimThreadLocal zDoubleVector CCNTCell::m_RandomNumbers;
+SimThreadLocal long          CCNTCell::m_StringSize = 8;
 const zString CCNTCell::m_StringSeparator = "-";
 const zString CCNTCell::m_AlphabetChars   = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
 
 
-long   CCNTCell::m_CNTXCellNo			= 0;
-long   CCNTCell::m_CNTYCellNo			= 0;
-long   CCNTCell::m_CNTZCellNo			= 0;
-double CCNTCell::m_CNTXCellWidth		= 0.0;
-double CCNTCell::m_CNTYCellWidth		= 0.0;
-double CCNTCell::m_CNTZCellWidth		= 0.0;
-double CCNTCell::m_SimBoxXLength		= 0.0;
-double CCNTCell::m_SimBoxYLength		= 0.0;
-double CCNTCell::m_SimBoxZLength		= 0.0;
-double CCNTCell::m_HalfSimBoxXLength	= 0.0;
-double CCNTCell::m_HalfSimBoxYLength	= 0.0;
-double CCNTCell::m_HalfSimBoxZLength	= 0.0;
-double CCNTCell::m_dt					= 0.0;
-double CCNTCell::m_lambda				= 0.0;
-double CCNTCell::m_cutoffradius			= 0.0;
-double CCNTCell::m_coradius2			= 0.0;
-double CCNTCell::m_kT					= 0.0;
-double CCNTCell::m_halfdt				= 0.0;
-double CCNTCell::m_halfdt2				= 0.0;
-double CCNTCell::m_invrootdt			= 0.0;
-double CCNTCell::m_lamdt				= 0.0;
-double CCNTCell::m_lgnorm               = 0.0;
-double CCNTCell::m_dtoverkt			    = 0.0;
-double CCNTCell::m_dispmag			    = 0.0;
-uint64_t   CCNTCell::m_RNGSeed	        = -1ull;
+SimThreadLocal long   CCNTCell::m_CNTXCellNo			= 0;
+SimThreadLocal long   CCNTCell::m_CNTYCellNo			= 0;
+SimThreadLocal long   CCNTCell::m_CNTZCellNo			= 0;
+SimThreadLocal double CCNTCell::m_CNTXCellWidth		= 0.0;
+SimThreadLocal double CCNTCell::m_CNTYCellWidth		= 0.0;
+SimThreadLocal double CCNTCell::m_CNTZCellWidth		= 0.0;
+SimThreadLocal double CCNTCell::m_SimBoxXLength		= 0.0;
+SimThreadLocal double CCNTCell::m_SimBoxYLength		= 0.0;
+SimThreadLocal double CCNTCell::m_SimBoxZLength		= 0.0;
+SimThreadLocal double CCNTCell::m_HalfSimBoxXLength	= 0.0;
+SimThreadLocal double CCNTCell::m_HalfSimBoxYLength	= 0.0;
+SimThreadLocal double CCNTCell::m_HalfSimBoxZLength	= 0.0;
+SimThreadLocal double CCNTCell::m_dt					= 0.0;
+SimThreadLocal double CCNTCell::m_lambda				= 0.0;
+SimThreadLocal double CCNTCell::m_cutoffradius			= 0.0;
+SimThreadLocal double CCNTCell::m_coradius2			= 0.0;
+SimThreadLocal double CCNTCell::m_kT					= 0.0;
+SimThreadLocal double CCNTCell::m_halfdt				= 0.0;
+SimThreadLocal double CCNTCell::m_halfdt2				= 0.0;
+SimThreadLocal double CCNTCell::m_invrootdt			= 0.0;
+SimThreadLocal double CCNTCell::m_lamdt				= 0.0;
+SimThreadLocal bool   CCNTCell::m_bPairThermostat		= false;
+SimThreadLocal bool   CCNTCell::m_bLoweAndersen		= false;
+SimThreadLocal double CCNTCell::m_CollisionRate		= 0.0;
+SimThreadLocal double CCNTCell::m_CollisionProb		= 0.0;
+SimThreadLocal long   CCNTCell::m_RESPASubstepNo		= 1;
+SimThreadLocal double CCNTCell::m_rootdt				= 0.0;
+SimThreadLocal double CCNTCell::m_root2kT				= 0.0;
+SimThreadLocal long   CCNTCell::m_PairCheckTotal		= 0;
+SimThreadLocal long   CCNTCell::m_MigrationTotal		= 0;
+SimThreadLocal bool   CCNTCell::m_bCountPairs		= false;
+SimThreadLocal bool   CCNTCell::m_bSumPotential		= false;
+SimThreadLocal double CCNTCell::m_lgnorm               = 0.0;
+SimThreadLocal double CCNTCell::m_dtoverkt			    = 0.0;
+SimThreadLocal double CCNTCell::m_dispmag			    = 0.0;
+SimThreadLocal uint64_t   CCNTCell::m_RNGSeed	        = -1ull;
 long double CCNTCell::m_2Power32             =  4294967296.0l;              // 2**32
 long double CCNTCell::m_Inv2Power32          =  1.0l/CCNTCell::m_2Power32;  // Inverse of 2**32
 
-CMonitor* CCNTCell::m_pMonitor				 = 0;
-ISimBox* CCNTCell::m_pISimBox                = 0;
+SimThreadLocal CMonitor* CCNTCell::m_pMonitor				 = 0;
+SimThreadLocal ISimBox* CCNTCell::m_pISimBox                = 0;
 
-const zArray2dDouble* CCNTCell::m_pvvConsInt = 0;
-const zArray2dDouble* CCNTCell::m_pvvDissInt = 0;
-const zArray2dDouble* CCNTCell::m_pvvLGInt   = 0;
-const zArray2dDouble* CCNTCell::m_pvvLJDepth = 0;
-const zArray2dDouble* CCNTCell::m_pvvLJRange = 0;
-const zArray2dDouble* CCNTCell::m_pvvSCDepth = 0;
-const zArray2dDouble* CCNTCell::m_pvvSCRange = 0;
+SimThreadLocal const zArray2dDouble* CCNTCell::m_pvvConsInt = 0;
+SimThreadLocal const zArray2dDouble* CCNTCell::m_pvvDissInt = 0;
+SimThreadLocal const zArray2dDouble* CCNTCell::m_pvvLGInt   = 0;
+SimThreadLocal const zArray2dDouble* CCNTCell::m_pvvLJDepth = 0;
+SimThreadLocal const zArray2dDouble* CCNTCell::m_pvvLJRange = 0;
+SimThreadLocal const zArray2dDouble* CCNTCell::m_pvvSCDepth = 0;
+SimThreadLocal const zArray2dDouble* CCNTCell::m_pvvSCRange = 0;
 
 // Platform-dependent initialisation of static arrays
 
 
-zArray2dDouble	     CCNTCell::m_vvConsInt;
-zArray2dDouble	     CCNTCell::m_vvDissInt;
-zArray2dDouble	     CCNTCell::m_vvLGInt;
-zArray2dDouble	     CCNTCell::m_vvConsIntBackup;
-zArray2dDouble	     CCNTCell::m_vvDissIntBackup;
-zArray2dDouble	     CCNTCell::m_vvLGIntBackup;
-zArray2dDouble	     CCNTCell::m_vvLJDepth;
-zArray2dDouble	     CCNTCell::m_vvLJRange;
-zArray2dDouble	     CCNTCell::m_vvSCDepth;
-zArray2dDouble	     CCNTCell::m_vvSCRange;
-zArray2dDouble	     CCNTCell::m_vvLJDelta;
-zArray2dDouble	     CCNTCell::m_vvLJSlope;
-zArray2dDouble	     CCNTCell::m_vvSCDelta;
-zArray2dDouble	     CCNTCell::m_vvSCSlope;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvConsInt;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvDissInt;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvLGInt;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvConsIntBackup;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvDissIntBackup;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvLGIntBackup;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvLJDepth;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvLJRange;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvSCDepth;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvSCRange;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvLJDelta;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvLJSlope;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvSCDelta;
+SimThreadLocal zArray2dDouble	     CCNTCell::m_vvSCSlope;
 
 
 // Function to set the static member variable that holds a pointer to the
@@ -136,6 +147,46 @@ void CCNTCell::SetRNGSeed(long idum)
     CCNTCell::m_RNGSeed = static_cast<uint64_t>(abs(idum));
 }
 
+// Functions to get and set the state of the RNG directly. They allow the RNG
+// to be left in the same state whether an initial state is assembled or read
+// from a cache.
+
+uint64_t CCNTCell::GetRNGState()
+{
+    return CCNTCell::m_RNGSeed;
+}
+
+void CCNTCell::SetRNGState(uint64_t state)
+{
+    CCNTCell::m_RNGSeed = state;
+}
+
+// Function to return the seed of an independent random number stream. The 
+// seed is derived from the current RNG state and the stream number using the
+// splitmix64 finaliser, so that neighbouring streams are uncorrelated, but 
+// the RNG state itself is not changed. Streams are used by code that draws 
+// random numbers on several threads and must give the same result however 
+// the work is divided between them. It must be called on the simulation's 
+// thread because the RNG state is thread-local.
+
+uint64_t CCNTCell::GetRandomStreamSeed(long stream)
+{
+    uint64_t z = CCNTCell::m_RNGSeed + (static_cast<uint64_t>(stream) + 1ull)*0x9E3779B97F4A7C15ull;
+
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBull;
+
+    return z ^ (z >> 31);
+}
+
+// Function to return a uniform random number in [0,1) from a stream whose 
+// state is held by the caller. It uses the same generator as Randf().
+
+double CCNTCell::GetStreamRandomNo(uint64_t& rState)
+{
+    return static_cast<double>(CCNTCell::lcg(rState))*CCNTCell::m_Inv2Power32;
+}
+
 // Function to set the static member variables holding the size of the
 // simulation box for use in applying the periodic boundary conditions.
 // Note the default values of 0 until a call to this function is made.
@@ -189,6 +240,9 @@ void CCNTCell::SetTimeStepConstants( const double dt, const double lambda,
 	CCNTCell::m_halfdt2				= 0.5*dt*dt;
 	CCNTCell::m_invrootdt			= sqrt(24.0*kT/dt);
 	CCNTCell::m_lamdt				= lambda*dt;
+	CCNTCell::m_rootdt				= sqrt(dt);
+	CCNTCell::m_root2kT				= sqrt(2.0*kT);
+	CCNTCell::m_CollisionProb		= m_CollisionRate*dt;
     CCNTCell::m_lgnorm				= 15.0/xxBase::m_globalTwoPI;
 	CCNTCell::m_dispmag		        = sqrt(2.0*dt); // Not including the diffusion coefficient
 
@@ -202,6 +256,75 @@ void CCNTCell::SetTimeStepConstants( const double dt, const double lambda,
     }
 }
 
+// Function to select the scheme used to integrate the DPD dissipative and 
+// random forces. The default, "GrootWarren", adds them to the conservative 
+// force in UpdateForce() and integrates all three with the modified velocity 
+// Verlet scheme. The alternatives remove them from UpdateForce() and instead 
+// apply a pairwise thermostat to the bead momenta after UpdateMom():
+//
+// "Shardlow"		S1 splitting of the dissipative and random terms (Shardlow, 
+//					SIAM J. Sci. Comput. 24:1267, 2003). Each pair is updated
+//					in two half steps, the second solved implicitly, so that
+//					the temperature remains stable at larger time steps.
+//
+// "LoweAndersen"	Lowe-Andersen thermostat (Lowe, Europhys. Lett. 47:145, 1999).
+//					Each interacting pair has its relative velocity along the 
+//					separation vector resampled from a Maxwell distribution
+//					with probability collisionRate*dt per step. The dissipation
+//					parameters are not used.
+//
+// The collision rate is only used by the Lowe-Andersen thermostat. We return
+// false if the integrator name is unknown or the collision probability would
+// exceed unity so that the caller can reject the control data.
+
+bool CCNTCell::SetIntegrator(const zString integrator, double collisionRate)
+{
+	if(integrator == "GrootWarren")
+	{
+		CCNTCell::m_bPairThermostat	= false;
+		CCNTCell::m_bLoweAndersen	= false;
+	}
+	else if(integrator == "Shardlow")
+	{
+		CCNTCell::m_bPairThermostat	= true;
+		CCNTCell::m_bLoweAndersen	= false;
+	}
+	else if(integrator == "LoweAndersen" && collisionRate > 0.0 && collisionRate*m_dt <= 1.0)
+	{
+		CCNTCell::m_bPairThermostat	= true;
+		CCNTCell::m_bLoweAndersen	= true;
+	}
+	else
+	{
+		return false;
+	}
+
+	CCNTCell::m_CollisionRate	= collisionRate;
+	CCNTCell::m_CollisionProb	= collisionRate*m_dt;
+
+	return true;
+}
+
+// Function to check that a new time step is compatible with the integrator.
+// It must be positive, and for the Lowe-Andersen thermostat it must not make
+// the collision probability per pair per step exceed unity.
+
+bool CCNTCell::IsTimeStepAllowed(double dt)
+{
+	return dt > 0.0 && (!m_bLoweAndersen || m_CollisionRate*dt <= 1.0);
+}
+
+// Function to set the number of substeps into which each timestep is divided 
+// for the polymer bond and bondpair forces. If it exceeds one, the CSimBox
+// integrates the beads over the whole timestep using the RESPA scheme before
+// calling UpdatePos(), which then only applies the stored displacements and
+// moves beads between cells. A value of one selects the standard scheme.
+
+void CCNTCell::SetRESPASubsteps(long substeps)
+{
+	CCNTCell::m_RESPASubstepNo = (substeps > 1 ? substeps : 1);
+}
+
 // Command handler function to turn the DPD bead-bead interactions on and off.
 //
 // This zeros the conservative, dissipative and random forces between all 
@@ -353,6 +476,9 @@ void CCNTCell::ToggleDPDBeadThermostat(bool bZero)
 // Note that we don't make any attempt to mitigate the effects of the step 
 // size change on the bead forces, etc. If this is to be done it should be 
 // done in the CSimBox that has access to all bead instances.
+//
+// The CSimBox refuses steps for which IsTimeStepAllowed() fails, but as a
+// final safeguard the Lowe-Andersen collision probability is limited to unity.
 
 void CCNTCell::ChangeTimeStepConstants(const double dt)
 {
@@ -363,6 +489,8 @@ void CCNTCell::ChangeTimeStepConstants(const double dt)
 		CCNTCell::m_halfdt2			= 0.5*dt*dt;
 		CCNTCell::m_invrootdt		= sqrt(24.0*m_kT/dt);
 		CCNTCell::m_lamdt			= m_lambda*dt;
+		CCNTCell::m_rootdt			= sqrt(dt);
+		CCNTCell::m_CollisionProb	= (m_CollisionRate*dt <= 1.0 ? m_CollisionRate*dt : 1.0);
 	    CCNTCell::m_dispmag		    = sqrt(2.0*dt); // Not including the diffusion coefficient
 
         if(m_kT > 0.0)
@@ -573,7 +701,7 @@ void CCNTCell::AddDPDBeadType(long oldType)
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-CCNTCell::CCNTCell() : CAbstractCell(), m_bExternal(false)
+CCNTCell::CCNTCell() : CAbstractCell(), m_bExternal(false), m_PotentialEnergy(0.0), m_FrozenTotal(0)
 {
 	for(short int i=0; i<27; i++)	// We allow 3d values for 2d simulations to avoid
 	{								// having to include SimDefs.h in the .h file
@@ -582,6 +710,9 @@ CCNTCell::CCNTCell() : CAbstractCell(), m_bExternal(false)
 	for(short int j=0; j<13; j++)
 	{
 		m_aIntNNCells[j] = 0;
+		m_aIntNNOffset[j][0] = 0;
+		m_aIntNNOffset[j][1] = 0;
+		m_aIntNNOffset[j][2] = 0;
 	}
 }
 
@@ -606,6 +737,8 @@ CCNTCell::CCNTCell(long index, long coords[3], bool flag) : CAbstractCell()
 	// Now the CCNTCell member variables
 
 	m_bExternal		= flag;
+	m_PotentialEnergy	= 0.0;
+	m_FrozenTotal		= 0;
 
 	for(short int i=0; i<27; i++)	// We allow 3d values for 2d simulations to avoid
 	{								// having to include SimDefs.h in the .h file
@@ -614,6 +747,9 @@ CCNTCell::CCNTCell(long index, long coords[3], bool flag) : CAbstractCell()
 	for(short int j=0; j<13; j++)
 	{
 		m_aIntNNCells[j] = 0;
+		m_aIntNNOffset[j][0] = 0;
+		m_aIntNNOffset[j][1] = 0;
+		m_aIntNNOffset[j][2] = 0;
 	}
 	
 	// Copy the bead structure data from the static pointer members into static
@@ -763,7 +899,9 @@ CCNTCell::CCNTCell(long index, long coords[3], bool flag) : CAbstractCell()
 // copy the pointers to the neighbouring cells.
 
 CCNTCell::CCNTCell(const CCNTCell& oldCell) : CAbstractCell(oldCell), 
-                                              m_bExternal(oldCell.m_bExternal)
+                                              m_bExternal(oldCell.m_bExternal),
+                                              m_PotentialEnergy(oldCell.m_PotentialEnergy),
+                                              m_FrozenTotal(oldCell.m_FrozenTotal)
 {
 	for(short int i=0; i<27; i++)	
 	{
@@ -772,6 +910,9 @@ CCNTCell::CCNTCell(const CCNTCell& oldCell) : CAbstractCell(oldCell),
 	for(short int j=0; j<13; j++)
 	{
 		m_aIntNNCells[j] = oldCell.m_aIntNNCells[j];
+		m_aIntNNOffset[j][0] = oldCell.m_aIntNNOffset[j][0];
+		m_aIntNNOffset[j][1] = oldCell.m_aIntNNOffset[j][1];
+		m_aIntNNOffset[j][2] = oldCell.m_aIntNNOffset[j][2];
 	}
 }
 
@@ -873,6 +1014,11 @@ CCNTCell::~CCNTCell()
 // requires that all bead coordinates be at the same timestep and that 
 // they not be updated until after it has been called for all CNT cells 
 // and their contained beads.
+//
+// Pairs of frozen beads, which includes wall beads, are skipped as neither
+// bead can move. UpdatePos() keeps each cell's frozen beads at the end of its 
+// bead list, so a frozen bead only has to be paired with the mobile beads 
+// that precede the first frozen bead in each list.
 
 void CCNTCell::UpdateForce()
 {
@@ -882,6 +1028,37 @@ void CCNTCell::UpdateForce()
 	
 	long  localCellCellCounter = 0;
 
+	// If the performance log is on, accumulate the number of candidate bead-bead
+	// pairs examined by this cell: N(N-1)/2 within the cell plus N times the 
+	// occupancy of each neighbouring cell on the inward side, less the pairs
+	// in which both beads are frozen.
+
+	if(m_bCountPairs)
+	{
+		const long beadTotal = m_lBeads.size();
+		long pairTotal = (beadTotal*(beadTotal - 1) - m_FrozenTotal*(m_FrozenTotal - 1))/2;
+
+#if SimDimension == 2
+		for( int i=0; i<4; i++ )
+#elif SimDimension == 3
+		for( int i=0; i<13; i++ )
+#endif
+		{
+			pairTotal += beadTotal*m_aIntNNCells[i]->m_lBeads.size() - m_FrozenTotal*m_aIntNNCells[i]->m_FrozenTotal;
+		}
+
+		m_PairCheckTotal += pairTotal;
+	}
+
+	// On energy-sampling steps the conservative potential energy of the pairs
+	// whose forces are calculated here is summed as a by-product of the force
+	// calculation. Each pair is visited once in the half-shell traversal.
+
+	if(m_bSumPotential)
+	{
+		m_PotentialEnergy = 0.0;
+	}
+
 #if SimIdentifier == BD
 
 	BeadListIterator iterBead1;
@@ -911,12 +1088,13 @@ void CCNTCell::UpdateForce()
 		// can hence store the N(N-1)/2 contributions to the stress tensor in the
 		// beads that form the first ones accessed in the double loops.
 
-		for(short int j=0; j<9; j++)
-		{
-			(*iterBead1)->m_Stress[j] = 0.0;
-		}
+		(*iterBead1)->ZeroStress();
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
+		// All beads after a frozen bead are frozen, so it has no partners here
+
+		const bool bFrozen1 = (*iterBead1)->GetFrozen();
+
+		for( riterBead2=m_lBeads.rbegin(); !bFrozen1 && (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
 		{
 			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
 			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
@@ -1000,7 +1178,7 @@ void CCNTCell::UpdateForce()
 		for( int i=0; i<13; i++ )
 #endif
 		{
-			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
+			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end() && !(bFrozen1 && (*iterBead2)->GetFrozen()); iterBead2++ )
 			{
 				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
 				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
@@ -1131,6 +1309,22 @@ void CCNTCell::UpdateForce()
 
 #endif
 
+	// Square of the range of the non-bonded interactions used to skip
+	// neighbouring cells that lie wholly out of range of a bead. It is enlarged 
+	// slightly so that rounding in the cell coordinates cannot exclude a pair 
+	// that is in range. When the range depends on the bead radii no cells are
+	// skipped.
+
+#if SimIdentifier == MD
+	const double rangeSq = 1.000001*m_coradius2;
+#elif defined(UseDPDBeadRadii)
+	const double rangeSq = -1.0;
+#else
+	const double rangeSq = 1.000001;
+#endif
+
+	double faceDistSq[3][3];	// Squared distance from a bead to the faces of its cell
+
 //	if( m_lBeads.size() > 0 )
 //	{
 //		TraceInt2("UpdateForce: Cell No has beads with ids:", m_id, m_lBeads.size());
@@ -1156,12 +1350,26 @@ void CCNTCell::UpdateForce()
 		// can hence store the N(N-1)/2 contributions to the stress tensor in the
 		// beads that form the first ones accessed in the double loops.
 
-		for(short int j=0; j<9; j++)
+		(*iterBead1)->ZeroStress();
+
+		// All beads after a frozen bead are frozen, so it has no partners here
+
+		const bool bFrozen1 = (*iterBead1)->GetFrozen();
+
+		// Squared distances from the bead to the lower and upper faces of this
+		// cell in each dimension, indexed by the direction of a neighbour
+
+		for(short int j=0; j<3; j++)
 		{
-			(*iterBead1)->m_Stress[j] = 0.0;
+			const double lower = (*iterBead1)->m_Pos[j] - m_BLCoord[j];
+			const double upper = m_TRCoord[j] - (*iterBead1)->m_Pos[j];
+
+			faceDistSq[j][0] = lower > 0.0 ? lower*lower : 0.0;
+			faceDistSq[j][1] = 0.0;
+			faceDistSq[j][2] = upper > 0.0 ? upper*upper : 0.0;
 		}
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
+		for( riterBead2=m_lBeads.rbegin(); !bFrozen1 && (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
 		{
 			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
 			dv[0] = ((*iterBead1)->m_Mom[0] - (*riterBead2)->m_Mom[0]);
@@ -1216,14 +1424,31 @@ void CCNTCell::UpdateForce()
 					rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
 					gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr2;
 
-					dissForce	= -gammap*rdotv;				
-					randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-// Gauss RNG		randForce	= 0.288675*sqrt(gammap)*CCNTCell::m_invrootdt*CCNTCell::Gasdev();
+					if(m_bPairThermostat)
+					{
+						dissForce	= 0.0;
+						randForce	= 0.0;
+					}
+					else
+					{
+						dissForce	= -gammap*rdotv;				
+						randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
+// Gauss RNG			randForce	= 0.288675*sqrt(gammap)*CCNTCell::m_invrootdt*CCNTCell::Gasdev();
+					}
 
 					newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
 					newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
 					newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
 
+					if(m_bSumPotential)
+					{
+#ifndef UseDPDBeadRadii
+						m_PotentialEnergy += 0.5*conForce*wr;
+#else
+						m_PotentialEnergy += 0.5*drmax*conForce*wr;
+#endif
+					}
+
 #elif SimIdentifier == MD
 
 			if( dr2 < m_coradius2 )
@@ -1265,10 +1490,24 @@ void CCNTCell::UpdateForce()
 					newForce[0] = (magLJ + magSC)*dx[0];
 					newForce[1] = (magLJ + magSC)*dx[1];
 					newForce[2] = (magLJ + magSC)*dx[2];
+
+					if(m_bSumPotential)
+					{
+						m_PotentialEnergy += eLJ*sLJR6*(sLJR6 - 1.0) - m_vvLJDelta.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())
+											+ m_vvLJSlope.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*(dr - m_cutoffradius);
+
+						if(eSC > 0.0)
+						{
+							m_PotentialEnergy += eSC*sSCR3*sSCR3*sSCR3 - m_vvSCDelta.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())
+												+ m_vvSCSlope.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*(dr - m_cutoffradius);
+						}
+					}
 #endif
 
+#if EnableBeadForceCounter == SimMiscEnabled
 					(*iterBead1)->m_ForceCounter++;
 					(*riterBead2)->m_ForceCounter++;
+#endif
 					
 					(*iterBead1)->m_Force[0] += newForce[0];
 					(*iterBead1)->m_Force[1] += newForce[1];
@@ -1358,9 +1597,25 @@ void CCNTCell::UpdateForce()
 				}
 			}
 */			
+			// Skip the neighbouring cell if its nearest point is out of range of 
+			// the bead, as none of its beads can interact with it. This examines
+			// only the region of the neighbouring cells within the range of each
+			// bead, as a grid of ever smaller sub-cells would.
+
+			if(rangeSq > 0.0 && faceDistSq[0][m_aIntNNOffset[i][0]+1] + 
+								faceDistSq[1][m_aIntNNOffset[i][1]+1] + 
+								faceDistSq[2][m_aIntNNOffset[i][2]+1] >= rangeSq)
+			{
+				if(m_bCountPairs)
+				{
+					m_PairCheckTotal -= bFrozen1 ? m_aIntNNCells[i]->m_lBeads.size() - m_aIntNNCells[i]->m_FrozenTotal : m_aIntNNCells[i]->m_lBeads.size();
+				}
+				continue;
+			}
+
 			localCellCellCounter++;  // Increment the local cell-cell inteaction counter
 			
-			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
+			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end() && !(bFrozen1 && (*iterBead2)->GetFrozen()); iterBead2++ )
 			{
 				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
 				dv[0] = ((*iterBead1)->m_Mom[0] - (*iterBead2)->m_Mom[0]);
@@ -1429,14 +1684,31 @@ void CCNTCell::UpdateForce()
 						rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
 						gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr2;
 
-						dissForce	= -gammap*rdotv;				
-						randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-// Gauss RNG		    randForce	= 0.288675*sqrt(gammap)*CCNTCell::m_invrootdt*CCNTCell::Gasdev();
+						if(m_bPairThermostat)
+						{
+							dissForce	= 0.0;
+							randForce	= 0.0;
+						}
+						else
+						{
+							dissForce	= -gammap*rdotv;				
+							randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
+// Gauss RNG		        randForce	= 0.288675*sqrt(gammap)*CCNTCell::m_invrootdt*CCNTCell::Gasdev();
+						}
 
 						newForce[0] = (conForce + dissForce + randForce)*dx[0]/dr;
 						newForce[1] = (conForce + dissForce + randForce)*dx[1]/dr;
 						newForce[2] = (conForce + dissForce + randForce)*dx[2]/dr;
 
+						if(m_bSumPotential)
+						{
+#ifndef UseDPDBeadRadii
+							m_PotentialEnergy += 0.5*conForce*wr;
+#else
+							m_PotentialEnergy += 0.5*drmax*conForce*wr;
+#endif
+						}
+
 #elif SimIdentifier == MD
 
 				if( dr2 < m_coradius2 )
@@ -1478,6 +1750,18 @@ void CCNTCell::UpdateForce()
 						newForce[0] = (magLJ + magSC)*dx[0];
 						newForce[1] = (magLJ + magSC)*dx[1];
 						newForce[2] = (magLJ + magSC)*dx[2];
+
+						if(m_bSumPotential)
+						{
+							m_PotentialEnergy += eLJ*sLJR6*(sLJR6 - 1.0) - m_vvLJDelta.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())
+												+ m_vvLJSlope.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius);
+
+							if(eSC > 0.0)
+							{
+								m_PotentialEnergy += eSC*sSCR3*sSCR3*sSCR3 - m_vvSCDelta.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())
+													+ m_vvSCSlope.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*(dr - m_cutoffradius);
+							}
+						}
 #endif
 
 //                if(((*iterBead1)->GetId() == targetBeadId || (*iterBead2)->GetId() == targetBeadId))
@@ -1485,8 +1769,10 @@ void CCNTCell::UpdateForce()
 //				    std::cout << "CNTCell " << GetId() << " calculating internal force with NN cell " << m_aIntNNCells[i]->GetId() << " for its beads " << (*iterBead1)->GetId() << " " << (*iterBead2)->GetId() << zEndl;
 //				}
 
+#if EnableBeadForceCounter == SimMiscEnabled
 					    (*iterBead1)->m_ForceCounter++;
 					    (*iterBead2)->m_ForceCounter++;
+#endif
 						
 						(*iterBead1)->m_Force[0] += newForce[0];
 						(*iterBead1)->m_Force[1] += newForce[1];
@@ -1631,8 +1917,26 @@ void CCNTCell::UpdatePos()
 
 	double dx[3];
 
+	// Frozen beads never leave the cell and the beads that arrive from other 
+	// cells are added to the front of their new cell's list, so the frozen beads
+	// stay at the end of the list. We only have to reorder it if a command has
+	// frozen or unfrozen beads since the last step. This is detected by finding
+	// a mobile bead after a frozen one.
+
+	long frozenTotal    = 0;
+	bool bFrozenOrdered = true;
+
 	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); )
 	{
+		if((*iterBead)->GetFrozen())
+		{
+			frozenTotal++;
+		}
+		else if(frozenTotal > 0)
+		{
+			bFrozenOrdered = false;
+		}
+
 		// Only allow bead to move if its IsMovable flag is true. This allows
 		// us to indicate when a bead has already crossed a cell boundary and
 		// should not be moved again in this timestep.
@@ -1708,19 +2012,31 @@ void CCNTCell::UpdatePos()
 			(*iterBead)->m_oldPos[1] = (*iterBead)->m_Pos[1];
 			(*iterBead)->m_oldPos[2] = (*iterBead)->m_Pos[2];
 
-			(*iterBead)->m_oldMom[0] = (*iterBead)->m_Mom[0];
-			(*iterBead)->m_oldMom[1] = (*iterBead)->m_Mom[1];
-			(*iterBead)->m_oldMom[2] = (*iterBead)->m_Mom[2];
+			if(m_RESPASubstepNo > 1)
+			{
+				// The CSimBox has already integrated the bead's momentum and 
+				// stored its displacement over the whole timestep
 
-			(*iterBead)->m_oldForce[0] = (*iterBead)->m_Force[0];
-			(*iterBead)->m_oldForce[1] = (*iterBead)->m_Force[1];
-			(*iterBead)->m_oldForce[2] = (*iterBead)->m_Force[2];
+				dx[0] = (*iterBead)->m_dPos[0];
+				dx[1] = (*iterBead)->m_dPos[1];
+				dx[2] = (*iterBead)->m_dPos[2];
+			}
+			else
+			{
+				(*iterBead)->m_oldMom[0] = (*iterBead)->m_Mom[0];
+				(*iterBead)->m_oldMom[1] = (*iterBead)->m_Mom[1];
+				(*iterBead)->m_oldMom[2] = (*iterBead)->m_Mom[2];
+
+				(*iterBead)->m_oldForce[0] = (*iterBead)->m_Force[0];
+				(*iterBead)->m_oldForce[1] = (*iterBead)->m_Force[1];
+				(*iterBead)->m_oldForce[2] = (*iterBead)->m_Force[2];
 	
-			// Update position coordinates
+				// Update position coordinates
 
-			dx[0] = m_dt*(*iterBead)->m_Mom[0] + m_halfdt2*(*iterBead)->m_Force[0];
-			dx[1] = m_dt*(*iterBead)->m_Mom[1] + m_halfdt2*(*iterBead)->m_Force[1];
-			dx[2] = m_dt*(*iterBead)->m_Mom[2] + m_halfdt2*(*iterBead)->m_Force[2];
+				dx[0] = m_dt*(*iterBead)->m_Mom[0] + m_halfdt2*(*iterBead)->m_Force[0];
+				dx[1] = m_dt*(*iterBead)->m_Mom[1] + m_halfdt2*(*iterBead)->m_Force[1];
+				dx[2] = m_dt*(*iterBead)->m_Mom[2] + m_halfdt2*(*iterBead)->m_Force[2];
+			}
 
 			(*iterBead)->m_Pos[0] += dx[0];
 			(*iterBead)->m_Pos[1] += dx[1];
@@ -1740,20 +2056,24 @@ void CCNTCell::UpdatePos()
 			(*iterBead)->m_dPos[1] = dx[1];
 			(*iterBead)->m_dPos[2] = dx[2];
 
-			// Update intermediate velocity
+			// Update intermediate velocity and zero current force on beads so that
+			// UpdateForce() just has to form a sum of all bead-bead interactions.
+			// The RESPA scheme has already done both.
 
-			(*iterBead)->m_Mom[0] = (*iterBead)->m_oldMom[0] + m_lamdt*(*iterBead)->m_oldForce[0];
-			(*iterBead)->m_Mom[1] = (*iterBead)->m_oldMom[1] + m_lamdt*(*iterBead)->m_oldForce[1];
-			(*iterBead)->m_Mom[2] = (*iterBead)->m_oldMom[2] + m_lamdt*(*iterBead)->m_oldForce[2];
+			if(m_RESPASubstepNo == 1)
+			{
+				(*iterBead)->m_Mom[0] = (*iterBead)->m_oldMom[0] + m_lamdt*(*iterBead)->m_oldForce[0];
+				(*iterBead)->m_Mom[1] = (*iterBead)->m_oldMom[1] + m_lamdt*(*iterBead)->m_oldForce[1];
+				(*iterBead)->m_Mom[2] = (*iterBead)->m_oldMom[2] + m_lamdt*(*iterBead)->m_oldForce[2];
 
-			// Zero current force on beads so that UpdateForce() just has to form
-			// a sum of all bead-bead interactions
+				(*iterBead)->m_Force[0] = 0.0;
+				(*iterBead)->m_Force[1] = 0.0;
+				(*iterBead)->m_Force[2] = 0.0;
+			}
 
+#if EnableBeadForceCounter == SimMiscEnabled
 			(*iterBead)->m_ForceCounter = 0;
-
-			(*iterBead)->m_Force[0] = 0.0;
-			(*iterBead)->m_Force[1] = 0.0;
-			(*iterBead)->m_Force[2] = 0.0;
+#endif
 #endif
 
 // **********************************************************************
@@ -1784,6 +2104,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[26]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DTR
 					{
@@ -1799,6 +2120,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[8]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves TR
 					{
@@ -1812,6 +2134,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[17]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[8]->IsExternal())
@@ -1824,6 +2147,7 @@ void CCNTCell::UpdatePos()
 					(*iterBead)->SetNotMovable();
 					m_aNNCells[8]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 				else if( (*iterBead)->m_Pos[1] < m_BLCoord[1] )
@@ -1843,6 +2167,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[20]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DBR
 					{
@@ -1858,6 +2183,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[2]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves BR
 					{
@@ -1871,6 +2197,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[11]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[2]->IsExternal())
@@ -1883,6 +2210,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 					m_aNNCells[2]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 				else	// no change in Y direction
@@ -1900,6 +2228,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[23]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DR
 					{
@@ -1913,6 +2242,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[5]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves R
 					{
@@ -1924,6 +2254,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[14]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[5]->IsExternal())
@@ -1934,6 +2265,7 @@ void CCNTCell::UpdatePos()
 					(*iterBead)->SetNotMovable();
 					m_aNNCells[5]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 			}
@@ -1956,6 +2288,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[24]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DTL
 					{
@@ -1971,6 +2304,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[6]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves TL
 					{
@@ -1984,6 +2318,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[15]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[6]->IsExternal())
@@ -1996,6 +2331,7 @@ void CCNTCell::UpdatePos()
 					(*iterBead)->SetNotMovable();
 					m_aNNCells[6]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 				else if( (*iterBead)->m_Pos[1] < m_BLCoord[1] )	
@@ -2015,6 +2351,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[18]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DBL
 					{
@@ -2030,6 +2367,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[0]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves BL
 					{
@@ -2043,6 +2381,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[9]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[0]->IsExternal())
@@ -2055,6 +2394,7 @@ void CCNTCell::UpdatePos()
 					(*iterBead)->SetNotMovable();
 					m_aNNCells[0]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 				else	// no change in Y direction
@@ -2072,6 +2412,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[21]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DL
 					{
@@ -2085,6 +2426,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[3]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves L
 					{
@@ -2096,6 +2438,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[12]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[3]->IsExternal())
@@ -2106,6 +2449,7 @@ void CCNTCell::UpdatePos()
 					(*iterBead)->SetNotMovable();
 					m_aNNCells[3]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 			}
@@ -2126,6 +2470,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[25]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DT
 					{
@@ -2139,6 +2484,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[7]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves T
 					{
@@ -2150,6 +2496,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[16]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[7]->IsExternal())
@@ -2160,6 +2507,7 @@ void CCNTCell::UpdatePos()
 					(*iterBead)->SetNotMovable();
 					m_aNNCells[7]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 				else if( (*iterBead)->m_Pos[1] < m_BLCoord[1] )
@@ -2177,6 +2525,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[19]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves DB
 					{
@@ -2190,6 +2539,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[1]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else	// bead moves B
 					{
@@ -2201,6 +2551,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[10]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 #elif SimDimension == 2
 					if(m_bExternal && m_aNNCells[1]->IsExternal())
@@ -2211,6 +2562,7 @@ void CCNTCell::UpdatePos()
 					(*iterBead)->SetNotMovable();
 					m_aNNCells[1]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 #endif
 				}
 				else	// no change in X, Y directions
@@ -2226,6 +2578,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[22]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else if( (*iterBead)->m_Pos[2] < m_BLCoord[2] )	// bead moves D
 					{
@@ -2237,6 +2590,7 @@ void CCNTCell::UpdatePos()
 						(*iterBead)->SetNotMovable();
 						m_aNNCells[4]->m_lBeads.push_front((*iterBead));
 						iterBead = m_lBeads.erase(iterBead);
+						m_MigrationTotal++;
 					}
 					else
 					{
@@ -2259,6 +2613,13 @@ void CCNTCell::UpdatePos()
 		}
 // **********************************************************************
 	}
+
+	m_FrozenTotal = frozenTotal;
+
+	if(!bFrozenOrdered)
+	{
+		OrderFrozenBeads();
+	}
 }
 
 // Function to update the velocity of the beads using the old
@@ -2295,17 +2656,159 @@ void CCNTCell::UpdateMom()
 									 m_halfdt*((*iterBead)->m_Force[1] + (*iterBead)->m_oldForce[1]);
 			(*iterBead)->m_Mom[2] = (*iterBead)->m_oldMom[2] + 
 									 m_halfdt*((*iterBead)->m_Force[2] + (*iterBead)->m_oldForce[2]);		
+		}
+#endif
+	}
+}
+
+// Function to apply the pairwise DPD thermostat selected by SetIntegrator()
+// to the bead momenta. It is called for every CNT cell after UpdateMom() 
+// and visits each bead pair once using the same half-shell of neighbouring 
+// cells as UpdateForce(). Pairs are processed sequentially so that each pair 
+// sees the momenta already updated by earlier pairs, as the splitting 
+// requires. Pairs containing an immovable bead are skipped because their 
+// momenta are never integrated. Note that the dissipative and random forces 
+// do not then contribute to the stress tensor.
+
+void CCNTCell::UpdatePairThermostat()
+{
+	double dx[3];
+
+	for(BeadListIterator iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++)
+	{
+		if(!(*iterBead1)->GetMovable())
+			continue;
+
+		for(rBeadListIterator riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2)
+		{
+			if((*riterBead2)->GetMovable())
+			{
+				dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
+				dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
+#if SimDimension == 2
+				dx[2] = 0.0;
+#elif SimDimension == 3
+				dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
+#endif
+				ThermostatPair(*iterBead1, *riterBead2, dx);
+			}
+		}
+
+#if SimDimension == 2
+		for( int i=0; i<4; i++ )
+#elif SimDimension == 3
+		for( int i=0; i<13; i++ )
+#endif
+		{
+			const bool bPBC = m_bExternal && m_aIntNNCells[i]->IsExternal();
+
+			for(BeadListIterator iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++)
+			{
+				if(!(*iterBead2)->GetMovable())
+					continue;
+
+				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
+				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
+#if SimDimension == 2
+				dx[2] = 0.0;
+#elif SimDimension == 3
+				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
+#endif
+
+				if(bPBC)
+				{
+					if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
+						dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
+					else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
+						dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
 
-			(*iterBead)->m_AngMom[0]	= (*iterBead)->m_Pos[1]*(*iterBead)->m_Mom[2] - 
-										  (*iterBead)->m_Pos[2]*(*iterBead)->m_Mom[1];
+					if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
+						dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
+					else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
+						dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
 
-			(*iterBead)->m_AngMom[1]	= -(*iterBead)->m_Pos[0]*(*iterBead)->m_Mom[2] + 
-										   (*iterBead)->m_Pos[2]*(*iterBead)->m_Mom[0];
+#if SimDimension == 3
+					if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
+						dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
+					else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
+						dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
+#endif
+				}
 
-			(*iterBead)->m_AngMom[2]	= (*iterBead)->m_Pos[0]*(*iterBead)->m_Mom[1] - 
-										  (*iterBead)->m_Pos[1]*(*iterBead)->m_Mom[0];
+				ThermostatPair(*iterBead1, *iterBead2, dx);
+			}
 		}
+	}
+}
+
+// Private helper function to update the momenta of a single bead pair for 
+// the pairwise thermostat. All beads have unit mass so the change in the 
+// relative velocity along the unit separation vector, e, is shared equally 
+// between the two beads.
+//
+// Shardlow S1: with a = gamma*wD*dt and s = sigma*wR*xi*sqrt(dt), the first
+// half step is explicit and the second is solved implicitly for the new 
+// relative velocity, u' = (u + s)/(1 + a). The same random number is used
+// in both halves.
+//
+// Lowe-Andersen: with probability Gamma*dt the relative velocity is replaced
+// by a sample from the Maxwell distribution for the pair's reduced mass.
+
+void CCNTCell::ThermostatPair(CAbstractBead* const pBead1, CAbstractBead* const pBead2, const double dx[3])
+{
+	const double dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+
+#ifndef UseDPDBeadRadii
+	const double drmax = 1.0;
+#else
+	const double drmax = pBead1->GetRadius() + pBead2->GetRadius();
 #endif
+
+	if(dr2 < drmax*drmax && dr2 > 0.000000001)
+	{
+		const double dr = sqrt(dr2);
+		const double e[3] = {dx[0]/dr, dx[1]/dr, dx[2]/dr};
+
+		double u = e[0]*(pBead1->m_Mom[0] - pBead2->m_Mom[0]) + 
+				   e[1]*(pBead1->m_Mom[1] - pBead2->m_Mom[1]) + 
+				   e[2]*(pBead1->m_Mom[2] - pBead2->m_Mom[2]);
+
+		double delta;
+
+		if(m_bLoweAndersen)
+		{
+			if(CCNTCell::Randf() >= m_CollisionProb)
+				return;
+
+			delta = 0.5*(m_root2kT*CCNTCell::Gasdev() - u);
+		}
+		else
+		{
+			const double wr    = 1.0 - dr/drmax;
+			const double gamma = m_vvDissInt.at(pBead1->GetType()).at(pBead2->GetType());
+			const double a     = gamma*wr*wr*m_dt;
+			const double s     = sqrt(gamma)*m_root2kT*wr*m_rootdt*3.464101615*(CCNTCell::Randf() - 0.5);
+
+			delta = 0.5*(s - a*u);
+
+			pBead1->m_Mom[0] += delta*e[0];
+			pBead1->m_Mom[1] += delta*e[1];
+			pBead1->m_Mom[2] += delta*e[2];
+			pBead2->m_Mom[0] -= delta*e[0];
+			pBead2->m_Mom[1] -= delta*e[1];
+			pBead2->m_Mom[2] -= delta*e[2];
+
+			u += 2.0*delta;
+
+			delta = 0.5*((u + s)/(1.0 + a) - u);
+		}
+
+		pBead1->m_Mom[0] += delta*e[0];
+		pBead1->m_Mom[1] += delta*e[1];
+		pBead1->m_Mom[2] += delta*e[2];
+		pBead2->m_Mom[0] -= delta*e[0];
+		pBead2->m_Mom[1] -= delta*e[1];
+		pBead2->m_Mom[2] -= delta*e[2];
 	}
 }
 
@@ -2334,18 +2837,34 @@ void CCNTCell::SetNNCellIndex(long index, CCNTCell *pCell)
 
 }
 
-// Function to add a bead to the current cell.
+// Function to add a bead to the current cell. Frozen beads are kept at the
+// end of the list so that UpdateForce() can skip pairs of frozen beads.
 
 void CCNTCell::AddBeadtoCell(CAbstractBead *pBead)
 {
-	m_lBeads.push_front(pBead);
+	if(pBead->GetFrozen())
+	{
+		m_lBeads.push_back(pBead);
+		m_FrozenTotal++;
+	}
+	else
+	{
+		m_lBeads.push_front(pBead);
+	}
 }
 
 // Function to remove a bead from the current cell.
 
 void CCNTCell::RemoveBeadFromCell(CAbstractBead* const pBead)
 {
+	const long oldTotal = m_lBeads.size();
+
 	m_lBeads.remove(pBead);
+
+	if(pBead->GetFrozen() && static_cast<long>(m_lBeads.size()) < oldTotal)
+	{
+		m_FrozenTotal--;
+	}
 }
 
 // Function to remove all beads from the current cell. Note that this does NOT
@@ -2354,17 +2873,43 @@ void CCNTCell::RemoveBeadFromCell(CAbstractBead* const pBead)
 void CCNTCell::RemoveAllBeadsFromCell()
 {
 	m_lBeads.clear();
+	m_FrozenTotal = 0;
 }
 
-long CCNTCell::CellBeadTotal() const
+// Private function to restore the order of the bead list when beads have been
+// frozen or unfrozen by a command: the frozen beads are moved to the end of the
+// list keeping the relative order of both sets of beads.
+
+void CCNTCell::OrderFrozenBeads()
 {
-	return m_lBeads.size();
-}
+	m_FrozenTotal = 0;
 
-// Function to store a pointer to a nearest-neighbour cell used in 
-// calculating the interactions between beads. Because the forces are
-// all pairwise we only have to loop over bead pairs once. Hence we store
-// pointers to those cells that are to the right of, or above the current cell.
+	BeadListIterator iterBead = m_lBeads.begin();
+
+	for(long i=static_cast<long>(m_lBeads.size()); i>0; i--)
+	{
+		BeadListIterator iterNext = iterBead;
+		++iterNext;
+
+		if((*iterBead)->GetFrozen())
+		{
+			m_lBeads.splice(m_lBeads.end(), m_lBeads, iterBead);
+			m_FrozenTotal++;
+		}
+
+		iterBead = iterNext;
+	}
+}
+
+long CCNTCell::CellBeadTotal() const
+{
+	return m_lBeads.size();
+}
+
+// Function to store a pointer to a nearest-neighbour cell used in 
+// calculating the interactions between beads. Because the forces are
+// all pairwise we only have to loop over bead pairs once. Hence we store
+// pointers to those cells that are to the right of, or above the current cell.
 
 
 void CCNTCell::SetIntNNCellIndex( long index, CCNTCell* pCell )
@@ -2378,6 +2923,38 @@ void CCNTCell::SetIntNNCellIndex( long index, CCNTCell* pCell )
 	{
 // map cell index to cell pointer using an array
 		m_aIntNNCells[index] = pCell;
+
+		// Store the direction of the neighbouring cell, allowing for the PBCs,
+		// so that UpdateForce() can find the distance from a bead to the cell.
+		// If the direction is ambiguous because there are too few cells in a 
+		// dimension we store zero so that the cell is never skipped.
+
+		const long cellNo[3] = {m_CNTXCellNo, m_CNTYCellNo, m_CNTZCellNo};
+		const long nnIndex[3] = {pCell->GetBLXIndex(), pCell->GetBLYIndex(), pCell->GetBLZIndex()};
+
+		bool bKnown = true;
+
+		for(short int j=0; j<3; j++)
+		{
+			long offset = nnIndex[j] - m_BLIndex[j];
+
+			if(offset > 1)
+				offset -= cellNo[j];
+			else if(offset < -1)
+				offset += cellNo[j];
+
+			if(offset < -1 || offset > 1 || (offset != 0 && cellNo[j] < 3))
+				bKnown = false;
+
+			m_aIntNNOffset[index][j] = offset;
+		}
+
+		if(!bKnown)
+		{
+			m_aIntNNOffset[index][0] = 0;
+			m_aIntNNOffset[index][1] = 0;
+			m_aIntNNOffset[index][2] = 0;
+		}
 	}
 	else
 	{
@@ -2879,6 +3456,182 @@ double CCNTCell::GetPotentialEnergy(CAbstractBead *pBead) const
 	return totalPE;
 }
 
+// Function to return the potential energy of a bead interacting with all the
+// beads in the current cell and all of its neighbours. Unlike GetPotentialEnergy(),
+// it visits the full set of neighbouring cells and not just the half-shell used
+// for the forces, so the result is the bead's complete non-bonded energy. The
+// bead may be in the cell's bead list as it is skipped by pointer, and the 
+// current cell need not be the one holding the bead. The caller must ensure 
+// that there are at least three cells in each dimension so that no neighbour
+// is visited twice.
+//
+// It only reads the beads in the neighbouring cells, so it can be called
+// concurrently on threads that work on cells separated by more than two
+// cells. Such threads must first copy the interaction tables from the 
+// simulation's thread using SetMDPotentialState().
+
+double CCNTCell::GetNeighbourhoodPotentialEnergy(const CAbstractBead* pBead) const
+{
+	double totalPE = 0.0;
+
+#if SimIdentifier == MD
+
+	const zDoubleVector& rvLJDepth = m_vvLJDepth.at(pBead->GetType());
+	const zDoubleVector& rvLJRange = m_vvLJRange.at(pBead->GetType());
+	const zDoubleVector& rvLJDelta = m_vvLJDelta.at(pBead->GetType());
+	const zDoubleVector& rvLJSlope = m_vvLJSlope.at(pBead->GetType());
+	const zDoubleVector& rvSCDepth = m_vvSCDepth.at(pBead->GetType());
+	const zDoubleVector& rvSCRange = m_vvSCRange.at(pBead->GetType());
+	const zDoubleVector& rvSCDelta = m_vvSCDelta.at(pBead->GetType());
+	const zDoubleVector& rvSCSlope = m_vvSCSlope.at(pBead->GetType());
+
+	double dx[3];
+	double dr, dr2;
+
+	double magLJ;						// LJ potential variables
+	double sLJOverR, sLJR3, sLJR6;
+
+	double magSC;						// SC potential variables
+	double eSC, sSCOverR, sSCR3;
+
+#if SimDimension == 2
+	for( int i=0; i<9; i++ )
+#elif SimDimension == 3
+	for( int i=0; i<27; i++ )
+#endif
+	{
+		const bool bPBC = m_bExternal && m_aNNCells[i]->IsExternal();
+
+		for(cBeadListIterator iterBead2=m_aNNCells[i]->m_lBeads.begin(); iterBead2!=m_aNNCells[i]->m_lBeads.end(); iterBead2++)
+		{
+			if(*iterBead2 == pBead)
+				continue;
+
+			dx[0] = pBead->m_Pos[0] - (*iterBead2)->m_Pos[0];
+			dx[1] = pBead->m_Pos[1] - (*iterBead2)->m_Pos[1];
+
+#if SimDimension == 2
+			dx[2] = 0.0;
+#elif SimDimension == 3
+			dx[2] = pBead->m_Pos[2] - (*iterBead2)->m_Pos[2];
+#endif
+
+			if(bPBC)
+			{
+				if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
+					dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
+				else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
+					dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
+
+				if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
+					dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
+				else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
+					dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
+
+#if SimDimension == 3
+				if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
+					dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
+				else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
+					dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
+#endif
+			}
+
+			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+
+			if( dr2 < m_coradius2 && dr2 > 0.000000001 )
+			{		
+				const long type2 = (*iterBead2)->GetType();
+
+				dr = sqrt(dr2);
+
+				sLJOverR  = rvLJRange[type2]/dr;
+				sLJR3	  = sLJOverR*sLJOverR*sLJOverR;
+				sLJR6	  = sLJR3*sLJR3;
+				magLJ	  = rvLJDepth[type2]*sLJR6*(sLJR6 - 1.0);
+
+				totalPE += (magLJ - rvLJDelta[type2] + rvLJSlope[type2]*(dr - m_cutoffradius));
+
+				// Only add the soft-core potential if the potential depth is non-zero
+
+				eSC = rvSCDepth[type2];	
+
+				if(eSC > 0.0)
+				{
+					sSCOverR  = rvSCRange[type2]/dr;
+					sSCR3	  = sSCOverR*sSCOverR*sSCOverR;
+					magSC	  = eSC*sSCR3*sSCR3*sSCR3;
+
+					totalPE += (magSC - rvSCDelta[type2] + rvSCSlope[type2]*(dr - m_cutoffradius));
+				}
+			}
+		}
+	}
+
+#endif
+
+	return totalPE;
+}
+
+// Functions to copy the thread-local simulation box size and MD interaction
+// tables out of, and into, the calling thread. A worker thread starts with the
+// default values of these members, so it must be given the simulation thread's
+// values before calling GetNeighbourhoodPotentialEnergy().
+
+namespace
+{
+	// Copy an interaction table row by row. xxBasevector declares a copy 
+	// constructor but no assignment operator, so the rows are copy-constructed.
+
+	void CopyTable(const zArray2dDouble& rFrom, zArray2dDouble& rTo)
+	{
+		rTo.clear();
+		rTo.reserve(rFrom.size());
+
+		for(zArray2dDouble::const_iterator iterRow=rFrom.begin(); iterRow!=rFrom.end(); iterRow++)
+		{
+			rTo.push_back(*iterRow);
+		}
+	}
+}
+
+void CCNTCell::GetMDPotentialState(MDPotentialState& rState)
+{
+	rState.boxLength[0] = CCNTCell::m_SimBoxXLength;
+	rState.boxLength[1] = CCNTCell::m_SimBoxYLength;
+	rState.boxLength[2] = CCNTCell::m_SimBoxZLength;
+	rState.cutoffRadius = CCNTCell::m_cutoffradius;
+
+	CopyTable(CCNTCell::m_vvLJDepth, rState.vvLJDepth);
+	CopyTable(CCNTCell::m_vvLJRange, rState.vvLJRange);
+	CopyTable(CCNTCell::m_vvSCDepth, rState.vvSCDepth);
+	CopyTable(CCNTCell::m_vvSCRange, rState.vvSCRange);
+	CopyTable(CCNTCell::m_vvLJDelta, rState.vvLJDelta);
+	CopyTable(CCNTCell::m_vvLJSlope, rState.vvLJSlope);
+	CopyTable(CCNTCell::m_vvSCDelta, rState.vvSCDelta);
+	CopyTable(CCNTCell::m_vvSCSlope, rState.vvSCSlope);
+}
+
+void CCNTCell::SetMDPotentialState(const MDPotentialState& rState)
+{
+	CCNTCell::m_SimBoxXLength		= rState.boxLength[0];
+	CCNTCell::m_SimBoxYLength		= rState.boxLength[1];
+	CCNTCell::m_SimBoxZLength		= rState.boxLength[2];
+	CCNTCell::m_HalfSimBoxXLength	= 0.5*m_SimBoxXLength;
+	CCNTCell::m_HalfSimBoxYLength	= 0.5*m_SimBoxYLength;
+	CCNTCell::m_HalfSimBoxZLength	= 0.5*m_SimBoxZLength;
+	CCNTCell::m_cutoffradius		= rState.cutoffRadius;
+	CCNTCell::m_coradius2			= rState.cutoffRadius*rState.cutoffRadius;
+
+	CopyTable(rState.vvLJDepth, CCNTCell::m_vvLJDepth);
+	CopyTable(rState.vvLJRange, CCNTCell::m_vvLJRange);
+	CopyTable(rState.vvSCDepth, CCNTCell::m_vvSCDepth);
+	CopyTable(rState.vvSCRange, CCNTCell::m_vvSCRange);
+	CopyTable(rState.vvLJDelta, CCNTCell::m_vvLJDelta);
+	CopyTable(rState.vvLJSlope, CCNTCell::m_vvLJSlope);
+	CopyTable(rState.vvSCDelta, CCNTCell::m_vvSCDelta);
+	CopyTable(rState.vvSCSlope, CCNTCell::m_vvSCSlope);
+}
+
 // Function to calculate the total kinetic energy and bead-bead potential energies 
 // for all beads in a CNT cell. This involves bead pairs in the current cell and 
 // adjacent cells. Bond and bondpair potential energies are not calculated here,
@@ -3208,158 +3961,237 @@ void CCNTCell::UpdateTotalEnergy(double* const pKinetic, double* const pPotentia
 #endif
 }
 
+// Function to pass the energy of the cell's beads to the CMonitor on steps
+// where UpdateForce() or UpdateLGForce() have summed the conservative potential
+// energy of the pairs they visit. This replaces the second pair traversal in
+// UpdateTotalEnergy() with a loop over the cell's beads for the kinetic energy.
+// Because the force calculation visits each pair in the half-shell once, pairs 
+// that straddle two cells are counted once without the bead id check used above.
+//
+// NOTE. The function CMonitor::ZeroTotalEnergy() must be called before using this 
+// routine, and SetPotentialSum(true) before the force calculation.
+
+void CCNTCell::AddForceEnergy() const
+{
+#if SimIdentifier != BD
+	double kinetic = 0.0;
+
+	for(cBeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++ )
+	{
+		kinetic += (*iterBead)->m_Mom[0]*(*iterBead)->m_Mom[0] +
+				   (*iterBead)->m_Mom[1]*(*iterBead)->m_Mom[1] +
+				   (*iterBead)->m_Mom[2]*(*iterBead)->m_Mom[2];
+	}
+
+	m_pMonitor->AddBeadEnergy(kinetic, m_PotentialEnergy);
+#endif
+}
+
 // Function that replaces UpdateForce() when the DPD density-dependent force
 // is included. This allows the appearance of liquid-gas interfaces in the 
 // simulation. It is only included if the EnableDPDLG flag is set, but even then
-// should only be called if the LG force is actually included as it is 
-// less efficient than the standard force calculation.
+// should only be called if the LG force is actually included.
 //
-// It peforms an extra calculation of the local bead density around each of the
-// pair of interacting beads and adds in a density-dependent force after
-// Warren PRL 2001.
+// It adds a density-dependent force after Warren PRL 2001 to the standard DPD
+// forces. The local bead densities must already have been calculated for all
+// beads in the SimBox by UpdateLGDensity(), which also stores the separation 
+// of every bead pair in the half-shell of the current cell that lies within 
+// range of either the DPD or the LG interaction. We iterate over this cached 
+// pair list instead of repeating the neighbour-cell traversal. The bead momenta
+// are not changed between the two passes, so only the relative velocity has
+// to be formed here.
 
 void CCNTCell::UpdateLGForce()
 {
 #if EnableDPDLG == ExperimentEnabled
 
-	BeadListIterator iterBead1;
-	BeadListIterator iterBead2;
-	rBeadListIterator riterBead2;
-
-	double dx[3], dv[3], newForce[3];
-	double dr, dr2;
+	double dv[3], newForce[3];
+	double dr;
 	double gammap, rdotv, wr, wr2;
-	double conForce, dissForce, randForce;
+	double conForce, dissForce, randForce, totalForce;
 	double drmax;
 
     double lgForce, lgPrefactor;
     double wrd, drdmax;  // Parameters needed for DPDLG force
 
-	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
+	if(m_bSumPotential)
 	{
-		// First add interactions between beads in the current cell. Note that
-		// we don't have to check the PBCs here and we perform a reverse loop
-		// over the neighbouring beads until the iterators are equal. Because you can't
-		// compare a forward and reverse iterator we compare the bead ids for
-		// the terminating condition.
+		m_PotentialEnergy = 0.0;
+	}
 
-		// Zero the stress tensor for this bead. Notice that because of the
-		// way we only sum over beads distinct from the current bead in the same
-		// cell, and over beads in cells to the right and above the current cell
-		// we don't have to worry about double counting the pairwise forces. We
-		// can hence store the N(N-1)/2 contributions to the stress tensor in the
-		// beads that form the first ones accessed in the double loops.
+	// Zero the stress tensor for the beads in this cell. As in UpdateForce() 
+	// the N(N-1)/2 pair contributions are stored in the first bead of each pair, 
+	// and this is always a bead in the current cell.
 
-		for(short int j=0; j<9; j++)
-		{
-			(*iterBead1)->m_Stress[j] = 0.0;
-		}
+	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++)
+	{
+		(*iterBead)->ZeroStress();
+	}
 
-		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
-		{
-			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
-			dv[0] = ((*iterBead1)->m_Mom[0] - (*riterBead2)->m_Mom[0]);
+	for(LGPairIterator iterPair=m_vLGPairs.begin(); iterPair!=m_vLGPairs.end(); iterPair++)
+	{
+		CAbstractBead* const pBead1 = iterPair->pBead1;
+		CAbstractBead* const pBead2 = iterPair->pBead2;
 
-			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
-			dv[1] = ((*iterBead1)->m_Mom[1] - (*riterBead2)->m_Mom[1]);
+		dr    = iterPair->dr;
+		drmax = pBead1->GetRadius() + pBead2->GetRadius();
 
-#if SimDimension == 2
-			dx[2] = 0.0;
-			dv[2] = 0.0;
-#elif SimDimension == 3
-			dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
-			dv[2] = ((*iterBead1)->m_Mom[2] - (*riterBead2)->m_Mom[2]);
-#endif
+		// Pairs that are only within range of the density weighting function 
+		// do not contribute to the force
 
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-
-// Calculate the interactions between the two DPD beads including the 
-// density-dependent force. Note that the LG force prefactor depends on
-// the cube of the interaction range, and this may depend on bead type.
-// If all beads have the same LG range, then it is a constant factor and
-// it would be more efficient to include in the constant m_lgnorm.
+		if( dr < drmax )
+		{
+			dv[0] = (pBead1->m_Mom[0] - pBead2->m_Mom[0]);
+			dv[1] = (pBead1->m_Mom[1] - pBead2->m_Mom[1]);
+			dv[2] = (pBead1->m_Mom[2] - pBead2->m_Mom[2]);
 
-			dr = sqrt(dr2);
-			drmax  = (*iterBead1)->GetRadius()+(*riterBead2)->GetRadius();
-			drdmax = (*iterBead1)->GetLGRadius()+(*riterBead2)->GetLGRadius();
+			drdmax = pBead1->GetLGRadius() + pBead2->GetLGRadius();
 
-			if( dr < drmax )
-			{		
-				if( dr > 0.000000001 )
-				{
-					wr = (1.0 - dr/drmax);
-					wr2 = wr*wr;
-					wrd = (1.0 - dr/drdmax);
-                    lgPrefactor = m_lgnorm/(drdmax*drdmax*drdmax);
+			wr  = (1.0 - dr/drmax);
+			wr2 = wr*wr;
+			wrd = (1.0 - dr/drdmax);
+			lgPrefactor = m_lgnorm/(drdmax*drdmax*drdmax);
 
 // Conservative force magnitude
 
-					conForce  = m_vvConsInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr;				
-//					conForce = 0.0;
+			conForce = m_vvConsInt[pBead1->GetType()][pBead2->GetType()]*wr;
 
-// Density-dependent force magnitude: first we get the raw interaction parameter
-// then we multiply it by the local density function. This requires that the 
-// bead densities for every bead must be calculated before this loop.
+			if(m_bSumPotential)
+			{
+				m_PotentialEnergy += 0.5*drmax*conForce*wr;
+			}
+
+// Density-dependent force magnitude: the raw interaction parameter is 
+// multiplied by the sum of the local densities of the two beads
 
-					lgForce  = lgPrefactor*m_vvLGInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*((*iterBead1)->GetLGDensity() + (*riterBead2)->GetLGDensity())*wrd;				
+			lgForce  = lgPrefactor*m_vvLGInt[pBead1->GetType()][pBead2->GetType()]*(pBead1->GetLGDensity() + pBead2->GetLGDensity())*wrd;
 
 // Dissipative and random force magnitudes. Note dr factor in newForce calculation
 
-					rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-					gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*wr2;
+			rdotv     = (iterPair->dx[0]*dv[0] + iterPair->dx[1]*dv[1] + iterPair->dx[2]*dv[2])/dr;
+			gammap    = m_vvDissInt[pBead1->GetType()][pBead2->GetType()]*wr2;
 
-					dissForce	= -gammap*rdotv;				
-					randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
+			if(m_bPairThermostat)
+			{
+				dissForce = 0.0;
+				randForce = 0.0;
+			}
+			else
+			{
+				dissForce = -gammap*rdotv;
+				randForce = sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
+			}
 
-					newForce[0] = (conForce + lgForce + dissForce + randForce)*dx[0]/dr;
-					newForce[1] = (conForce + lgForce + dissForce + randForce)*dx[1]/dr;
-					newForce[2] = (conForce + lgForce + dissForce + randForce)*dx[2]/dr;
+			totalForce  = (conForce + lgForce + dissForce + randForce)/dr;
 
-					(*iterBead1)->m_Force[0] += newForce[0];
-					(*iterBead1)->m_Force[1] += newForce[1];
-					(*iterBead1)->m_Force[2] += newForce[2];
+			newForce[0] = totalForce*iterPair->dx[0];
+			newForce[1] = totalForce*iterPair->dx[1];
+			newForce[2] = totalForce*iterPair->dx[2];
 
-					(*riterBead2)->m_Force[0] -= newForce[0];
-					(*riterBead2)->m_Force[1] -= newForce[1];
-					(*riterBead2)->m_Force[2] -= newForce[2];
+			pBead1->m_Force[0] += newForce[0];
+			pBead1->m_Force[1] += newForce[1];
+			pBead1->m_Force[2] += newForce[2];
 
-					// stress tensor summation
+			pBead2->m_Force[0] -= newForce[0];
+			pBead2->m_Force[1] -= newForce[1];
+			pBead2->m_Force[2] -= newForce[2];
 
-					(*iterBead1)->m_Stress[0] += dx[0]*newForce[0];
-					(*iterBead1)->m_Stress[1] += dx[1]*newForce[0];
-					(*iterBead1)->m_Stress[2] += dx[2]*newForce[0];
-					(*iterBead1)->m_Stress[3] += dx[0]*newForce[1];
-					(*iterBead1)->m_Stress[4] += dx[1]*newForce[1];
-					(*iterBead1)->m_Stress[5] += dx[2]*newForce[1];
-					(*iterBead1)->m_Stress[6] += dx[0]*newForce[2];
-					(*iterBead1)->m_Stress[7] += dx[1]*newForce[2];
-					(*iterBead1)->m_Stress[8] += dx[2]*newForce[2];
+			// stress tensor summation
 
-					// Pass the stress tensor components to the CMonitor
-					// for use in analysing the stress over slices.
-					// Note that dx[2] might be close to zero and we should
-					// check for this.
+			pBead1->m_Stress[0] += iterPair->dx[0]*newForce[0];
+			pBead1->m_Stress[1] += iterPair->dx[1]*newForce[0];
+			pBead1->m_Stress[2] += iterPair->dx[2]*newForce[0];
+			pBead1->m_Stress[3] += iterPair->dx[0]*newForce[1];
+			pBead1->m_Stress[4] += iterPair->dx[1]*newForce[1];
+			pBead1->m_Stress[5] += iterPair->dx[2]*newForce[1];
+			pBead1->m_Stress[6] += iterPair->dx[0]*newForce[2];
+			pBead1->m_Stress[7] += iterPair->dx[1]*newForce[2];
+			pBead1->m_Stress[8] += iterPair->dx[2]*newForce[2];
+		}
+	}
 
-//					m_pMonitor->AddBeadStress(*iterBead1, *riterBead2, newForce, dx);
-				}
-				else
+#endif
+}
+
+// Function to zero the local density of the beads in the cell. Because 
+// UpdateLGDensity() adds the contribution of each pair to both beads, and the
+// second bead may belong to a neighbouring cell, the densities of all beads 
+// in the SimBox must be zeroed before any cell starts its density sweep.
+
+void CCNTCell::ZeroLGDensity()
+{
+#if EnableDPDLG == ExperimentEnabled
+	for(BeadListIterator iterBead=m_lBeads.begin(); iterBead!=m_lBeads.end(); iterBead++)
+	{
+		(*iterBead)->SetLGDensity(0.0);
+	}
+#endif
+}
+
+// Function to calculate the local bead density around each bead in the cell.
+// This is used to weight the density-dependent force on the beads. We perform
+// a separate loop over the cells so that the density can be calculated for all
+// beads before we update the total force.
+//
+// The sweep uses the same half-shell as UpdateForce(): pairs within the current
+// cell are visited once using a reverse loop, and pairs with beads in the 13 
+// neighbouring cells stored in m_aIntNNCells[] are visited once from this side
+// only. Each pair's weight is added to both beads, so every pair is evaluated 
+// once instead of twice and no bead lists are copied. Note that this does not 
+// include the constant normalisation factor that ensures the integral over the
+// range is unity; that is factored into the density-dependent interaction 
+// parameter itself.
+//
+// Every pair that lies within either the DPD or the LG interaction range is 
+// stored in m_vLGPairs together with its separation so that UpdateLGForce() 
+// does not have to repeat the traversal. The vector's capacity is retained 
+// between timesteps so it does not reallocate once the simulation is running.
+
+void CCNTCell::UpdateLGDensity()
+{
+#if EnableDPDLG == ExperimentEnabled
+
+	BeadListIterator iterBead1;
+	BeadListIterator iterBead2;
+	rBeadListIterator riterBead2;
+
+	double dx[3];
+	double dr, dr2, drmax, drdmax, wrd;
+
+	m_vLGPairs.clear();
+
+	for( iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++ )
+	{
+		// Beads in the same cell: no PBCs are needed
+
+		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=(*iterBead1)->m_id; ++riterBead2 )
+		{
+			dx[0] = ((*iterBead1)->m_Pos[0] - (*riterBead2)->m_Pos[0]);
+			dx[1] = ((*iterBead1)->m_Pos[1] - (*riterBead2)->m_Pos[1]);
+			dx[2] = ((*iterBead1)->m_Pos[2] - (*riterBead2)->m_Pos[2]);
+
+			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
+
+			drmax  = (*iterBead1)->GetRadius()   + (*riterBead2)->GetRadius();
+			drdmax = (*iterBead1)->GetLGRadius() + (*riterBead2)->GetLGRadius();
+
+			if( (dr2 < drmax*drmax || dr2 < drdmax*drdmax) && dr2 > 0.00000001 )
+			{
+				dr = sqrt(dr2);
+
+				if( dr < drdmax )
 				{
-					TraceInt("same cell bead", (*iterBead1)->GetId());
-					TraceInt("interacts with", (*riterBead2)->GetId());
-					TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-											(*iterBead1)->GetYPos(), 
-											(*iterBead1)->GetZPos() );
-					TraceVector("2nd pos",	(*riterBead2)->GetXPos(),
-											(*riterBead2)->GetYPos(), 
-											(*riterBead2)->GetZPos() );
-					TraceDouble("Bead distance", dr);
+					wrd = (1.0 - dr/drdmax);
+					(*iterBead1)->m_LGDensity  += wrd*wrd;
+					(*riterBead2)->m_LGDensity += wrd*wrd;
 				}
+
+				AddLGPair(*iterBead1, *riterBead2, dx, dr);
 			}
 		}
 
-		// Next add in interactions with beads in neighbouring cells taking the
-		// PBCs into account and the presence of a wall. The PBCs are only applied
-		// if both the current CNT cell and the neighbouring one are external.
+		// Beads in neighbouring cells: the PBCs are only applied if both the 
+		// current CNT cell and the neighbouring one are external.
 
 #if SimDimension == 2
 		for( int i=0; i<4; i++ )
@@ -3367,23 +4199,15 @@ void CCNTCell::UpdateLGForce()
 		for( int i=0; i<13; i++ )
 #endif
 		{
+			const bool bPBC = m_bExternal && m_aIntNNCells[i]->IsExternal();
+
 			for( iterBead2=m_aIntNNCells[i]->m_lBeads.begin(); iterBead2!=m_aIntNNCells[i]->m_lBeads.end(); iterBead2++ )
 			{
 				dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
-				dv[0] = ((*iterBead1)->m_Mom[0] - (*iterBead2)->m_Mom[0]);
-
 				dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
-				dv[1] = ((*iterBead1)->m_Mom[1] - (*iterBead2)->m_Mom[1]);
-
-#if SimDimension == 2
-				dx[2] = 0.0;
-				dv[2] = 0.0;
-#elif SimDimension == 3
 				dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
-				dv[2] = ((*iterBead1)->m_Mom[2] - (*iterBead2)->m_Mom[2]);
-#endif
 
-				if( m_bExternal && m_aIntNNCells[i]->IsExternal() )
+				if( bPBC )
 				{
 					if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
 						dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
@@ -3395,182 +4219,53 @@ void CCNTCell::UpdateLGForce()
 					else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
 						dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
 
-#if SimDimension == 3
 					if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
 						dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
 					else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
 						dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
-#endif
-
 				}
 
 				dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-				dr = sqrt(dr2);
-				drmax  = (*iterBead1)->GetRadius()+(*iterBead2)->GetRadius();
-				drdmax = (*iterBead1)->GetLGRadius()+(*iterBead2)->GetLGRadius();
 
-				if( dr < drmax )
-				{		
-					if( dr > 0.000000001 )
-					{
-					   wr = (1.0 - dr/drmax);
-                       wr2 = wr*wr;
-                       wrd = (1.0 - dr/drdmax);
-                       lgPrefactor = m_lgnorm/(drdmax*drdmax*drdmax);
-
-                       conForce	    = m_vvConsInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr;				
-//                       conForce = 0.0;
-
-// Density-dependent force magnitude: first we get the raw interaction parameter
-// then we multiply it by the local density function
+				drmax  = (*iterBead1)->GetRadius()   + (*iterBead2)->GetRadius();
+				drdmax = (*iterBead1)->GetLGRadius() + (*iterBead2)->GetLGRadius();
 
-					    lgForce     = lgPrefactor*m_vvLGInt.at((*iterBead1)->GetType()).at((*riterBead2)->GetType())*((*iterBead1)->GetLGDensity() + (*riterBead2)->GetLGDensity())*wrd;				
-
-						rdotv		= (dx[0]*dv[0] + dx[1]*dv[1] + dx[2]*dv[2])/dr;
-						gammap		= m_vvDissInt.at((*iterBead1)->GetType()).at((*iterBead2)->GetType())*wr2;
-
-						dissForce	= -gammap*rdotv;				
-						randForce	= sqrt(gammap)*CCNTCell::m_invrootdt*(0.5 - CCNTCell::Randf());
-
-						newForce[0] = (conForce + lgForce + dissForce + randForce)*dx[0]/dr;
-						newForce[1] = (conForce + lgForce + dissForce + randForce)*dx[1]/dr;
-						newForce[2] = (conForce + lgForce + dissForce + randForce)*dx[2]/dr;
-
-						(*iterBead1)->m_Force[0] += newForce[0];
-						(*iterBead1)->m_Force[1] += newForce[1];
-						(*iterBead1)->m_Force[2] += newForce[2];
-
-						(*iterBead2)->m_Force[0] -= newForce[0];
-						(*iterBead2)->m_Force[1] -= newForce[1];
-						(*iterBead2)->m_Force[2] -= newForce[2];
-
-						// stress tensor summation
-
-						(*iterBead1)->m_Stress[0] += dx[0]*newForce[0];
-						(*iterBead1)->m_Stress[1] += dx[1]*newForce[0];
-						(*iterBead1)->m_Stress[2] += dx[2]*newForce[0];
-						(*iterBead1)->m_Stress[3] += dx[0]*newForce[1];
-						(*iterBead1)->m_Stress[4] += dx[1]*newForce[1];
-						(*iterBead1)->m_Stress[5] += dx[2]*newForce[1];
-						(*iterBead1)->m_Stress[6] += dx[0]*newForce[2];
-						(*iterBead1)->m_Stress[7] += dx[1]*newForce[2];
-						(*iterBead1)->m_Stress[8] += dx[2]*newForce[2];
-
-						// Pass the stress tensor components to the CMonitor
-						// for use in analysing the stress over slices.
-						// Note that dx[2] might be close to zero and we should
-						// check for this.
-
-//						m_pMonitor->AddBeadStress(*iterBead1, *iterBead2, newForce, dx);
+				if( (dr2 < drmax*drmax || dr2 < drdmax*drdmax) && dr2 > 0.00000001 )
+				{
+					dr = sqrt(dr2);
 
-					}
-					else
+					if( dr < drdmax )
 					{
-						TraceInt("neighbour cell bead", (*iterBead1)->GetId());
-						TraceInt("interacts with", (*iterBead2)->GetId());
-						TraceVector("1st pos",	(*iterBead1)->GetXPos(),
-												(*iterBead1)->GetYPos(), 
-												(*iterBead1)->GetZPos() );
-						TraceVector("2nd pos",	(*iterBead2)->GetXPos(),
-												(*iterBead2)->GetYPos(), 
-												(*iterBead2)->GetZPos() );
-						TraceDouble("Bead distance", dr);
+						wrd = (1.0 - dr/drdmax);
+						(*iterBead1)->m_LGDensity += wrd*wrd;
+						(*iterBead2)->m_LGDensity += wrd*wrd;
 					}
+
+					AddLGPair(*iterBead1, *iterBead2, dx, dr);
 				}
 			}
 		}
 	}
-
 #endif
 }
 
-// Function to calculate the local bead density around each bead in the cell.
-// This is used to weight the density-dependent force on the beads. We perform
-// a separate loop over the cells so that the density can be calculated for all
-// beads before we update the total force.
-
-void CCNTCell::UpdateLGDensity()
-{
 #if EnableDPDLG == ExperimentEnabled
-    // Get a list of all beads in the current cell and its 26 neighbours
-
-    BeadList localBeads;
-    localBeads.clear();
-
-    BeadList lNNBeads;
-    lNNBeads.clear();
-
-    for(short int i=0; i<27; i++)
-    {
-        lNNBeads = m_aNNCells[i]->GetBeads();
-		copy(lNNBeads.begin(), lNNBeads.end(), back_inserter(localBeads));
-    }
-
-    // Now calculate the local density around each bead in the cell.
-    // Note that this does not include the constant normalisation factor that
-    // ensures the integral over the range is unity; that is factored into
-    // the density-dependent interaction parameter itself. We loop over all beads
-    // in the current cell and its 26 nearest neighbours, but as this includes
-    // the bead itself twice, we have to remove the self-interaction.
-
-    double dx[3];
-    double dr, dr2, drdmax, drdmax2;
-    double wr2;
-
-    double density;
-
-	for(BeadListIterator iterBead1=m_lBeads.begin(); iterBead1!=m_lBeads.end(); iterBead1++)
-	{
-        density = 0.0;
-
-		for(BeadListIterator iterBead2=localBeads.begin(); iterBead2!=localBeads.end(); iterBead2++)
-		{
-			dx[0] = ((*iterBead1)->m_Pos[0] - (*iterBead2)->m_Pos[0]);
-			dx[1] = ((*iterBead1)->m_Pos[1] - (*iterBead2)->m_Pos[1]);
-			dx[2] = ((*iterBead1)->m_Pos[2] - (*iterBead2)->m_Pos[2]);
-
-            // If the current CNT cell is on the SimBox boundary, we check the 
-            // PBCs for all bead pairs as we don't do a loop over neighbouring 
-            // CNT cells here. As long as there are not too many beads in the 
-            // current cell this should not be a resource drain. 
-
-			if(m_bExternal)
-			{
-				if( dx[0] > CCNTCell::m_HalfSimBoxXLength )
-					dx[0] = dx[0] - CCNTCell::m_SimBoxXLength;
-				else if( dx[0] < -CCNTCell::m_HalfSimBoxXLength )
-					dx[0] = dx[0] + CCNTCell::m_SimBoxXLength;
-
-				if( dx[1] > CCNTCell::m_HalfSimBoxYLength )
-					dx[1] = dx[1] - CCNTCell::m_SimBoxYLength;
-				else if( dx[1] < -CCNTCell::m_HalfSimBoxYLength )
-					dx[1] = dx[1] + CCNTCell::m_SimBoxYLength;
-				if( dx[2] > CCNTCell::m_HalfSimBoxZLength )
-					dx[2] = dx[2] - CCNTCell::m_SimBoxZLength;
-				else if( dx[2] < -CCNTCell::m_HalfSimBoxZLength )
-					dx[2] = dx[2] + CCNTCell::m_SimBoxZLength;
-			}
-
-
-			dr2 = dx[0]*dx[0] + dx[1]*dx[1] + dx[2]*dx[2];
-			drdmax = (*iterBead1)->GetLGRadius()+(*iterBead2)->GetLGRadius();
-            drdmax2 = drdmax*drdmax;
-
-            // The second test should remove self-interactions
+// Private helper function to append a bead pair to the cached LG pair list.
 
-            if(dr2 < drdmax2 && dr2 > 0.00000001)
-            {
-			    dr = sqrt(dr2);
-                wr2 = (1.0 - dr/drdmax)*(1.0 - dr/drdmax);
+void CCNTCell::AddLGPair(CAbstractBead* const pBead1, CAbstractBead* const pBead2, const double dx[3], double dr)
+{
+	LGPair pair;
 
-                density += wr2;
-            }
-        }
+	pair.pBead1 = pBead1;
+	pair.pBead2 = pBead2;
+	pair.dx[0]  = dx[0];
+	pair.dx[1]  = dx[1];
+	pair.dx[2]  = dx[2];
+	pair.dr     = dr;
 
-        (*iterBead1)->SetLGDensity(density);
-	}
-#endif
+	m_vLGPairs.push_back(pair);
 }
+#endif
 
 // Function a cell uses to calculate non-bonded, bead-bead forces between
 // beads in the current cell and its neighbouring cells that belong to adjacent
@@ -3628,10 +4323,7 @@ void CCNTCell::UpdateForceP()
 		// can hence store the N(N-1)/2 contributions to the stress tensor in the
 		// beads that form the first ones accessed in the double loops.
 
-		for(short int j=0; j<9; j++)
-		{
-			pBead1->m_Stress[j] = 0.0;
-		}
+		pBead1->ZeroStress();
 
 		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=pBead1->m_id; ++riterBead2 )
 		{
@@ -3773,10 +4465,7 @@ void CCNTCell::UpdateForceP()
 		// can hence store the N(N-1)/2 contributions to the stress tensor in the
 		// beads that form the first ones accessed in the double loops.
 
-		for(short int j=0; j<9; j++)
-		{
-			pBead1->m_Stress[j] = 0.0;
-		}
+		pBead1->ZeroStress();
 
 		for( riterBead2=m_lBeads.rbegin(); (*riterBead2)->m_id!=pBead1->m_id; ++riterBead2 )
 		{
@@ -3882,8 +4571,10 @@ void CCNTCell::UpdateForceP()
 					newForce[1] = (magLJ + magSC)*dx[1];
 					newForce[2] = (magLJ + magSC)*dx[2];
 #endif
+#if EnableBeadForceCounter == SimMiscEnabled
 				    pBead1->m_ForceCounter++;
 				    (*riterBead2)->m_ForceCounter++;
+#endif
 
 					pBead1->m_Force[0] += newForce[0];
 					pBead1->m_Force[1] += newForce[1];
@@ -4273,8 +4964,10 @@ void CCNTCell::UpdateForceBetweenCells(bool bExternal, CAbstractBead* const pBea
 //			std::cout << "CNTCell " << GetId() << " calculating internal force with NN cell " << " for its beads " << pBead->GetId() << " " << (*iterBead2)->GetId() << zEndl;
 //		}
 
+#if EnableBeadForceCounter == SimMiscEnabled
 					    pBead->m_ForceCounter++;
 					    (*iterBead2)->m_ForceCounter++;
+#endif
 						
 						pBead->m_Force[0] += newForce[0];
 						pBead->m_Force[1] += newForce[1];
@@ -14,6 +14,7 @@ class ISimBox;
 class mpsBorder;
 
 
+#include "ExperimentDefs.h"
 #include "AbstractCell.h"
 
 class CCNTCell : public CAbstractCell  
@@ -63,10 +64,31 @@ public:
 
 	static void SetRNGSeed(long idum);
 
+	// Functions to save and restore the RNG state, and to create independent
+	// random number streams that can be used on other threads
+
+	static uint64_t GetRNGState();
+	static void     SetRNGState(uint64_t state);
+	static uint64_t GetRandomStreamSeed(long stream);
+	static double   GetStreamRandomNo(uint64_t& rState);
+
 	static void SetSimBoxLengths(long nx, long ny, long nz, double cntlx, double cntly, double cntlz);
 
 	static void SetTimeStepConstants(double dt, double lambda, double cutoffradius, double kT);
 
+	static bool SetIntegrator(const zString integrator, double collisionRate);
+	static bool IsTimeStepAllowed(double dt);
+
+	static void SetRESPASubsteps(long substeps);
+	static long GetRESPASubstepNo() {return m_RESPASubstepNo;}
+
+	// Integration constants needed by the CSimBox's RESPA scheme. The half step
+	// is zero while the bead forces are toggled off.
+
+	static double GetStepSize()			{return m_dt;}
+	static double GetHalfStepSize()		{return m_halfdt;}
+	static double GetLambdaStepSize()	{return m_lamdt;}
+
 	static void SetBDBeadStructure(const zArray2dDouble* pvvConsInt, const zArray2dDouble* pvvDissInt);
 
     // Standard DPD conservative and dissipative forces
@@ -130,6 +152,23 @@ public:
 	void UpdateMom();
 	void UpdatePos();
 
+	// Pairwise thermostat applied after UpdateMom() when the DPD dissipative
+	// and random forces are not integrated by the velocity Verlet scheme
+
+	static bool IsPairThermostatOn() {return m_bPairThermostat;}
+	void UpdatePairThermostat();
+
+	// Running totals of the bead pairs examined in UpdateForce() and the beads
+	// that change cells in UpdatePos(), used by the performance log. The pairs
+	// are only counted while the log is on.
+
+	static long GetPairCheckTotal() {return m_PairCheckTotal;}
+	static long GetMigrationTotal() {return m_MigrationTotal;}
+
+	static void SetPairCount(bool bCount) {m_bCountPairs = bCount;}
+
+	static void SetPotentialSum(bool bSum) {m_bSumPotential = bSum;}
+
     // Parallel versions of the updating functions
 
 	void UpdateForceP();
@@ -138,13 +177,41 @@ public:
 
 	void UpdateLGForce();
 	void UpdateLGDensity();
+	void ZeroLGDensity();
 
 	// Function to calculate the kinetic and potential energy of the cell including
 	// both interactions within the cell and with its immediate neighbours
 
 	void UpdateTotalEnergy(double* const pKinetic, double* const pPotential) const;
 
+	// Function to pass the potential energy summed in UpdateForce() on energy-sampling
+	// steps, and the kinetic energy of the cell's beads, to the CMonitor
+
+	void AddForceEnergy() const;
+
 	double GetPotentialEnergy(CAbstractBead* pBead) const;	// Used for MC relaxation
+	double GetNeighbourhoodPotentialEnergy(const CAbstractBead* pBead) const;	// Used for parallel MC relaxation
+
+	// Copy of the thread-local simulation box size and MD interaction tables
+	// that a worker thread needs to calculate bead potential energies
+
+	struct MDPotentialState
+	{
+		double boxLength[3];
+		double cutoffRadius;
+		zArray2dDouble vvLJDepth;
+		zArray2dDouble vvLJRange;
+		zArray2dDouble vvSCDepth;
+		zArray2dDouble vvSCRange;
+		zArray2dDouble vvLJDelta;
+		zArray2dDouble vvLJSlope;
+		zArray2dDouble vvSCDelta;
+		zArray2dDouble vvSCSlope;
+	};
+
+	static void GetMDPotentialState(MDPotentialState& rState);
+	static void SetMDPotentialState(const MDPotentialState& rState);
+
 	long CellBeadTotal() const;
 	void AddBeadtoCell(CAbstractBead* pBead);
 	void RemoveBeadFromCell(CAbstractBead* const pBead);
@@ -170,92 +237,131 @@ private:
 
     static uint32_t lcg(uint64_t &state);  // Internal helper function for RNG
 
+	void ThermostatPair(CAbstractBead* const pBead1, CAbstractBead* const pBead2, const double dx[3]);
+
+	void OrderFrozenBeads();
+
+#if EnableDPDLG == ExperimentEnabled
+	void AddLGPair(CAbstractBead* const pBead1, CAbstractBead* const pBead2, const double dx[3], double dr);
+#endif
+
 	// ****************************************
 	// Data members
 private:
 	
-    static bool   m_bReadFileOnce;           // Flag showing if external random number file should be read once only
-    static long   m_NextRNIndex;             // Index of next random number to use
-    static zDoubleVector m_RandomNumbers;    // Externally-generated random numbers for testing
-    static long   m_StringSize;              // Default size of randomly-generated strings
+    static SimThreadLocal bool   m_bReadFileOnce;           // Flag showing if external random number file should be read once only
+    static SimThreadLocal long   m_NextRNIndex;             // Index of next random number to use
+    static SimThreadLocal zDoubleVector m_RandomNumbers;    // Externally-generated random numbers for testing
+    static SimThreadLocal long   m_StringSize;              // Default size of randomly-generated strings
     static const zString m_StringSeparator;  // Separator character used in random strings
     static const zString m_AlphabetChars;    // Set of characters that can be in the first position of a type name
 
-	static double m_SimBoxXLength;
-	static double m_SimBoxYLength;
-	static double m_SimBoxZLength;
-	static double m_HalfSimBoxXLength;
-	static double m_HalfSimBoxYLength;
-	static double m_HalfSimBoxZLength;
-
-	static long m_CNTXCellNo;
-	static long m_CNTYCellNo;
-	static long m_CNTZCellNo;
-	static double m_CNTXCellWidth;
-	static double m_CNTYCellWidth;
-	static double m_CNTZCellWidth;
-
-	static double m_dt;
-	static double m_lambda;
-	static double m_cutoffradius;		// Potential cut-off radius for both DPD and MD
-	static double m_coradius2;			// Square of cut-off radius
-	static double m_kT;
-	static double m_halfdt;
-	static double m_halfdt2;
-	static double m_invrootdt;
-	static double m_lamdt;
-    static double m_lgnorm;            // Constant part of DPD density-dependent force prefactor
-
-    static double m_dtoverkt;          // Prefactor of the BD force term: not including diffusion constant
-    static double m_dispmag;           // Prefactor of the BD displacement term: not including diffusion constant
-
-    static uint64_t m_RNGSeed;   // 64-bit seed for the lcg RNG
+	static SimThreadLocal double m_SimBoxXLength;
+	static SimThreadLocal double m_SimBoxYLength;
+	static SimThreadLocal double m_SimBoxZLength;
+	static SimThreadLocal double m_HalfSimBoxXLength;
+	static SimThreadLocal double m_HalfSimBoxYLength;
+	static SimThreadLocal double m_HalfSimBoxZLength;
+
+	static SimThreadLocal long m_CNTXCellNo;
+	static SimThreadLocal long m_CNTYCellNo;
+	static SimThreadLocal long m_CNTZCellNo;
+	static SimThreadLocal double m_CNTXCellWidth;
+	static SimThreadLocal double m_CNTYCellWidth;
+	static SimThreadLocal double m_CNTZCellWidth;
+
+	static SimThreadLocal double m_dt;
+	static SimThreadLocal double m_lambda;
+	static SimThreadLocal double m_cutoffradius;		// Potential cut-off radius for both DPD and MD
+	static SimThreadLocal double m_coradius2;			// Square of cut-off radius
+	static SimThreadLocal double m_kT;
+	static SimThreadLocal double m_halfdt;
+	static SimThreadLocal double m_halfdt2;
+	static SimThreadLocal double m_invrootdt;
+	static SimThreadLocal double m_lamdt;
+	static SimThreadLocal bool   m_bPairThermostat;    // Flag showing if the dissipative and random forces are applied pairwise
+	static SimThreadLocal bool   m_bLoweAndersen;      // Flag showing if the pairwise thermostat is Lowe-Andersen rather than Shardlow
+	static SimThreadLocal double m_CollisionRate;      // Lowe-Andersen bath collision frequency
+	static SimThreadLocal double m_CollisionProb;      // Lowe-Andersen collision probability per pair per step
+	static SimThreadLocal long   m_RESPASubstepNo;     // Substeps per timestep for polymer bond forces, 1 if RESPA is off
+	static SimThreadLocal double m_rootdt;
+	static SimThreadLocal double m_root2kT;
+	static SimThreadLocal long   m_PairCheckTotal;     // Cumulative number of bead pairs examined for non-bonded forces
+	static SimThreadLocal long   m_MigrationTotal;     // Cumulative number of beads that have moved between cells
+	static SimThreadLocal bool   m_bCountPairs;        // Flag showing if UpdateForce() adds to m_PairCheckTotal
+	static SimThreadLocal bool   m_bSumPotential;      // Flag showing if UpdateForce() sums the pair potential energy
+    static SimThreadLocal double m_lgnorm;            // Constant part of DPD density-dependent force prefactor
+
+    static SimThreadLocal double m_dtoverkt;          // Prefactor of the BD force term: not including diffusion constant
+    static SimThreadLocal double m_dispmag;           // Prefactor of the BD displacement term: not including diffusion constant
+
+    static SimThreadLocal uint64_t m_RNGSeed;   // 64-bit seed for the lcg RNG
     static long double m_2Power32;         // 2**32
     static long double m_Inv2Power32;      // Inverse of 2**32
 
-	static CMonitor* m_pMonitor;	// Pointer to CMonitor to allow on-the-fly analysis
-	static ISimBox*  m_pISimBox;	// Pointer to ISimBox to allow on-the-fly analysis
+	static SimThreadLocal CMonitor* m_pMonitor;	// Pointer to CMonitor to allow on-the-fly analysis
+	static SimThreadLocal ISimBox*  m_pISimBox;	// Pointer to ISimBox to allow on-the-fly analysis
 
 	// Bead internal structure data including bead-bead interaction matrices
 	// for all simulation types: DPD, MD. We use static pointers so that we
 	// can initialize them but then copy the vectors into local storage in the 
 	// constructor to avoid having to dereference the pointers all the time.
 
-	static const zArray2dDouble* m_pvvConsInt;	// DPD
-	static const zArray2dDouble* m_pvvDissInt;
-	static const zArray2dDouble* m_pvvLGInt;
+	static SimThreadLocal const zArray2dDouble* m_pvvConsInt;	// DPD
+	static SimThreadLocal const zArray2dDouble* m_pvvDissInt;
+	static SimThreadLocal const zArray2dDouble* m_pvvLGInt;
 
-	static const zArray2dDouble* m_pvvLJDepth;	// MD
-	static const zArray2dDouble* m_pvvLJRange;
-	static const zArray2dDouble* m_pvvSCDepth;
-	static const zArray2dDouble* m_pvvSCRange;
+	static SimThreadLocal const zArray2dDouble* m_pvvLJDepth;	// MD
+	static SimThreadLocal const zArray2dDouble* m_pvvLJRange;
+	static SimThreadLocal const zArray2dDouble* m_pvvSCDepth;
+	static SimThreadLocal const zArray2dDouble* m_pvvSCRange;
 
 	// Static arrays to hold the above data without requiring a dereference
 
-	static zArray2dDouble m_vvConsInt;		// DPD
-	static zArray2dDouble m_vvDissInt;
-	static zArray2dDouble m_vvLGInt;
+	static SimThreadLocal zArray2dDouble m_vvConsInt;		// DPD
+	static SimThreadLocal zArray2dDouble m_vvDissInt;
+	static SimThreadLocal zArray2dDouble m_vvLGInt;
 
-	static zArray2dDouble m_vvConsIntBackup;	// DPD zero force array
-	static zArray2dDouble m_vvDissIntBackup;
-	static zArray2dDouble m_vvLGIntBackup;
+	static SimThreadLocal zArray2dDouble m_vvConsIntBackup;	// DPD zero force array
+	static SimThreadLocal zArray2dDouble m_vvDissIntBackup;
+	static SimThreadLocal zArray2dDouble m_vvLGIntBackup;
 
-	static zArray2dDouble m_vvLJDepth;	// MD
-	static zArray2dDouble m_vvLJRange;
-	static zArray2dDouble m_vvSCDepth;
-	static zArray2dDouble m_vvSCRange;
+	static SimThreadLocal zArray2dDouble m_vvLJDepth;	// MD
+	static SimThreadLocal zArray2dDouble m_vvLJRange;
+	static SimThreadLocal zArray2dDouble m_vvSCDepth;
+	static SimThreadLocal zArray2dDouble m_vvSCRange;
 
-	static zArray2dDouble m_vvLJDelta;	// Shift in LJ potential 
-	static zArray2dDouble m_vvLJSlope;   // Slope of shifted LJ potential
-	static zArray2dDouble m_vvSCDelta;	// Ditto for SC potential
-	static zArray2dDouble m_vvSCSlope;
+	static SimThreadLocal zArray2dDouble m_vvLJDelta;	// Shift in LJ potential 
+	static SimThreadLocal zArray2dDouble m_vvLJSlope;   // Slope of shifted LJ potential
+	static SimThreadLocal zArray2dDouble m_vvSCDelta;	// Ditto for SC potential
+	static SimThreadLocal zArray2dDouble m_vvSCSlope;
 
 	// Local data members
 
 	bool m_bExternal;
+	double m_PotentialEnergy;		// Potential energy of pairs summed in the last UpdateForce()
+	long   m_FrozenTotal;			// Number of frozen beads, held at the end of the bead list
 
     CCNTCell* m_aNNCells[27];		// Allow for both 2d and 3d
     CCNTCell* m_aIntNNCells[13];
+    long      m_aIntNNOffset[13][3];	// Direction of each m_aIntNNCells entry, or zero if unknown
+
+#if EnableDPDLG == ExperimentEnabled
+	// Bead pairs found in the half-shell density sweep that are within range
+	// of the DPD or LG forces. They are reused by UpdateLGForce().
+
+	struct LGPair
+	{
+		CAbstractBead* pBead1;
+		CAbstractBead* pBead2;
+		double dx[3];
+		double dr;
+	};
+
+	typedef xxBasevector<LGPair>::iterator LGPairIterator;
+
+	xxBasevector<LGPair> m_vLGPairs;
+#endif
 };
 
 #endif // !defined(AFX_CNTCELL_H__E36E3E80_32EC_11D3_820E_0060088AD300__INCLUDED_)
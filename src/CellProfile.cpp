@@ -27,12 +27,11 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 CCellProfile::CCellProfile(CRow* const pRow, long cellTotal) : m_pRow(pRow)
 {
-	// A copy of the row's beads is defined here because the for loops 
-	// seem to fail when the row's GetBeads() function is used directly. 
+	// We iterate over the row's own bead container rather than a copy of it.
 	// An iterator is declared here because some machines do not allow
 	// a redeclaration of the loop counter in different loops.
 
-	BeadList lBeads = pRow->GetBeads();
+	const BeadList& lBeads = pRow->GetBeads();
 	cBeadListIterator iterBead;
 
 	// Create the cells by dividing the row into cellTotal parts. The cell
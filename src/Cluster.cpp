@@ -0,0 +1,533 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// Cluster.cpp: implementation of the CCluster class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "SimMathFlags.h"
+#include "Cluster.h"
+#include "ClusterData.h"
+#include "SimState.h"
+#include "ISimBox.h"
+#include "InSituSnapshot.h"
+#include "Polymer.h"
+#include "Bead.h"
+
+#include "aaScalarSingle.h"				// Types of data that can be sent as observables
+#include "ScalarObservable.h"			// Types of observables
+
+#include "TimeSeriesData.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// We pass the CAnalysisData-derived object to the CAnalysis base class for 
+// initialisation of all general analysis data. The pointer is passed as
+// const as we do not expect it to be altered.
+
+CCluster::CCluster(const zString runId, long samplePeriod, 
+				   const CClusterData* const pAD) : CAnalysis(runId, samplePeriod, pAD),
+												    m_Polymer(pAD->m_Polymer),
+												    m_Bead(pAD->m_Bead),
+													m_Cutoff(pAD->m_Cutoff),
+													m_MaxSize(pAD->m_MaxSize),
+													m_pTSD(NULL),
+													m_bInitialised(false),
+													m_PolymerType(0),
+													m_BeadType(0),
+													m_PolymerTotal(0),
+													m_PolymerSize(0),
+													m_Cutoff2(pAD->m_Cutoff*pAD->m_Cutoff)
+{
+	for(short int i=0; i<3; i++)
+	{
+		m_SimBoxLength[i] = 0.0;
+		m_CellNo[i]		  = 0;
+		m_CellWidth[i]	  = 0.0;
+	}
+
+	m_vBeadIds.clear();
+	m_vContactIndex.clear();
+	m_vContactPolymer.clear();
+}
+
+CCluster::~CCluster()
+{
+
+}
+
+// **********************************************************************
+// Function to divide the polymers of the user-specified type into clusters.
+// Two polymers belong to the same cluster if any of their contact beads, 
+// those of the user-specified bead type, are closer than the cutoff distance,
+// and clustering is transitive. The contact beads are sorted into the CNT
+// cells each sample so that only beads in neighbouring cells are compared, 
+// and the polymers are joined using a union-find forest, so the cost of the 
+// analysis is linear in the number of beads.
+//
+// **********************************************************************
+
+void CCluster::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
+{
+	cPolymerVectorIterator iterPoly;
+	cBeadVectorIterator iterBead;
+
+	// **********************************************************************
+	// On the first call, store the ids of the beads in the polymers so that 
+	// their coordinates can be copied quickly each sample, and the indices 
+	// of the contact beads amongst them. Note that this requires that 
+	// ConvertNames() be called before the first call to UpdateState().
+
+	if(!m_bInitialised)
+	{
+		m_bInitialised = true;
+
+		m_SimBoxLength[0] = pISimBox->GetSimBoxXLength();
+		m_SimBoxLength[1] = pISimBox->GetSimBoxYLength();
+		m_SimBoxLength[2] = pISimBox->GetSimBoxZLength();
+
+		m_CellNo[0]	   = pISimBox->GetCNTXCellNo();
+		m_CellNo[1]	   = pISimBox->GetCNTYCellNo();
+		m_CellNo[2]	   = pISimBox->GetCNTZCellNo();
+		m_CellWidth[0] = pISimBox->GetCNTXCellWidth();
+		m_CellWidth[1] = pISimBox->GetCNTYCellWidth();
+		m_CellWidth[2] = pISimBox->GetCNTZCellWidth();
+
+		for(iterPoly=rSimState.GetPolymers().begin(); iterPoly!=rSimState.GetPolymers().end(); iterPoly++)
+		{
+			if((*iterPoly)->GetType() == m_PolymerType)
+			{
+				m_PolymerSize = (*iterPoly)->GetSize();
+
+				for(iterBead=(*iterPoly)->GetBeads().begin(); iterBead!=(*iterPoly)->GetBeads().end(); iterBead++)
+				{
+					if((*iterBead)->GetType() == m_BeadType)
+					{
+						m_vContactIndex.push_back(m_vBeadIds.size());
+						m_vContactPolymer.push_back(m_PolymerTotal);
+					}
+
+					m_vBeadIds.push_back((*iterBead)->GetId());
+				}
+
+				m_PolymerTotal++;
+			}
+		}
+
+		m_vBeadPos.resize(3*m_vBeadIds.size());
+
+		m_vCellStart.resize(m_CellNo[0]*m_CellNo[1]*m_CellNo[2] + 1);
+		m_vCellBeads.resize(m_vContactIndex.size());
+		m_vBeadCell.resize(m_vContactIndex.size());
+
+		m_vParent.resize(m_PolymerTotal);
+		m_vClusterSize.resize(m_PolymerTotal);
+		m_vClusterSum.resize(3*m_PolymerTotal);
+		m_vClusterSum2.resize(m_PolymerTotal);
+
+		// Create the observables needed to hold the cluster data.
+
+		// Id	Name
+		// *********
+		//
+		//	0	Number of clusters including single polymers
+		//	1	Weight-averaged aggregation number
+		//	2	Aggregation number of the largest cluster
+
+		CScalarObservable* pTotal	= new CScalarObservable(m_Polymer + " cluster total",
+												rSimState.GetAnalysisPeriod(), rSimState.GetSamplePeriod());
+		CScalarObservable* pMean	= new CScalarObservable(m_Polymer + " cluster aggregation number",
+												rSimState.GetAnalysisPeriod(), rSimState.GetSamplePeriod());
+		CScalarObservable* pLargest	= new CScalarObservable(m_Polymer + " largest cluster",
+												rSimState.GetAnalysisPeriod(), rSimState.GetSamplePeriod());
+
+		m_vObservables.push_back(pTotal);
+		m_vObservables.push_back(pMean);
+		m_vObservables.push_back(pLargest);
+	}
+
+	// **********************************************************************
+	// Copy the coordinates of the polymers' beads and find the clusters
+
+	long i = 0;
+
+	for(iterPoly=rSimState.GetPolymers().begin(); iterPoly!=rSimState.GetPolymers().end(); iterPoly++)
+	{
+		if((*iterPoly)->GetType() == m_PolymerType)
+		{
+			for(iterBead=(*iterPoly)->GetBeads().begin(); iterBead!=(*iterPoly)->GetBeads().end(); iterBead++)
+			{
+				m_vBeadPos[i]   = (*iterBead)->GetXPos();
+				m_vBeadPos[i+1] = (*iterBead)->GetYPos();
+				m_vBeadPos[i+2] = (*iterBead)->GetZPos();
+				i += 3;
+			}
+		}
+	}
+
+	AnalyseClusters(pISimBox->GetCurrentTime());
+}
+
+// The clusters can be found from a snapshot once the first call to UpdateState()
+// has stored the ids of the polymers' beads.
+
+bool CCluster::CanUpdateFromSnapshot() const
+{
+	return m_bInitialised;
+}
+
+void CCluster::UpdateStateFromSnapshot(const CInSituSnapshot& rSnapshot)
+{
+	for(unsigned long i=0; i<m_vBeadIds.size(); i++)
+	{
+		const double* const pPos = rSnapshot.GetPosition(m_vBeadIds[i]);
+
+		m_vBeadPos[3*i]   = pPos[0];
+		m_vBeadPos[3*i+1] = pPos[1];
+		m_vBeadPos[3*i+2] = pPos[2];
+	}
+
+	AnalyseClusters(rSnapshot.GetCurrentTime());
+}
+
+// **********************************************************************
+// Function to find the clusters from the bead coordinates copied into the 
+// local containers and store their statistics in the observables and time 
+// series. Each polymer starts in its own cluster. Contact beads in each
+// CNT cell are compared with those in the same cell and in the 13 cells
+// of the forward half of its neighbourhood, so that each pair of cells is
+// visited once, and the polymers owning beads in contact are joined.
+//
+// The radius of gyration of each cluster is calculated from all beads of 
+// its polymers using minimum image displacements from the first bead of the
+// cluster's root polymer. This is valid as long as clusters are smaller 
+// than half the SimBox.
+//
+// **********************************************************************
+
+void CCluster::AnalyseClusters(long time)
+{
+	long i, p;
+
+	for(p=0; p<m_PolymerTotal; p++)
+	{
+		m_vParent[p]	  = p;
+		m_vClusterSize[p] = 1;
+	}
+
+	BinContactBeads();
+
+	for(long iz=0; iz<m_CellNo[2]; iz++)
+	{
+		for(long iy=0; iy<m_CellNo[1]; iy++)
+		{
+			for(long ix=0; ix<m_CellNo[0]; ix++)
+			{
+				const long cell = ix + m_CellNo[0]*(iy + m_CellNo[1]*iz);
+
+				JoinContactsInCells(cell, cell);
+
+				for(long dz=0; dz<2; dz++)
+				{
+					for(long dy=(dz == 0 ? 0 : -1); dy<2; dy++)
+					{
+						for(long dx=(dz == 0 && dy == 0 ? 1 : -1); dx<2; dx++)
+						{
+							const long nx = (ix + dx + m_CellNo[0]) % m_CellNo[0];
+							const long ny = (iy + dy + m_CellNo[1]) % m_CellNo[1];
+							const long nz = (iz + dz + m_CellNo[2]) % m_CellNo[2];
+
+							JoinContactsInCells(cell, nx + m_CellNo[0]*(ny + m_CellNo[1]*nz));
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Accumulate the bead displacements of each polymer in the sums belonging
+	// to the root of its cluster
+
+	for(p=0; p<m_PolymerTotal; p++)
+	{
+		m_vClusterSum[3*p]   = 0.0;
+		m_vClusterSum[3*p+1] = 0.0;
+		m_vClusterSum[3*p+2] = 0.0;
+		m_vClusterSum2[p]	 = 0.0;
+	}
+
+	for(p=0; p<m_PolymerTotal; p++)
+	{
+		const long root = FindRoot(p);
+		const double* const pRef = &m_vBeadPos[3*root*m_PolymerSize];
+
+		for(i=p*m_PolymerSize; i<(p+1)*m_PolymerSize; i++)
+		{
+			double dr[3];
+
+			for(short int j=0; j<3; j++)
+			{
+				dr[j] = m_vBeadPos[3*i+j] - pRef[j];
+
+				if(dr[j] > 0.5*m_SimBoxLength[j])
+					dr[j] -= m_SimBoxLength[j];
+				else if(dr[j] < -0.5*m_SimBoxLength[j])
+					dr[j] += m_SimBoxLength[j];
+
+				m_vClusterSum[3*root+j] += dr[j];
+			}
+
+			m_vClusterSum2[root] += dr[0]*dr[0] + dr[1]*dr[1] + dr[2]*dr[2];
+		}
+	}
+
+	// Collect the aggregation number distribution and the mean radius of 
+	// gyration of clusters of each size. Clusters larger than the maximum
+	// size are counted in the last bin.
+
+	zDoubleVector vSizeNo(m_MaxSize, 0.0);
+	zDoubleVector vSizeRg(m_MaxSize, 0.0);
+
+	long   clusterTotal	= 0;
+	long   freeTotal	= 0;
+	long   largest		= 0;
+	long   rgTotal		= 0;
+	double size2Sum		= 0.0;
+	double rgSum		= 0.0;
+
+	for(p=0; p<m_PolymerTotal; p++)
+	{
+		if(m_vParent[p] == p)
+		{
+			const long size = m_vClusterSize[p];
+			const double beadTotal = static_cast<double>(size*m_PolymerSize);
+
+			const double cmx = m_vClusterSum[3*p]/beadTotal;
+			const double cmy = m_vClusterSum[3*p+1]/beadTotal;
+			const double cmz = m_vClusterSum[3*p+2]/beadTotal;
+
+			double rg2 = m_vClusterSum2[p]/beadTotal - (cmx*cmx + cmy*cmy + cmz*cmz);
+			if(rg2 < 0.0)
+				rg2 = 0.0;
+
+			const double rg = sqrt(rg2);
+			const long bin  = (size < m_MaxSize ? size : m_MaxSize) - 1;
+
+			vSizeNo[bin] += 1.0;
+			vSizeRg[bin] += rg;
+
+			clusterTotal++;
+			size2Sum += static_cast<double>(size*size);
+
+			if(size > largest)
+				largest = size;
+
+			if(size == 1)
+			{
+				freeTotal++;
+			}
+			else
+			{
+				rgTotal++;
+				rgSum += rg;
+			}
+		}
+	}
+
+	double meanSize		  = 0.0;
+	double weightMeanSize = 0.0;
+	double meanRg		  = 0.0;
+
+	if(clusterTotal > 0)
+	{
+		meanSize	   = static_cast<double>(m_PolymerTotal)/static_cast<double>(clusterTotal);
+		weightMeanSize = size2Sum/static_cast<double>(m_PolymerTotal);
+	}
+
+	if(rgTotal > 0)
+		meanRg = rgSum/static_cast<double>(rgTotal);
+
+	aaScalarSingle total(clusterTotal);
+	aaScalarSingle mean(weightMeanSize);
+	aaScalarSingle maxSize(largest);
+
+	total.AddData(m_vObservables.at(0));
+	mean.AddData(m_vObservables.at(1));
+	maxSize.AddData(m_vObservables.at(2));
+
+	// Store the time-dependent data in a TSD object and pass it to the 
+	// aggregate state object. The number of clusters of each size and their 
+	// mean radius of gyration follow the summary values.
+
+	long dataTotal = 7 + 2*m_MaxSize;
+
+	m_pTSD = new CTimeSeriesData(dataTotal);
+
+	m_pTSD->SetValue(0, time,			"Time");
+	m_pTSD->SetValue(1, clusterTotal,	"Clusters");
+	m_pTSD->SetValue(2, freeTotal,		"Free");
+	m_pTSD->SetValue(3, meanSize,		"MeanSize");
+	m_pTSD->SetValue(4, weightMeanSize,	"WeightMeanSize");
+	m_pTSD->SetValue(5, largest,		"Largest");
+	m_pTSD->SetValue(6, meanRg,			"MeanRg");
+
+	for(i=0; i<m_MaxSize; i++)
+	{
+		const double rg = (vSizeNo[i] > 0.0 ? vSizeRg[i]/vSizeNo[i] : 0.0);
+
+		m_pTSD->SetValue(7 + i,			  vSizeNo[i], "N"  + ToString(i+1));
+		m_pTSD->SetValue(7 + m_MaxSize + i, rg,		  "Rg" + ToString(i+1));
+	}
+
+	m_pState->AddTimeSeriesData(m_pTSD);
+}
+
+// Private function to sort the contact beads by the CNT cell that contains
+// them. The cell counts are accumulated so that m_vCellStart[cell] holds the
+// end of each cell's beads, and each bead is then placed by decrementing it,
+// which leaves it holding the start of the cell's beads.
+
+void CCluster::BinContactBeads()
+{
+	const long cellTotal = m_vCellStart.size() - 1;
+	long k;
+
+	fill(m_vCellStart.begin(), m_vCellStart.end(), 0);
+
+	for(k=0; k<static_cast<long>(m_vContactIndex.size()); k++)
+	{
+		const double* const pPos = &m_vBeadPos[3*m_vContactIndex[k]];
+
+		long cellIndex[3];
+
+		for(short int j=0; j<3; j++)
+		{
+			cellIndex[j] = static_cast<long>(pPos[j]/m_CellWidth[j]);
+
+			if(cellIndex[j] < 0)
+				cellIndex[j] = 0;
+			else if(cellIndex[j] >= m_CellNo[j])
+				cellIndex[j] = m_CellNo[j] - 1;
+		}
+
+		m_vBeadCell[k] = cellIndex[0] + m_CellNo[0]*(cellIndex[1] + m_CellNo[1]*cellIndex[2]);
+		m_vCellStart[m_vBeadCell[k]]++;
+	}
+
+	for(long cell=1; cell<cellTotal; cell++)
+	{
+		m_vCellStart[cell] += m_vCellStart[cell-1];
+	}
+
+	m_vCellStart[cellTotal] = m_vContactIndex.size();
+
+	for(k=0; k<static_cast<long>(m_vContactIndex.size()); k++)
+	{
+		m_vCellBeads[--m_vCellStart[m_vBeadCell[k]]] = k;
+	}
+}
+
+// Private function to join the polymers owning contact beads in two cells 
+// that are within the cutoff distance. If the cells are the same, each pair
+// of beads is only compared once. Small SimBoxes can make the same pair of
+// cells appear more than once, but this only repeats joins already made.
+
+void CCluster::JoinContactsInCells(long cell, long neighbour)
+{
+	for(long i=m_vCellStart[cell]; i<m_vCellStart[cell+1]; i++)
+	{
+		const long k1 = m_vCellBeads[i];
+		const double* const pPos1 = &m_vBeadPos[3*m_vContactIndex[k1]];
+
+		const long jStart = (neighbour == cell ? i + 1 : m_vCellStart[neighbour]);
+
+		for(long j=jStart; j<m_vCellStart[neighbour+1]; j++)
+		{
+			const long k2 = m_vCellBeads[j];
+
+			if(m_vContactPolymer[k1] != m_vContactPolymer[k2])
+			{
+				const double* const pPos2 = &m_vBeadPos[3*m_vContactIndex[k2]];
+
+				double dr2 = 0.0;
+
+				for(short int n=0; n<3; n++)
+				{
+					double dr = pPos2[n] - pPos1[n];
+
+					if(dr > 0.5*m_SimBoxLength[n])
+						dr -= m_SimBoxLength[n];
+					else if(dr < -0.5*m_SimBoxLength[n])
+						dr += m_SimBoxLength[n];
+
+					dr2 += dr*dr;
+				}
+
+				if(dr2 < m_Cutoff2)
+				{
+					Join(m_vContactPolymer[k1], m_vContactPolymer[k2]);
+				}
+			}
+		}
+	}
+}
+
+// Private functions to find the root of a polymer's cluster, halving the path
+// to it on the way, and to join two clusters by attaching the smaller to the
+// root of the larger.
+
+long CCluster::FindRoot(long polymer)
+{
+	while(m_vParent[polymer] != polymer)
+	{
+		m_vParent[polymer] = m_vParent[m_vParent[polymer]];
+		polymer = m_vParent[polymer];
+	}
+
+	return polymer;
+}
+
+void CCluster::Join(long polymer1, long polymer2)
+{
+	long root1 = FindRoot(polymer1);
+	long root2 = FindRoot(polymer2);
+
+	if(root1 != root2)
+	{
+		if(m_vClusterSize[root1] < m_vClusterSize[root2])
+		{
+			const long temp = root1;
+			root1 = root2;
+			root2 = temp;
+		}
+
+		m_vParent[root2]	   = root1;
+		m_vClusterSize[root1] += m_vClusterSize[root2];
+	}
+}
+
+// **********************************************************************
+// Function to store the integer ids for beads, bonds and polymers given 
+// the strings that were entered by the user in the control data file.
+//
+
+void CCluster::ConvertNames(const CAnalysisState &raState)
+{
+	m_PolymerType = raState.GetPolymerTypeFromName(m_Polymer);
+	m_BeadType	  = raState.GetBeadTypeFromName(m_Bead);
+}
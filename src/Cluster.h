@@ -0,0 +1,97 @@
+// Cluster.h: interface for the CCluster class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CLUSTER_H__8DF93294_4470_4195_95ED_5F7C44E2D7C6__INCLUDED_)
+#define AFX_CLUSTER_H__8DF93294_4470_4195_95ED_5F7C44E2D7C6__INCLUDED_
+
+
+// Forward declarations
+
+class CClusterData;
+
+
+#include "Analysis.h"
+
+class CCluster : public CAnalysis  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+	CCluster(const zString runId, long samplePeriod, const CClusterData* const pAD);
+	virtual ~CCluster();
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline const zString GetPolymer() const {return m_Polymer;}
+
+
+	// ****************************************
+	// PVS inherited from CAnalysis base class
+public:
+
+	// Function to get the bead coordinates of the polymers from the ISimBox
+
+	virtual void UpdateState(CSimState& rSimState, const ISimBox* const pISimBox);
+
+	// Function to convert any bead, bond or polymer names from strings to integers
+
+	virtual void ConvertNames(const CAnalysisState& raState);
+
+	// Functions used to find the clusters on the in-situ analysis thread
+
+	virtual bool CanUpdateFromSnapshot() const;
+	virtual void UpdateStateFromSnapshot(const CInSituSnapshot& rSnapshot);
+
+
+private:
+
+	void AnalyseClusters(long time);
+
+	void BinContactBeads();
+	void JoinContactsInCells(long cell, long neighbour);
+	long FindRoot(long polymer);
+	void Join(long polymer1, long polymer2);
+
+	// Data specified by user for cluster analysis
+
+	zString m_Polymer;		// Polymer whose clusters are analysed
+	zString m_Bead;			// Bead type whose contacts join polymers
+	double  m_Cutoff;		// Maximum separation of beads in contact
+	long    m_MaxSize;		// Largest aggregation number reported separately
+
+	// Local data used in the analysis
+
+	CTimeSeriesData* m_pTSD;	// Store time-dependent data here
+
+	bool   m_bInitialised;		// Flag showing that the first call to UpdateState() has set up the analysis
+
+	long   m_PolymerType;		// Id of the clustering polymer
+	long   m_BeadType;			// Id of the contact bead
+	long   m_PolymerTotal;		// Number of polymers of the given type
+	long   m_PolymerSize;		// Number of beads per polymer
+	double m_Cutoff2;			// Square of the cutoff distance
+	double m_SimBoxLength[3];	// SimBox side lengths used for minimum images
+	long   m_CellNo[3];			// Number of CNT cells in each dimension
+	double m_CellWidth[3];		// Width of CNT cells in each dimension
+
+	zLongVector   m_vBeadIds;		// Ids of all beads in the polymers, polymer by polymer
+	zDoubleVector m_vBeadPos;		// Copies of their PBC coordinates, three per bead
+	zLongVector   m_vContactIndex;	// Indices into m_vBeadIds of the contact beads
+	zLongVector   m_vContactPolymer;// Polymer owning each contact bead
+
+	zLongVector   m_vCellStart;		// Offset of each cell's contact beads in m_vCellBeads
+	zLongVector   m_vCellBeads;		// Contact beads sorted by CNT cell
+	zLongVector   m_vBeadCell;		// CNT cell holding each contact bead
+
+	zLongVector   m_vParent;		// Union-find forest over the polymers
+	zLongVector   m_vClusterSize;	// Number of polymers in the cluster rooted at each polymer
+	zDoubleVector m_vClusterSum;	// Sums of bead displacements from a cluster's reference bead
+	zDoubleVector m_vClusterSum2;	// and of their squares, used for the radius of gyration
+
+};
+
+#endif // !defined(AFX_CLUSTER_H__8DF93294_4470_4195_95ED_5F7C44E2D7C6__INCLUDED_)
@@ -0,0 +1,220 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// ClusterData.cpp: implementation of the CClusterData class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "SimXMLFlags.h"
+#include "ClusterData.h"
+#include "Cluster.h"
+#include "InputData.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// Static member variable containing the identifier for the aggregates that are
+// investigated by analysis objects of this class. It is used to select the 
+// appropriate analysis object when the Analysis/Type variable is read in the 
+// control data file.
+
+zString CClusterData::m_Type = "cluster";
+
+const zString CClusterData::GetType()
+{
+	return m_Type;
+}
+
+// We use an anonymous namespace to wrap the call to the factory object
+// so that it is not accessible from outside this file. The identifying
+// string is stored in the m_Type static member variable.
+
+namespace
+{
+	CAnalysisData* Create() {return new CClusterData();}
+
+	const zString id = CClusterData::GetType();
+
+	const bool bRegistered = acfAnalysisFactory::Instance()->Register(id, Create);
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+CClusterData::CClusterData() : CAnalysisData(false),
+							   m_Polymer(""), m_Bead(""),
+							   m_Cutoff(0.0), m_MaxSize(0)
+{
+
+}
+
+CClusterData::~CClusterData()
+{
+
+}
+
+// Functions to read and write the data needed for the cluster analysis.
+// We call the base class's function first to get the more general data before
+// that specific to each aggregate.
+
+zOutStream& CClusterData::put(zOutStream& os) const
+{
+
+#if EnableXMLProcesses == SimXMLEnabled
+
+	putXMLStartTags(os);
+	os << "<Polymer>" << m_Polymer << "</Polymer>" << zEndl;
+	os << "<Bead>"    << m_Bead    << "</Bead>"    << zEndl;
+	os << "<Cutoff>"  << m_Cutoff  << "</Cutoff>"  << zEndl;
+	os << "<MaxSize>" << m_MaxSize << "</MaxSize>" << zEndl;
+	putXMLEndTags(os);
+
+#elif EnableXMLProcesses == SimXMLDisabled
+
+	putASCIIStartTags(os);
+	os << "    Polymer      " << m_Polymer << zEndl;
+	os << "    Bead         " << m_Bead    << zEndl;
+	os << "    Cutoff       " << m_Cutoff  << zEndl;
+	os << "    Max Size     " << m_MaxSize << zEndl;
+	putASCIIEndTags(os);
+
+#endif
+
+	return os;
+}
+
+// The cutoff distance must not exceed the width of the CNT cells because
+// only beads in neighbouring cells are tested for contact. The cell width
+// is never less than the DPD interaction range of 1.
+
+zInStream& CClusterData::get(zInStream& is)
+{
+	// Read base class data first
+
+	CAnalysisData::get(is);
+	
+	zString token;
+	zString polymer;
+	zString bead;
+	double  cutoff;
+	long    maxSize;
+
+	is >> token;
+	if(!is.good() || token != "Polymer")
+	{
+		SetDataValid(false);
+		return is;
+	}
+	else
+	{
+		is >> polymer;
+		if(!is.good() || polymer.empty())
+		{
+			SetDataValid(false);
+			return is;
+		}
+	}
+
+	is >> token;
+	if(!is.good() || token != "Bead")
+	{
+		SetDataValid(false);
+		return is;
+	}
+	else
+	{
+		is >> bead;
+		if(!is.good() || bead.empty())
+		{
+			SetDataValid(false);
+			return is;
+		}
+	}
+
+	is >> token;
+	if(!is.good() || token != "Cutoff")
+	{
+		SetDataValid(false);
+		return is;
+	}
+	else
+	{
+		is >> cutoff;
+		if(!is.good() || cutoff <= 0.0 || cutoff > 1.0)
+		{
+			SetDataValid(false);
+			return is;
+		}
+	}
+
+	is >> token;
+	if(!is.good() || token != "MaxSize")
+	{
+		SetDataValid(false);
+		return is;
+	}
+	else
+	{
+		is >> maxSize;
+		if(!is.good() || maxSize < 1)
+		{
+			SetDataValid(false);
+			return is;
+		}
+	}
+
+	// Data has been read successfully so store it in the member variables
+
+	SetDataValid(true);
+	m_Polymer = polymer;
+	m_Bead    = bead;
+	m_Cutoff  = cutoff;
+	m_MaxSize = maxSize;
+
+	return is;
+}
+
+CAnalysis* CClusterData::CreateAnalysis(const zString runId, long samplePeriod) 
+{
+	return new CCluster(runId, samplePeriod, this);
+}
+
+// Virtual function to return the type of analysis represented by the class.
+// This has to access the static class variable for the type.
+
+const zString CClusterData::GetAnalysisType() const
+{
+	return m_Type;
+}
+
+// Function to check that the polymer and bead names used to define the 
+// clusters have been defined.
+
+bool CClusterData::ValidateData(const CInputData& riData) const
+{
+	if(!riData.IsExternalNameValid(m_Polymer))
+		return ErrorTrace("Invalid cluster analysis polymer name");
+	else if(!riData.IsPolymerinMap(m_Polymer))
+		return ErrorTrace("Cluster analysis polymer not found in map");
+	else if(!riData.IsExternalNameValid(m_Bead))
+		return ErrorTrace("Invalid cluster analysis bead name");
+	else if(!riData.IsBeadinMap(m_Bead))
+		return ErrorTrace("Cluster analysis bead not found in map");
+
+	return true;
+}
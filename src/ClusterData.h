@@ -0,0 +1,74 @@
+// ClusterData.h: interface for the CClusterData class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CLUSTERDATA_H__B883FFF3_EB85_4C26_83BC_D5450D0D23B5__INCLUDED_)
+#define AFX_CLUSTERDATA_H__B883FFF3_EB85_4C26_83BC_D5450D0D23B5__INCLUDED_
+
+
+#include "AnalysisData.h"
+
+class CClusterData : public CAnalysisData  
+{
+	friend class CCluster;		// Needed to copy data into CCluster
+
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CClusterData();
+
+	virtual ~CClusterData();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();
+
+private:
+
+	static zString m_Type;		// Keyword used to identify aggregate analysis
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	virtual const zString GetAnalysisType() const;
+
+	// Function to copy the data into a CAnalysis-derived object
+
+	virtual CAnalysis* CreateAnalysis(const zString runId, long samplePeriod);
+
+	virtual bool ValidateData(const CInputData& riData) const;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// Protected local functions
+protected:
+	
+	// ****************************************
+	// Implementation
+
+	// ****************************************
+	// Private functions
+private:
+
+	// ****************************************
+	// Data members
+private:
+
+	zString m_Polymer;		// Polymer whose clusters are analysed
+	zString m_Bead;			// Bead type whose contacts join polymers into clusters
+	double  m_Cutoff;		// Maximum separation of beads in contact
+	long    m_MaxSize;		// Largest aggregation number reported separately
+
+};
+
+#endif // !defined(AFX_CLUSTERDATA_H__B883FFF3_EB85_4C26_83BC_D5450D0D23B5__INCLUDED_)
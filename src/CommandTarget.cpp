@@ -337,6 +337,8 @@ bool CCommandTarget::ReplaceProxyIds(CInitialState* const pIS)
         }
     }
 
+    IncrementMembershipChangeTotal();
+
     return true;
 }
 
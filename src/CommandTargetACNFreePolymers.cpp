@@ -269,6 +269,15 @@ long CCommandTargetACNFreePolymers::GetBeadTotal() const
 	return beadTotal;
 }
 
+// The polymers in the target are obtained from the active cell network each
+// time they are requested, so its contents change without the membership 
+// change total being incremented.
+
+bool CCommandTargetACNFreePolymers::IsMembershipDynamic() const
+{
+	return true;
+}
+
 // Function to return the aggregate of all beads forming the polymers contained
 // in the command target. Unlike the GetBeads() function defined for
 // bead command targets, this function may return beads of many different types
@@ -60,6 +60,7 @@ public:
 	virtual long GetBeadTotalForType(long type) const;
 	virtual long GetBeadTotal() const;
 	virtual BeadVector GetBeads() const;
+	virtual bool IsMembershipDynamic() const;
 
 	// IQueryPolymerTarget interface
 
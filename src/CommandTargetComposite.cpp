@@ -260,6 +260,19 @@ BeadVector CCommandTargetComposite::GetBeads() const
 	return vBeads;
 }
 
+// A composite target's contents are dynamic if those of any of its targets are.
+
+bool CCommandTargetComposite::IsMembershipDynamic() const
+{
+	for(cStringTargetIterator iterTarget=m_mTargetMap.begin(); iterTarget!=m_mTargetMap.end(); iterTarget++)
+	{
+		if((iterTarget->second)->IsMembershipDynamic())
+			return true;
+	}
+
+	return false;
+}
+
 // ****************************************
 
 // Function to return the number of targets held in the composite target.
@@ -282,6 +295,7 @@ bool CCommandTargetComposite::AddTarget(CCommandTargetNode *const pTarget)
 	if(!GetTargetRecursively(label) && !pTarget->GetTargetRecursively(GetLabel()))
 	{
 		m_mTargetMap.insert(zPairST(label, pTarget));
+		IncrementMembershipChangeTotal();
 		return true;
 	}
 	else
@@ -295,6 +309,7 @@ bool CCommandTargetComposite::RemoveTarget(const zString label)
 	if(m_mTargetMap.find(label) != m_mTargetMap.end())
 	{
 		m_mTargetMap.erase(label);
+		IncrementMembershipChangeTotal();
 		return true;
 	}
 	else
@@ -60,6 +60,7 @@ public:
 	virtual long	    GetBeadTotal()              const;
 	virtual long    GetFirstBeadType()              const;
 	virtual BeadVector	    GetBeads()		        const;
+	virtual bool IsMembershipDynamic()              const;
 
  	virtual bool ChangeNamedBeadType(long newType);
 
@@ -22,7 +22,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 // Static member variable holding the number of command targets created.
 
-long CCommandTargetNode::m_CommandTargetTotal = 0;
+SimThreadLocal long CCommandTargetNode::m_CommandTargetTotal = 0;
 
 long CCommandTargetNode::GetCommandTargetTotal()
 {
@@ -36,6 +36,25 @@ void CCommandTargetNode::ZeroCommandTargetTotal()
 	m_CommandTargetTotal = 0;
 }
 
+// Static member variable counting the changes to the set of beads, polymers
+// or sub-targets contained in any command target. Decorators that cache the
+// beads of the target they wrap compare this with its value when they last
+// collected them, and only collect them again if it has changed. Membership 
+// changes are rare compared to the number of time steps, so we do not try 
+// to identify which target has changed.
+
+SimThreadLocal long CCommandTargetNode::m_MembershipChangeTotal = 0;
+
+long CCommandTargetNode::GetMembershipChangeTotal()
+{
+	return m_MembershipChangeTotal;
+}
+
+void CCommandTargetNode::IncrementMembershipChangeTotal()
+{
+	++m_MembershipChangeTotal;
+}
+
 // Function to write out the target's data to file. We pass the
 // stream output operator to the contained CCommandTargetNode-derived object using
 // its put() function. This is because the << and >> operators cannot be
@@ -230,6 +249,17 @@ BeadVector CCommandTargetNode::GetBeads() const
 	return vBeads;
 }
 
+// Function showing whether the target's beads are computed afresh on each call
+// instead of being stored. Such targets can change their contents without 
+// calling IncrementMembershipChangeTotal(), so callers that cache the beads 
+// must not rely on the membership change total for them. Stored targets 
+// return false.
+
+bool CCommandTargetNode::IsMembershipDynamic() const
+{
+	return false;
+}
+
 long CCommandTargetNode::GetCurrentBeadType() const
 {
 	return -1;
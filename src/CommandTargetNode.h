@@ -42,9 +42,16 @@ public:
 	static long GetCommandTargetTotal();
 	static void ZeroCommandTargetTotal();
 
+	static long GetMembershipChangeTotal();
+
+protected:
+
+	static void IncrementMembershipChangeTotal();
+
 private:
 
-	static long m_CommandTargetTotal;	// Number of command targets created
+	static SimThreadLocal long m_CommandTargetTotal;		// Number of command targets created
+	static SimThreadLocal long m_MembershipChangeTotal;	// Number of changes to the contents of any target
 
 	// ****************************************
 	// PVFs that must be implemented by all instantiated derived classes 
@@ -120,6 +127,7 @@ public:
 	virtual long GetBeadTotal()					const;
 	virtual long GetFirstBeadType()             const;
 	virtual BeadVector GetBeads()				const;
+	virtual bool IsMembershipDynamic()			const;
 
     virtual bool ChangeNamedBeadType(long newType);
 
@@ -132,6 +132,7 @@ void CCommandTargetPolymer::AddPolymer(CPolymer* pPolymer)
     if(pPolymer && find(m_Polymers.begin(), m_Polymers.end(), pPolymer) == m_Polymers.end())
     {
         m_Polymers.push_back(pPolymer);
+        IncrementMembershipChangeTotal();
     }
 }
 
@@ -140,6 +141,7 @@ void CCommandTargetPolymer::RemovePolymer(CPolymer* pPolymer)
     if(pPolymer && find(m_Polymers.begin(), m_Polymers.end(), pPolymer) != m_Polymers.end())
 	{
 	m_Polymers.erase(find(m_Polymers.begin(), m_Polymers.end(), pPolymer));
+        IncrementMembershipChangeTotal();
     }
 }
 
@@ -325,5 +327,7 @@ bool CCommandTargetPolymer::ReplaceProxyIds(CInitialState* const pIS)
         }
     }
 
+    IncrementMembershipChangeTotal();
+
     return true;
 }
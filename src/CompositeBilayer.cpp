@@ -1039,7 +1039,7 @@ void CCompositeBilayer::UpdateState(CSimState& rSimState, const ISimBox* const p
 
 	for(cSliceVectorIterator iterSlice=m_pLipidSP->Begin(); iterSlice!=m_pLipidSP->End(); iterSlice++)
 	{
-		BeadList lBeads = (*iterSlice)->GetBeads();
+		const BeadList& lBeads = (*iterSlice)->GetBeads();
 
 		cBeadListIterator iterBead = find_if(lBeads.begin(), lBeads.end(), aaBeadType2(m_LipidHeadType, m_LipidTailType));
 
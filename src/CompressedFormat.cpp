@@ -0,0 +1,182 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// CompressedFormat.cpp: implementation of the CCompressedFormat class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "CompressedFormat.h"
+
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// Static member variables containing the file extension for this 
+// visualisation format class and the tag at the start of its files.
+
+const zString CCompressedFormat::m_FileExtension = ".dpz";
+
+const char* const CCompressedFormat::m_SnapshotMagic = "DPDCSZ01";
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Format class that writes a binary snapshot compressed by a CCoordinateCodec.
+// The bead coordinates are stored to the given precision, which is typically 
+// about an order of magnitude smaller than a text snapshot.
+//
+// The file holds the tag m_SnapshotMagic, the number of bead names followed 
+// by each name's length, characters and radius, and the length of the encoded
+// frame followed by the frame. The frame's bead types index the names, and 
+// its display ids set the bead colours as in the other formats. Snapshots do
+// not identify individual beads, so the bead ids are their positions in the 
+// file. All values are written in the byte order of the machine that ran 
+// the simulation.
+//
+// The codec needs every bead before it can encode the frame, so the beads 
+// are collected and the whole file is written by SerializeFooter().
+
+CCompressedFormat::CCompressedFormat(double lx, double ly, double lz, bool bDisplayBox,
+									 const long beadTypeTotal, double precision) : CCurrentStateFormat(lx, ly, lz, bDisplayBox, beadTypeTotal),
+									 m_Codec(lx, ly, lz, precision),
+									 m_LastType(-1)
+{
+
+}
+
+CCompressedFormat::~CCompressedFormat()
+{
+
+}
+
+void CCompressedFormat::SerializeHeader(zOutStream& os, const long beadTotal)
+{
+	m_Codec.Clear();
+	m_vNames.clear();
+	m_vRadii.clear();
+	m_LastType = -1;
+}
+
+// Function to add a bead to the frame. Consecutive beads usually have the
+// same name, so the previous name is checked before searching the others.
+
+void CCompressedFormat::SerializeBead(zOutStream& os, const zString name, const long type, const double radius,
+									  const double x, const double y, const double z)
+{
+	if(m_LastType < 0 || m_vNames.at(m_LastType) != name)
+	{
+		m_LastType = static_cast<long>(std::find(m_vNames.begin(), m_vNames.end(), name) - m_vNames.begin());
+
+		if(m_LastType == static_cast<long>(m_vNames.size()))
+		{
+			m_vNames.push_back(name);
+			m_vRadii.push_back(radius);
+		}
+	}
+
+	m_Codec.AddBead(m_Codec.GetBeadTotal(), m_LastType, type, x, y, z);
+}
+
+void CCompressedFormat::SerializeFooter(zOutStream& os, const long beadTotal)
+{
+	if(!m_Codec.Encode(m_vBuffer))
+	{
+		os.setstate(std::ios::failbit);
+		return;
+	}
+
+	os.write(m_SnapshotMagic, 8);
+
+	const int64_t nameTotal = static_cast<int64_t>(m_vNames.size());
+
+	os.write(reinterpret_cast<const char*>(&nameTotal), sizeof(int64_t));
+
+	for(long type=0; type<nameTotal; type++)
+	{
+		const int64_t length = static_cast<int64_t>(m_vNames[type].size());
+
+		os.write(reinterpret_cast<const char*>(&length), sizeof(int64_t));
+		os.write(m_vNames[type].c_str(), length);
+		os.write(reinterpret_cast<const char*>(&m_vRadii[type]), sizeof(double));
+	}
+
+	const int64_t frameLength = static_cast<int64_t>(m_vBuffer.size());
+
+	os.write(reinterpret_cast<const char*>(&frameLength), sizeof(int64_t));
+	os.write(reinterpret_cast<const char*>(&m_vBuffer[0]), m_vBuffer.size());
+}
+
+// Static function to read a compressed snapshot. It returns false if the 
+// file cannot be read or is not a complete snapshot.
+
+bool CCompressedFormat::ReadSnapshot(const zString fileName, StringSequence& vNames, 
+									 zDoubleVector& vRadii, CCoordinateCodec& rCodec)
+{
+	vNames.clear();
+	vRadii.clear();
+	rCodec.Clear();
+
+	zInFileStream inStream(fileName.c_str(), std::ios::in | std::ios::binary);
+
+	char magic[8];
+	int64_t nameTotal = 0;
+
+	inStream.read(magic, 8);
+	inStream.read(reinterpret_cast<char*>(&nameTotal), sizeof(int64_t));
+
+	if(!inStream.good() || std::memcmp(magic, m_SnapshotMagic, 8) != 0 || nameTotal < 0)
+		return false;
+
+	for(long type=0; type<nameTotal; type++)
+	{
+		int64_t length = 0;
+		double  radius = 0.0;
+
+		inStream.read(reinterpret_cast<char*>(&length), sizeof(int64_t));
+
+		if(!inStream.good() || length < 0 || length > 1024)
+			return false;
+
+		zString name(static_cast<size_t>(length), ' ');
+
+		inStream.read(&name[0], length);
+		inStream.read(reinterpret_cast<char*>(&radius), sizeof(double));
+
+		if(!inStream.good())
+			return false;
+
+		vNames.push_back(name);
+		vRadii.push_back(radius);
+	}
+
+	int64_t frameLength = 0;
+
+	inStream.read(reinterpret_cast<char*>(&frameLength), sizeof(int64_t));
+
+	if(!inStream.good() || frameLength <= 0)
+		return false;
+
+	xxBasevector<unsigned char> vBuffer(static_cast<size_t>(frameLength));
+
+	inStream.read(reinterpret_cast<char*>(&vBuffer[0]), frameLength);
+
+	if(inStream.gcount() != frameLength)
+		return false;
+
+	return rCodec.Decode(&vBuffer[0], vBuffer.size());
+}
@@ -0,0 +1,81 @@
+// CompressedFormat.h: interface for the CCompressedFormat class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_COMPRESSEDFORMAT_H__E53474A3_C1E0_4F13_B487_75C0A03C98CF__INCLUDED_)
+#define AFX_COMPRESSEDFORMAT_H__E53474A3_C1E0_4F13_B487_75C0A03C98CF__INCLUDED_
+
+
+#include "CurrentStateFormat.h"
+#include "CoordinateCodec.h"
+
+class CCompressedFormat : public CCurrentStateFormat  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CCompressedFormat(double lx, double ly, double lz, bool bDisplayBox,
+					  const long beadTypeTotal, double precision);
+
+	virtual ~CCompressedFormat();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const char* const m_SnapshotMagic;
+
+	// Function to read a snapshot written by this class. The bead types in 
+	// the codec index the names and radii returned.
+
+	static bool ReadSnapshot(const zString fileName, StringSequence& vNames, 
+							 zDoubleVector& vRadii, CCoordinateCodec& rCodec);
+
+private:
+
+	static const zString m_FileExtension;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline const zString GetFileExtension() const {return m_FileExtension;}
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual void SerializeHeader(zOutStream& os, const long beadTotal);
+	virtual void SerializeBead(zOutStream& os, const zString name, const long type, const double radius,
+								const double x, const double y, const double z);
+	virtual void SerializeFooter(zOutStream& os, const long beadTotal);
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	CCoordinateCodec			m_Codec;		// Holds the beads until the footer is written
+
+	StringSequence				m_vNames;		// Bead names in order of first appearance
+	zDoubleVector				m_vRadii;		// Radius of the first bead with each name
+	long						m_LastType;		// Index of the previous bead's name
+
+	xxBasevector<unsigned char>	m_vBuffer;		// Encoded frame
+};
+
+#endif // !defined(AFX_COMPRESSEDFORMAT_H__E53474A3_C1E0_4F13_B487_75C0A03C98CF__INCLUDED_)
@@ -0,0 +1,500 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// CoordinateCodec.cpp: implementation of the CCoordinateCodec class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "CoordinateCodec.h"
+
+#include <cmath>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+namespace
+{
+	// Layout of the start of an encoded frame. It is followed by six packed
+	// streams holding the bead ids, types, display ids and the x, y and z
+	// grid coordinates.
+
+	struct FrameHeader
+	{
+		int64_t beadTotal;
+		double  precision;
+		double  box[3];
+	};
+
+	const long StreamTotal = 6;
+
+	// Map signed residuals to unsigned values so that small negative numbers
+	// also have few significant bits.
+
+	inline uint64_t ZigZag(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	inline int64_t UnZigZag(uint64_t value)
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+
+	inline long BitWidth(uint64_t value)
+	{
+		long width = 0;
+
+		while(value)
+		{
+			value >>= 1;
+			width++;
+		}
+
+		return width;
+	}
+
+	void AppendBytes(xxBasevector<unsigned char>& vBuffer, const void* pData, size_t size)
+	{
+		const unsigned char* const pBytes = static_cast<const unsigned char*>(pData);
+
+		vBuffer.insert(vBuffer.end(), pBytes, pBytes + size);
+	}
+
+	// Writes the values in blocks of CCoordinateCodec::m_BlockSize. Each block
+	// is a byte holding the number of bits needed by its largest value followed
+	// by all its values packed with that many bits, least significant bit 
+	// first, and padded to a whole byte. Runs of equal residuals, such as 
+	// consecutive bead ids or a block of solvent beads of one type, take one 
+	// byte per block.
+
+	class BitWriter
+	{
+	public:
+		explicit BitWriter(xxBasevector<unsigned char>& vBuffer) : m_rBuffer(vBuffer), m_Bits(0), m_Count(0) {}
+
+		void Put(uint64_t value, long width)
+		{
+			if(width > 32)
+			{
+				Put(value & 0xffffffffULL, 32);
+				Put(value >> 32, width - 32);
+				return;
+			}
+
+			m_Bits  |= value << m_Count;
+			m_Count += width;
+
+			while(m_Count >= 8)
+			{
+				m_rBuffer.push_back(static_cast<unsigned char>(m_Bits));
+				m_Bits  >>= 8;
+				m_Count -= 8;
+			}
+		}
+
+		void Flush()
+		{
+			if(m_Count > 0)
+			{
+				m_rBuffer.push_back(static_cast<unsigned char>(m_Bits));
+			}
+
+			m_Bits  = 0;
+			m_Count = 0;
+		}
+
+	private:
+		xxBasevector<unsigned char>& m_rBuffer;
+		uint64_t m_Bits;
+		long     m_Count;
+	};
+
+	class BitReader
+	{
+	public:
+		BitReader(const unsigned char* pData, const unsigned char* pEnd) : m_pData(pData), m_pEnd(pEnd), m_Bits(0), m_Count(0) {}
+
+		bool Get(long width, uint64_t* pValue)
+		{
+			if(width > 32)
+			{
+				uint64_t low = 0, high = 0;
+
+				if(!Get(32, &low) || !Get(width - 32, &high))
+					return false;
+
+				*pValue = low | (high << 32);
+				return true;
+			}
+
+			while(m_Count < width)
+			{
+				if(m_pData == m_pEnd)
+					return false;
+
+				m_Bits  |= static_cast<uint64_t>(*m_pData++) << m_Count;
+				m_Count += 8;
+			}
+
+			*pValue  = m_Bits & ((static_cast<uint64_t>(1) << width) - 1);
+			m_Bits  >>= width;
+			m_Count -= width;
+			return true;
+		}
+
+		bool GetByte(unsigned char* pValue)
+		{
+			if(m_pData == m_pEnd)
+				return false;
+
+			*pValue = *m_pData++;
+			return true;
+		}
+
+		// Discard the padding bits at the end of a block
+
+		void Align()
+		{
+			m_Bits  = 0;
+			m_Count = 0;
+		}
+
+	private:
+		const unsigned char* m_pData;
+		const unsigned char* const m_pEnd;
+		uint64_t m_Bits;
+		long     m_Count;
+	};
+
+	// Appends a stream holding the residuals to the buffer. The stream starts 
+	// with its length in bytes so that a reader can skip it.
+
+	void PackStream(const xxBasevector<int64_t>& vResiduals, xxBasevector<unsigned char>& vBuffer)
+	{
+		const size_t lengthPos = vBuffer.size();
+		uint64_t length = 0;
+
+		AppendBytes(vBuffer, &length, sizeof(uint64_t));
+
+		BitWriter writer(vBuffer);
+
+		for(size_t start=0; start<vResiduals.size(); start+=CCoordinateCodec::m_BlockSize)
+		{
+			const size_t end = std::min(vResiduals.size(), start + static_cast<size_t>(CCoordinateCodec::m_BlockSize));
+
+			uint64_t bitsUsed = 0;
+
+			for(size_t i=start; i<end; i++)
+			{
+				bitsUsed |= ZigZag(vResiduals[i]);
+			}
+
+			const long width = BitWidth(bitsUsed);
+
+			vBuffer.push_back(static_cast<unsigned char>(width));
+
+			if(width > 0)
+			{
+				for(size_t i=start; i<end; i++)
+				{
+					writer.Put(ZigZag(vResiduals[i]), width);
+				}
+				writer.Flush();
+			}
+		}
+
+		length = vBuffer.size() - lengthPos - sizeof(uint64_t);
+		std::memcpy(&vBuffer[lengthPos], &length, sizeof(uint64_t));
+	}
+
+	// Reads a stream of count residuals starting at pData and advances pData
+	// past it. It returns false if the stream is truncated or malformed.
+
+	bool UnpackStream(const unsigned char*& pData, const unsigned char* pEnd, size_t count, xxBasevector<int64_t>& vResiduals)
+	{
+		uint64_t length = 0;
+
+		if(static_cast<size_t>(pEnd - pData) < sizeof(uint64_t))
+			return false;
+
+		std::memcpy(&length, pData, sizeof(uint64_t));
+		pData += sizeof(uint64_t);
+
+		if(length > static_cast<uint64_t>(pEnd - pData))
+			return false;
+
+		BitReader reader(pData, pData + length);
+
+		vResiduals.resize(count);
+
+		for(size_t start=0; start<count; start+=CCoordinateCodec::m_BlockSize)
+		{
+			const size_t end = std::min(count, start + static_cast<size_t>(CCoordinateCodec::m_BlockSize));
+
+			unsigned char width = 0;
+
+			if(!reader.GetByte(&width) || width > 64)
+				return false;
+
+			for(size_t i=start; i<end; i++)
+			{
+				uint64_t value = 0;
+
+				if(width > 0 && !reader.Get(width, &value))
+					return false;
+
+				vResiduals[i] = UnZigZag(value);
+			}
+			reader.Align();
+		}
+
+		pData += length;
+		return true;
+	}
+
+	// Grid coordinates are periodic, so a difference between two of them is
+	// mapped to the shorter way round the box. This keeps the residuals of 
+	// bonded beads on opposite sides of a boundary small.
+
+	inline int64_t WrapResidual(int64_t residual, int64_t levels)
+	{
+		if(residual > levels/2)
+			residual -= levels;
+		else if(residual < -(levels - 1)/2)
+			residual += levels;
+
+		return residual;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class that compresses the bead data of a snapshot or trajectory frame. 
+// Coordinates are quantised to a grid of spacing equal to the precision, 
+// measured from the origin of the SimBox, so that each one is stored as an 
+// integer less than the number of grid points along its side. The ids, types,
+// display ids and the three grid coordinates are stored as separate streams. 
+// Each stream holds the difference between consecutive values, because beads
+// in the same polymer are adjacent in the bead container, and packs the 
+// differences in blocks using only as many bits as the largest needs. 
+// Decoding is a single pass over each stream with no tables to build.
+//
+// A frame stores the precision and box size used to encode it, so a codec 
+// used for decoding may be constructed with any values.
+
+CCoordinateCodec::CCoordinateCodec(double lx, double ly, double lz, double precision)
+{
+	SetBox(lx, ly, lz, precision);
+}
+
+CCoordinateCodec::~CCoordinateCodec()
+{
+}
+
+void CCoordinateCodec::SetBox(double lx, double ly, double lz, double precision)
+{
+	m_Precision = precision;
+	m_Length[0] = lx;
+	m_Length[1] = ly;
+	m_Length[2] = lz;
+
+	for(short int i=0; i<3; i++)
+	{
+		// The tolerance prevents rounding errors adding a grid point when the
+		// side length is a multiple of the precision.
+
+		m_Levels[i] = 1;
+
+		if(m_Precision > 0.0 && m_Length[i] > 0.0)
+		{
+			m_Levels[i] = std::max(static_cast<int64_t>(1), static_cast<int64_t>(std::ceil(m_Length[i]/m_Precision - 1.0e-6)));
+		}
+	}
+}
+
+// Function to remove all beads from the current frame.
+
+void CCoordinateCodec::Clear()
+{
+	m_vIds.clear();
+	m_vTypes.clear();
+	m_vDisplayIds.clear();
+	m_vCoords.clear();
+}
+
+void CCoordinateCodec::AddBead(long id, long type, long displayId, double x, double y, double z)
+{
+	m_vIds.push_back(id);
+	m_vTypes.push_back(type);
+	m_vDisplayIds.push_back(displayId);
+	m_vCoords.push_back(x);
+	m_vCoords.push_back(y);
+	m_vCoords.push_back(z);
+}
+
+// Function to replace the contents of the buffer with the encoded frame. 
+// Coordinates outside the SimBox are first mapped back into it using the PBCs.
+// It returns false if the codec has no valid precision.
+
+bool CCoordinateCodec::Encode(xxBasevector<unsigned char>& vBuffer)
+{
+	vBuffer.clear();
+
+	if(m_Precision <= 0.0)
+		return false;
+
+	const size_t beadTotal = m_vIds.size();
+
+	FrameHeader header;
+	header.beadTotal = static_cast<int64_t>(beadTotal);
+	header.precision = m_Precision;
+	header.box[0]    = m_Length[0];
+	header.box[1]    = m_Length[1];
+	header.box[2]    = m_Length[2];
+
+	AppendBytes(vBuffer, &header, sizeof(FrameHeader));
+
+	const xxBasevector<int64_t>* const pIntStreams[3] = {&m_vIds, &m_vTypes, &m_vDisplayIds};
+
+	for(short int stream=0; stream<3; stream++)
+	{
+		const xxBasevector<int64_t>& rValues = *pIntStreams[stream];
+
+		m_vResiduals.resize(beadTotal);
+
+		int64_t previous = 0;
+
+		for(size_t i=0; i<beadTotal; i++)
+		{
+			m_vResiduals[i] = rValues[i] - previous;
+			previous        = rValues[i];
+		}
+
+		PackStream(m_vResiduals, vBuffer);
+	}
+
+	const double invPrecision = 1.0/m_Precision;
+
+	for(short int dim=0; dim<3; dim++)
+	{
+		const int64_t levels = m_Levels[dim];
+
+		m_vResiduals.resize(beadTotal);
+
+		int64_t previous = 0;
+
+		for(size_t i=0; i<beadTotal; i++)
+		{
+			// Coordinates within half the precision of the upper box edge would
+			// round to the grid point at the edge, which is not stored, so they
+			// are clamped to the last grid point instead of wrapping to zero.
+
+			int64_t grid = static_cast<int64_t>(std::floor(m_vCoords[3*i + dim]*invPrecision + 0.5));
+
+			if(grid >= levels)
+				grid = levels - 1;
+			else if(grid < 0)
+				grid = 0;
+
+			m_vResiduals[i] = WrapResidual(grid - previous, levels);
+			previous        = grid;
+		}
+
+		PackStream(m_vResiduals, vBuffer);
+	}
+
+	return true;
+}
+
+// Function to replace the current frame with one decoded from the data. 
+// The precision and box size are those stored in the frame. It returns false,
+// leaving the frame empty, if the data are not a complete frame.
+
+bool CCoordinateCodec::Decode(const unsigned char* pData, size_t size)
+{
+	Clear();
+
+	const unsigned char* const pEnd = pData + size;
+
+	FrameHeader header;
+
+	if(size < sizeof(FrameHeader))
+		return false;
+
+	std::memcpy(&header, pData, sizeof(FrameHeader));
+	pData += sizeof(FrameHeader);
+
+	// Each bead needs at least one bit in some stream unless all its values 
+	// are zero, so only the block headers bound the bead total from the size.
+
+	const uint64_t maxBeads = static_cast<uint64_t>(size)*m_BlockSize;
+
+	if(header.beadTotal < 0 || static_cast<uint64_t>(header.beadTotal) > maxBeads || !(header.precision > 0.0))
+		return false;
+
+	SetBox(header.box[0], header.box[1], header.box[2], header.precision);
+
+	const size_t beadTotal = static_cast<size_t>(header.beadTotal);
+
+	xxBasevector<int64_t>* const pIntStreams[3] = {&m_vIds, &m_vTypes, &m_vDisplayIds};
+
+	for(short int stream=0; stream<3; stream++)
+	{
+		if(!UnpackStream(pData, pEnd, beadTotal, *pIntStreams[stream]))
+		{
+			Clear();
+			return false;
+		}
+
+		int64_t previous = 0;
+
+		for(size_t i=0; i<beadTotal; i++)
+		{
+			previous += (*pIntStreams[stream])[i];
+			(*pIntStreams[stream])[i] = previous;
+		}
+	}
+
+	m_vCoords.resize(3*beadTotal);
+
+	for(short int dim=0; dim<3; dim++)
+	{
+		if(!UnpackStream(pData, pEnd, beadTotal, m_vResiduals))
+		{
+			Clear();
+			return false;
+		}
+
+		const int64_t levels = m_Levels[dim];
+
+		int64_t grid = 0;
+
+		for(size_t i=0; i<beadTotal; i++)
+		{
+			grid = (grid + m_vResiduals[i]) % levels;
+
+			if(grid < 0)
+				grid += levels;
+
+			m_vCoords[3*i + dim] = m_Precision*static_cast<double>(grid);
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,91 @@
+// CoordinateCodec.h: interface for the CCoordinateCodec class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_COORDINATECODEC_H__AD691BBF_6EA3_4AA7_A7D3_0C352C888775__INCLUDED_)
+#define AFX_COORDINATECODEC_H__AD691BBF_6EA3_4AA7_A7D3_0C352C888775__INCLUDED_
+
+
+#include "xxBase.h"
+
+#include <stdint.h>
+
+class CCoordinateCodec
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CCoordinateCodec(double lx, double ly, double lz, double precision);
+
+	~CCoordinateCodec();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	// Number of values in each block of a packed stream
+
+	static const long m_BlockSize = 128;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline double GetPrecision()  const {return m_Precision;}
+	inline long   GetBeadTotal()  const {return static_cast<long>(m_vIds.size());}
+
+	// Functions used to build a frame before encoding it
+
+	void Clear();
+	void AddBead(long id, long type, long displayId, double x, double y, double z);
+
+	bool Encode(xxBasevector<unsigned char>& vBuffer);
+	bool Decode(const unsigned char* pData, size_t size);
+
+	// Functions to return the data of the current frame. The coordinates are
+	// stored as (x,y,z) triples for each bead, and after decoding differ from 
+	// the encoded values by at most half the precision, except within half the
+	// precision of the upper box edge where they are clamped to the last grid
+	// point and differ by less than the precision.
+
+	inline const xxBasevector<int64_t>& GetIds()        const {return m_vIds;}
+	inline const xxBasevector<int64_t>& GetTypes()      const {return m_vTypes;}
+	inline const xxBasevector<int64_t>& GetDisplayIds() const {return m_vDisplayIds;}
+	inline const xxBasevector<double>&  GetCoordinates() const {return m_vCoords;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+	// ****************************************
+	// Private functions
+private:
+
+	CCoordinateCodec(const CCoordinateCodec& oldCodec);
+	CCoordinateCodec& operator=(const CCoordinateCodec& rhs);
+
+	void SetBox(double lx, double ly, double lz, double precision);
+
+	// ****************************************
+	// Data members
+private:
+
+	double  m_Precision;		// Spacing of the grid that coordinates are quantised to
+	double  m_Length[3];		// SimBox side lengths
+	int64_t m_Levels[3];		// Number of grid points along each side
+
+	// Data of the current frame
+
+	xxBasevector<int64_t> m_vIds;
+	xxBasevector<int64_t> m_vTypes;
+	xxBasevector<int64_t> m_vDisplayIds;
+	xxBasevector<double>  m_vCoords;
+
+	xxBasevector<int64_t> m_vResiduals;	// Reused for each stream to avoid reallocation
+};
+
+#endif // !defined(AFX_COORDINATECODEC_H__AD691BBF_6EA3_4AA7_A7D3_0C352C888775__INCLUDED_)
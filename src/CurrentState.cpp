@@ -29,7 +29,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 //
 // Static member function to clear the map prior to use.
 
-LongLongMap CCurrentState::m_mBeadDisplayId;
+SimThreadLocal LongLongMap CCurrentState::m_mBeadDisplayId;
 
 void CCurrentState::ClearBeadDisplayIdMap()
 {
@@ -48,7 +48,7 @@ private:
 	// Map of (beadId, displayId) pairs that determines what colour each
 	// bead is drawn in current state snapshots.
 
-	static LongLongMap	m_mBeadDisplayId;
+	static SimThreadLocal LongLongMap	m_mBeadDisplayId;
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -51,7 +51,7 @@ public:
 
 private:
 
-	static IExperiment* m_pInstance;		
+	static SimThreadLocal IExperiment* m_pInstance;		
 
 	
 	// ****************************************
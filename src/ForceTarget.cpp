@@ -34,7 +34,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 CForceTarget::CForceTarget(const zString label, BeadVector beads) : m_Label(label), 
 																	m_Beads(beads),														
 																	m_End(0),
-																	m_ForceLaw(0)
+																	m_ForceLaw(0),
+																	m_bVariableForce(false)
 {
 }
 
@@ -51,6 +52,8 @@ CForceTarget::~CForceTarget()
 // previous object. We copy the end time into the target object so that it 
 // can check when it should stop. This is done for speed of access instead of 
 // having to use a function call to the CForceLaw object every time step.
+// Similarly, we record whether the force law depends on the bead coordinates
+// here instead of testing its type every time step.
 
 void CForceTarget::SetForceLaw(CForceLaw *const pForce)
 {
@@ -60,6 +63,10 @@ void CForceTarget::SetForceLaw(CForceLaw *const pForce)
 		delete m_ForceLaw;
 
 	m_ForceLaw = pForce;
+
+#if EnableMiscClasses == SimMiscEnabled
+	m_bVariableForce = (dynamic_cast<CRadialForce*>(m_ForceLaw) != 0);
+#endif
 }
 
 // Function to add the force generated by the enclosed CForceLaw object to each 
@@ -71,7 +78,7 @@ void CForceTarget::SetForceLaw(CForceLaw *const pForce)
 bool CForceTarget::AddForce(long simTime)
 {
 #if EnableMiscClasses == SimMiscEnabled
-	if(dynamic_cast<CRadialForce*>(m_ForceLaw))
+	if(m_bVariableForce)
 	{
 		double fx = 0.0;
 		double fy = 0.0;
@@ -88,11 +95,19 @@ bool CForceTarget::AddForce(long simTime)
 	}
 	else
 	{
+		// The force is the same for all beads in the target so we evaluate it 
+		// once per time step. The X component must be obtained first because
+		// some force laws, e.g., CSpringForce, calculate all components in it.
+
+		const double fx = m_ForceLaw->GetXForce(simTime);
+		const double fy = m_ForceLaw->GetYForce(simTime);
+		const double fz = m_ForceLaw->GetZForce(simTime);
+
 		for(BeadVectorIterator iterBead=m_Beads.begin(); iterBead!=m_Beads.end(); iterBead++)
 		{
-			(*iterBead)->m_Force[0] += m_ForceLaw->GetXForce(simTime);
-			(*iterBead)->m_Force[1] += m_ForceLaw->GetYForce(simTime);
-			(*iterBead)->m_Force[2] += m_ForceLaw->GetZForce(simTime);
+			(*iterBead)->m_Force[0] += fx;
+			(*iterBead)->m_Force[1] += fy;
+			(*iterBead)->m_Force[2] += fz;
 		}
 	}
 #endif
@@ -36,6 +36,7 @@ private:
 	long m_End;						// Time at which force ends
 
 	CForceLaw* m_ForceLaw;			// Pointer to a particular force object
+	bool m_bVariableForce;			// Flag showing if the force depends on bead coordinates
 
 
 };
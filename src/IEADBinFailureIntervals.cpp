@@ -16,6 +16,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 //////////////////////////////////////////////////////////////////////
 
 #include "StdAfx.h"
+#include "SimDefs.h"
 #include "IEADBinFailureIntervals.h"
 #include "taEventSourceDecorator.h"
 
@@ -38,7 +38,7 @@ const IGlobalSimBox* IGlobalSimBox::Instance()
 	return m_pInstance;
 }
 
-ISimBox* IGlobalSimBox::m_pInstance = 0;
+SimThreadLocal ISimBox* IGlobalSimBox::m_pInstance = 0;
 
 
 //////////////////////////////////////////////////////////////////////
@@ -61,8 +61,16 @@ IGlobalSimBox::IGlobalSimBox(ISimBox* pISimBox)
 	}
 }
 
+// The ISimBox clears the stored pointer when it is destroyed so that a later 
+// simulation on the same thread stores its own ISimBox instead of using a 
+// deleted one.
+
 IGlobalSimBox::~IGlobalSimBox()
 {
+    if(IGlobalSimBox::m_pInstance && static_cast<IGlobalSimBox*>(IGlobalSimBox::m_pInstance) == this)
+	{
+	    IGlobalSimBox::m_pInstance = 0;
+	}
 }
 
 const zString IGlobalSimBox::GetRunId() const
@@ -72,7 +72,7 @@ public:
 	// interface class
 private:
 
-	static ISimBox* m_pInstance;
+	static SimThreadLocal ISimBox* m_pInstance;
 
 	// ****************************************
 	// Protected constructor to prevent external creation of this class
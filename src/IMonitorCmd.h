@@ -38,6 +38,7 @@ public:
 	virtual void		         ShowModifiableProcesses(const xxCommand* const pCommand) = 0;
 	virtual void	          ToggleCurrentStateAnalysis(const xxCommand* const pCommand) = 0;
 	virtual void			          ToggleEnergyOutput(const xxCommand* const pCommand) = 0;
+	virtual void		         TogglePerformanceOutput(const xxCommand* const pCommand) = 0;
 	virtual void		         ToggleSliceEnergyOutput(const xxCommand* const pCommand) = 0;
 	virtual void		          ZoomCurrentStateCamera(const xxCommand* const pCommand) = 0;
 #endif
@@ -72,9 +73,11 @@ public:
 	virtual void	     SetRestartStateDefaultInclusive(const xxCommand* const pCommand) = 0;
 	virtual void		          SetRunCompleteInterval(const xxCommand* const pCommand) = 0;
 	virtual void				         SetSamplePeriod(const xxCommand* const pCommand) = 0;
+	virtual void				       SetStateRetention(const xxCommand* const pCommand) = 0;
 	virtual void			           ToggleBeadDisplay(const xxCommand* const pCommand) = 0;
 	virtual void		           ToggleCurrentStateBox(const xxCommand* const pCommand) = 0;
 	virtual void		        ToggleDensityFieldOutput(const xxCommand* const pCommand) = 0;
+	virtual void		            ToggleInSituAnalysis(const xxCommand* const pCommand) = 0;
 	virtual void			        TogglePolymerDisplay(const xxCommand* const pCommand) = 0;
 	virtual void	        ToggleRestartWarningMessages(const xxCommand* const pCommand) = 0;
 	virtual void			             WriteLogMessage(const xxCommand* const pCommand) = 0;
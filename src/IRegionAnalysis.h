@@ -37,7 +37,7 @@ public:
 
 private:
 
-	static long m_RegionAnalysisTotal;
+	static SimThreadLocal long m_RegionAnalysisTotal;
 
 
 	// ****************************************
@@ -37,7 +37,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable holding a pointer to the single instance of ISimBox.
 // Note that it does not get assigned a value until the user creates the instance.
 
-ISimBox* ISimBox::m_pInstance = 0;
+SimThreadLocal ISimBox* ISimBox::m_pInstance = 0;
 
 // Public member function to create a single instance of the ISimBox class.
 
@@ -44,7 +44,7 @@ public:
 
 private:
 
-	static ISimBox* m_pInstance;	// Pointer to single instance of ISimBox class
+	static SimThreadLocal ISimBox* m_pInstance;	// Pointer to single instance of ISimBox class
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -420,6 +420,11 @@ void ISimBoxBase::SetSamplePeriod(const xxCommand* const pCommand) const
 	m_pISimBox->IIMonitorCmd()->SetSamplePeriod(pCommand);
 }
 
+void ISimBoxBase::SetStateRetention(const xxCommand* const pCommand) const
+{
+	m_pISimBox->IIMonitorCmd()->SetStateRetention(pCommand);
+}
+
 void ISimBoxBase::ShowAllProcesses(const xxCommand* const pCommand) const
 {
 #if EnableMonitorCommand == SimCommandEnabled
@@ -463,11 +468,23 @@ void ISimBoxBase::ToggleEnergyOutput(const xxCommand* const pCommand) const
 #endif
 }
 
+void ISimBoxBase::TogglePerformanceOutput(const xxCommand* const pCommand) const
+{
+#if EnableMonitorCommand == SimCommandEnabled
+	m_pISimBox->IIMonitorCmd()->TogglePerformanceOutput(pCommand);
+#endif
+}
+
 void ISimBoxBase::TogglePolymerDisplay(const xxCommand* const pCommand) const
 {
 	m_pISimBox->IIMonitorCmd()->TogglePolymerDisplay(pCommand);
 }
 
+void ISimBoxBase::ToggleInSituAnalysis(const xxCommand* const pCommand) const
+{
+	m_pISimBox->IIMonitorCmd()->ToggleInSituAnalysis(pCommand);
+}
+
 void ISimBoxBase::ToggleRestartWarningMessages(const xxCommand* const pCommand) const
 {
 	m_pISimBox->IIMonitorCmd()->ToggleRestartWarningMessages(pCommand);
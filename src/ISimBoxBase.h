@@ -115,6 +115,7 @@ public:
 	void            SetRestartStateDefaultInclusive(const xxCommand* const pCommand) const;
 	void	                 SetRunCompleteInterval(const xxCommand* const pCommand) const;
 	void                            SetSamplePeriod(const xxCommand* const pCommand) const;
+	void                          SetStateRetention(const xxCommand* const pCommand) const;
 	void			               ShowAllProcesses(const xxCommand* const pCommand) const;
 	void	                ShowModifiableProcesses(const xxCommand* const pCommand) const;
 	void			              ToggleBeadDisplay(const xxCommand* const pCommand) const;
@@ -122,6 +123,8 @@ public:
 	void		              ToggleCurrentStateBox(const xxCommand* const pCommand) const;
 	void	               ToggleDensityFieldOutput(const xxCommand* const pCommand) const;
 	void		                 ToggleEnergyOutput(const xxCommand* const pCommand) const;
+	void		               ToggleInSituAnalysis(const xxCommand* const pCommand) const;
+	void	                TogglePerformanceOutput(const xxCommand* const pCommand) const;
 	void	                ToggleSliceEnergyOutput(const xxCommand* const pCommand) const;
 	void		               TogglePolymerDisplay(const xxCommand* const pCommand) const;
 	void               ToggleRestartWarningMessages(const xxCommand* const pCommand) const;
@@ -171,6 +171,7 @@ public:
 	virtual void						      GravityOn(const xxCommand* const pCommand) = 0;
 	virtual void						    LinearForce(const xxCommand* const pCommand) = 0;
 	virtual void				    LinearForceOnTarget(const xxCommand* const pCommand) = 0;
+	virtual void			      MakeNanoparticleRigid(const xxCommand* const pCommand) = 0;
 	virtual void			        MovePolymersToSlice(const xxCommand* const pCommand) = 0;
 	virtual void						    RadialForce(const xxCommand* const pCommand) = 0;
 	virtual void				    RadialForceOnTarget(const xxCommand* const pCommand) = 0;
@@ -51,6 +51,7 @@ ISimState::ISimState(CSimState& simState, const ISimBox* const pISimBox) : ISimE
 									m_SimTime(0),
 									m_TotalTime(simState.GetTotalTime()),
 				    				        m_TotalMCTime(simState.GetTotalMCTime()),
+									m_MCThreadNo(simState.GetMCThreadNo()),
 									m_MaxMCStep(simState.GetMCStepSize()),
 									m_RenormalisationPeriod(1),
 									m_rSimState(simState)
@@ -510,6 +511,16 @@ bool ISimState::IsEnergyOutputOn() const
 	return m_rSimState.IsEnergyOutputOn();
 }
 
+bool ISimState::IsPerformanceOutputOn() const
+{
+	return m_rSimState.IsPerformanceOutputOn();
+}
+
+long ISimState::GetPerformancePeriod() const
+{
+	return m_rSimState.GetPerformancePeriod();
+}
+
 bool ISimState::IsGravityOn() const
 {
 	return m_rSimState.IsGravityOn();
@@ -781,7 +792,7 @@ const BondVector ISimState::GetAllBonds() const
 	return m_rSimState.GetBonds();
 }
 
-const BondVector ISimState::GetAllPolymerisedBonds() const
+const BondVector& ISimState::GetAllPolymerisedBonds() const
 {
 	return m_rSimState.GetPolymerisedBonds();
 }
@@ -153,11 +153,14 @@ protected:
 	bool IsBondStressAdded() const;
 	bool IsBondPairStressAdded() const;
 	bool IsEnergyOutputOn() const;
+	bool IsPerformanceOutputOn() const;
 	bool IsGravityOn() const;
 	bool IsRenormalisationOn() const;
 	bool IsWallOn() const;
 	bool IsWallPolymerFlexible() const;
 
+	long GetPerformancePeriod() const;
+
 	// Functions that return information about the physical state of the simulation
 
 	long GetProcessorsXNo() const;
@@ -193,7 +196,7 @@ protected:
 	// each bead type, etc.
 
 	const BondVector GetAllBonds() const;
-	const BondVector GetAllPolymerisedBonds() const;
+	const BondVector& GetAllPolymerisedBonds() const;
 
 
 
@@ -264,6 +267,7 @@ protected:
 	long m_TotalTime;				// Total time for simulation to run
 
 	long m_TotalMCTime;				// Total time for pre-MD Monte Carlo relaxation
+	long m_MCThreadNo;				// Threads used for checkerboard MC relaxation, or zero
 	double m_MaxMCStep;				// Max displacement for an MC step
 
 	long m_RenormalisationPeriod;	// Period for renormalising momenta
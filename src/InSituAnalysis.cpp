@@ -0,0 +1,131 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// InSituAnalysis.cpp: implementation of the CInSituAnalysis class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "InSituAnalysis.h"
+#include "Analysis.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class that analyses aggregates on a background thread while the simulation
+// continues. The CMonitor copies the bead data into a snapshot each time it 
+// samples, and the worker thread passes the snapshot to each aggregate 
+// that can be updated from it. Only one snapshot is analysed at a time, and
+// Submit() waits for the previous one to finish, so the aggregates receive 
+// their samples, and write their state files, in the order of the simulation.
+//
+// The worker thread is only created when the first snapshot is submitted. It
+// must not touch the simulation singletons as these are local to the thread
+// running the simulation: aggregates only use the snapshot and their own data.
+
+CInSituAnalysis::CInSituAnalysis() : m_bPending(false), m_bStop(false)
+{
+	m_vAggregates.clear();
+	m_vSerialize.clear();
+}
+
+// The destructor waits for any outstanding analysis to finish before stopping
+// the worker thread, so all aggregate data is written before the aggregates 
+// are destroyed.
+
+CInSituAnalysis::~CInSituAnalysis()
+{
+	if(m_Worker.joinable())
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]{return !m_bPending;});
+			m_bStop = true;
+		}
+
+		m_Condition.notify_all();
+		m_Worker.join();
+	}
+}
+
+// Function to copy the current bead data into the snapshot and pass it to the
+// worker thread together with the aggregates to update. The vSerialize flags 
+// show which aggregates should write their state to file after the update.
+// This function blocks until the previous snapshot has been analysed.
+
+void CInSituAnalysis::Submit(long time, const CSimState& rSimState, const AggregateSequence& vAggregates, const zBoolVector& vSerialize)
+{
+	Wait();
+
+	m_Snapshot.Fill(time, rSimState);
+	m_vAggregates.assign(vAggregates.begin(), vAggregates.end());
+	m_vSerialize.assign(vSerialize.begin(), vSerialize.end());
+
+	if(!m_Worker.joinable())
+	{
+		m_Worker = std::thread(&CInSituAnalysis::Run, this);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_bPending = true;
+	}
+
+	m_Condition.notify_all();
+}
+
+// Function to block until the worker thread has finished analysing the most
+// recent snapshot. The CMonitor calls this before it touches any aggregate 
+// that may still be in use by the worker.
+
+void CInSituAnalysis::Wait()
+{
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_Condition.wait(lock, [this]{return !m_bPending;});
+}
+
+// Worker thread loop. Each submitted snapshot is passed to the aggregates in 
+// the order they were given, and those flagged for serialization write their
+// data to file after they are updated.
+
+void CInSituAnalysis::Run()
+{
+	while(true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]{return m_bPending || m_bStop;});
+
+			if(!m_bPending)
+				return;
+		}
+
+		for(unsigned long i=0; i<m_vAggregates.size(); i++)
+		{
+			m_vAggregates.at(i)->UpdateStateFromSnapshot(m_Snapshot);
+
+			if(m_vSerialize.at(i) && !m_vAggregates.at(i)->Serialize())
+				ErrorTrace("Error in CInSituAnalysis::Run");
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_bPending = false;
+		}
+
+		m_Condition.notify_all();
+	}
+}
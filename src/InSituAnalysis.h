@@ -0,0 +1,80 @@
+// InSituAnalysis.h: interface for the CInSituAnalysis class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_INSITUANALYSIS_H__317F92ED_4CCB_490F_AB24_908412C14A77__INCLUDED_)
+#define AFX_INSITUANALYSIS_H__317F92ED_4CCB_490F_AB24_908412C14A77__INCLUDED_
+
+
+// Forward declarations
+
+class CSimState;
+
+
+#include "xxBase.h"
+#include "InSituSnapshot.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class CInSituAnalysis : public xxBase
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CInSituAnalysis();
+
+	virtual ~CInSituAnalysis();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void Submit(long time, const CSimState& rSimState, const AggregateSequence& vAggregates, const zBoolVector& vSerialize);
+
+	void Wait();
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+
+	// ****************************************
+	// Implementation
+
+protected:
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	void Run();
+
+	CInSituAnalysis(const CInSituAnalysis& oldAnalysis);
+	CInSituAnalysis& operator=(const CInSituAnalysis& rhs);
+
+	// ****************************************
+	// Data members
+private:
+
+	CInSituSnapshot   m_Snapshot;		// Bead data staged for the worker thread
+	AggregateSequence m_vAggregates;	// Aggregates to update from the snapshot
+	zBoolVector       m_vSerialize;		// Flags showing which aggregates write their state afterwards
+
+	std::thread             m_Worker;
+	std::mutex              m_Mutex;
+	std::condition_variable m_Condition;
+	bool                    m_bPending;	// Snapshot submitted but not yet analysed
+	bool                    m_bStop;	// Worker thread must exit
+
+};
+
+#endif // !defined(AFX_INSITUANALYSIS_H__317F92ED_4CCB_490F_AB24_908412C14A77__INCLUDED_)
@@ -0,0 +1,105 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// InSituSnapshot.cpp: implementation of the CInSituSnapshot class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "InSituSnapshot.h"
+#include "SimState.h"
+#include "Bead.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class holding a copy of the bead data needed by aggregates that are analysed
+// on the in-situ analysis thread. The snapshot is reused for every sample so
+// its containers only grow when the number of beads increases.
+
+CInSituSnapshot::CInSituSnapshot() : m_Time(0), m_StepSize(0.0), 
+									 m_SamplePeriod(0), m_AnalysisPeriod(0),
+									 m_BeadIdTotal(0)
+{
+	m_SimBoxLength[0] = 0.0;
+	m_SimBoxLength[1] = 0.0;
+	m_SimBoxLength[2] = 0.0;
+
+	m_vType.clear();
+	m_vPos.clear();
+	m_vUnPBCPos.clear();
+	m_vMom.clear();
+}
+
+CInSituSnapshot::~CInSituSnapshot()
+{
+
+}
+
+// Function to copy the current coordinates, momenta and types of all beads
+// in the simulation into the snapshot. Beads are stored by id so that an 
+// aggregate can look up the beads it found on its first sample without 
+// holding pointers to the live beads.
+
+void CInSituSnapshot::Fill(long time, const CSimState& rSimState)
+{
+	m_Time				= time;
+	m_StepSize			= rSimState.GetIntegrationStep();
+	m_SamplePeriod		= rSimState.GetSamplePeriod();
+	m_AnalysisPeriod	= rSimState.GetAnalysisPeriod();
+	m_SimBoxLength[0]	= rSimState.GetSimBoxXLength();
+	m_SimBoxLength[1]	= rSimState.GetSimBoxYLength();
+	m_SimBoxLength[2]	= rSimState.GetSimBoxZLength();
+
+	const BeadVector& vBeads = rSimState.GetInitialStateBeads();
+
+	m_BeadIdTotal = 0;
+
+	for(cBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	{
+		if((*iterBead)->GetId() >= m_BeadIdTotal)
+		{
+			m_BeadIdTotal = (*iterBead)->GetId() + 1;
+		}
+	}
+
+	if(static_cast<long>(m_vType.size()) < m_BeadIdTotal)
+	{
+		m_vType.resize(m_BeadIdTotal, -1);
+		m_vPos.resize(3*m_BeadIdTotal, 0.0);
+		m_vUnPBCPos.resize(3*m_BeadIdTotal, 0.0);
+		m_vMom.resize(3*m_BeadIdTotal, 0.0);
+	}
+
+	for(cBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	{
+		const long id = (*iterBead)->GetId();
+
+		m_vType[id] = (*iterBead)->GetType();
+
+		m_vPos[3*id]		= (*iterBead)->GetXPos();
+		m_vPos[3*id+1]		= (*iterBead)->GetYPos();
+		m_vPos[3*id+2]		= (*iterBead)->GetZPos();
+
+		m_vUnPBCPos[3*id]	= (*iterBead)->GetunPBCXPos();
+		m_vUnPBCPos[3*id+1]	= (*iterBead)->GetunPBCYPos();
+		m_vUnPBCPos[3*id+2]	= (*iterBead)->GetunPBCZPos();
+
+		m_vMom[3*id]		= (*iterBead)->GetXMom();
+		m_vMom[3*id+1]		= (*iterBead)->GetYMom();
+		m_vMom[3*id+2]		= (*iterBead)->GetZMom();
+	}
+}
@@ -0,0 +1,89 @@
+// InSituSnapshot.h: interface for the CInSituSnapshot class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_INSITUSNAPSHOT_H__BF869C00_C4D6_4B61_8B34_DCA9D37B86B2__INCLUDED_)
+#define AFX_INSITUSNAPSHOT_H__BF869C00_C4D6_4B61_8B34_DCA9D37B86B2__INCLUDED_
+
+
+// Forward declarations
+
+class CSimState;
+
+
+#include "xxBase.h"
+
+class CInSituSnapshot  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CInSituSnapshot();
+
+	~CInSituSnapshot();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void Fill(long time, const CSimState& rSimState);
+
+	inline long   GetCurrentTime()     const {return m_Time;}
+	inline double GetStepSize()        const {return m_StepSize;}
+	inline long   GetSamplePeriod()    const {return m_SamplePeriod;}
+	inline long   GetAnalysisPeriod()  const {return m_AnalysisPeriod;}
+	inline double GetSimBoxXLength()   const {return m_SimBoxLength[0];}
+	inline double GetSimBoxYLength()   const {return m_SimBoxLength[1];}
+	inline double GetSimBoxZLength()   const {return m_SimBoxLength[2];}
+
+	// Bead data are indexed by bead id: ids up to GetBeadIdTotal()-1 are valid
+
+	inline long          GetBeadIdTotal()             const {return m_BeadIdTotal;}
+	inline long          GetBeadType(long id)         const {return m_vType[id];}
+	inline const double* GetPosition(long id)         const {return &m_vPos[3*id];}
+	inline const double* GetUnPBCPosition(long id)    const {return &m_vUnPBCPos[3*id];}
+	inline const double* GetMomentum(long id)         const {return &m_vMom[3*id];}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+
+	// ****************************************
+	// Implementation
+
+protected:
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	CInSituSnapshot(const CInSituSnapshot& oldSnapshot);
+	CInSituSnapshot& operator=(const CInSituSnapshot& rhs);
+
+	// ****************************************
+	// Data members
+private:
+
+	long   m_Time;				// Simulation time at which the snapshot was taken
+	double m_StepSize;			// Integration step size
+	long   m_SamplePeriod;
+	long   m_AnalysisPeriod;
+	double m_SimBoxLength[3];
+
+	long          m_BeadIdTotal;	// One more than the largest bead id
+	zLongVector   m_vType;			// Bead types indexed by id
+	zDoubleVector m_vPos;			// Bead coordinates, three per bead
+	zDoubleVector m_vUnPBCPos;		// Bead coordinates without periodic boundaries
+	zDoubleVector m_vMom;			// Bead momenta
+
+};
+
+#endif // !defined(AFX_INSITUSNAPSHOT_H__BF869C00_C4D6_4B61_8B34_DCA9D37B86B2__INCLUDED_)
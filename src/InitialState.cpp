@@ -28,6 +28,10 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Bond.h"
 #include "BondPair.h"
 #include "Polymer.h"
+#include "PolymerArena.h"
+#include "InitialStateCache.h"
+#include "InitialStateRestart.h"
+#include "LogTextMessage.h"
 #include "acfTargetFactory.h"
 #include "CommandTargetNode.h"
 
@@ -89,6 +93,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
                                                         m_pIRS(new IInclusiveRestartState(pSimState)),
                                                         m_bDPDLG(rData.IsDPDLG()),
 														RNGSeed(rData.GetRNGSeed()),
+														m_AssemblyThreadNo(rData.GetAssemblyThreadNo()),
+														m_StateCache(rData.GetStateCache()),
 														ProcessorsXNo(rData.GetProcessorsXNo()),
 														ProcessorsYNo(rData.GetProcessorsYNo()),
 														CNTXCellNo(rData.GetCNTXCellNo()),
@@ -102,6 +108,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 														vBondPairTypes(rData.GetBondPairTypes()),
 														vPolymerTypes(rData.GetPolymerTypes()),
 														m_pISD(rData.GetISD()),
+														m_pPolymerArena(0),
 													    m_TempBeadTotal(0),
 														m_TempBondTotal(0),  
 														m_TempBondPairTotal(0),   
@@ -114,6 +121,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
                                                         m_pIRS(new IInclusiveRestartState(pSimState)),
                                                         m_bDPDLG(rData.IsDPDLG()),
                                                         RNGSeed(rData.GetRNGSeed()),
+														m_AssemblyThreadNo(rData.GetAssemblyThreadNo()),
+														m_StateCache(rData.GetStateCache()),
 														ProcessorsXNo(rData.GetProcessorsXNo()),
 														ProcessorsYNo(rData.GetProcessorsYNo()),
 														CNTXCellNo(rData.GetCNTXCellNo()),
@@ -127,6 +136,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 														vBondPairTypes(rData.GetBondPairTypes()),
 														vPolymerTypes(rData.GetPolymerTypes()),
 														m_pISD(rData.GetISD()),
+														m_pPolymerArena(0),
 														m_TempBeadTotal(0),
 														m_TempBondTotal(0),  
 														m_TempBondPairTotal(0),   
@@ -306,9 +316,17 @@ CInitialState::~CInitialState()
 	
 #else
 	// Delete all the polymers that were created to form the initial state object, and
-	// let the CPolymers destroy their own beads and bonds. 
+	// let the CPolymers destroy their own beads and bonds. Polymers created by
+	// CreatePolymers() live in the polymer arena, which destroys them together with 
+	// their beads, bonds and bondpairs.
 
-	if(!vAllPolymers.empty())
+	if(m_pPolymerArena)
+	{
+		delete m_pPolymerArena;
+		m_pPolymerArena = 0;
+		vAllPolymers.clear();
+	}
+	else if(!vAllPolymers.empty())
 	{
 		for(PolymerVectorIterator iterPolymer=vAllPolymers.begin(); iterPolymer!=vAllPolymers.end(); iterPolymer++)
 		{
@@ -487,12 +505,23 @@ void CInitialState::CreatePolymers()
 	long BondPairTotal	= 0;
 	long PolymerTotal	= 0;
 
+	// The polymers of each type, and their beads, bonds and bondpairs, are
+	// constructed in a single block of memory owned by the polymer arena so that 
+	// the force loops traverse contiguous objects and teardown is one release 
+	// per type.
+
+	m_pPolymerArena = new CPolymerArena();
+
 	for(cPolymerVectorIterator iterPolyType=vPolymerTypes.begin(); iterPolyType!=vPolymerTypes.end(); iterPolyType++)
 	{
-		for(long pno=0; pno<m_vPolymerTypeTotal.at((*iterPolyType)->GetType()); pno++)
+		const long polymerTypeTotal = m_vPolymerTypeTotal.at((*iterPolyType)->GetType());
+
+		CPolymer* const pPolymers = m_pPolymerArena->AddPolymers(**iterPolyType, polymerTypeTotal);
+
+		for(long pno=0; pno<polymerTypeTotal; pno++)
 		{
 			PolymerTotal++;
-			CPolymer* pPolymer = new CPolymer(**iterPolyType);
+			CPolymer* pPolymer = pPolymers + pno;
 			pPolymer->SetId(PolymerTotal);
 
 			BeadTotal		= pPolymer->SetBeadIds(BeadTotal);
@@ -687,8 +716,14 @@ bool CInitialState::Assemble()
 	// object. If this succeeds, write out the data on beads, bonds and polymers 
     // created for the initial state, and then close the file to force it to be 
     // written immediately so that the user can view it.
-
-    if(m_pISD->Assemble(*this))
+	//
+	// If the user has specified a cache directory, we first try to read the 
+	// bead coordinates from a previously-assembled state with the same 
+	// definition, and store newly-assembled states there. Restart states are
+	// not cached, nor are states whose builders create new bonds between 
+	// polymers because only the bead data are stored.
+
+    if(AssembleFromCache())
     {
 	    // Copy the entity totals into local storage that is required by the parallel builder but only used here to avoid having to write two versions of the
 		// serialisation function.
@@ -726,6 +761,37 @@ bool CInitialState::Assemble()
     }
 }
 
+// Private helper function used by Assemble() to read the assembled state from
+// the cache or assemble it and add it to the cache.
+
+bool CInitialState::AssembleFromCache()
+{
+	if(m_StateCache.empty() || GetInitialStateType() == CInitialStateRestart::GetType())
+		return m_pISD->Assemble(*this);
+
+	CInitialStateCache cache(m_StateCache, GetRunId());
+
+	if(cache.Read(*this))
+	{
+		new CLogTextMessage(0, "Initial state read from " + cache.GetFileName());
+		return true;
+	}
+	else if(m_pISD->Assemble(*this))
+	{
+		if(!IsPolymerised() && cache.IsKeyValid())
+		{
+			if(cache.Write(*this))
+				new CLogTextMessage(0, "Initial state written to " + cache.GetFileName());
+			else
+				new CLogTextMessage(0, "Unable to write initial state to " + cache.GetFileName());
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
 // Parallel version of the Assemble() function that manages the creation of polymers for a parallel simulation. 	
 // We delegate the creation of the beads, bonds and polymers 
 // specified in the control data file to the nested instance to handle both P0 and PN creation.
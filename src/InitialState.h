@@ -15,6 +15,7 @@ class CInitialStateData;
 class CLamellaBuilder;
 class CCompositeLamellaBuilder;
 class IInclusiveRestartState;
+class CPolymerArena;
 
 
 #include "SimMPSFlags.h"
@@ -103,6 +104,7 @@ public:
     bool            IsDPDLG() const;
 
 	inline long		GetRNGSeed()		  const {return RNGSeed;}
+	inline long		GetAssemblyThreadNo() const {return m_AssemblyThreadNo;}
 	inline long		GetProcessorsXNo()	  const {return ProcessorsXNo;}
 	inline long		GetProcessorsYNo()	  const {return ProcessorsYNo;}
 	inline long		GetProcessorsZNo()	  const {return ProcessorsZNo;}
@@ -270,6 +272,8 @@ private:
 	void CreatePolymers();   // Serial versions
 	void CreateWallPolymers();
 
+	bool AssembleFromCache();	// Reads or writes the optional assembled state cache
+
 	void SetGravityBeads();	// Function to store bead pointers in a vector
 							// if they are affected by the body force
 
@@ -325,6 +329,9 @@ private:
 
     long RNGSeed;
 
+    const long    m_AssemblyThreadNo;	// Threads used by builders that can assemble in parallel
+    const zString m_StateCache;			// Directory holding cached assembled states
+	
     long ProcessorsXNo;   // Number of processors in X dimension of simulation space
     long ProcessorsYNo;   // Number of processors in Y dimension of simulation space
     long ProcessorsZNo;   // Number of processors in Z dimension of simulation space
@@ -407,6 +414,8 @@ private:
 
 
 	const CInitialStateData* const m_pISD;	// Pointer to the initial state data object
+
+	CPolymerArena* m_pPolymerArena;			// Storage for the polymers created by CreatePolymers()
 	
 	// Temporary storage of entity totals for use in serialisation. Only P0 can write to file so the Serialize() function is 
 	// is only called by P0 and hence it cannot communicate with the other processors. We hold the totals in these locations
@@ -0,0 +1,340 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// InitialStateCache.cpp: implementation of the CInitialStateCache class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "InitialStateCache.h"
+#include "InitialState.h"
+#include "CNTCell.h"
+#include "Bead.h"
+
+#include <cstdio>
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+const char* const CInitialStateCache::m_Magic = "DPDACH01";
+
+namespace
+{
+	// FNV-1a hash constants for 64-bit keys
+
+	const uint64_t fnvOffsetBasis = 14695981039346656037ull;
+	const uint64_t fnvPrime       = 1099511628211ull;
+
+	uint64_t HashString(uint64_t hash, const zString& text)
+	{
+		for(zString::const_iterator iterChar=text.begin(); iterChar!=text.end(); iterChar++)
+		{
+			hash ^= static_cast<unsigned char>(*iterChar);
+			hash *= fnvPrime;
+		}
+
+		// Separate consecutive tokens so that "ab c" and "a bc" differ
+
+		hash ^= 0xffull;
+		hash *= fnvPrime;
+
+		return hash;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class that stores assembled initial states on disk so that runs whose 
+// control data files define the same initial state can read it instead of
+// assembling it again. This is useful for parameter sweeps that only change
+// interaction parameters, the run length or the commands. 
+//
+// Cache files are named dmpcac.<key> in the user-specified directory, where
+// the key is a hash of the control data file from the State section to the 
+// RNGSeed, inclusive. These sections define the beads, bonds, polymers, 
+// SimBox and random number seed that determine the assembled state, and 
+// anything else in the file is ignored. If the control data file cannot be 
+// read in the expected order, the key is marked invalid and the cache is not 
+// used. A file is only used if its key and bead totals match the state 
+// being assembled.
+
+CInitialStateCache::CInitialStateCache(const zString directory, const zString runId) : m_RunId(runId),
+																						m_Key(0),
+																						m_bKeyValid(false),
+																						m_FileName("")
+{
+	m_bKeyValid = HashControlData(xxBase::GetCDFPrefix() + runId);
+
+	if(m_bKeyValid)
+	{
+		char key[17];
+		std::sprintf(key, "%016llx", static_cast<unsigned long long>(m_Key));
+
+		m_FileName = directory + "/" + xxBase::GetACPrefix() + key;
+	}
+}
+
+CInitialStateCache::~CInitialStateCache()
+{
+
+}
+
+// Function to copy the bead coordinates and momenta from the cache file into
+// the beads that the CInitialState has created, and to restore the RNG to 
+// the state it was in after the original assembly, so that the run continues
+// exactly as if the state had been assembled. It returns false without 
+// changing anything if there is no usable file for the key.
+
+bool CInitialStateCache::Read(CInitialState& riState) const
+{
+	if(!m_bKeyValid)
+		return false;
+
+	zInFileStream inStream(m_FileName.c_str(), std::ios::in | std::ios::binary);
+
+	if(!inStream.is_open())
+		return false;
+
+	const long beadTotal     = riState.GetBeads().size();
+	const long wallBeadTotal = riState.GetWallBeads().size();
+
+	FileHeader header;
+	inStream.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+
+	if(!inStream.good() || std::memcmp(header.magic, m_Magic, sizeof(header.magic)) != 0 ||
+	   header.key != m_Key || header.beadTotal != beadTotal || header.wallBeadTotal != wallBeadTotal)
+		return false;
+
+	std::vector<BeadRecord> vRecords(beadTotal + wallBeadTotal);
+
+	if(!vRecords.empty())
+	{
+		inStream.read(reinterpret_cast<char*>(&vRecords[0]), vRecords.size()*sizeof(BeadRecord));
+	}
+
+	if(!inStream.good())
+		return false;
+
+	long i = 0;
+
+	for(cBeadVectorIterator iterBead=riState.GetBeads().begin(); iterBead!=riState.GetBeads().end(); iterBead++, i++)
+	{
+		CAbstractBead* const pBead = *iterBead;
+		const BeadRecord& rRecord  = vRecords[i];
+
+		pBead->SetXPos(rRecord.pos[0]);
+		pBead->SetYPos(rRecord.pos[1]);
+		pBead->SetZPos(rRecord.pos[2]);
+		pBead->SetunPBCXPos(rRecord.unPBCPos[0]);
+		pBead->SetunPBCYPos(rRecord.unPBCPos[1]);
+		pBead->SetunPBCZPos(rRecord.unPBCPos[2]);
+		pBead->SetInitialXPos(rRecord.initialPos[0]);
+		pBead->SetInitialYPos(rRecord.initialPos[1]);
+		pBead->SetInitialZPos(rRecord.initialPos[2]);
+		pBead->SetXMom(rRecord.mom[0]);
+		pBead->SetYMom(rRecord.mom[1]);
+		pBead->SetZMom(rRecord.mom[2]);
+
+		if(rRecord.frozen)
+			pBead->SetFrozen();
+	}
+
+	for(cAbstractBeadVectorIterator iterWall=riState.GetWallBeads().begin(); iterWall!=riState.GetWallBeads().end(); iterWall++, i++)
+	{
+		CAbstractBead* const pBead = *iterWall;
+		const BeadRecord& rRecord  = vRecords[i];
+
+		pBead->SetXPos(rRecord.pos[0]);
+		pBead->SetYPos(rRecord.pos[1]);
+		pBead->SetZPos(rRecord.pos[2]);
+		pBead->SetunPBCXPos(rRecord.unPBCPos[0]);
+		pBead->SetunPBCYPos(rRecord.unPBCPos[1]);
+		pBead->SetunPBCZPos(rRecord.unPBCPos[2]);
+		pBead->SetInitialXPos(rRecord.initialPos[0]);
+		pBead->SetInitialYPos(rRecord.initialPos[1]);
+		pBead->SetInitialZPos(rRecord.initialPos[2]);
+		pBead->SetXMom(rRecord.mom[0]);
+		pBead->SetYMom(rRecord.mom[1]);
+		pBead->SetZMom(rRecord.mom[2]);
+	}
+
+	CCNTCell::SetRNGState(header.rngState);
+
+	return true;
+}
+
+// Function to write the assembled state to the cache. The data are written 
+// to a temporary file that is renamed when complete, so that concurrent jobs 
+// sharing the cache directory never read a partially-written file.
+
+bool CInitialStateCache::Write(const CInitialState& riState) const
+{
+	if(!m_bKeyValid)
+		return false;
+
+	FileHeader header;
+	std::memcpy(header.magic, m_Magic, sizeof(header.magic));
+	header.key           = m_Key;
+	header.beadTotal     = riState.GetBeads().size();
+	header.wallBeadTotal = riState.GetWallBeads().size();
+	header.rngState      = CCNTCell::GetRNGState();
+
+	std::vector<BeadRecord> vRecords;
+	vRecords.reserve(header.beadTotal + header.wallBeadTotal);
+
+	for(cBeadVectorIterator iterBead=riState.GetBeads().begin(); iterBead!=riState.GetBeads().end(); iterBead++)
+	{
+		BeadRecord record;
+		record.pos[0]        = (*iterBead)->GetXPos();
+		record.pos[1]        = (*iterBead)->GetYPos();
+		record.pos[2]        = (*iterBead)->GetZPos();
+		record.unPBCPos[0]   = (*iterBead)->GetunPBCXPos();
+		record.unPBCPos[1]   = (*iterBead)->GetunPBCYPos();
+		record.unPBCPos[2]   = (*iterBead)->GetunPBCZPos();
+		record.initialPos[0] = (*iterBead)->GetInitialXPos();
+		record.initialPos[1] = (*iterBead)->GetInitialYPos();
+		record.initialPos[2] = (*iterBead)->GetInitialZPos();
+		record.mom[0]        = (*iterBead)->GetXMom();
+		record.mom[1]        = (*iterBead)->GetYMom();
+		record.mom[2]        = (*iterBead)->GetZMom();
+		record.frozen        = (*iterBead)->GetFrozen() ? 1 : 0;
+
+		vRecords.push_back(record);
+	}
+
+	for(cAbstractBeadVectorIterator iterWall=riState.GetWallBeads().begin(); iterWall!=riState.GetWallBeads().end(); iterWall++)
+	{
+		BeadRecord record;
+		record.pos[0]        = (*iterWall)->GetXPos();
+		record.pos[1]        = (*iterWall)->GetYPos();
+		record.pos[2]        = (*iterWall)->GetZPos();
+		record.unPBCPos[0]   = (*iterWall)->GetunPBCXPos();
+		record.unPBCPos[1]   = (*iterWall)->GetunPBCYPos();
+		record.unPBCPos[2]   = (*iterWall)->GetunPBCZPos();
+		record.initialPos[0] = (*iterWall)->GetInitialXPos();
+		record.initialPos[1] = (*iterWall)->GetInitialYPos();
+		record.initialPos[2] = (*iterWall)->GetInitialZPos();
+		record.mom[0]        = (*iterWall)->GetXMom();
+		record.mom[1]        = (*iterWall)->GetYMom();
+		record.mom[2]        = (*iterWall)->GetZMom();
+		record.frozen        = 0;
+
+		vRecords.push_back(record);
+	}
+
+	const zString tempName = m_FileName + ".tmp." + m_RunId;
+
+	zOutFileStream outStream(tempName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+	outStream.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+
+	if(!vRecords.empty())
+	{
+		outStream.write(reinterpret_cast<const char*>(&vRecords[0]), vRecords.size()*sizeof(BeadRecord));
+	}
+
+	outStream.close();
+
+	if(outStream.fail() || std::rename(tempName.c_str(), m_FileName.c_str()) != 0)
+	{
+		std::remove(tempName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+// Private function to calculate the cache key from the control data file.
+// The tokens are read in the same order as CInputDPDFile reads them: the 
+// simulation type, the quoted title, the date and the quoted comment precede 
+// the State section. All tokens from State up to Lambda are hashed, except 
+// the cache directory, which does not affect the state, and the number of 
+// assembly threads, because the state assembled with per-polymer random 
+// number streams does not depend on it. Whether the AssemblyThreads token is
+// present does matter, as it selects those streams instead of the serial 
+// random number sequence, so a flag recording it is hashed after the tokens.
+// The dimension of the simulation is hashed as well.
+
+bool CInitialStateCache::HashControlData(const zString cdfName)
+{
+	zInFileStream inStream(cdfName.c_str());
+
+	if(!inStream.is_open())
+		return false;
+
+	zString token;
+
+	inStream >> token;		// Simulation type
+	inStream >> token;
+	if(!inStream.good() || token != "Title")
+		return false;
+
+	inStream >> token;
+	if(token != "\"")
+		return false;
+
+	do
+	{
+		inStream >> token;
+	} while(inStream.good() && token != "\"");
+
+	inStream >> token >> token;		// Date and its value
+	inStream >> token;
+	if(!inStream.good() || token != "Comment")
+		return false;
+
+	inStream >> token;
+	if(token != "\"")
+		return false;
+
+	do
+	{
+		inStream >> token;
+	} while(inStream.good() && token != "\"");
+
+	inStream >> token;
+	if(!inStream.good() || token != "State")
+		return false;
+
+	m_Key = HashString(fnvOffsetBasis, "SimDimension " + ToString(static_cast<long>(SimDimension)));
+
+	bool bStreams = false;
+
+	while(inStream.good() && token != "Lambda")
+	{
+		if(token == "StateCache")
+		{
+			inStream >> token;
+		}
+		else if(token == "AssemblyThreads")
+		{
+			bStreams = true;
+			inStream >> token;
+		}
+		else
+		{
+			m_Key = HashString(m_Key, token);
+		}
+
+		inStream >> token;
+	}
+
+	m_Key = HashString(m_Key, bStreams ? "AssemblyStreams" : "AssemblySerial");
+
+	return token == "Lambda";
+}
@@ -0,0 +1,86 @@
+// InitialStateCache.h: interface for the CInitialStateCache class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_INITIALSTATECACHE_H__3C6A9A55_CB34_43D9_896B_E41CDE1F264C__INCLUDED_)
+#define AFX_INITIALSTATECACHE_H__3C6A9A55_CB34_43D9_896B_E41CDE1F264C__INCLUDED_
+
+
+// Forward declarations
+
+class CInitialState;
+
+
+#include "xxBase.h"
+
+#include <stdint.h>
+
+class CInitialStateCache : public xxBase
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CInitialStateCache(const zString directory, const zString runId);
+
+	virtual ~CInitialStateCache();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	// Layout of a cache file: FileHeader followed by one BeadRecord for each
+	// bead in the initial state's bead container and then one for each wall 
+	// bead. Values are written in the byte order of the machine that 
+	// assembled the state.
+
+	struct FileHeader
+	{
+		char     magic[8];
+		uint64_t key;				// Hash of the control data that define the state
+		int64_t  beadTotal;
+		int64_t  wallBeadTotal;
+		uint64_t rngState;			// RNG state after the state was assembled
+	};
+
+	struct BeadRecord
+	{
+		double  pos[3];
+		double  unPBCPos[3];
+		double  initialPos[3];
+		double  mom[3];
+		int64_t frozen;
+	};
+
+private:
+
+	static const char* const m_Magic;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline bool			 IsKeyValid()  const {return m_bKeyValid;}
+	inline const zString GetFileName() const {return m_FileName;}
+
+	bool Read(CInitialState& riState) const;
+	bool Write(const CInitialState& riState) const;
+
+	// ****************************************
+	// Private functions
+private:
+
+	bool HashControlData(const zString cdfName);
+
+	// ****************************************
+	// Data members
+private:
+
+	const zString m_RunId;
+	uint64_t      m_Key;			// Hash of the initial-state sections of the control data file
+	bool          m_bKeyValid;
+	zString       m_FileName;		// Cache file for the current key
+
+};
+
+#endif // !defined(AFX_INITIALSTATECACHE_H__3C6A9A55_CB34_43D9_896B_E41CDE1F264C__INCLUDED_)
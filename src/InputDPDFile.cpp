@@ -52,6 +52,12 @@ CInputDPDFile::CInputDPDFile(zString iFileName, bool IOFlag,
 															  pISD(NULL),
 															  pGD(NULL),
 															  pWD(NULL),
+															  Integrator("GrootWarren"),
+															  StateCache(""),
+															  CollisionRate(0.0),
+															  AssemblyThreadNo(0),
+															  RESPASubstepNo(1),
+															  SnapshotPrecision(0.001),
 															  m_rISD(rISD),
 															  m_pISO(NULL)
 													
@@ -289,7 +295,22 @@ bool CInputDPDFile::Serialize()
 		m_outStream << "Density		" << AverageBeadDensity << zEndl;
 		m_outStream << "Temp		" << kT					<< zEndl;
 		m_outStream << "RNGSeed		" << RNGSeed			<< zEndl;
+
+		if(AssemblyThreadNo > 0)
+			m_outStream << "AssemblyThreads	" << AssemblyThreadNo << zEndl;
+		if(!StateCache.empty())
+			m_outStream << "StateCache	" << StateCache << zEndl;
+
 		m_outStream << "Lambda		" << Lambda				<< zEndl;
+
+		if(Integrator == "LoweAndersen")
+			m_outStream << "Integrator	" << Integrator << " " << CollisionRate << zEndl;
+		else if(Integrator != "GrootWarren")
+			m_outStream << "Integrator	" << Integrator << zEndl;
+
+		if(RESPASubstepNo > 1)
+			m_outStream << "RESPA		" << RESPASubstepNo << zEndl;
+
 		m_outStream << "Step		" << StepSize			<< zEndl;
 		m_outStream << "Time		" << TotalTime			<< zEndl;
 
@@ -297,6 +318,10 @@ bool CInputDPDFile::Serialize()
 		m_outStream << "AnalysisPeriod		" << AnalysisPeriod << zEndl;
 		m_outStream << "DensityPeriod		" << DensityPeriod  << zEndl;
 		m_outStream << "DisplayPeriod		" << DisplayPeriod  << zEndl;
+
+		if(SnapshotPrecision != 0.001)
+			m_outStream << "SnapshotPrecision	" << SnapshotPrecision << zEndl;
+
 		m_outStream << "RestartPeriod		" << RestartPeriod  << zEndl;
 		m_outStream << "Grid		" << GridXCellNo	<< " " << GridYCellNo	<< " " << GridZCellNo << zEndl;
 
@@ -731,7 +756,34 @@ bool CInputDPDFile::Serialize()
 				return IOError("Error reading RNG seed");
 		}
 
+		// The number of threads used to assemble the initial state and the
+		// directory used to cache assembled states are optional. If the 
+		// thread number is given, even as 1, beads are placed using random 
+		// number streams belonging to each polymer so that the initial state
+		// does not depend on the number of threads.
+
+		AssemblyThreadNo = 0;
+		StateCache       = "";
+
 		m_inStream >> token;
+		if(token == "AssemblyThreads")
+		{
+			m_inStream >> AssemblyThreadNo;
+			if(!m_inStream.good() || AssemblyThreadNo < 1)
+				return IOError("Error reading number of assembly threads");
+
+			m_inStream >> token;
+		}
+
+		if(token == "StateCache")
+		{
+			m_inStream >> StateCache;
+			if(!m_inStream.good() || StateCache.empty())
+				return IOError("Error reading initial state cache directory");
+
+			m_inStream >> token;
+		}
+
 		if(token != "Lambda")
 			return IOError("Error reading Lambda token");
 		else
@@ -741,7 +793,45 @@ bool CInputDPDFile::Serialize()
 				return IOError("Error reading lambda");
 		}
 
+		// The DPD thermostat integration scheme is optional and defaults to
+		// the modified velocity Verlet scheme controlled by Lambda. The 
+		// Lowe-Andersen thermostat also needs the bath collision frequency.
+
+		Integrator    = "GrootWarren";
+		CollisionRate = 0.0;
+
 		m_inStream >> token;			
+		if(token == "Integrator")
+		{
+			m_inStream >> Integrator;
+			if(!m_inStream.good() || (Integrator != "GrootWarren" && Integrator != "Shardlow" && Integrator != "LoweAndersen"))
+				return IOError("Error reading integrator name");
+
+			if(Integrator == "LoweAndersen")
+			{
+				m_inStream >> CollisionRate;
+				if(!m_inStream.good() || CollisionRate <= 0.0)
+					return IOError("Error reading Lowe-Andersen collision rate");
+			}
+
+			m_inStream >> token;
+		}
+
+		// The number of substeps used to integrate the polymer bond and bondpair
+		// forces is optional and defaults to one, so that all forces are 
+		// integrated with the same timestep.
+
+		RESPASubstepNo = 1;
+
+		if(token == "RESPA")
+		{
+			m_inStream >> RESPASubstepNo;
+			if(!m_inStream.good() || RESPASubstepNo < 1)
+				return IOError("Error reading number of RESPA substeps");
+
+			m_inStream >> token;
+		}
+
 		if(token != "Step")
 			return IOError("Error reading Step token");
 		else
@@ -749,6 +839,8 @@ bool CInputDPDFile::Serialize()
 			m_inStream >> StepSize;
 			if(!m_inStream.good() || StepSize < 0.000001)
 				return IOError("Error reading step size");
+			else if(CollisionRate*StepSize > 1.0)
+				return IOError("Error: Lowe-Andersen collision probability per step exceeds unity");
 		}
 
 		m_inStream >> token;
@@ -806,7 +898,21 @@ bool CInputDPDFile::Serialize()
 				return IOError("Error reading display period");
 		}
 
+		// The precision of the coordinates in compressed snapshots and 
+		// trajectories is optional and defaults to 0.001.
+
+		SnapshotPrecision = 0.001;
+
 		m_inStream >> token;
+		if(token == "SnapshotPrecision")
+		{
+			m_inStream >> SnapshotPrecision;
+			if(!m_inStream.good() || SnapshotPrecision <= 0.0)
+				return IOError("Error reading snapshot precision");
+
+			m_inStream >> token;
+		}
+
 		if(token != "RestartPeriod")
 			return IOError("Error reading RestartPeriod token");
 		else
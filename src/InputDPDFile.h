@@ -54,6 +54,8 @@ public:
 	zString Title;
 	zString Date;
 	zString Comment;
+	zString Integrator;		// Optional DPD thermostat integration scheme
+	zString StateCache;		// Optional directory holding assembled initial states
 
 // Types of bead, bond and polymer used to construct the CBead, etc, representations
 // needed to copy-construct the many copies of beads, bonds and polymers used
@@ -70,6 +72,8 @@ public:
 	double AverageBeadDensity;
 	double kT;
 	double Lambda;
+	double CollisionRate;	// Lowe-Andersen thermostat only
+	double SnapshotPrecision;	// Optional precision of compressed snapshot coordinates
 	double StepSize;
 
     long ProcXNo;  // Number of processors to use in each dimension for parallel code
@@ -87,6 +91,8 @@ public:
 	long RestartPeriod;
 	long SamplePeriod;
 	long RNGSeed;
+	long AssemblyThreadNo;	// Optional number of threads assembling the initial state
+	long RESPASubstepNo;	// Optional number of substeps for the polymer bond forces
 	long TotalTime;
 
 // Local data used to wrap certain classes. These are not accessible by
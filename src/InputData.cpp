@@ -28,6 +28,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "GravityData.h"
 #include "WallData.h"
 #include "InputData.h"
+#include "PolymerShape.h"
 #include "Bead.h"
 #include "Bond.h"
 #include "BondPair.h"
@@ -141,6 +142,10 @@ CInputData::CInputData(const zString runid) : runId(runid),
                                               Title(""), Date(""), Comment(""),
                                               AverageBeadDensity(0.0),
                                               Lambda(0.0),
+                                              Integrator("GrootWarren"),
+                                              CollisionRate(0.0),
+                                              SnapshotPrecision(0.001),
+                                              StateCache(""),
                                               RCutOff(0.0),
                                               MCStepSize(0.0),
                                               kT(0.0),
@@ -164,8 +169,11 @@ CInputData::CInputData(const zString runid) : runId(runid),
                                               CNTZCellNo(0),
                                               CurrentTime(0),
                                               TotalMCTime(0),
+                                              MCThreadNo(0),
                                               TotalTime(0),
                                               RNGSeed(0),
+                                              AssemblyThreadNo(0),
+                                              RESPASubstepNo(1),
                                               GravityXForce(0.0),
                                               GravityYForce(0.0),
                                               GravityZForce(0.0),
@@ -673,46 +681,6 @@ bool CInputData::AddBondPairType(zString name1, zString name2, zString name3, do
 	return true;
 }
 
-// Function to check that that all the bead names that appear in a polymer
-// "shape" have been entered into the mBeadNames map. It assumes that
-// the shape has been checked for illegal characters using IsShapeValid().
-// It recursively checks that each element is not empty, is not an operator
-// and is not compound (has brackets around it) and is a member of the bead
-// names map.
-
-bool CInputData::AreAllBeadNamesValid( const zString shape ) const
-{
-	zString element = CAR(shape);
-
-	bool bValid;
-
-	if(shape == "" || shape == "()")				// empty
-		bValid = false;
-	else if(element == CInputData::branchChar ||	// branch operator or multiplier
-	 	  !(element.find_first_not_of(CInputData::validNumOpChars) < element.length()) )
-		bValid = AreAllBeadNamesValid(CDR(shape));
-	else if(element == CInputData::loopChar)		// loop operator		
-		bValid = AreAllBeadNamesValid(LAST(shape));
-	else if(RemoveBrackets(shape) != shape)			// compound element
-	{
-		if(CDR(shape) == "()")
-			bValid = AreAllBeadNamesValid(element);
-		else
-		{
-			if(AreAllBeadNamesValid(element) && AreAllBeadNamesValid(CDR(shape)))
-				bValid = true;
-			else
-				bValid = false;
-		}
-	}
-	else if(!IsBeadinMap(shape) )	// at this point we know we have a non-empty, 
-		bValid = false;				// non-operator, non-compound element so we can
-	else							// assume it is a bead name
-		bValid = true;	
-	
-	return bValid;
-}
-
 // Function to check that that a bead or polymer name is valid.
 // A valid name can consist only of an alphabetic character 
 // (either case) or a number (listed in the static constant CInputData::validNameChars)
@@ -730,285 +698,6 @@ bool CInputData::IsNameValid( const zString name ) const
 	return true;
 }
 
-// Function to check that the architecture specified for a polymer is valid.
-// A polymer "shape" is valid if it satisfies the conditions:
-//
-//  It is not empty
-//  The first character is "(" and the last is ")"
-//  It is not just opening and closing brackets around whitespace
-//  The number of left brackets equals the number of right brackets
-//  Left and right brackets occur in the correct order (left before right)
-//  Only numbers, letters and the key symbols "(", ")", "*", "/" " " occur in it
-//  (notice that the space " " must be included as an allowed char).
-//  The first element after the opening "(" is not an operator
-
-bool CInputData::IsShapeValid( const zString shape ) const
-{
-	if( shape.empty() )
-		return false;
-	else if( shape.find_first_not_of(CInputData::validChars) < shape.length() )
-		return false;
-	else if( (*shape.begin() != '(') || (*shape.rbegin() != ')') )
-		return false;
-	else
-	{
-		// check that there is at least one non-whitespace character between
-		// the brackets. We create iterators to the first character after the
-		// opening bracket and the last before the closing bracket
-
-		zString::const_iterator iterFirst = shape.begin();
-		iterFirst++;
-		zString::const_iterator iterLast  = shape.end();
-		iterLast--;
-
-		zString::const_iterator iterChar;
-
-		bool bValid = false;
-		for(iterChar = iterFirst; iterChar!=iterLast; iterChar++ )
-		{
-			if(*iterChar != ' ')
-				bValid = true;
-		}
-
-		if( !bValid )
-			return false;
-
-		// count the number of left and right brackets
-		// and make sure that they match. Note we exclude the first and
-		// last characters. The number of right brackets at any
-		// position in the shape must be less than or equal the number of 
-		// left brackets.
-
-		long leftbra  = 0;
-		long rightbra = 0;
-
-		bValid = true;
-		for(iterChar = iterFirst; iterChar!=iterLast; iterChar++ )
-		{
-			if(*iterChar == '(')
-			{			
-				leftbra++;
-			}
-			else if(*iterChar == ')')
-			{
-				rightbra++;
-				if( rightbra > leftbra )
-					bValid = false;
-			}
-		}
-
-		if( !bValid || leftbra != rightbra )
-			return false;
-	}
-	return true;
-}
-
-// Function to expand the multiplicative operator in an element of the
-// form: (nn token). It returns the sequence of bead names, or elements, 
-// resulting from it. Note that token might be a compound element. This function 
-// just concatenates "nn" of them, adds surrounding brackets to make them into 
-// a valid element again, and returns the result. Also note that 0 as the operator 
-// returns a space.
-
-zString CInputData::ExpandElement(zString op, zString token)
-{
-	zString newString;
-
-	int multi;
-	multi = atoi(op.c_str());
-
-	if(multi == 0)		// if multiplier is 0 return a space
-		newString = CInputData::spaceChar;
-	else if(multi == 1)
-		newString = token;
-	else
-	{
-		newString = token;
-		for(int j=1; j<multi; j++)
-		{
-			newString+= ' ';
-			newString+= token;
-		}		
-	}
-	newString = '(' + newString + ')';	// add back surrounding brackets
-
-	return newString;
-}
-
-// Function to return the head of "oldString". It is named after the
-// LISP CAR function.
-//
-// First it checks for surrounding brackets and if they are there it ignores them,
-// but if not it returns "oldString" as is.
-// Then it looks for either a second left bracket, indicating a substring with its
-// own brackets, or the first non-whitespace character, indicating a token, and 
-// when it finds it it stores the position of the character. It loops from 
-// this position forwards looking for the terminating character: either a right 
-// bracket if the left bracket was found, or a whitespace character OR another
-// left bracket if not.
-// Once it has the terminating character it returns the characters between the
-// first and last positions. Note that if the whitespace is the terminating 
-// character then it is not included, but if the right bracket is the terminator 
-// it is included.
-//
-// Examples
-//
-// CAR( "(A B C)" )		= A
-// CAR( "(  A B C)" )		= A
-// CAR( "((A) B C)" )		= (A)
-// CAR( "(  (A) B C)" )		= (A)
-// CAR( "((2 A) B C)" )		= (2 A)
-// CAR( "( (2 A) B C)" )	= (2 A)
-// CAR( "( (A2) B C)" )		= (A2)  NB A2 is a valid token name but 2A is not
-// CAR( "( A (* (A B) ) B )"    = A
-
-
-
-
-zString CInputData::CAR(const zString oldString) const
-{
-	if(!IsShapeValid(oldString))		// check shape is valid first
-		return oldString;
-	
-	char endChar =' ';
-
-	zString::const_iterator iterFirst= oldString.begin();
-	iterFirst++;									// ignore opening bracket
-	zString::const_iterator iterLast = oldString.end();
-	iterLast--;										// ignore closing bracket
-
-	zString::const_iterator iterChar = iterFirst;
-
-	bool bFound = false;
-	while(!bFound && iterChar != iterLast)
-	{
-		if(*iterChar == ' ')
-		{
-			iterChar++;
-		}
-		else if(*iterChar == '(')
-		{
-			bFound = true;
-			endChar = ')';	// terminating character is right bracket
-		}
-		else
-		{
-			bFound = true;		// first alphanumeric character found
-			endChar = ' ';		// terminating character is a space
-		}
-	}
-
-	if( !bFound)
-		return oldString;	// return the empty zString
-
-	// now we have the ending condition and the first character find the 
-	// end of the first element in the whole zString and return it. But make
-	// sure that we match the number of left and right brackets if ")" is the
-	// terminating character.
-
-	int leftBrackets = 0;
-	bFound = false;
-	zString head = "";
-
-	while(!bFound && iterChar != iterLast)
-	{
-		if(endChar == ')')
-		{
-			if(*iterChar == endChar)
-			{
-				leftBrackets--;
-				if(leftBrackets == 0)
-					bFound = true;
-				head+= *iterChar;			// include endChar
-				iterChar++;
-			}
-			else							// include spaces
-			{
-				if(*iterChar == '(')		// count left brackets to find matching
-					leftBrackets++;			// right bracket to end element
-				head+= *iterChar;
-				iterChar++;
-			}
-		}
-		else if( endChar == ' ')
-		{
-			if(*iterChar == endChar || *iterChar == '(')
-				bFound = true;			// don't include spaces
-			else
-			{
-				head+= *iterChar;
-				iterChar++;
-			}
-		}
-	}
-
-// If bFound is still false this means that there were no spaces after the 
-// characters before the end. This is not an error.
-
-	return head;
-}
-
-// Function to return a zString with its head removed. It is named after
-// the LISP CDR function. See the CAR function for the definition of the "head".
-//
-// If there is only one element in the zString then we return the empty zString.
-// This complements CAR which would return the single element as the head.
-// Because we call IsShapeValid() we know that the zString is not empty and
-// has at least one non-whitespace character between the opening and closing
-// brackets. Hence, it has at least a head or a head and a tail. We only have
-// to check if there is a head and a tail.
-
-zString CInputData::CDR(const zString oldString) const
-{
-	if(!IsShapeValid(oldString))		// check zString is valid first
-		return oldString;
-	
-	zString head = CAR(oldString);
-	zString tail	= oldString;
-	long startPos;
-
-	startPos = oldString.find(head);
-	startPos+= head.length();
-
-	tail = '(' + tail.erase(0,startPos);	// add opening bracket back
-
-	if( !IsShapeValid(tail))
-		return "()";
-
-// The Modena string class does not have the erase() member function nor an
-// iterator: we have to use remove() to remove the leading white space.
-
-
-	zStringIterator iterChar=tail.begin();	// remove leading whitespace
-	iterChar++;
-	while(*iterChar == ' ')
-	{
-		tail.erase(iterChar);
-	}
-
-
-	return tail;
-}
-
-// Function to strip the bounding brackets off a zString if they exist.
-// If not it returns the zString unchanged. Note that we do not remove
-// whitespace.
-
-zString CInputData::RemoveBrackets(zString oldString) const
-{
-	if( (*oldString.begin() != '(') || (*oldString.rbegin() != ')') )
-		return oldString;
-	else
-	{
-		oldString.erase(oldString.begin());
-		zStringIterator iterLast = oldString.end();
-		iterLast--;
-		oldString.erase(iterLast);
-	}
-
-	return oldString;
-}
-
 // First overloaded function to construct a polymer type out of a shape.
 //
 // This version assigns the head and tail beads by default to the first and last
@@ -1027,66 +716,34 @@ zString CInputData::RemoveBrackets(zString oldString) const
 
 bool CInputData::AddPolymerType(zString name, zString shape, double fraction)
 {
-	if( !IsNameValid(name)			 || !IsShapeValid(shape) ||
-		!IsNameValid(FIRST(shape))	 || 
-	    (LAST(shape) != "" && !IsNameValid(LAST(shape)))  ||
-		!AreAllBeadNamesValid(shape) ||
-		!IsElementValid(shape)       ||  (fraction < 0.0) || (fraction > 1.0) )
+	// Compile the shape once: this checks its grammar and bead names, and
+	// produces the instructions that are used below to create the beads and bonds.
+
+	const CPolymerShape polymerShape(shape, mBeadNames);
+
+	if( !IsNameValid(name)			 || !polymerShape.IsValid() ||
+		!polymerShape.HasBeadEnds()  || (fraction < 0.0) || (fraction > 1.0) )
 		return false;
 	else if(mPolymerNames.find(name) != mPolymerNames.end())
 		return false;
 	else
 	{
-		// Move through the elements in the shape, starting at the first,
-		// adding beads and bonds. If an element is a simple bead name 
-		// we add it to the polymer's vector of beads (creating a bond 
-		// to attach it to the current bead if it is not the first bead), 
-		// if it is a compound element we call
-		// functions recursively to deal with each element in the compound.
-		// They all end up by calling the AddBeadtoPolymer function.
-		// For each polymer type we check to see if any CBondPair objects are
-		// needed to account for stiff bonds (3-body forces between triplets of
+		// Execute the instructions compiled from the shape, starting at the first
+		// bead, adding beads and bonds. Each bead is added to the polymer's vector
+		// of beads, with a bond to attach it to the current bead if it is not the
+		// first bead. For each polymer type we check to see if any CBondPair objects
+		// are needed to account for stiff bonds (3-body forces between triplets of
 		// beads connected by two adjacent bonds) and add them to the polymer
-		// if so.
+		// if so. The flag bLinear is used to indicate if the polymer has any side
+		// branches or loops.
 
 		BeadVector vNewBeads;
 		BondVector vNewBonds;
 		BondPairVector vNewBondPairs;
 
-		// Note that current_element is not used in AddBeadtoPolymer() if we are
-		// processing the first bead, and it is initialised if we are not.
-		// Also the first bead must be a simple bead name in this version
-		// of AddPolymerType(). The flag bLinear is used to indicate if the 
-		// polymer has any side branches or not.
-
-		zString current_element; 
-		zString next_element; 
+		const bool bLinear = polymerShape.IsLinear();
 
-		long currentBeadIndex = -1;
-		bool bLinear = true;
-		zString tail = shape;
-
-		while(tail != "()")
-		{
-			next_element = CAR(tail);
-
-			// if next_element is a bead's name then add it directly to the polymer, 
-			// otherwise parse the element looking for brackets or an operator at its 
-			// head. The currentBeadIndex keeps track of which bead the next bond will
-			// be added to. Because of side branches and loops this is not necessarily
-			// the last bead that was added. We indicate whether to move the current bead
-			// index by the last argument
-			
-			if(IsNameValid(next_element))
-			{
-				current_element = AddBeadtoPolymer(vNewBeads, vNewBonds, current_element, next_element, &currentBeadIndex, true);
-			}
-			else	// we have a compound element so parse it recursively
-			{
-				current_element = ParseElement(bLinear, vNewBeads, vNewBonds, current_element, next_element, &currentBeadIndex, true);
-			}
-			tail = CDR(tail);
-		}
+		BuildPolymer(polymerShape, vNewBeads, vNewBonds);
 
 		// The new polymer type has been defined so create a new type and add 
 		// it to the vector of polymer types passing the bead, and bondpair vectors, 
@@ -1106,62 +763,9 @@ bool CInputData::AddPolymerType(zString name, zString shape, double fraction)
 
 		// ****************************************
 		// Add CBondPair objects to the polymer if it has the 3-body bond force.
-		// We search through the bonds in the polymer looking for ones that connect
-		// three beads whose names match any of the CBondPair types specified for
-		// the simulation. If one if found we create a CBondPair object and add it
-		// to the polymer for later use in CInitialState::CreatePolymers().
-
-		long type1, type2, type3, bpType;
-		zString firstName, secondName, thirdName;
 
-		long firstBondIndex  = 0;
-		for(BondVectorIterator iterBond=vNewBonds.begin(); iterBond!=vNewBonds.end(); iterBond++)
-		{
-			type1 = (*iterBond)->GetHead()->GetType();
-			type2 = (*iterBond)->GetTail()->GetType();
-
-			firstName  = (*mBeadTypes.find(type1)).second;
-			secondName = (*mBeadTypes.find(type2)).second;
-
-			// Find all bonds that have the currentIndex as their head index.
-			// For each one concatenate the bead names from the first, second and
-			// third beads: if this triplet exists in the mBondNames map it indicates
-			// that the triplet represents a stiff bond so create a CBondPair object 
-			// using the template  accessed via the name and associated type.
-			//
-			// Note that the order of storing the two bonds in the bondpair object
-			// is opposite to the order in which they are encountered in the polymer
-			// shape. This is necessary because the bonds' head and tail beads are
-			// stored in the order they are added to the polymer, and the direction
-			// of the bonds is thus from the tail of the bond added last to the head 
-			// of that added before. We calculate the 3-body forces given that the 
-			// bond vectors are pointing from the tail of a bond to its head. This
-			// requires that we use the three beads defining the two bonds in the
-			// reverse order to their occurrence in the polymer shape.
-
-			long secondBondIndex = 0;
-			for(BondVectorIterator iterBond2=vNewBonds.begin(); iterBond2!=vNewBonds.end(); iterBond2++)
-			{
-				if( (*iterBond2)->GetHeadIndex() == (*iterBond)->GetTailIndex())
-				{
-					type3 = (*iterBond2)->GetTail()->GetType();
-					thirdName = (*mBeadTypes.find(type3)).second;
+		AddBondPairstoPolymer(vNewBeads, vNewBonds, vNewBondPairs);
 
-					if(mBondPairNames.find(firstName+secondName+thirdName) != mBondPairNames.end())
-					{
-						bpType = (*mBondPairNames.find(firstName+secondName+thirdName)).second;
-
-						CBondPair* pBP = new CBondPair(*vBondPairTypes.at(bpType));
-						pBP->SetBondIndex(secondBondIndex, firstBondIndex);
-						pBP->SetBonds(*iterBond2, *iterBond);
-
-						vNewBondPairs.push_back(pBP);
-					}
-				}
-				secondBondIndex++;
-			}
-			firstBondIndex++;
-		}
 		// ****************************************
 		// Add the new polymer to the vector of polymer types initialising its integer
 		// type, linearity, number fraction, head, tail and bead and bond vectors.
@@ -1200,68 +804,36 @@ bool CInputData::AddPolymerType(zString name, zString shape, double fraction)
 
 bool CInputData::AddPolymerType(zString name, zString shape, double fraction, zString headBead, zString tailBead)
 {
-	if( !IsNameValid(name)	|| !IsShapeValid(shape) ||
-		!(IsBeadUniqueInPolymer(headBead,shape))	|| 
-		!(IsBeadUniqueInPolymer(tailBead,shape))	||
-		(headBead == tailBead)       ||
-		!AreAllBeadNamesValid(shape) ||  
-		!IsElementValid(shape)       ||(fraction < 0.0) || (fraction > 1.0) )
+	// Compile the shape once: this checks its grammar and bead names, and
+	// produces the instructions that are used below to create the beads and bonds.
+
+	const CPolymerShape polymerShape(shape, mBeadNames);
+
+	if( !IsNameValid(name)	|| !polymerShape.IsValid() ||
+		polymerShape.GetBeadNameCount(headBead) != 1	|| 
+		polymerShape.GetBeadNameCount(tailBead) != 1	||
+		(headBead == tailBead)       || (fraction < 0.0) || (fraction > 1.0) )
 		return false;
 	else if(mPolymerNames.find(name) != mPolymerNames.end())
 		return false;
 	else
 	{
-		// Move through the elements in the shape, starting at the first,
-		// adding beads and bonds. If an element is a simple bead name 
-		// we add it to the polymer's vector of beads (creating a bond 
-		// to attach it to the current bead if it is not the first bead), 
-		// if it is a compound element we call
-		// functions recursively to deal with each element in the compound.
-		// They all end up by calling the AddBeadtoPolymer function.
-		// For each polymer type we check to see if any CBondPair objects are
-		// needed to account for stiff bonds (3-body forces between triplets of
+		// Execute the instructions compiled from the shape, starting at the first
+		// bead, adding beads and bonds. Each bead is added to the polymer's vector
+		// of beads, with a bond to attach it to the current bead if it is not the
+		// first bead. For each polymer type we check to see if any CBondPair objects
+		// are needed to account for stiff bonds (3-body forces between triplets of
 		// beads connected by two adjacent bonds) and add them to the polymer
-		// if so.
+		// if so. The flag bLinear is used to indicate if the polymer has any side
+		// branches or loops.
 
 		BeadVector vNewBeads;
 		BondVector vNewBonds;
 		BondPairVector vNewBondPairs;
 
-		// Note that current_element is not used in AddBeadtoPolymer() if we are
-		// processing the first bead, and it is initialised if we are not.
-		// Also the first bead must be a simple bead name in this version
-		// of AddPolymerType(). The flag bLinear is used to indicate if the 
-		// polymer has any side branches or not.
-
-		zString current_element; 
-		zString next_element; 
-
-		long currentBeadIndex = -1;
-		bool bLinear = true;
+		const bool bLinear = polymerShape.IsLinear();
 
-		zString tail = shape;
-
-		while(tail != "()")
-		{
-			next_element = CAR(tail);
-
-			// if next_element is a bead's name then add it directly to the polymer, 
-			// otherwise parse the element looking for brackets or an operator at its 
-			// head. The currentBeadIndex keeps track of which bead the next bond will
-			// be added to. Because of side branches and loops this is not necessarily
-			// the last bead that was added. We indicate whether to increment the current
-			// bead index using the last argument.
-			
-			if(IsNameValid(next_element))
-			{
-				current_element = AddBeadtoPolymer(vNewBeads, vNewBonds, current_element, next_element, &currentBeadIndex, true);
-			}
-			else	// we have a compound element so parse it recursively
-			{
-				current_element = ParseElement(bLinear, vNewBeads, vNewBonds, current_element, next_element, &currentBeadIndex, true);
-			}
-			tail = CDR(tail);
-		}
+		BuildPolymer(polymerShape, vNewBeads, vNewBonds);
 
 		// The new polymer type has been defined so create a new type and add 
 		// it to the vector of polymer types passing the bead and bond lists 
@@ -1298,62 +870,9 @@ bool CInputData::AddPolymerType(zString name, zString shape, double fraction, zS
 
 		// ****************************************
 		// Add CBondPair objects to the polymer if it has the 3-body bond force.
-		// We search through the bonds in the polymer looking for ones that connect
-		// three beads whose names match any of the CBondPair types specified for
-		// the simulation. If one if found we create a CBondPair object and add it
-		// to the polymer for later use in CInitialState::CreatePolymers().
-		//
-		// Note that the order of storing the two bonds in the bondpair object
-		// is opposite to the order in which they are encountered in the polymer
-		// shape. This is necessary because the bonds' head and tail beads are
-		// stored in the order they are added to the polymer, and the direction
-		// of the bonds is thus from the tail of the bond added last to the head 
-		// of that added before. We calculate the 3-body forces given that the 
-		// bond vectors are pointing from the tail of a bond to its head. This
-		// requires that we use the three beads defining the two bonds in the
-		// reverse order to their occurrence in the polymer shape.
-
-		long type1, type2, type3, bpType;
-		zString firstName, secondName, thirdName;
-
-		long firstBondIndex  = 0;
-		for(BondVectorIterator iterBond=vNewBonds.begin(); iterBond!=vNewBonds.end(); iterBond++)
-		{
-			type1 = (*iterBond)->GetHead()->GetType();
-			type2 = (*iterBond)->GetTail()->GetType();
-
-			firstName  = (*mBeadTypes.find(type1)).second;
-			secondName = (*mBeadTypes.find(type2)).second;
-
-			// Find all bonds that have the currentIndex as their head index.
-			// For each one concatenate the bead names from the first, second and
-			// third beads: if this triplet exists in the mBondNames map it indicates
-			// that the triplet represents a stif bond so create a CBondPair object 
-			// using the template  accessed via the name and associated type.
-
-			long secondBondIndex = 0;
-			for(BondVectorIterator iterBond2=vNewBonds.begin(); iterBond2!=vNewBonds.end(); iterBond2++)
-			{
-				if( (*iterBond2)->GetHeadIndex() == (*iterBond)->GetTailIndex())
-				{
-					type3 = (*iterBond2)->GetTail()->GetType();
-					thirdName = (*mBeadTypes.find(type3)).second;
-
-					if(mBondPairNames.find(firstName+secondName+thirdName) != mBondPairNames.end())
-					{
-						bpType = (*mBondPairNames.find(firstName+secondName+thirdName)).second;
 
-						CBondPair* pBP = new CBondPair(*vBondPairTypes.at(bpType));
-						pBP->SetBondIndex(secondBondIndex, firstBondIndex);
-						pBP->SetBonds(*iterBond2, *iterBond);
+		AddBondPairstoPolymer(vNewBeads, vNewBonds, vNewBondPairs);
 
-						vNewBondPairs.push_back(pBP);
-					}
-				}
-				secondBondIndex++;
-			}
-			firstBondIndex++;
-		}
 		// ****************************************
 		// Add the new polymer to the vector of polymer types initialising its integer
 		// type, linearity, number fraction, head, tail and bead and bond vectors.
@@ -1452,14 +971,14 @@ bool CInputData::IsBondPairinMap(const zString name) const
 // that is already used to point to the current bead).
 //
 // The current bead represents the local backbone of the polymer and is
-// used recusively within AddPolymerType() to grow the side branches and 
+// used by BuildPolymer() to grow the side branches and 
 // loops as well as the backbone itself. The bonds hold the indices into the 
 // vNewBeads array of the beads at their head and tail. This is used when copying
 // a polymer template into the actual polymers used in the simulation.
 //
 // If the vector of beads is empty this means we are starting the polymer at
 // its head so there is no current_beadname and currentBeadIndex is -1. But these
-// are not used when the first bead is added and are updated in ParseElement()
+// are not used when the first bead is added and are updated in BuildPolymer()
 // before the second bead and a bond are added.
 //
 // Note that we pass the vectors of beads and bonds in by reference to allow
@@ -1512,34 +1031,6 @@ zString CInputData::AddBeadtoPolymer(BeadVector& vNewBeads, BondVector& vNewBond
 	return next_beadname;
 }
 
-// Function to return the last element in the shape. We remove
-// any spaces at the beginning and end of the element so that simple bead names
-// do not appear to have spaces in them even if they were surrounded by spaces
-// in the polymer shape.
-
-zString CInputData::LAST(const zString shape) const
-{
-	zString tail = CDR(shape); 
-	zString previous_tail = tail;
-
-	while(tail != "()")
-	{
-		previous_tail = tail;
-		tail = CDR(tail);
-	}
-	previous_tail = RemoveBrackets(previous_tail);
-	previous_tail = RemoveSpaces(previous_tail);											// strip whitespace off
-	return previous_tail;
-}
-
-// Synonym for CAR(shape). It returns the first element in the polymer shape.
-// It is added just for symmetry with LAST()
-
-zString CInputData::FIRST(const zString shape) const
-{
-	return CAR(shape);
-}
-
 long CInputData::GetSamplePeriod() const
 {
 	return SamplePeriod;
@@ -1644,6 +1135,50 @@ double CInputData::GetLambda() const
 	return Lambda;
 }
 
+// DPD functions to get the scheme used to integrate the dissipative and random
+// forces and the bath collision frequency used by the Lowe-Andersen thermostat.
+
+const zString CInputData::GetIntegrator() const
+{
+	return Integrator;
+}
+
+double CInputData::GetCollisionRate() const
+{
+	return CollisionRate;
+}
+
+// DPD function to get the number of substeps used to integrate the polymer 
+// bond and bondpair forces in each timestep. One means that RESPA is off.
+
+long CInputData::GetRESPASubstepNo() const
+{
+	return RESPASubstepNo;
+}
+
+// Function to get the spacing of the grid to which bead coordinates are 
+// quantised in compressed snapshots and trajectories.
+
+double CInputData::GetSnapshotPrecision() const
+{
+	return SnapshotPrecision;
+}
+
+// Functions to get the number of threads used to assemble the initial state
+// and the directory in which assembled initial states are cached. A thread 
+// number of zero selects the original serial assembly, and an empty directory
+// name disables the cache.
+
+long CInputData::GetAssemblyThreadNo() const
+{
+	return AssemblyThreadNo;
+}
+
+const zString CInputData::GetStateCache() const
+{
+	return StateCache;
+}
+
 // MD function to return the cut-off radius of all potentials
 
 double CInputData::GetCutOffRadius() const
@@ -1694,102 +1229,110 @@ double CInputData::GetSimSpaceZLength() const
 {
     return static_cast<double>(GetProcessorsZNo())*GetSimBoxZLength();
 }
-
-// Function to analyse the structure of an element and expand its tokens
-// to allow the beads to be added to the growing polymer. Each bead is added
-// using the AddBeadtoPolymer() function.
+// Function to create the beads and bonds of a polymer type by executing the
+// instructions that CPolymerShape has compiled from its shape. Each bead is 
+// added using the AddBeadtoPolymer() function, so the polymer is built in
+// time proportional to its number of beads without re-parsing the shape.
 //
-// Note that this function assumes that only valid bead names and operators 
-// appear in the element, and that all bead names are in the beadnames map, 
-// so it must be called after an application of AreAllBeadNamesValid().
+// The currentBeadIndex keeps track of which bead the next bond will be added
+// to. Because of side branches and loops this is not necessarily the last bead
+// that was added. Each multiplier or side branch that has been entered but not
+// completed has a frame on a stack: multipliers store the number of repeats
+// remaining, and branches store the bead at which the polymer continues to 
+// grow when the branch is complete.
 //
-// We indicate whether to move the current bead index with the bIncrementBeadIndex flag.
-// If this is true, it shows that the polymer backbone will grow with the addition of a 
-// bead or sequence of beads, but if it is false, then a sidebranch is added that does not
-// reposition the place where the next bead will be added.
+// Note that this function assumes the shape is valid, so it must only be 
+// called if CPolymerShape::IsValid() returns true.
 
-zString CInputData::ParseElement(bool& bLinear, BeadVector& vNewBeads, BondVector& vNewBonds, zString current_beadname, zString element, long* pCurrentBeadIndex, bool bIncrementBeadIndex)
+void CInputData::BuildPolymer(const CPolymerShape& polymerShape, BeadVector& vNewBeads, BondVector& vNewBonds)
 {
-	zString head = CAR(element);
-	zString tail = CDR(element);
-	zString token = RemoveBrackets(tail);
+	struct ShapeFrame
+	{
+		long    repeatsLeft;
+		long    beadIndex;
+		zString beadName;
+	};
 
-	zString dummy_beadname;	// used to avoid changing the current bead name
+	xxBasevector<ShapeFrame> vFrames;
 
-	if(!(head.find_first_not_of(CInputData::validNameChars) < head.length()) &&
-		(head.find_first_of(CInputData::validNumOpChars) != 0) )	// simple bead name
-	{		
-		current_beadname = AddBeadtoPolymer(vNewBeads, vNewBonds, current_beadname, head, pCurrentBeadIndex, bIncrementBeadIndex);
-		if(tail != "()")
-			current_beadname = ParseElement(bLinear, vNewBeads, vNewBonds, current_beadname, tail, pCurrentBeadIndex, bIncrementBeadIndex);
-	}
-	else if(!(head.find_first_not_of(CInputData::validNumOpChars) < head.length()))	// multiplier operator
-	{
-		tail = ExpandElement(head, token);
-		current_beadname = ParseElement(bLinear, vNewBeads, vNewBonds, current_beadname, tail, pCurrentBeadIndex, bIncrementBeadIndex);
-	}	
-	else if(head == CInputData::branchChar)			// side branch operator
-	{
-		bLinear = false;
-		if(IsNameValid(token))
-			dummy_beadname = AddBeadtoPolymer(vNewBeads, vNewBonds, current_beadname, token, pCurrentBeadIndex, false);
-		else
-		{
-			long NewCurrentBeadIndex;
+	const xxBasevector<CPolymerShape::Instruction>& vInstructions = polymerShape.GetInstructions();
 
-			NewCurrentBeadIndex = *pCurrentBeadIndex;
-			dummy_beadname = ParseElement(bLinear, vNewBeads, vNewBonds, current_beadname, tail, &NewCurrentBeadIndex, true);
+	zString currentBeadName;
+	long currentBeadIndex = -1;
 
-// Following line was an error
-//			dummy_beadname = ParseElement(bLinear, vNewBeads, vNewBonds, current_beadname, tail, pCurrentBeadIndex, false);
-		}
-	}
-	else if(head == CInputData::loopChar)		// loop operator
+	for(long pc=0; pc<static_cast<long>(vInstructions.size()); pc++)
 	{
-		bLinear = false;
-		zString loopId			= FIRST(tail);
-		zString targetBeadName	= LAST(tail);
-		int iLoopId				= atoi(loopId.c_str());	// convert string to a number
+		const CPolymerShape::Instruction& ins = vInstructions.at(pc);
 
-		// Unlike the branch operator we do move the current_beadname pointer when
-		// adding a loop target. This is because loop targets are just normal beads
-		// that can have extra bonds attached to them later.
+		if(ins.op == CPolymerShape::opBead)
+		{
+			currentBeadName = AddBeadtoPolymer(vNewBeads, vNewBonds, currentBeadName, ins.name, &currentBeadIndex, true);
+		}
+		else if(ins.op == CPolymerShape::opRepeat)
+		{
+			ShapeFrame frame = {ins.arg, 0, ""};
+			vFrames.push_back(frame);
+		}
+		else if(ins.op == CPolymerShape::opEndRepeat)
+		{
+			// Go back to the first instruction after the opRepeat if any
+			// repeats remain
 
-		if(IsNameValid(targetBeadName))
+			if(--vFrames.back().repeatsLeft > 0)
+			{
+				pc = ins.arg;
+			}
+			else
+			{
+				vFrames.pop_back();
+			}
+		}
+		else if(ins.op == CPolymerShape::opBranch)
 		{
-			current_beadname = AddBeadtoPolymer(vNewBeads, vNewBonds, current_beadname, targetBeadName, pCurrentBeadIndex, bIncrementBeadIndex);
+			ShapeFrame frame = {0, currentBeadIndex, currentBeadName};
+			vFrames.push_back(frame);
+		}
+		else if(ins.op == CPolymerShape::opEndBranch)
+		{
+			currentBeadIndex = vFrames.back().beadIndex;
+			currentBeadName  = vFrames.back().beadName;
+			vFrames.pop_back();
+		}
+		else if(ins.op == CPolymerShape::opLoop)
+		{
+			// Unlike the branch operator we do move the current bead when
+			// adding a loop target. This is because loop targets are just normal
+			// beads that can have extra bonds attached to them later.
+
+			currentBeadName = AddBeadtoPolymer(vNewBeads, vNewBonds, currentBeadName, ins.name, &currentBeadIndex, true);
 
 			// If the target does not exist in the map we simply insert it, if
 			// it is there then we add the current bead to it with a bond. 
 
 			CAbstractBead* pTargetBead = vNewBeads.back();
 
-			if(m_mLoopTargets.find(iLoopId) == m_mLoopTargets.end())
+			if(m_mLoopTargets.find(ins.arg) == m_mLoopTargets.end())
 			{
-				LoopTarget* pTarget = new LoopTarget(*pCurrentBeadIndex, targetBeadName, pTargetBead);
+				LoopTarget* pTarget = new LoopTarget(currentBeadIndex, ins.name, pTargetBead);
 
-				m_mLoopTargets.insert(idPairLongLoopTarget(iLoopId,pTarget));
+				m_mLoopTargets.insert(idPairLongLoopTarget(ins.arg, pTarget));
 			}
 			else
 			{
-				LoopTarget* pTarget = (*m_mLoopTargets.find(iLoopId)).second;
+				LoopTarget* pTarget = (*m_mLoopTargets.find(ins.arg)).second;
 
 				long targetBeadIndex		= pTarget->GetId();
 				zString targetBeadName		= pTarget->GetName();
-				CAbstractBead* pTargetBead	= pTarget->GetBead();
+				pTargetBead					= pTarget->GetBead();
 
-				StringLongIterator iterBondType;	
-				long BondType;
-				zString bondname;		// we only ever need one bond
+				StringLongIterator iterBondType = mBondNames.find(currentBeadName + targetBeadName);
 
-				bondname		= current_beadname + targetBeadName;
-				iterBondType	= mBondNames.find(bondname);
 				if(iterBondType != mBondNames.end())
 				{
-					BondType		= (*iterBondType).second;
+					long BondType	= (*iterBondType).second;
 					CBond* pBond	= new CBond(*vBondTypes.at(BondType));		// bonds don't know about beads
 					pBond->SetBeadIndex(targetBeadIndex, vNewBeads.size()-1);	// set indices of beads 
-					pBond->SetBeads(vNewBeads.at(*pCurrentBeadIndex), pTargetBead);	    // set bead pointers
+					pBond->SetBeads(vNewBeads.at(currentBeadIndex), pTargetBead);	// set bead pointers
 					vNewBonds.push_back(pBond);
 				}
 				else
@@ -1799,50 +1342,78 @@ zString CInputData::ParseElement(bool& bLinear, BeadVector& vNewBeads, BondVecto
 			}
 		}
 	}
-	else		// head is a compound element so parse it further until tail is empty
-	{
-		if(tail =="()")
-			current_beadname = ParseElement(bLinear, vNewBeads, vNewBonds, current_beadname, head, pCurrentBeadIndex, bIncrementBeadIndex);
-		else
-		{
-			current_beadname = ParseElement(bLinear, vNewBeads, vNewBonds, current_beadname, head, pCurrentBeadIndex, bIncrementBeadIndex);
-			current_beadname = ParseElement(bLinear, vNewBeads, vNewBonds, current_beadname, tail, pCurrentBeadIndex, bIncrementBeadIndex);
-		}	
-	}
-
-	return current_beadname;
 }
 
-// Function to trim whitespace off the front and back of a zString.
-// We don't check inside the zString because the spaces may be significant, e.g.,
-// in separating bead names.
+// Function to add CBondPair objects to a polymer type if it has the 3-body 
+// bond force. We search through the bonds in the polymer looking for pairs that
+// connect three beads whose names match any of the CBondPair types specified for
+// the simulation. If one is found we create a CBondPair object and add it
+// to the polymer for later use in CInitialState::CreatePolymers().
+//
+// Note that the order of storing the two bonds in the bondpair object
+// is opposite to the order in which they are encountered in the polymer
+// shape. This is necessary because the bonds' head and tail beads are
+// stored in the order they are added to the polymer, and the direction
+// of the bonds is thus from the tail of the bond added last to the head 
+// of that added before. We calculate the 3-body forces given that the 
+// bond vectors are pointing from the tail of a bond to its head. This
+// requires that we use the three beads defining the two bonds in the
+// reverse order to their occurrence in the polymer shape.
+//
+// The bonds are first indexed by their head bead so that the bonds adjacent
+// to each bond are found without searching the whole bond vector. They are
+// stored in increasing order so the bondpairs are created in the same order 
+// as a search over all pairs of bonds.
 
-zString CInputData::RemoveSpaces(zString oldString) const
+void CInputData::AddBondPairstoPolymer(const BeadVector& vNewBeads, const BondVector& vNewBonds, BondPairVector& vNewBondPairs) const
 {
-    if(!oldString.empty())
-    {
-        
-	zStringIterator iterFor	 = oldString.begin();
-	zStringIterator iterBack = oldString.end();
-	iterBack--;
+	if(mBondPairNames.empty())
+		return;
 
-	for(long unsigned int j=0; j<oldString.size(); j++)
+	xxBasevector<zLongVector> vBondsByHead(vNewBeads.size());
+
+	for(long bondIndex=0; bondIndex<static_cast<long>(vNewBonds.size()); bondIndex++)
 	{
-		if(*iterFor == ' ') {
-			oldString.erase(iterFor); }	// erase automatically increments iterator
-		if(*iterBack == ' ')
+		vBondsByHead.at(vNewBonds.at(bondIndex)->GetHeadIndex()).push_back(bondIndex);
+	}
+
+	for(long firstBondIndex=0; firstBondIndex<static_cast<long>(vNewBonds.size()); firstBondIndex++)
+	{
+		CBond* const pFirstBond = vNewBonds.at(firstBondIndex);
+
+		const zString firstName  = (*mBeadTypes.find(pFirstBond->GetHead()->GetType())).second;
+		const zString secondName = (*mBeadTypes.find(pFirstBond->GetTail()->GetType())).second;
+
+		// Find all bonds that have the first bond's tail index as their head index.
+		// For each one concatenate the bead names from the first, second and
+		// third beads: if this triplet exists in the mBondPairNames map it indicates
+		// that the triplet represents a stiff bond so create a CBondPair object 
+		// using the template accessed via the name and associated type.
+
+		const zLongVector& vAdjacentBonds = vBondsByHead.at(pFirstBond->GetTailIndex());
+
+		for(czLongVectorIterator iterIndex=vAdjacentBonds.begin(); iterIndex!=vAdjacentBonds.end(); iterIndex++)
 		{
-			oldString.erase(iterBack);	
-			iterBack--;					// move back from end()
+			const long secondBondIndex = *iterIndex;
+			CBond* const pSecondBond   = vNewBonds.at(secondBondIndex);
+
+			const zString thirdName = (*mBeadTypes.find(pSecondBond->GetTail()->GetType())).second;
+
+			cStringLongIterator iterBP = mBondPairNames.find(firstName+secondName+thirdName);
+
+			if(iterBP != mBondPairNames.end())
+			{
+				CBondPair* pBP = new CBondPair(*vBondPairTypes.at((*iterBP).second));
+				pBP->SetBondIndex(secondBondIndex, firstBondIndex);
+				pBP->SetBonds(pSecondBond, pFirstBond);
+
+				vNewBondPairs.push_back(pBP);
+			}
 		}
 	}
-    
-        
-    }
-    
-	return oldString;
 }
 
+
 void CInputData::SetAveBeadDensity(double dens)
 {
 	AverageBeadDensity = dens;
@@ -1989,8 +1560,15 @@ bool CInputData::WriteDefaultControlDataFile(const zString iFileName)
 	inFile.Lambda				= Lambda;
 #elif SimIdentifier == DPD
 	inFile.Lambda				= Lambda;
+	inFile.Integrator			= Integrator;
+	inFile.CollisionRate		= CollisionRate;
+	inFile.RESPASubstepNo		= RESPASubstepNo;
+	inFile.SnapshotPrecision	= SnapshotPrecision;
+	inFile.AssemblyThreadNo		= AssemblyThreadNo;
+	inFile.StateCache			= StateCache;
 #elif SimIdentifier == MD
 	inFile.RCutOff				= RCutOff;
+	inFile.MCThreadNo			= MCThreadNo;
 #endif
 
 	inFile.StepSize				= StepSize;
@@ -2315,10 +1893,15 @@ bool CInputData::ReadControlDataFile(const zString iFileName)
 		SetLambda(inFile.Lambda);
 #elif SimIdentifier == DPD
 		SetLambda(inFile.Lambda);
+		SetIntegrator(inFile.Integrator, inFile.CollisionRate);
+		SetRESPASubsteps(inFile.RESPASubstepNo);
+		SetSnapshotPrecision(inFile.SnapshotPrecision);
+		SetAssembly(inFile.AssemblyThreadNo, inFile.StateCache);
 #elif SimIdentifier == MD
 		SetCutOffRadius(inFile.RCutOff);
 		SetMCStepSize(inFile.MCStepSize);
 		SetTotalMCTime(inFile.TotalMCTime);
+		SetMCThreadNo(inFile.MCThreadNo);
 #endif
 
 		SetStepSize(inFile.StepSize);
@@ -2555,6 +2138,28 @@ void CInputData::SetLambda(double lambda)
 	Lambda = lambda;
 }
 
+void CInputData::SetIntegrator(const zString integrator, double rate)
+{
+	Integrator    = integrator;
+	CollisionRate = rate;
+}
+
+void CInputData::SetRESPASubsteps(long substeps)
+{
+	RESPASubstepNo = substeps;
+}
+
+void CInputData::SetSnapshotPrecision(double precision)
+{
+	SnapshotPrecision = precision;
+}
+
+void CInputData::SetAssembly(long threadNo, const zString cache)
+{
+	AssemblyThreadNo = threadNo;
+	StateCache		 = cache;
+}
+
 void CInputData::SetCutOffRadius(double rcutoff)
 {
 	RCutOff = rcutoff;
@@ -2570,6 +2175,11 @@ void CInputData::SetTotalMCTime(long steps)
 	TotalMCTime = steps;
 }
 
+void CInputData::SetMCThreadNo(long threadNo)
+{
+	MCThreadNo = threadNo;
+}
+
 void CInputData::SetStepSize(double step)
 {
 	StepSize = step;
@@ -2663,139 +2273,19 @@ void CInputData::SetISD(const CInitialStateData *pISD)
 
 	m_pISD = pISD->Copy();
 }
-
 // Function to check that a bead name occurs exactly once in a polymer shape.
-// Actually, we only have to check if it is missing or occurs at least twice 
-// for the test to fail. We assume that the polymer shape has been validated 
-// by a call to IsShapeValid() so that we only have to look for bead name 
-// substrings that occur in the shape.
-// Because bead names can contain sub-strings that are valid bead names 
-// (e.g., H, H1, beadH), we have to check that the characters on either side 
-// of the bead names being tested are not valid name characters: this indicates 
-// the bead name is isolated. Also, because elements can be nested, we check 
-// every bead name in each element by searching for contiguous groups of
-// characters that are in the validNameChars set.
-//
+// The shape is compiled by CPolymerShape, which counts the times the name is
+// written in it. Multipliers are not expanded, so the bead in (A (4 B) C) 
+// counts as unique even though the polymer contains four of them. An invalid 
+// shape fails the test.
 
 bool CInputData::IsBeadUniqueInPolymer(const zString bead, const zString shape) const
 {
-	bool bValid = false;
-
-	long BeadMatches = 0;
-
-	zString prevChar = "";
-	zString nextChar = "";
-
-	zString element = shape;
-
-	while(element != "()")
-	{
-		zString localElement = CAR(element);
-
-		while(localElement.find(bead) < localElement.length())
-		{
-			if(localElement.find(bead) > 0)
-				prevChar.assign(localElement, localElement.find(bead)-1, 1);
-			else
-				prevChar = "";
-
-			if(localElement.find(bead) < localElement.length()-bead.size())
-				nextChar.assign(localElement, localElement.find(bead)+bead.size(), 1);
-			else
-				nextChar = "";
+	const CPolymerShape polymerShape(shape, mBeadNames);
 
-			if( (prevChar.empty() || !(validNameChars.find(prevChar) < validNameChars.length())) &&
-				(nextChar.empty() || !(validNameChars.find(nextChar) < validNameChars.length())) )
-				BeadMatches++;
-
-			// Remove all characters from the start of the localElement to 
-			// the end of the (searched-for) bead name, and repeat the search. 
-			// This relies on the find() algorithm returning the first occurrence 
-			// of a sub-string.
-
-			localElement.erase(0, localElement.find(bead)+bead.size());
-
-			while(!nextChar.empty() && validNameChars.find(nextChar) < validNameChars.length())
-			{
-				localElement.erase(0, 1);
-				nextChar.assign(localElement, 0, 1);
-			}
-		}
-		element = CDR(element);
-	}
-
-	if(BeadMatches == 1)	// if a unique match is found return true
-		bValid = true;
-
-	return bValid;
+	return (polymerShape.IsValid() && polymerShape.GetBeadNameCount(bead) == 1);
 }
 
-// Function to check an element is valid: this implies
-//
-// CAR(element) is a bead, an operator or another element
-// CAR(element) is branchChar and CDR(CDR(element)) is "()"
-// CAR(element) is branchChar and CAR(CDR(element)) is not branchChar
-//
-// The function is called recursively until the element is empty or it returns
-// false. An empty element returns false but the result is checked against the
-// expected value and need not invalidate the element.
-//
-// We assume that IsShapeValid() has been called to validate the order of brackets
-// so we only check the contents of the elements here.
-
-bool CInputData::IsElementValid(zString element) const
-{
-	bool bValid;
-
-	zString head = CAR(element);
-	zString tail = CDR(element);
-
-	if(element == "()")
-		bValid = false;
-	else if(IsBeadinMap(element))
-		bValid = true;
-	else if(head == CInputData::branchChar)
-	{
-		if(IsBeadinMap(CAR(tail)) && CDR(tail) == "()")
-			bValid = true;
-		else if ( *CAR(tail).begin() == '('   && 
-				  CDR(tail)       == "()"  && 
-				  IsBeadinMap(CAR(CAR(tail))) ) 
-			return IsElementValid(CAR(tail));
-		else
-			bValid = false;
-	}
-	else if(head == CInputData::loopChar)
-	{
-		zString loopId			= FIRST(tail);
-		zString loopBeadName	= LAST(tail);
-		int iLoopId				= atoi(loopId.c_str());
-
-		if(IsBeadinMap(loopBeadName) &&
-		   !(loopId.find_first_not_of(CInputData::validNumOpChars) < loopId.length())
-		   && iLoopId > 0)
-			bValid = true;
-		else
-			bValid = false;
-	}
-	else if(!(head.find_first_not_of(CInputData::validNumOpChars) < head.length()) )
-	{
-		return IsElementValid(tail);
-	}
-	else if(*head.begin() == '(')					// compound element
-	{
-		if(IsElementValid(head) && (tail =="()" || IsElementValid(tail)))	
-			bValid = true;
-		else
-			bValid = false;
-	}
-	else if(IsBeadinMap(head) && (tail =="()" || IsElementValid(tail)))	
-		bValid = true;							
-	else									
-		bValid = false;
-
-	return bValid;
-}
 
 // Function to copy the CWallData object from the input data file to a local data
 // members. Note that we only set the data values if the user specified a wall
@@ -3356,6 +2846,14 @@ long CInputData::GetTotalMCTime() const
 	return TotalMCTime;
 }
 
+// Function to return the number of threads used to relax the initial state 
+// by MC. Zero means that beads are moved one at a time on the main thread.
+
+long CInputData::GetMCThreadNo() const
+{
+	return MCThreadNo;
+}
+
 // Function to return the maximum displacement of a bead in an MC step.
 // The MC moves are isotropic so the same step size is used for all dimensions.
 
@@ -40,6 +40,7 @@ class pmBondPairData;
 class pmPolymerData;
 class pmCommandNames;
 class mpmInitialState;
+class CPolymerShape;
 
 
 #include "xxBase.h"
@@ -179,6 +180,12 @@ public:
 
 	double GetAveBeadDensity() const;
 	double GetLambda()		   const;		// DPD only
+	double GetCollisionRate()  const;		// DPD only
+	const zString GetIntegrator() const;	// DPD only
+	long   GetRESPASubstepNo() const;		// DPD only
+	double GetSnapshotPrecision() const;
+	long   GetAssemblyThreadNo() const;		// DPD only
+	const zString GetStateCache() const;	// DPD only
 	double GetCutOffRadius()   const;		// MD only
 	double GetMCStepSize()	   const;		// MD only
 	double GetStepSize()       const;
@@ -196,6 +203,7 @@ public:
 	long   GetRNGSeed()			const;
 	long   GetCurrentTime()		const;
 	long   GetTotalMCTime()     const;		// MD only
+	long   GetMCThreadNo()      const;		// MD only
 	long   GetTotalTime()		const;
 	long   GetProcessorsXNo()	const;      // For parallel runs only
 	long   GetProcessorsYNo()	const;
@@ -314,9 +322,14 @@ private:
 	void SetTemp(double temp);
 	void SetRNGSeed(long seed);
 	void SetLambda(double lambda);					// DPD only
+	void SetIntegrator(const zString integrator, double rate);	// DPD only
+	void SetRESPASubsteps(long substeps);			// DPD only
+	void SetSnapshotPrecision(double precision);	// DPD only
+	void SetAssembly(long threadNo, const zString cache);		// DPD only
 	void SetCutOffRadius(double rcutoff);			// MD only
 	void SetMCStepSize(double step);
 	void SetTotalMCTime(long steps);
+	void SetMCThreadNo(long threadNo);				// MD only
 	void SetStepSize(double step);
 	void SetTotalTime(long steps);
 	void SetSamplePeriod(long period);
@@ -360,23 +373,13 @@ private:
 								 zString current_beadname, zString next_beadname, 
 								 long* pCurrentBeadIndex, bool bIncrementBeadIndex);
 
-	zString ParseElement(bool& bLinear, BeadVector& vNewBeads, BondVector& vNewBonds, 
-							 zString current_beadname, zString element, 
-							 long* pCurrentBeadIndex, bool bIncrementBeadIndex);
+	void BuildPolymer(const CPolymerShape& polymerShape, BeadVector& vNewBeads, BondVector& vNewBonds);
 
-	zString ExpandElement(zString op, zString token);
-	zString RemoveBrackets(zString oldString) const;
-	zString RemoveSpaces(zString oldString) const;
-	zString CDR(const zString oldString) const;
-	zString CAR(const zString oldString) const;
-	zString FIRST(const zString shape) const;
-	zString LAST(const zString shape) const;
+	void AddBondPairstoPolymer(const BeadVector& vNewBeads, const BondVector& vNewBonds, 
+							   BondPairVector& vNewBondPairs) const;
 
-	bool AreAllBeadNamesValid(const zString shape) const;
 	bool IsNameValid(const zString name) const;
-	bool IsShapeValid(const zString shape) const;
 	bool IsBeadUniqueInPolymer(const zString bead, const zString shape) const;
-	bool IsElementValid(zString element) const;
 
 	// Functions to check that constraints on the SimBox are valid
 	bool IsGravityValid() const;
@@ -436,6 +439,10 @@ private:
 
 	double AverageBeadDensity;
 	double Lambda;							// DPD only
+	zString Integrator;						// DPD only
+	double CollisionRate;					// DPD only
+	double SnapshotPrecision;				// Set by DPD control data files only
+	zString StateCache;						// DPD only
 	double RCutOff;							// MD only
 	double MCStepSize;						// MD only
 	double kT;
@@ -461,8 +468,11 @@ private:
 	long CNTZCellNo;
 	long CurrentTime;
 	long TotalMCTime;						// MD only
+	long MCThreadNo;						// MD only
 	long TotalTime;
 	long RNGSeed;
+	long AssemblyThreadNo;					// DPD only
+	long RESPASubstepNo;					// DPD only
 
 	StringSequence vGravityBeadNames;		// Body force data derived from CGravityData object
 	double GravityXForce;
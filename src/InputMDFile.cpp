@@ -51,6 +51,7 @@ CInputMDFile::CInputMDFile(zString iFileName, bool IOFlag,
 															  pISD(NULL),
 															  pGD(NULL),
 															  pWD(NULL),
+															  MCThreadNo(0),
 															  m_rISD(rISD),
 															  m_pISO(NULL)
 {
@@ -283,6 +284,10 @@ bool CInputMDFile::Serialize()
 		m_outStream << "CutOff		" << RCutOff			<< zEndl;
 		m_outStream << "MCStep		" << MCStepSize			<< zEndl;
 		m_outStream << "MCTime		" << TotalMCTime		<< zEndl;
+
+		if(MCThreadNo > 0)
+			m_outStream << "MCThreads	" << MCThreadNo			<< zEndl;
+
 		m_outStream << "Step		" << StepSize			<< zEndl;
 		m_outStream << "Time		" << TotalTime			<< zEndl;
 
@@ -744,7 +749,22 @@ bool CInputMDFile::Serialize()
 				return IOError("Error reading total MC time");
 		}
 
-		m_inStream >> token;			
+		// The number of threads used to relax the initial state is optional. 
+		// If it is absent, or zero, the beads are moved one at a time; otherwise
+		// non-adjacent CNT cells are relaxed concurrently.
+
+		MCThreadNo = 0;
+
+		m_inStream >> token;
+		if(token == "MCThreads")
+		{
+			m_inStream >> MCThreadNo;
+			if(!m_inStream.good() || MCThreadNo < 0)
+				return IOError("Error reading number of MC threads");
+
+			m_inStream >> token;
+		}
+			
 		if(token != "Step")
 			return IOError("Error reading Step token");
 		else
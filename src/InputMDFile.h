@@ -88,6 +88,7 @@ public:
 	long RNGSeed;
 	long TotalTime;
 	long TotalMCTime;	// MC parameters needed for pre-MD relaxation 
+	long MCThreadNo;	// Optional number of threads for checkerboard MC relaxation
 	double MCStepSize;
 	double RCutOff;		// MD cut-off radius for LJ and SC potentials
 	
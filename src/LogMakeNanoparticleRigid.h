@@ -0,0 +1,66 @@
+// LogMakeNanoparticleRigid.h: interface for the CLogMakeNanoparticleRigid class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGMAKENANOPARTICLERIGID_H__4F82E442_775B_4651_9184_BF30FF7C3E66__INCLUDED_)
+#define AFX_LOGMAKENANOPARTICLERIGID_H__4F82E442_775B_4651_9184_BF30FF7C3E66__INCLUDED_
+
+
+#include "LogConstraintMessage.h"
+
+class CLogMakeNanoparticleRigid : public CLogConstraintMessage   
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogMakeNanoparticleRigid(long time, long id, long beadTotal);
+
+	virtual ~CLogMakeNanoparticleRigid();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogMakeNanoparticleRigid& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogMakeNanoparticleRigid(const CLogMakeNanoparticleRigid& oldMessage);
+	CLogMakeNanoparticleRigid& operator=(const CLogMakeNanoparticleRigid& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const long m_Id;			// Nanoparticle id
+	const long m_BeadTotal;		// Number of beads in the rigid body
+};
+
+
+#endif // !defined(AFX_LOGMAKENANOPARTICLERIGID_H__4F82E442_775B_4651_9184_BF30FF7C3E66__INCLUDED_)
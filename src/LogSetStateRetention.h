@@ -0,0 +1,65 @@
+// LogSetStateRetention.h: interface for the CLogSetStateRetention class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGSETSTATERETENTION_H__11A1CD24_34CB_468B_90BC_B5F1CECA3DE7__INCLUDED_)
+#define AFX_LOGSETSTATERETENTION_H__11A1CD24_34CB_468B_90BC_B5F1CECA3DE7__INCLUDED_
+
+
+#include "LogInfoMessage.h"
+
+class CLogSetStateRetention : public CLogInfoMessage   
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogSetStateRetention(long time, long currentStates, long densityStates);
+
+	virtual ~CLogSetStateRetention();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogSetStateRetention& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogSetStateRetention(const CLogSetStateRetention& oldMessage);
+	CLogSetStateRetention& operator=(const CLogSetStateRetention& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const long m_CurrentStates;	// No of current states kept in memory
+	const long m_DensityStates;	// No of density grid samples kept in memory
+};
+
+#endif // !defined(AFX_LOGSETSTATERETENTION_H__11A1CD24_34CB_468B_90BC_B5F1CECA3DE7__INCLUDED_)
@@ -32,7 +32,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Note that it does not get assigned a value until the user creates the
 // instance. 
 
-CLogState* CLogState::m_pInstance = NULL;
+SimThreadLocal CLogState* CLogState::m_pInstance = NULL;
 
 
 // Static member function to add a newly-created message to the message sequence
@@ -35,7 +35,7 @@ public:
 
 private:
 
-	static CLogState* m_pInstance;		// Pointer to single instance of CLogState class
+	static SimThreadLocal CLogState* m_pInstance;		// Pointer to single instance of CLogState class
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
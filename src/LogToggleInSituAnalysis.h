@@ -0,0 +1,65 @@
+// LogToggleInSituAnalysis.h: interface for the CLogToggleInSituAnalysis class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGTOGGLEINSITUANALYSIS_H__EE768828_9875_4CBF_B14F_D3DDAF09E43D__INCLUDED_)
+#define AFX_LOGTOGGLEINSITUANALYSIS_H__EE768828_9875_4CBF_B14F_D3DDAF09E43D__INCLUDED_
+
+
+#include "LogInfoMessage.h"
+
+class CLogToggleInSituAnalysis : public CLogInfoMessage  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogToggleInSituAnalysis(long time, bool bInSitu);
+
+	virtual ~CLogToggleInSituAnalysis();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogToggleInSituAnalysis& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogToggleInSituAnalysis(const CLogToggleInSituAnalysis& oldMessage);
+	CLogToggleInSituAnalysis& operator=(const CLogToggleInSituAnalysis& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+	
+	const bool m_bInSitu;	// Flag showing whether aggregates are analysed on a background thread
+
+};
+
+#endif // !defined(AFX_LOGTOGGLEINSITUANALYSIS_H__EE768828_9875_4CBF_B14F_D3DDAF09E43D__INCLUDED_)
@@ -0,0 +1,65 @@
+// LogTogglePerformanceOutput.h: interface for the CLogTogglePerformanceOutput class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_LOGTOGGLEPERFORMANCEOUTPUT_H__8BE1BEA0_F036_493A_BF6D_5E0B8F8C5244__INCLUDED_)
+#define AFX_LOGTOGGLEPERFORMANCEOUTPUT_H__8BE1BEA0_F036_493A_BF6D_5E0B8F8C5244__INCLUDED_
+
+
+#include "LogInfoMessage.h"
+
+class CLogTogglePerformanceOutput : public CLogInfoMessage  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CLogTogglePerformanceOutput(long time, bool bSave, long period);
+
+	virtual ~CLogTogglePerformanceOutput();		// Public so the CLogState can delete messages
+
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	friend zOutStream& operator<<(zOutStream& os, const CLogTogglePerformanceOutput& rMsg);
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	virtual	void Serialize(zOutStream& os) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+	
+	// Explicitly disallow the copy constructor and assignment operators
+	// by declaring them private and providing NO definitions.
+
+	CLogTogglePerformanceOutput(const CLogTogglePerformanceOutput& oldMessage);
+	CLogTogglePerformanceOutput& operator=(const CLogTogglePerformanceOutput& rhs);
+
+
+	// ****************************************
+	// Data members
+private:
+
+	const bool m_bSave;		// Flag showing whether phase timings are being saved or not
+	const long m_Period;	// Number of steps averaged per line of the performance log
+};
+
+#endif // !defined(AFX_LOGTOGGLEPERFORMANCEOUTPUT_H__8BE1BEA0_F036_493A_BF6D_5E0B8F8C5244__INCLUDED_)
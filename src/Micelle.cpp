@@ -23,6 +23,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "MicelleData.h"
 #include "SimState.h"
 #include "ISimBox.h"
+#include "InSituSnapshot.h"
 #include "Bead.h"
 #include "aaRegionToType.h"
 
@@ -88,6 +89,8 @@ CMicelle::CMicelle(const zString runId, long samplePeriod,
 	}
 
 	m_lLipids.clear();
+	m_vBeadIds.clear();
+	m_vHeadIds.clear();
 	m_lCurrentLipids.clear();
 
 	m_mPolymerFromHeadId.clear();
@@ -168,6 +171,23 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 		m_PolymerSize = m_lLipids.front()->GetSize();
 		m_dBeadSize = static_cast<double>(m_MaxMicelleSize*m_PolymerSize);
 
+		// Store the ids of the micelle's beads, and of the lipid head beads, so that
+		// the micelle can also be analysed from a snapshot of the bead data
+
+		for(iterLipid=m_lLipids.begin(); iterLipid!=m_lLipids.end(); iterLipid++)
+		{
+			for(iterBead=(*iterLipid)->GetBeads().begin(); iterBead!=(*iterLipid)->GetBeads().end(); iterBead++)
+			{
+				m_vBeadIds.push_back((*iterBead)->GetId());
+			}
+
+			m_vHeadIds.push_back((*iterLipid)->GetHead()->GetId());
+		}
+
+		m_vBeadPos.resize(3*m_vBeadIds.size());
+		m_vBeadMom.resize(3*m_vBeadIds.size());
+		m_vHeadPos.resize(3*m_vHeadIds.size());
+
 		// Calculate the initial micelle CM coordinates for use in normalising the
 		// data during a run
 
@@ -254,6 +274,88 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 	{
 	}
 
+	// **********************************************************************
+	// Copy the coordinates and momenta of the micelle's beads and analyse them
+
+	long i = 0;
+
+	for(iterLipid=m_lLipids.begin(); iterLipid!=m_lLipids.end(); iterLipid++)
+	{
+		for(iterBead=(*iterLipid)->GetBeads().begin(); iterBead!=(*iterLipid)->GetBeads().end(); iterBead++)
+		{
+			m_vBeadPos[i]   = (*iterBead)->GetunPBCXPos();
+			m_vBeadPos[i+1] = (*iterBead)->GetunPBCYPos();
+			m_vBeadPos[i+2] = (*iterBead)->GetunPBCZPos();
+			m_vBeadMom[i]   = (*iterBead)->GetXMom();
+			m_vBeadMom[i+1] = (*iterBead)->GetYMom();
+			m_vBeadMom[i+2] = (*iterBead)->GetZMom();
+			i += 3;
+		}
+	}
+
+	i = 0;
+
+	for(iterLipid=m_lLipids.begin(); iterLipid!=m_lLipids.end(); iterLipid++)
+	{
+		m_vHeadPos[i]   = (*iterLipid)->GetHead()->GetunPBCXPos();
+		m_vHeadPos[i+1] = (*iterLipid)->GetHead()->GetunPBCYPos();
+		m_vHeadPos[i+2] = (*iterLipid)->GetHead()->GetunPBCZPos();
+		i += 3;
+	}
+
+	AnalyseMicelle(pISimBox->GetCurrentTime(), pISimBox->GetStepSize(), 
+				   rSimState.GetAnalysisPeriod(), rSimState.GetSamplePeriod());
+}
+
+// The micelle can be updated from a snapshot once its first call to UpdateState()
+// has stored the ids of its beads.
+
+bool CMicelle::CanUpdateFromSnapshot() const
+{
+	return m_MaxMicelleSize > 0;
+}
+
+// Function to analyse the micelle on the in-situ analysis thread. The bead data
+// are copied from the snapshot in the same order as UpdateState() copies them
+// from the beads themselves, so both give identical results.
+
+void CMicelle::UpdateStateFromSnapshot(const CInSituSnapshot& rSnapshot)
+{
+	for(unsigned long i=0; i<m_vBeadIds.size(); i++)
+	{
+		const double* const pPos = rSnapshot.GetUnPBCPosition(m_vBeadIds[i]);
+		const double* const pMom = rSnapshot.GetMomentum(m_vBeadIds[i]);
+
+		m_vBeadPos[3*i]   = pPos[0];
+		m_vBeadPos[3*i+1] = pPos[1];
+		m_vBeadPos[3*i+2] = pPos[2];
+		m_vBeadMom[3*i]   = pMom[0];
+		m_vBeadMom[3*i+1] = pMom[1];
+		m_vBeadMom[3*i+2] = pMom[2];
+	}
+
+	for(unsigned long j=0; j<m_vHeadIds.size(); j++)
+	{
+		const double* const pPos = rSnapshot.GetUnPBCPosition(m_vHeadIds[j]);
+
+		m_vHeadPos[3*j]   = pPos[0];
+		m_vHeadPos[3*j+1] = pPos[1];
+		m_vHeadPos[3*j+2] = pPos[2];
+	}
+
+	AnalyseMicelle(rSnapshot.GetCurrentTime(), rSnapshot.GetStepSize(), 
+				   rSnapshot.GetAnalysisPeriod(), rSnapshot.GetSamplePeriod());
+}
+
+// **********************************************************************
+// Function to calculate the micelle's properties from the bead data copied 
+// into the local containers and store them in the micelle's observables and
+// time series. It only uses the arguments and the micelle's own data.
+//
+// **********************************************************************
+
+void CMicelle::AnalyseMicelle(long time, double stepSize, long analysisPeriod, long samplePeriod)
+{
 	// **********************************************************************
 	// Now do the general analysis for the micelle. Initially we assume that all 
 	// polymers are in the micelle and find the average radius. Then we see if
@@ -277,21 +379,14 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 	m_CMVel[1] = 0.0;
 	m_CMVel[2] = 0.0;
 
-	for(iterLipid=m_lLipids.begin(); iterLipid!=m_lLipids.end(); iterLipid++)
+	for(unsigned long i=0; i<m_vBeadPos.size(); i+=3)
 	{
-		for(iterBead=(*iterLipid)->GetBeads().begin(); iterBead!=(*iterLipid)->GetBeads().end(); iterBead++)
-		{
-			double xb = (*iterBead)->GetunPBCXPos();
-			double yb = (*iterBead)->GetunPBCYPos();
-			double zb = (*iterBead)->GetunPBCZPos();
-
-			m_CMPos[0] += xb;
-			m_CMPos[1] += yb;
-			m_CMPos[2] += zb;
-			m_CMVel[0] += (*iterBead)->GetXMom();
-			m_CMVel[1] += (*iterBead)->GetYMom();
-			m_CMVel[2] += (*iterBead)->GetZMom();
-		}
+		m_CMPos[0] += m_vBeadPos[i];
+		m_CMPos[1] += m_vBeadPos[i+1];
+		m_CMPos[2] += m_vBeadPos[i+2];
+		m_CMVel[0] += m_vBeadMom[i];
+		m_CMVel[1] += m_vBeadMom[i+1];
+		m_CMVel[2] += m_vBeadMom[i+2];
 	}
 
 	m_CMPos[0] /= m_dBeadSize;
@@ -310,11 +405,11 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 	m_Radius		= 0.0;
 	m_SurfaceArea	= 0.0;
 
-	for(iterLipid=m_lLipids.begin(); iterLipid!=m_lLipids.end(); iterLipid++)
+	for(unsigned long j=0; j<m_vHeadPos.size(); j+=3)
 	{
-		double hx = (*iterLipid)->GetHead()->GetunPBCXPos();
-		double hy = (*iterLipid)->GetHead()->GetunPBCYPos();
-		double hz = (*iterLipid)->GetHead()->GetunPBCZPos();
+		double hx = m_vHeadPos[j];
+		double hy = m_vHeadPos[j+1];
+		double hz = m_vHeadPos[j+2];
 
 		m_Radius += (hx - m_CMPos[0])*(hx - m_CMPos[0]);
 		m_Radius += (hy - m_CMPos[1])*(hy - m_CMPos[1]);
@@ -339,7 +434,7 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 	// we actually use the time, and micelle coordinates, from the first call 
 	// to calculate the distance moved.
 
-	double dt = (pISimBox->GetCurrentTime() - m_InitialTime)*pISimBox->GetStepSize();
+	double dt = (time - m_InitialTime)*stepSize;
 
 	if(dt > 0.0)
 	{
@@ -391,10 +486,10 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 
 
 // Test case of a sine wave
-//	double xx = sin(10.0*m_globalTwoPI*static_cast<double>(pISimBox->GetCurrentTime())/1000.0);
+//	double xx = sin(10.0*m_globalTwoPI*static_cast<double>(time)/1000.0);
 //	m_pVAC->AddSample(xx);
 
-	if(pISimBox->GetCurrentTime()%rSimState.GetAnalysisPeriod() == 0)
+	if(time%analysisPeriod == 0)
 	{
 //		std::cout << "starting normalisation" << zEndl;
 
@@ -416,7 +511,7 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 		// Create a new CAutoCorr object to hold the next data set
 
 		delete m_pVAC;
-		m_pVAC = new CAutoCorr(rSimState.GetAnalysisPeriod()/rSimState.GetSamplePeriod(), m_VACTimeLag);
+		m_pVAC = new CAutoCorr(analysisPeriod/samplePeriod, m_VACTimeLag);
 	}
 
 	// Store the time-dependent data in a TSD object and pass it to the 
@@ -426,7 +521,7 @@ void CMicelle::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 
 	m_pTSD = new CTimeSeriesData(dataTotal);
 
-	m_pTSD->SetValue(0, pISimBox->GetCurrentTime(), "Time");
+	m_pTSD->SetValue(0, time, "Time");
 	m_pTSD->SetValue(1, m_Radius,        "Radius");
 	m_pTSD->SetValue(2, m_SurfaceArea,   "SurfaceArea");
 	m_pTSD->SetValue(3, m_DiffCoeff,     "Diffusion");
@@ -50,8 +50,16 @@ public:
 
 	virtual void ConvertNames(const CAnalysisState& raState);
 
+	// Functions used to analyse the micelle on the in-situ analysis thread
+
+	virtual bool CanUpdateFromSnapshot() const;
+	virtual void UpdateStateFromSnapshot(const CInSituSnapshot& rSnapshot);
+
 
 private:
+
+	void AnalyseMicelle(long time, double stepSize, long analysisPeriod, long samplePeriod);
+
 	// Data specified by user for micelle analysis
 
 	zString m_Polymer;		// Polymer composing micelle
@@ -92,6 +100,12 @@ private:
 	LongPolymerMap m_mPolymerFromHeadId;		// Map taking head bead id to polymer
 	LongPolymerMap m_mPolymerFromTailId;		// Map taking tail bead id to polymer
 
+	zLongVector   m_vBeadIds;			// Ids of all beads in micelle-forming polymers
+	zLongVector   m_vHeadIds;			// Ids of their head beads
+	zDoubleVector m_vBeadPos;			// Copies of the bead coordinates analysed each sample
+	zDoubleVector m_vBeadMom;			// and their momenta
+	zDoubleVector m_vHeadPos;			// Copies of the head bead coordinates
+
 	CAutoCorr*		  m_pVAC;			// Pointer to the velocity autocorrelation object
 	aaScalarProfile*  m_pVACProfile;	// Velocity profile
 
@@ -114,7 +114,10 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "PovrayFormat.h"
 #include "AmiraFormat.h"
 #include "ParaviewFormat.h"
+#include "CompressedFormat.h"
 #include "SolventFreeFormat.h"
+#include "TrajectoryFile.h"
+#include "InSituAnalysis.h"
 
 // Parallel code include files
 
@@ -155,7 +158,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Note that it does not get assigned a value until the user creates the
 // instance.
 
-CMonitor* CMonitor::m_pInstance = NULL;
+SimThreadLocal CMonitor* CMonitor::m_pInstance = NULL;
 
 // Public member function to create a single instance of the CMonitor class.
 
@@ -203,7 +206,12 @@ CMonitor::CMonitor(CSimState* const psState, const ISimBox* const pISimBox) : IS
 													   m_MaxXFraction(1.0),
 													   m_MaxYFraction(1.0),
 													   m_MaxZFraction(1.0),
+													   m_CurrentStateRetention(0),
+													   m_DensityStateRetention(1),
                                                        m_DefaultCurrentStateFormat("Povray"),
+                                                       m_pTrajectory(0),
+                                                       m_SnapshotPrecision(psState->GetSnapshotPrecision()),
+                                                       m_pInSituAnalysis(0),
                                                        m_bCurrentStateAnalysis(false),
 													   m_bDisplayBox(true),
 													   m_bRestrictCurrentStateCoords(false),
@@ -360,6 +368,7 @@ CMonitor::CMonitor(CSimState* const psState, const ISimBox* const pISimBox) : IS
 	//
 
 	m_vAggregates.clear();
+	m_vInSituAggregates.clear();
 
 
 	std::copy(m_pSimState->GetAnalysisState().GetAggregates().begin(), 
@@ -633,6 +642,15 @@ CMonitor::~CMonitor()
 
 	m_pInstance = NULL;
 
+	// stop the in-situ analysis thread first so that it has finished with the
+	// aggregates before anything else is destroyed
+
+	if(m_pInSituAnalysis)
+	{
+		delete m_pInSituAnalysis;
+		m_pInSituAnalysis = 0;
+	}
+
 	// delete the CObservable-derived objects that were created for fixed data, 
 	// bond, bondpair and polymer data. We loop over the concatenated container.
 
@@ -650,6 +668,14 @@ CMonitor::~CMonitor()
 	}
 	m_vGridObservables.clear();
 
+	// close the binary trajectory if one was written
+
+	if(m_pTrajectory)
+	{
+		delete m_pTrajectory;
+		m_pTrajectory = 0;
+	}
+
 	// delete the current state snapshots if they were saved
 	
 	if(!m_vCurrentStates.empty())
@@ -822,21 +848,26 @@ void CMonitor::CalculateSingleBeadData()
 	// total momentum, total angular momentum and average kinetic energy. Then 
 	// calculate the temperature, pressure and the stress and inertia tensors
 
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
 	double dPos[3];
 	double magPos;
+#endif
 
 	AbstractBeadVector vAllBeads = GetSimBoxBeads();
 	for(AbstractBeadVectorIterator iterBead=vAllBeads.begin(); iterBead!=vAllBeads.end(); iterBead++)
 	{
 		// We must use the un-periodic boundary positions for the diffusion coefficient
-		// calculation
+		// calculation. The lean bead layout only stores the initial positions,
+		// and so only calculates the MSDs, if EnableLeanBeadMSD is set.
 
-		dPos[0]	=  (*iterBead)->m_unPBCPos[0] - (*iterBead)->m_InitialPos[0];
-		dPos[1]	=  (*iterBead)->m_unPBCPos[1] - (*iterBead)->m_InitialPos[1];
-		dPos[2]	=  (*iterBead)->m_unPBCPos[2] - (*iterBead)->m_InitialPos[2];
+#if EnableLeanBeadStorage == SimMiscDisabled || EnableLeanBeadMSD == SimMiscEnabled
+		dPos[0]	=  (*iterBead)->m_unPBCPos[0] - (*iterBead)->GetInitialXPos();
+		dPos[1]	=  (*iterBead)->m_unPBCPos[1] - (*iterBead)->GetInitialYPos();
+		dPos[2]	=  (*iterBead)->m_unPBCPos[2] - (*iterBead)->GetInitialZPos();
 		magPos	= dPos[0]*dPos[0] + dPos[1]*dPos[1] + dPos[2]*dPos[2];
 
 		m_vBeadMSD.at((*iterBead)->GetType()) += magPos;
+#endif
 
 		m_cmPos[0]	+= (*iterBead)->m_Pos[0];
 		m_cmPos[1]	+= (*iterBead)->m_Pos[1];
@@ -856,17 +887,21 @@ void CMonitor::CalculateSingleBeadData()
 
 #if SimDimension == 2
 
+#if EnableLeanBeadStorage == SimMiscDisabled
 		m_totalStress[0] += (*iterBead)->m_Stress[0];
 		m_totalStress[1] += (*iterBead)->m_Stress[1];
 		m_totalStress[3] += (*iterBead)->m_Stress[3];
 		m_totalStress[4] += (*iterBead)->m_Stress[4];
+#endif
 
 #elif SimDimension == 3
 
+#if EnableLeanBeadStorage == SimMiscDisabled
 		for(short int i=0; i<9; i++)
 		{
 			m_totalStress[i] += (*iterBead)->m_Stress[i];
 		}
+#endif
 
 		m_totalInertia[0] +=	(*iterBead)->m_Pos[1]*(*iterBead)->m_Pos[1] +
 							    (*iterBead)->m_Pos[2]*(*iterBead)->m_Pos[2];
@@ -906,6 +941,24 @@ void CMonitor::CalculateSingleBeadData()
 		m_vGridObservables.at((*iterBead)->GetType())->m_vField.at(index) += 1.0;
 	}
 
+	// The lean bead layout stores the stress tensor already summed over all beads
+
+#if EnableLeanBeadStorage == SimMiscEnabled
+	const double* const pTotalStress = CAbstractBead::GetTotalStress();
+
+#if SimDimension == 2
+	m_totalStress[0] += pTotalStress[0];
+	m_totalStress[1] += pTotalStress[1];
+	m_totalStress[3] += pTotalStress[3];
+	m_totalStress[4] += pTotalStress[4];
+#elif SimDimension == 3
+	for(short int i=0; i<9; i++)
+	{
+		m_totalStress[i] += pTotalStress[i];
+	}
+#endif
+#endif
+
 	// Normalize all observables according to the dimension of the simulation.
 	// Note that because the wall bead type is included in m_BeadTypeSize but has no
 	// entry in the m_vBeadTypeTotal (because the beads are CWallBeads and not CBeads)
@@ -1329,6 +1382,15 @@ void CMonitor::Sample()
 
 	if(m_SamplesTaken%m_SampleNo == 0)
 	{
+		// The analysis state includes the observables of aggregates being
+		// updated on the in-situ analysis thread, so we wait for it to finish
+		// before they are normalized and written out.
+
+		if(m_pInSituAnalysis)
+		{
+			m_pInSituAnalysis->Wait();
+		}
+
 		SaveAnalysisState();
 
 		SaveAggregateState();	// Check whether to serialize aggregate data in the function
@@ -1488,6 +1550,28 @@ void CMonitor::SaveRestartState() const
 
 void CMonitor::SaveCurrentState()
 {
+	// The "Trajectory" and "CompressedTrajectory" formats append a frame to a 
+	// single binary file instead of writing a snapshot file, so they bypass the
+	// CCurrentState. The file is created when the first frame is written, and 
+	// that frame's format decides whether the trajectory is compressed. The 
+	// frames are not stored for current state analysis.
+
+	if( m_DefaultCurrentStateFormat == "Trajectory" || m_DefaultCurrentStateFormat == "CompressedTrajectory" )
+	{
+		if(!m_pTrajectory)
+		{
+			const double precision = (m_DefaultCurrentStateFormat == "CompressedTrajectory" ? m_SnapshotPrecision : 0.0);
+
+			m_pTrajectory = new CTrajectoryFile(GetRunId(), m_SimBoxXLength, m_SimBoxYLength, m_SimBoxZLength, precision);
+		}
+
+		if(!m_pTrajectory->AddFrame(GetCurrentTime(), GetISimBox()->GetBeads()))
+		{
+			ErrorTrace("Error in CMonitor::SaveCurrentState Trajectory");
+		}
+		return;
+	}
+
 	// Replace the constructor call with the factory pattern that returns a new
 	// format object
 
@@ -1509,6 +1593,11 @@ void CMonitor::SaveCurrentState()
 		pFormat = new CParaviewFormat(m_SimBoxXLength, m_SimBoxYLength, m_SimBoxZLength,
 								   m_bDisplayBox, m_BeadTypeSize);
 	}
+	else if( m_DefaultCurrentStateFormat == "Compressed" )
+	{
+		pFormat = new CCompressedFormat(m_SimBoxXLength, m_SimBoxYLength, m_SimBoxZLength,
+								   m_bDisplayBox, m_BeadTypeSize, m_SnapshotPrecision);
+	}
     else if( m_DefaultCurrentStateFormat == "SolventFree" )
     {
         pFormat = new CSolventFreeFormat(m_SimBoxXLength, m_SimBoxYLength, m_SimBoxZLength,
@@ -1554,6 +1643,7 @@ void CMonitor::SaveCurrentState()
 	if(m_bCurrentStateAnalysis)
 	{
 		m_vCurrentStates.push_back(pcState);
+		TrimCurrentStates();
 	}
 	else
 	{
@@ -1717,6 +1807,51 @@ void CMonitor::SaveDensityStates()
 		if(!pdState->Serialize())
 			ErrorTrace("Error in CMonitor::SaveDensityStates");	
 	}
+
+	TrimDensityStates();
+}
+
+// Functions to destroy the oldest CCurrentState and CDensityState objects 
+// when their containers exceed the retention limits set by the 
+// SetStateRetention command. A limit of zero keeps every state. 
+//
+// Density states are counted in samples: each sample creates one state per 
+// grid observable, and the containers are trimmed by whole samples so that 
+// the states for all bead types remain available at the latest time. Note 
+// that a CDensityState only refers to its grid observable's data, so older 
+// states cannot show earlier densities anyway, and by default only the 
+// latest sample is kept.
+
+void CMonitor::TrimCurrentStates()
+{
+	if(m_CurrentStateRetention > 0 && static_cast<long>(m_vCurrentStates.size()) > m_CurrentStateRetention)
+	{
+		const long excess = m_vCurrentStates.size() - m_CurrentStateRetention;
+
+		for(CurrentStateIterator iterCur = m_vCurrentStates.begin(); iterCur != m_vCurrentStates.begin() + excess; iterCur++)
+		{
+			delete (*iterCur);
+		}
+
+		m_vCurrentStates.erase(m_vCurrentStates.begin(), m_vCurrentStates.begin() + excess);
+	}
+}
+
+void CMonitor::TrimDensityStates()
+{
+	const long maxStates = m_DensityStateRetention*m_vGridObservables.size();
+
+	if(maxStates > 0 && static_cast<long>(m_vDensityStates.size()) > maxStates)
+	{
+		const long excess = m_vDensityStates.size() - maxStates;
+
+		for(DensityStateIterator iterDen = m_vDensityStates.begin(); iterDen != m_vDensityStates.begin() + excess; iterDen++)
+		{
+			delete (*iterDen);
+		}
+
+		m_vDensityStates.erase(m_vDensityStates.begin(), m_vDensityStates.begin() + excess);
+	}
 }
 
 // Function to pass time-dependent data to the CHistoryState object packaged in a
@@ -1848,28 +1983,65 @@ void CMonitor::SaveLogStateP() const
 // we pass the ISimBox pointer in giving access to the CNT cells via the interface defined
 // in that class. This is preferable to passing in the SimBox pointer because it decouples
 // the actual SimBox implementation behind the ISimBox interface class.
+//
+// If the ToggleInSituAnalysis command is active, aggregates that can be updated 
+// from a snapshot of the bead data are passed to the in-situ analysis thread 
+// instead, and write their state files from there. We first wait for the 
+// previous sample's analysis to finish so that aggregates are never used by 
+// both threads. Events and processes read aggregate data in the same time step
+// as it is sampled, so all aggregates are analysed here if any exist.
 
 void CMonitor::FindAggregates()
 {
+	m_vInSituAggregates.clear();
+
+	if(m_pInSituAnalysis)
+	{
+		m_pInSituAnalysis->Wait();
+	}
+
+	const bool bInSitu = m_pInSituAnalysis && 
+						 m_pSimState->GetAnalysisState().GetEvents().empty() &&
+						 m_pSimState->GetAnalysisState().GetProcesses().empty();
+
+	zBoolVector vSerialize;
+
 	for(AggregateIterator iterAgg=m_vAggregates.begin(); iterAgg!=m_vAggregates.end(); iterAgg++)
 	{
 		if((*iterAgg)->TimeToSample(GetCurrentTime()))
-			(*iterAgg)->UpdateState(*m_pSimState, GetISimBox());
+		{
+			if(bInSitu && (*iterAgg)->CanUpdateFromSnapshot())
+			{
+				m_vInSituAggregates.push_back(*iterAgg);
+				vSerialize.push_back(m_SamplesTaken%m_SampleNo == 0 && 
+									 (*iterAgg)->TimeToAnalyse(GetCurrentTime(), m_pSimState->GetAnalysisPeriod()));
+			}
+			else
+			{
+				(*iterAgg)->UpdateState(*m_pSimState, GetISimBox());
+			}
+		}
 	}
 
+	if(!m_vInSituAggregates.empty())
+	{
+		m_pInSituAnalysis->Submit(GetCurrentTime(), *m_pSimState, m_vInSituAggregates, vSerialize);
+	}
 }
 
 // Function to serialize the aggregate state objects to file. These contain the
 // time-dependent data obtained from all the CAnalysis-derived objects (aggregates)
 // created during the run. To allow for the possibility of each aggregate having
 // a different sample/analysis period we send the Serialize() message to each
-// after checking if it is time to analyse.
+// after checking if it is time to analyse. Aggregates that are being analysed
+// on the in-situ analysis thread are serialized by that thread.
 
 void CMonitor::SaveAggregateState() const
 {
 	for(cAggregateIterator iterAgg=m_vAggregates.begin(); iterAgg!=m_vAggregates.end(); iterAgg++)
 	{
-		if( (*iterAgg)->TimeToAnalyse(GetCurrentTime(), m_pSimState->GetAnalysisPeriod()) &&
+		if( std::find(m_vInSituAggregates.begin(), m_vInSituAggregates.end(), *iterAgg) == m_vInSituAggregates.end() &&
+		    (*iterAgg)->TimeToAnalyse(GetCurrentTime(), m_pSimState->GetAnalysisPeriod()) &&
 		   !(*iterAgg)->Serialize() )
 			ErrorTrace("Error in CMonitor::SaveAggregateState");
 	}
@@ -3094,6 +3266,29 @@ bool CMonitor::InternalSetDensityPeriod(long period)
     }
 }
 
+// Command handler function to change the number of current and density states
+// kept in memory. Negative values are rejected; zero means keep all states. 
+// The containers are trimmed immediately in case the new limits are smaller 
+// than the number of states already stored.
+
+bool CMonitor::InternalSetStateRetention(long currentStates, long densityStates)
+{
+    if(currentStates >= 0 && densityStates >= 0)
+    {
+        m_CurrentStateRetention = currentStates;
+        m_DensityStateRetention = densityStates;
+
+        TrimCurrentStates();
+        TrimDensityStates();
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
 // Command handler function to change the period for saving current state snapshots.
 // We return a boolean flag showing if the change is accepted.
 
@@ -3170,4 +3365,13 @@ void CMonitor::InternalToggleEnergyOutput(bool bNormalizePerBead)
 	m_pSimState->SetEnergyOutput(m_bEnergyOutput);
 }
 
+// Command handler function to toggle the timing of the phases of the CSimBox's
+// integration loop. The flag and averaging period are stored in the CSimState
+// and the CSimBox creates or destroys its performance log when it sees them change.
+
+void CMonitor::InternalTogglePerformanceOutput(long period)
+{
+	m_pSimState->SetPerformanceOutput(!m_pSimState->IsPerformanceOutputOn(), period);
+}
+
 
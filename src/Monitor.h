@@ -9,6 +9,8 @@
 
 class CSimState;
 class CCurrentStateFormat;
+class CTrajectoryFile;
+class CInSituAnalysis;
 
 
 #include "ISimBoxBase.h"
@@ -28,6 +30,7 @@ class CCurrentStateFormat;
     #include "mcShowModifiableProcessesImpl.h"
     #include "mcToggleCurrentStateAnalysisImpl.h"
     #include "mcToggleEnergyOutputImpl.h"
+    #include "mcTogglePerformanceOutputImpl.h"
     #include "mcToggleSliceEnergyOutputImpl.h"
     #include "mcZoomCurrentStateCameraImpl.h"
 #endif
@@ -63,9 +66,11 @@ class CCurrentStateFormat;
 #include "mcSetRestartStateDefaultInclusiveImpl.h"
 #include "mcSetRunCompleteIntervalImpl.h"
 #include "mcSetSamplePeriodImpl.h"
+#include "mcSetStateRetentionImpl.h"
 #include "mcToggleBeadDisplayImpl.h"
 #include "mcToggleCurrentStateBoxImpl.h"
 #include "mcToggleDensityFieldOutputImpl.h"
+#include "mcToggleInSituAnalysisImpl.h"
 #include "mcTogglePolymerDisplayImpl.h"
 #include "mcToggleRestartWarningMessagesImpl.h"
 #include "mcWriteLogMessageImpl.h"
@@ -85,6 +90,7 @@ class CMonitor : public ISimBoxBase, public virtual IMonitorCmd,
 				public mcShowModifiableProcessesImpl,
 				public mcToggleCurrentStateAnalysisImpl,
 				public mcToggleEnergyOutputImpl,
+				public mcTogglePerformanceOutputImpl,
 				public mcToggleSliceEnergyOutputImpl,
 				public mcZoomCurrentStateCameraImpl,
 #endif
@@ -119,9 +125,11 @@ class CMonitor : public ISimBoxBase, public virtual IMonitorCmd,
 				public mcSetRestartStateDefaultInclusiveImpl,
 				public mcSetRunCompleteIntervalImpl,
 				public mcSetSamplePeriodImpl,
+				public mcSetStateRetentionImpl,
 				public mcToggleBeadDisplayImpl,
 				public mcToggleCurrentStateBoxImpl,
 				public mcToggleDensityFieldOutputImpl,
+				public mcToggleInSituAnalysisImpl,
 				public mcTogglePolymerDisplayImpl,
 				public mcToggleRestartWarningMessagesImpl,
 				public mcWriteLogMessageImpl
@@ -148,6 +156,7 @@ class CMonitor : public ISimBoxBase, public virtual IMonitorCmd,
 	friend class  mcShowModifiableProcessesImpl;
 	friend class  mcToggleCurrentStateAnalysisImpl;
 	friend class  mcToggleEnergyOutputImpl;
+	friend class  mcTogglePerformanceOutputImpl;
 	friend class  mcToggleSliceEnergyOutputImpl;
 	friend class  mcZoomCurrentStateCameraImpl;
 #endif
@@ -182,9 +191,11 @@ class CMonitor : public ISimBoxBase, public virtual IMonitorCmd,
 	friend class  mcSetRestartStateDefaultInclusiveImpl;
 	friend class  mcSetRunCompleteIntervalImpl;
 	friend class  mcSetSamplePeriodImpl;
+	friend class  mcSetStateRetentionImpl;
 	friend class  mcToggleBeadDisplayImpl;
 	friend class  mcToggleCurrentStateBoxImpl;
 	friend class  mcToggleDensityFieldOutputImpl;
+	friend class  mcToggleInSituAnalysisImpl;
 	friend class  mcTogglePolymerDisplayImpl;
 	friend class  mcToggleRestartWarningMessagesImpl;
 	friend class  mcWriteLogMessageImpl;
@@ -307,8 +318,10 @@ protected:
 	bool InternalSetDisplayPeriod(long period);
     bool InternalSetRestartPeriod(long period);
     bool InternalSetSamplePeriod(long period);
+    bool InternalSetStateRetention(long currentStates, long densityStates);
 
     void InternalToggleEnergyOutput(bool bNormalizePerBead);
+    void InternalTogglePerformanceOutput(long period);
 	void InternalTogglePolymerDisplay(const zString polymerName) const;
 
 	// ****************************************
@@ -348,6 +361,8 @@ private:
 	// CDensityState objects
 
 	void SaveDensityStates();
+	void TrimCurrentStates();
+	void TrimDensityStates();
 	void SaveAggregateState() const;
 	void SaveAnalysisState()  const;
 	void SaveHistoryState()   const;
@@ -364,7 +379,7 @@ private:
 
 private:
 
-	static CMonitor* m_pInstance;		// Pointer to single instance of CMonitor class
+	static SimThreadLocal CMonitor* m_pInstance;		// Pointer to single instance of CMonitor class
 
 	CSimState* const m_pSimState;		// Pointer is const but CSimState can be changed
 
@@ -451,6 +466,7 @@ private:
 	// to monitor during the run
 
 	AggregateSequence	m_vAggregates;
+	AggregateSequence	m_vInSituAggregates;	// Aggregates passed to the in-situ analysis thread at the current sample
 
 	// Sequences of analysis objects created during the run to hold the data collected
 	// from the aggregates and the overall system
@@ -536,7 +552,13 @@ private:
 	zDoubleVector m_vLightY;
 	zDoubleVector m_vLightZ;
 
+	long m_CurrentStateRetention;			// No of CCurrentStates kept in memory (0 = all)
+	long m_DensityStateRetention;			// No of density grid samples kept in memory (0 = all)
+
 	zString m_DefaultCurrentStateFormat;	// Format of CCurrentState output for visualisation
+	CTrajectoryFile* m_pTrajectory;			// Binary trajectory written when the format is "Trajectory" or "CompressedTrajectory"
+	const double m_SnapshotPrecision;		// Grid spacing of coordinates in compressed snapshots and trajectories
+	CInSituAnalysis* m_pInSituAnalysis;		// Background analysis of aggregates, or 0 if it is off
 	bool m_bCurrentStateAnalysis;			// Save and analyse CCurrentState snapshots
 	bool m_bDisplayBox;						// Display bounding box in CCurrentState snapshot
 	bool m_bRestrictCurrentStateCoords;		// Restrict current state bead coordinates
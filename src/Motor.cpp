@@ -216,7 +216,7 @@ void CMotor::UpdateState(CSimState& rSimState, const ISimBox* const pISimBox)
 
 	for(cSliceVectorIterator iterSlice=m_pFuelSP->Begin(); iterSlice!=m_pFuelSP->End(); iterSlice++)
 	{
-		BeadList lBeads = (*iterSlice)->GetBeads();
+		const BeadList& lBeads = (*iterSlice)->GetBeads();
 
 		cBeadListIterator iterBead = find_if(lBeads.begin(), lBeads.end(), aaBeadType(m_FuelHeadType));
 
@@ -28,7 +28,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 // Static member variable holding the number of commands created.
 
-long CNanoparticle::m_NanoparticleTotal = 0;
+SimThreadLocal long CNanoparticle::m_NanoparticleTotal = 0;
 
 long CNanoparticle::GetNanoparticleTotal()
 {
@@ -41,8 +41,30 @@ long CNanoparticle::GetNanoparticleTotal()
 //////////////////////////////////////////////////////////////////////
 // Default constructor used to make empty polymer instances.
 
-CNanoparticle::CNanoparticle(BondVector vBonds) : m_id(++CNanoparticle::m_NanoparticleTotal), m_MaxWidth(0.0), m_XCM(0.0), m_YCM(0.0), m_ZCM(0.0), m_vBonds(vBonds)
+CNanoparticle::CNanoparticle(BondVector vBonds) : m_id(++CNanoparticle::m_NanoparticleTotal), m_MaxWidth(0.0), m_XCM(0.0), m_YCM(0.0), m_ZCM(0.0), m_vBonds(vBonds),
+                                                  m_bRigid(false)
 {
+    for(short int i=0; i<3; i++)
+    {
+        m_RigidCM[i]     = 0.0;
+        m_RigidVel[i]    = 0.0;
+        m_RigidAngMom[i] = 0.0;
+        m_RigidForce[i]  = 0.0;
+        m_RigidTorque[i] = 0.0;
+    }
+
+    for(short int j=0; j<9; j++)
+    {
+        m_BodyInertia[j] = 0.0;
+    }
+
+    m_Quaternion[0] = 1.0;
+    m_Quaternion[1] = 0.0;
+    m_Quaternion[2] = 0.0;
+    m_Quaternion[3] = 0.0;
+
+    m_vBodyPos.clear();
+
     // Create a local map <long, CAbstractBead*> mapping bead ids to instances
     // zPairLongBead is the map iterator
     // LongBeadMap is the container
@@ -122,10 +144,32 @@ CNanoparticle::CNanoparticle(BondVector vBonds) : m_id(++CNanoparticle::m_Nanopa
 // We just copy the original bond pointers into the new nanoparticle.
 
 CNanoparticle::CNanoparticle(const CNanoparticle &oldNanoparticle) : m_id(oldNanoparticle.m_id), 
-                                                                     m_MaxWidth(oldNanoparticle.m_MaxWidth)
+                                                                     m_MaxWidth(oldNanoparticle.m_MaxWidth),
+                                                                     m_bRigid(oldNanoparticle.m_bRigid)
 {
     m_vBonds = oldNanoparticle.m_vBonds;
     m_vBeads = oldNanoparticle.m_vBeads;
+
+    for(short int i=0; i<3; i++)
+    {
+        m_RigidCM[i]     = oldNanoparticle.m_RigidCM[i];
+        m_RigidVel[i]    = oldNanoparticle.m_RigidVel[i];
+        m_RigidAngMom[i] = oldNanoparticle.m_RigidAngMom[i];
+        m_RigidForce[i]  = oldNanoparticle.m_RigidForce[i];
+        m_RigidTorque[i] = oldNanoparticle.m_RigidTorque[i];
+    }
+
+    for(short int j=0; j<9; j++)
+    {
+        m_BodyInertia[j] = oldNanoparticle.m_BodyInertia[j];
+    }
+
+    for(short int k=0; k<4; k++)
+    {
+        m_Quaternion[k] = oldNanoparticle.m_Quaternion[k];
+    }
+
+    m_vBodyPos = oldNanoparticle.m_vBodyPos;
 }
 
 // The CNanoparticle destructor is responsible for destroying its own CBond objects. But note  
@@ -147,8 +191,13 @@ CNanoparticle::~CNanoparticle()
 
 // Functions to calculate the forces on a nanoparticle's beads due to its bonds.
 
+// The bonds of a rigid nanoparticle are not needed as its shape is fixed, so we skip them.
+
 void CNanoparticle::AddBondForces()
 {
+	if(m_bRigid)
+		return;
+
 	for(BondVectorIterator iterBond=m_vBonds.begin(); iterBond!=m_vBonds.end(); iterBond++)
 	{
 		(*iterBond)->AddForce();
@@ -366,7 +415,349 @@ bool CNanoparticle::IsComplete() const
     return bComplete;
 }
 
+// Function to convert the nanoparticle into a rigid body. Its beads are fixed
+// at their current positions relative to the CM, which defines the body frame,
+// and subsequently move as one body whose CM velocity and angular momentum
+// are integrated from the total force and torque on the beads. The NP's bonds
+// are no longer needed, so the stiff springs that would otherwise limit the 
+// time step are skipped.
+//
+// The SimBox side lengths are passed in so that the bead coordinates can be
+// unwrapped relative to the first bead for NPs that straddle a boundary. 
+// All beads are assumed to have unit mass. We return false if the NP is 
+// already rigid or has no beads.
+
+bool CNanoparticle::MakeRigid(double lx, double ly, double lz)
+{
+    if(m_bRigid || m_vBeads.empty())
+        return false;
+
+    const double beadTotal = static_cast<double>(GetBeadTotal());
+    const double box[3]    = {lx, ly, lz};
+
+    const CAbstractBead* const pRef = m_vBeads.front();
+
+    double cm[3] = {0.0, 0.0, 0.0};
+
+    m_vBodyPos.clear();
+    m_vBodyPos.reserve(3*m_vBeads.size());
+
+    for(cBeadVectorIterator citerBead=m_vBeads.begin(); citerBead!=m_vBeads.end(); citerBead++)
+    {
+        for(short int i=0; i<3; i++)
+        {
+            double dx = (*citerBead)->m_Pos[i] - pRef->m_Pos[i];
+
+            if(dx > 0.5*box[i])
+                dx -= box[i];
+            else if(dx < -0.5*box[i])
+                dx += box[i];
+
+            m_vBodyPos.push_back(dx);
+            cm[i] += dx;
+        }
+    }
+
+    for(short int i=0; i<3; i++)
+    {
+        cm[i] /= beadTotal;
+        m_RigidCM[i]  = pRef->m_Pos[i] + cm[i];
+        m_RigidVel[i] = 0.0;
+        m_RigidAngMom[i] = 0.0;
+    }
+
+    for(short int j=0; j<9; j++)
+    {
+        m_BodyInertia[j] = 0.0;
+    }
+
+    // Body-frame coordinates, CM velocity and inertia tensor
+
+    long index = 0;
+    for(cBeadVectorIterator citerBead=m_vBeads.begin(); citerBead!=m_vBeads.end(); citerBead++, index+=3)
+    {
+        double* const b = &m_vBodyPos[index];
+
+        b[0] -= cm[0];
+        b[1] -= cm[1];
+        b[2] -= cm[2];
+
+        const double b2 = b[0]*b[0] + b[1]*b[1] + b[2]*b[2];
+
+        for(short int i=0; i<3; i++)
+        {
+            for(short int j=0; j<3; j++)
+            {
+                m_BodyInertia[3*i+j] += (i == j ? b2 : 0.0) - b[i]*b[j];
+            }
+
+            m_RigidVel[i] += (*citerBead)->m_Mom[i];
+        }
+    }
+
+    for(short int i=0; i<3; i++)
+    {
+        m_RigidVel[i] /= beadTotal;
+    }
+
+    // Angular momentum of the beads about the CM
+
+    index = 0;
+    for(cBeadVectorIterator citerBead=m_vBeads.begin(); citerBead!=m_vBeads.end(); citerBead++, index+=3)
+    {
+        const double* const b = &m_vBodyPos[index];
+        const double v[3] = {(*citerBead)->m_Mom[0] - m_RigidVel[0],
+                             (*citerBead)->m_Mom[1] - m_RigidVel[1],
+                             (*citerBead)->m_Mom[2] - m_RigidVel[2]};
+
+        m_RigidAngMom[0] += b[1]*v[2] - b[2]*v[1];
+        m_RigidAngMom[1] += b[2]*v[0] - b[0]*v[2];
+        m_RigidAngMom[2] += b[0]*v[1] - b[1]*v[0];
+    }
+
+    m_Quaternion[0] = 1.0;
+    m_Quaternion[1] = 0.0;
+    m_Quaternion[2] = 0.0;
+    m_Quaternion[3] = 0.0;
+
+    m_bRigid = true;
+
+    // Store the current force and torque for the first half-step of the
+    // integration and set the bead velocities to the rigid-body values.
+
+    double rot[9];
+    GetRotationMatrix(rot);
+    SumRigidForces(rot);
 
+    double omega[3];
+    GetAngularVelocity(rot, omega);
 
+    index = 0;
+    for(BeadVectorIterator iterBead=m_vBeads.begin(); iterBead!=m_vBeads.end(); iterBead++, index+=3)
+    {
+        const double* const b = &m_vBodyPos[index];
+
+        (*iterBead)->m_Mom[0] = m_RigidVel[0] + omega[1]*b[2] - omega[2]*b[1];
+        (*iterBead)->m_Mom[1] = m_RigidVel[1] + omega[2]*b[0] - omega[0]*b[2];
+        (*iterBead)->m_Mom[2] = m_RigidVel[2] + omega[0]*b[1] - omega[1]*b[0];
+    }
+
+    return true;
+}
 
+// First half of the rigid-body velocity Verlet step. The CM velocity and angular
+// momentum are advanced by half a step using the force and torque from the 
+// previous step, and the CM and orientation by a full step. We then give each 
+// bead the momentum that makes CCNTCell::UpdatePos() move it to its new rigid-body 
+// position, and zero its force, so that the cell lists and unPBC coordinates
+// are updated in the usual way.
 
+void CNanoparticle::UpdateRigidPos(double dt)
+{
+    if(!m_bRigid || dt <= 0.0)
+        return;
+
+    const double halfdt = 0.5*dt;
+    const double mass   = static_cast<double>(GetBeadTotal());
+
+    for(short int i=0; i<3; i++)
+    {
+        m_RigidVel[i]    += halfdt*m_RigidForce[i]/mass;
+        m_RigidAngMom[i] += halfdt*m_RigidTorque[i];
+    }
+
+    double oldRot[9];
+    GetRotationMatrix(oldRot);
+
+    double omega[3];
+    GetAngularVelocity(oldRot, omega);
+
+    const double oldCM[3] = {m_RigidCM[0], m_RigidCM[1], m_RigidCM[2]};
+
+    m_RigidCM[0] += dt*m_RigidVel[0];
+    m_RigidCM[1] += dt*m_RigidVel[1];
+    m_RigidCM[2] += dt*m_RigidVel[2];
+
+    // Rotate the orientation by the angle |omega|*dt about the space-frame 
+    // axis omega: q -> dq*q, and renormalise to remove rounding drift.
+
+    const double wmag = sqrt(omega[0]*omega[0] + omega[1]*omega[1] + omega[2]*omega[2]);
+
+    if(wmag > 0.0)
+    {
+        const double halfAngle = halfdt*wmag;
+        const double s  = sin(halfAngle)/wmag;
+        const double dq[4] = {cos(halfAngle), s*omega[0], s*omega[1], s*omega[2]};
+        const double* const q = m_Quaternion;
+
+        double newq[4];
+        newq[0] = dq[0]*q[0] - dq[1]*q[1] - dq[2]*q[2] - dq[3]*q[3];
+        newq[1] = dq[0]*q[1] + dq[1]*q[0] + dq[2]*q[3] - dq[3]*q[2];
+        newq[2] = dq[0]*q[2] - dq[1]*q[3] + dq[2]*q[0] + dq[3]*q[1];
+        newq[3] = dq[0]*q[3] + dq[1]*q[2] - dq[2]*q[1] + dq[3]*q[0];
+
+        const double qnorm = sqrt(newq[0]*newq[0] + newq[1]*newq[1] + newq[2]*newq[2] + newq[3]*newq[3]);
+
+        for(short int k=0; k<4; k++)
+        {
+            m_Quaternion[k] = newq[k]/qnorm;
+        }
+    }
+
+    double newRot[9];
+    GetRotationMatrix(newRot);
+
+    long index = 0;
+    for(BeadVectorIterator iterBead=m_vBeads.begin(); iterBead!=m_vBeads.end(); iterBead++, index+=3)
+    {
+        const double* const b = &m_vBodyPos[index];
+
+        for(short int i=0; i<3; i++)
+        {
+            const double oldPos = oldCM[i]    + oldRot[3*i]*b[0] + oldRot[3*i+1]*b[1] + oldRot[3*i+2]*b[2];
+            const double newPos = m_RigidCM[i] + newRot[3*i]*b[0] + newRot[3*i+1]*b[1] + newRot[3*i+2]*b[2];
+
+            (*iterBead)->m_Mom[i]   = (newPos - oldPos)/dt;
+            (*iterBead)->m_Force[i] = 0.0;
+        }
+    }
+}
+
+// Second half of the rigid-body velocity Verlet step. The new bead forces are
+// summed into the total force and torque on the body, the CM velocity and 
+// angular momentum are advanced by half a step, and the bead momenta replaced
+// by their rigid-body values. The bead forces are left unchanged so that they
+// remain available for analysis.
+
+void CNanoparticle::UpdateRigidMom(double dt)
+{
+    if(!m_bRigid)
+        return;
+
+    const double halfdt = 0.5*dt;
+    const double mass   = static_cast<double>(GetBeadTotal());
+
+    double rot[9];
+    GetRotationMatrix(rot);
+    SumRigidForces(rot);
+
+    for(short int i=0; i<3; i++)
+    {
+        m_RigidVel[i]    += halfdt*m_RigidForce[i]/mass;
+        m_RigidAngMom[i] += halfdt*m_RigidTorque[i];
+    }
+
+    double omega[3];
+    GetAngularVelocity(rot, omega);
+
+    long index = 0;
+    for(BeadVectorIterator iterBead=m_vBeads.begin(); iterBead!=m_vBeads.end(); iterBead++, index+=3)
+    {
+        const double* const b = &m_vBodyPos[index];
+        const double r[3] = {rot[0]*b[0] + rot[1]*b[1] + rot[2]*b[2],
+                             rot[3]*b[0] + rot[4]*b[1] + rot[5]*b[2],
+                             rot[6]*b[0] + rot[7]*b[1] + rot[8]*b[2]};
+
+        (*iterBead)->m_Mom[0] = m_RigidVel[0] + omega[1]*r[2] - omega[2]*r[1];
+        (*iterBead)->m_Mom[1] = m_RigidVel[1] + omega[2]*r[0] - omega[0]*r[2];
+        (*iterBead)->m_Mom[2] = m_RigidVel[2] + omega[0]*r[1] - omega[1]*r[0];
+    }
+}
+
+// Private helper function to return the rotation matrix (row-major) that takes
+// body-frame coordinates into the space frame.
+
+void CNanoparticle::GetRotationMatrix(double rot[9]) const
+{
+    const double w = m_Quaternion[0];
+    const double x = m_Quaternion[1];
+    const double y = m_Quaternion[2];
+    const double z = m_Quaternion[3];
+
+    rot[0] = 1.0 - 2.0*(y*y + z*z);
+    rot[1] = 2.0*(x*y - w*z);
+    rot[2] = 2.0*(x*z + w*y);
+    rot[3] = 2.0*(x*y + w*z);
+    rot[4] = 1.0 - 2.0*(x*x + z*z);
+    rot[5] = 2.0*(y*z - w*x);
+    rot[6] = 2.0*(x*z - w*y);
+    rot[7] = 2.0*(y*z + w*x);
+    rot[8] = 1.0 - 2.0*(x*x + y*y);
+}
+
+// Private helper function to calculate the angular velocity from the angular
+// momentum and the space-frame inertia tensor, I = R*Ibody*R^T. If the inertia
+// tensor is singular (a single bead or a linear set of beads) the body does
+// not rotate.
+
+void CNanoparticle::GetAngularVelocity(const double rot[9], double omega[3]) const
+{
+    double tmp[9];
+    double inertia[9];
+
+    for(short int i=0; i<3; i++)
+    {
+        for(short int j=0; j<3; j++)
+        {
+            tmp[3*i+j] = rot[3*i]*m_BodyInertia[j] + rot[3*i+1]*m_BodyInertia[3+j] + rot[3*i+2]*m_BodyInertia[6+j];
+        }
+    }
+
+    for(short int i=0; i<3; i++)
+    {
+        for(short int j=0; j<3; j++)
+        {
+            inertia[3*i+j] = tmp[3*i]*rot[3*j] + tmp[3*i+1]*rot[3*j+1] + tmp[3*i+2]*rot[3*j+2];
+        }
+    }
+
+    const double c0 = inertia[4]*inertia[8] - inertia[5]*inertia[7];
+    const double c1 = inertia[5]*inertia[6] - inertia[3]*inertia[8];
+    const double c2 = inertia[3]*inertia[7] - inertia[4]*inertia[6];
+
+    const double det = inertia[0]*c0 + inertia[1]*c1 + inertia[2]*c2;
+
+    if(fabs(det) < 0.000000001)
+    {
+        omega[0] = 0.0;
+        omega[1] = 0.0;
+        omega[2] = 0.0;
+        return;
+    }
+
+    const double* const L = m_RigidAngMom;
+
+    omega[0] = (c0*L[0] + (inertia[2]*inertia[7] - inertia[1]*inertia[8])*L[1] + (inertia[1]*inertia[5] - inertia[2]*inertia[4])*L[2])/det;
+    omega[1] = (c1*L[0] + (inertia[0]*inertia[8] - inertia[2]*inertia[6])*L[1] + (inertia[2]*inertia[3] - inertia[0]*inertia[5])*L[2])/det;
+    omega[2] = (c2*L[0] + (inertia[1]*inertia[6] - inertia[0]*inertia[7])*L[1] + (inertia[0]*inertia[4] - inertia[1]*inertia[3])*L[2])/det;
+}
+
+// Private helper function to sum the forces on the NP's beads into the total 
+// force and the torque about the CM.
+
+void CNanoparticle::SumRigidForces(const double rot[9])
+{
+    for(short int i=0; i<3; i++)
+    {
+        m_RigidForce[i]  = 0.0;
+        m_RigidTorque[i] = 0.0;
+    }
+
+    long index = 0;
+    for(cBeadVectorIterator citerBead=m_vBeads.begin(); citerBead!=m_vBeads.end(); citerBead++, index+=3)
+    {
+        const double* const b = &m_vBodyPos[index];
+        const double* const f = (*citerBead)->m_Force;
+        const double r[3] = {rot[0]*b[0] + rot[1]*b[1] + rot[2]*b[2],
+                             rot[3]*b[0] + rot[4]*b[1] + rot[5]*b[2],
+                             rot[6]*b[0] + rot[7]*b[1] + rot[8]*b[2]};
+
+        m_RigidForce[0] += f[0];
+        m_RigidForce[1] += f[1];
+        m_RigidForce[2] += f[2];
+
+        m_RigidTorque[0] += r[1]*f[2] - r[2]*f[1];
+        m_RigidTorque[1] += r[2]*f[0] - r[0]*f[2];
+        m_RigidTorque[2] += r[0]*f[1] - r[1]*f[0];
+    }
+}
@@ -37,7 +37,7 @@ public:
 
 private:
 
-	static long m_NanoparticleTotal;	// Number of nanoparticles created
+	static SimThreadLocal long m_NanoparticleTotal;	// Number of nanoparticles created
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -77,6 +77,15 @@ public:
 
     void CalculateCM();
 
+    // Rigid-body integration: the NP's beads move as a single body whose
+    // centre of mass and orientation are updated from the summed bead forces.
+
+    inline bool IsRigid() const {return m_bRigid;}
+
+    bool MakeRigid(double lx, double ly, double lz);
+    void UpdateRigidPos(double dt);     // Called before CCNTCell::UpdatePos()
+    void UpdateRigidMom(double dt);     // Called after CCNTCell::UpdateMom()
+
 	// ****************************************
 	// Protected local functions
 protected:
@@ -90,6 +99,9 @@ protected:
 	// Private functions
 private:
 
+    void GetRotationMatrix(double rot[9]) const;
+    void GetAngularVelocity(const double rot[9], double omega[3]) const;
+    void SumRigidForces(const double rot[9]);
 
 	// ****************************************
 	// Data members
@@ -105,6 +117,16 @@ private:
     BondVector  m_vBonds;    // Set of bonds used to polymerise the nanoparticle
     BeadVector  m_vBeads;    // Set of concrete beads in the NP's bonds
 
+    bool        m_bRigid;           // Flag showing if the NP is integrated as a rigid body
+    double      m_RigidCM[3];       // Unwrapped centre of mass of the rigid body
+    double      m_RigidVel[3];      // Centre of mass velocity
+    double      m_RigidAngMom[3];   // Angular momentum about the CM in the space frame
+    double      m_RigidForce[3];    // Total force on the beads
+    double      m_RigidTorque[3];   // Total torque about the CM
+    double      m_Quaternion[4];    // Orientation relative to the body frame (w, x, y, z)
+    double      m_BodyInertia[9];   // Inertia tensor in the body frame
+    zDoubleVector m_vBodyPos;       // Bead coordinates relative to the CM in the body frame
+
 //    ExtendedNPBondVector m_vExtBonds;  // Set of bonds that cross processor boundaries
 
 };
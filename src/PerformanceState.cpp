@@ -0,0 +1,104 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// PerformanceState.cpp: implementation of the CPerformanceState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "PerformanceState.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Constructor to open a stream attached to the performance log file. Each
+// line of the file holds the simulation time at the end of a period, the 
+// mean wall-clock time in milliseconds spent per step in each phase of the
+// integration loop, the total time per step, and the mean number of 
+// bead pairs examined and beads that changed cells per step. The header
+// line names the columns. The pair and migration counters are running 
+// totals kept by the CNT cells, so we store their values at construction 
+// as the baseline for the first period.
+
+CPerformanceState::CPerformanceState(const zString runId, long currentTime, long period,
+									 long pairTotal, long migrationTotal) : xxState(xxBase::GetPFPrefix() + runId, true, currentTime, runId),
+													m_Period(period > 0 ? period : 1),
+													m_StepCounter(0),
+													m_PairStart(pairTotal), m_MigrationStart(migrationTotal),
+													m_PairTotal(pairTotal), m_MigrationTotal(migrationTotal)
+{
+	Reset();
+
+	m_outStream << "# Time Commands UpdatePos UpdateForce BondForces ActiveCharged Targets UpdateMom CNTCellCheck Sample SaveState Total Pairs Migrations" << zEndl;
+}
+
+CPerformanceState::~CPerformanceState()
+{
+
+}
+
+// Function to record the counters at the end of a timestep and write the
+// averages out when a period has elapsed.
+
+void CPerformanceState::EndStep(long simTime, long pairTotal, long migrationTotal)
+{
+	m_CurrentTime    = simTime;
+	m_PairTotal      = pairTotal;
+	m_MigrationTotal = migrationTotal;
+
+	if(++m_StepCounter == m_Period)
+	{
+		Serialize();
+		Reset();
+	}
+}
+
+bool CPerformanceState::Serialize()
+{
+	if(m_IOFlag && m_StepCounter > 0)
+	{
+		const double norm = 1000.0/static_cast<double>(m_StepCounter);
+
+		double total = 0.0;
+
+		m_outStream << m_CurrentTime;
+
+		for(long phase=0; phase<PhaseTotal; phase++)
+		{
+			m_outStream << " " << norm*m_PhaseTime[phase];
+			total += m_PhaseTime[phase];
+		}
+
+		m_outStream << " " << norm*total;
+		m_outStream << " " << (m_PairTotal - m_PairStart)/m_StepCounter;
+		m_outStream << " " << (m_MigrationTotal - m_MigrationStart)/m_StepCounter << zEndl;
+	}
+
+	return IsFileStateOk();
+}
+
+// Private function to zero the accumulators at the start of a new period.
+
+void CPerformanceState::Reset()
+{
+	m_StepCounter    = 0;
+	m_PairStart      = m_PairTotal;
+	m_MigrationStart = m_MigrationTotal;
+
+	for(long phase=0; phase<PhaseTotal; phase++)
+	{
+		m_PhaseTime[phase] = 0.0;
+	}
+}
@@ -0,0 +1,96 @@
+// PerformanceState.h: interface for the CPerformanceState class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_PERFORMANCESTATE_H__C8F150D7_C6FF_4E1E_85CD_DFF9A1756190__INCLUDED_)
+#define AFX_PERFORMANCESTATE_H__C8F150D7_C6FF_4E1E_85CD_DFF9A1756190__INCLUDED_
+
+
+#include "xxState.h"
+
+#include <chrono>
+
+class CPerformanceState : public xxState  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CPerformanceState(const zString runId, long currentTime, long period,
+					  long pairTotal, long migrationTotal);
+
+	virtual ~CPerformanceState();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	// Indices of the phases of a timestep that are timed separately
+
+	static const long Commands         = 0;
+	static const long UpdatePos        = 1;
+	static const long UpdateForce      = 2;
+	static const long BondForces       = 3;
+	static const long ActiveCharged    = 4;
+	static const long Targets          = 5;
+	static const long UpdateMom        = 6;
+	static const long CNTCellCheck     = 7;
+	static const long Sample           = 8;
+	static const long SaveState        = 9;
+	static const long PhaseTotal       = 10;
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	bool Serialize();
+
+	// ****************************************
+	// Public access functions
+public:
+
+	// Phases are timed back-to-back: StartPhase() marks the beginning of a
+	// timestep and each EndPhase() charges the time since the previous mark
+	// to the given phase and starts timing the next one.
+
+	inline void StartPhase() {m_PhaseStart = std::chrono::steady_clock::now();}
+
+	inline void EndPhase(long phase)
+	{
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		m_PhaseTime[phase] += std::chrono::duration<double>(now - m_PhaseStart).count();
+		m_PhaseStart = now;
+	}
+
+	void EndStep(long simTime, long pairTotal, long migrationTotal);
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+	// ****************************************
+	// Private functions
+private:
+
+	void Reset();
+
+	// ****************************************
+	// Data members
+private:
+
+	const long m_Period;        // Number of steps averaged over per output line
+	long   m_StepCounter;       // Steps accumulated since the last output line
+	long   m_PairStart;         // Pair count at the start of the current period
+	long   m_MigrationStart;    // Migration count at the start of the current period
+	long   m_PairTotal;         // Latest cumulative pair count
+	long   m_MigrationTotal;    // Latest cumulative migration count
+	double m_PhaseTime[PhaseTotal];  // Wall-clock time (s) spent in each phase this period
+
+	std::chrono::steady_clock::time_point m_PhaseStart;
+
+};
+
+#endif // !defined(AFX_PERFORMANCESTATE_H__C8F150D7_C6FF_4E1E_85CD_DFF9A1756190__INCLUDED_)
@@ -27,6 +27,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "ISimBoxBase.h"
 #include "mpuExtendedPolymer.h"
 
+#include <new>
+
 //////////////////////////////////////////////////////////////////////
 // Global functions
 //////////////////////////////////////////////////////////////////////
@@ -47,7 +49,7 @@ bool operator==(const CPolymer& a, const CPolymer& b)
 //////////////////////////////////////////////////////////////////////
 // Default constructor used to make empty polymer instances.
 
-CPolymer::CPolymer() : m_id(0), m_Type(0), m_pHead(0), m_pTail(0)
+CPolymer::CPolymer() : m_id(0), m_Type(0), m_pHead(0), m_pTail(0), m_bArena(false)
 {
 
 #if EnableParallelSimBox == SimMPSEnabled
@@ -83,7 +85,8 @@ CPolymer::CPolymer(long type, bool blinear, double fraction,
 													m_pHead(pHead),
 													m_pTail(pTail),
 													m_vBeads(vBeads),
-													m_vBonds(vBonds)
+													m_vBonds(vBonds),
+													m_bArena(false)
 {
 
 #if EnableParallelSimBox == SimMPSEnabled
@@ -101,7 +104,8 @@ CPolymer::CPolymer(long type, bool blinear, double fraction,
 													m_pTail(pTail),
 													m_vBeads(vBeads),
 													m_vBonds(vBonds),
-													m_vBondPairs(vBondPairs)
+													m_vBondPairs(vBondPairs),
+													m_bArena(false)
 {
 
 #if EnableParallelSimBox == SimMPSEnabled
@@ -112,18 +116,25 @@ CPolymer::CPolymer(long type, bool blinear, double fraction,
 
 
 // The CPolymer destructor is responsible for destroying its own CBeads, CBonds and
-// CBondPair objects.
+// CBondPair objects unless they are owned by a CPolymerArena.
 
 CPolymer::~CPolymer()
 {
 	// Remove the head bead if it is a CWallBead not included in the vector of
-	// CBeads that are deleted next.
+	// CBeads that are deleted next. Wall beads are always allocated singly.
 
 	if(dynamic_cast<CWallBead*>(m_pHead))
 	{
 		delete m_pHead;
 	}
 
+	if(m_bArena)
+	{
+		m_vBeads.clear();
+		m_vBonds.clear();
+		m_vBondPairs.clear();
+	}
+
 	if(!m_vBeads.empty())
 	{
 		for(BeadVectorIterator iterBead=m_vBeads.begin(); iterBead!=m_vBeads.end(); iterBead++)
@@ -162,7 +173,27 @@ CPolymer::~CPolymer()
 // their owning polymer so that they can navigate upwards when passing beads
 // between processors.
 
-CPolymer::CPolymer(const CPolymer &oldPolymer)
+CPolymer::CPolymer(const CPolymer &oldPolymer) : m_bArena(false)
+{
+	CopyComponents(oldPolymer, 0, 0, 0);
+}
+
+// Constructor that copies a polymer type into storage owned by a CPolymerArena.
+// The pointers give the uninitialised memory for this polymer's beads, bonds and
+// bondpairs, which must be large enough to hold the numbers in the polymer type. 
+// The polymer does not delete them when it is destroyed.
+
+CPolymer::CPolymer(const CPolymer& oldPolymer, CBead* pBeads, CBond* pBonds, CBondPair* pBondPairs) : m_bArena(true)
+{
+	CopyComponents(oldPolymer, pBeads, pBonds, pBondPairs);
+}
+
+// Function used by the copy constructors to copy the beads, bonds and bondpairs
+// of a polymer type. If the storage pointers are null each object is allocated 
+// separately, otherwise they are constructed in consecutive locations starting 
+// at the pointers.
+
+void CPolymer::CopyComponents(const CPolymer& oldPolymer, CBead* pBeads, CBond* pBonds, CBondPair* pBondPairs)
 {
 	m_id				=	oldPolymer.m_id;
 	m_Type				=	oldPolymer.m_Type;
@@ -179,7 +210,7 @@ CPolymer::CPolymer(const CPolymer &oldPolymer)
 
 	for(cBeadVectorIterator iterBead=oldPolymer.m_vBeads.begin(); iterBead!=oldPolymer.m_vBeads.end(); iterBead++)
 	{
-		CBead* pBead = new CBead(**iterBead);
+		CBead* pBead = pBeads ? new(pBeads++) CBead(**iterBead) : new CBead(**iterBead);
 
 #if EnableParallelSimBox == SimMPSEnabled
 		pBead->SetOwningPolymer(this);
@@ -197,7 +228,7 @@ CPolymer::CPolymer(const CPolymer &oldPolymer)
 
 	for(cBondVectorIterator iterBond=oldPolymer.m_vBonds.begin(); iterBond!=oldPolymer.m_vBonds.end(); iterBond++)
 	{
-		CBond* pBond = new CBond(**iterBond);
+		CBond* pBond = pBonds ? new(pBonds++) CBond(**iterBond) : new CBond(**iterBond);
 		pBond->SetBeads(m_vBeads.at(pBond->GetHeadIndex()), m_vBeads.at(pBond->GetTailIndex()));
 		m_vBonds.push_back(pBond);
 	}
@@ -208,7 +239,7 @@ CPolymer::CPolymer(const CPolymer &oldPolymer)
 
 	for(cBondPairVectorIterator iterBP=oldPolymer.m_vBondPairs.begin(); iterBP!=oldPolymer.m_vBondPairs.end(); iterBP++)
 	{
-		CBondPair* pBondPair = new CBondPair(**iterBP);
+		CBondPair* pBondPair = pBondPairs ? new(pBondPairs++) CBondPair(**iterBP) : new CBondPair(**iterBP);
 		pBondPair->SetBonds( m_vBonds.at((*iterBP)->GetFirstIndex()), 
 							 m_vBonds.at((*iterBP)->GetSecondIndex()) );
 		m_vBondPairs.push_back(pBondPair);
@@ -310,14 +341,17 @@ void CPolymer::ChangeHeadtoWallBead()
 	// the new head bead into m_vBeads because that only holds CBead* and the head bead
 	// is now a CWallBead*
 
-	if(m_pTail == m_pHead)	// update the head and tail pointers and delete old head
+	if(!m_bArena)
 	{
 		delete m_pHead;
+	}
+
+	if(m_pTail == m_pHead)	// update the head and tail pointers
+	{
 		m_pTail = m_pHead = pNewHead;
 	}
 	else
 	{
-		delete m_pHead;
 		m_pHead = pNewHead;
 	}
 
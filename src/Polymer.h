@@ -42,6 +42,11 @@ public:
 	CPolymer(const CPolymer& oldPolymer);
 	CPolymer& operator =(const CPolymer &oldPolymer);
 
+	// Constructor used by CPolymerArena to copy a polymer type into storage 
+	// that it owns, instead of allocating the beads, bonds and bondpairs singly
+
+	CPolymer(const CPolymer& oldPolymer, CBead* pBeads, CBond* pBonds, CBondPair* pBondPairs);
+
 	// ****************************************
 	// Global functions, static member functions and variables
 public:
@@ -61,6 +66,8 @@ public:
 	inline long   GetId()         const {return m_id;}
 	inline long   GetType()       const {return m_Type;}
 	inline long   GetSize()       const {return m_vBeads.size();}
+	inline long   GetBondTotal()     const {return m_vBonds.size();}
+	inline long   GetBondPairTotal() const {return m_vBondPairs.size();}
 
 	inline CAbstractBead*    GetHead() const	 {return m_pHead;}
 	inline CAbstractBead*    GetTail() const	 {return m_pTail;}
@@ -166,6 +173,7 @@ protected:
 	// Private functions
 private:
 
+	void CopyComponents(const CPolymer& oldPolymer, CBead* pBeads, CBond* pBonds, CBondPair* pBondPairs);
 
 	// ****************************************
 	// Data members
@@ -185,6 +193,8 @@ private:
 	BeadVector		m_vBeads;
 	BondVector		m_vBonds;
 	BondPairVector	m_vBondPairs;
+
+	bool            m_bArena;	// Flag showing if the beads, bonds and bondpairs are owned by a CPolymerArena
 };
 
 #endif // !defined(AFX_POLYMER_H__A2FACF41_3F61_11D3_820E_0060088AD300__INCLUDED_)
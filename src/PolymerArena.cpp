@@ -0,0 +1,131 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// PolymerArena.cpp: implementation of the CPolymerArena class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "PolymerArena.h"
+#include "Polymer.h"
+#include "Bead.h"
+#include "Bond.h"
+#include "BondPair.h"
+
+#include <cstddef>
+#include <new>
+
+// Round a byte count up to a multiple of the largest fundamental alignment so
+// that each section of a block starts at a correctly aligned address.
+
+namespace
+{
+	size_t AlignedSize(size_t bytes)
+	{
+		const size_t alignment = alignof(std::max_align_t);
+
+		return ((bytes + alignment - 1)/alignment)*alignment;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class that owns the memory for all the polymers created from the polymer
+// types in CInitialState::CreatePolymers(), together with their beads, bonds
+// and bondpairs. Instead of allocating every object separately, all polymers of
+// one type are created in a single block: the polymers come first, then the
+// beads of the first polymer, the second polymer, and so on, then the bonds
+// and the bondpairs laid out in the same way. The beads and bonds of a polymer
+// are therefore contiguous in memory, and so are those of successive polymers, 
+// which are stored in this order in the CInitialState's vectors of all beads 
+// and bonds.
+//
+// The polymers are flagged as not owning their beads, bonds and bondpairs. When
+// the arena is destroyed it calls the destructor of each polymer, bead, bond 
+// and bondpair in the blocks and then releases the memory.
+
+CPolymerArena::CPolymerArena()
+{
+	m_vBlocks.clear();
+}
+
+CPolymerArena::~CPolymerArena()
+{
+	for(xxBasevector<Block>::iterator iterBlock=m_vBlocks.begin(); iterBlock!=m_vBlocks.end(); iterBlock++)
+	{
+		for(long i=0; i<iterBlock->total; i++)
+		{
+			iterBlock->pPolymers[i].~CPolymer();
+		}
+
+		for(long j=0; j<iterBlock->beadTotal; j++)
+		{
+			iterBlock->pBeads[j].~CBead();
+		}
+
+		for(long k=0; k<iterBlock->bondTotal; k++)
+		{
+			iterBlock->pBonds[k].~CBond();
+		}
+
+		for(long m=0; m<iterBlock->bondPairTotal; m++)
+		{
+			iterBlock->pBondPairs[m].~CBondPair();
+		}
+
+		::operator delete(iterBlock->pMemory);
+	}
+
+	m_vBlocks.clear();
+}
+
+// Function to create a number of copies of a polymer type in a new block and
+// return a pointer to the first of them. The polymers are stored contiguously 
+// so the caller can index them from the returned pointer. As for the CPolymer
+// copy constructor, the caller must set the ids of the polymers and their beads,
+// bonds and bondpairs.
+
+CPolymer* CPolymerArena::AddPolymers(const CPolymer& polymerType, long total)
+{
+	if(total <= 0)
+		return 0;
+
+	const long beadTotal     = polymerType.GetSize();
+	const long bondTotal     = polymerType.GetBondTotal();
+	const long bondPairTotal = polymerType.GetBondPairTotal();
+
+	const size_t polymerBytes  = AlignedSize(total*sizeof(CPolymer));
+	const size_t beadBytes     = AlignedSize(total*beadTotal*sizeof(CBead));
+	const size_t bondBytes     = AlignedSize(total*bondTotal*sizeof(CBond));
+	const size_t bondPairBytes = AlignedSize(total*bondPairTotal*sizeof(CBondPair));
+
+	char* const pMemory = static_cast<char*>(::operator new(polymerBytes + beadBytes + bondBytes + bondPairBytes));
+
+	CPolymer*  const pPolymers  = reinterpret_cast<CPolymer*>(pMemory);
+	CBead*     const pBeads     = reinterpret_cast<CBead*>(pMemory + polymerBytes);
+	CBond*     const pBonds     = reinterpret_cast<CBond*>(pMemory + polymerBytes + beadBytes);
+	CBondPair* const pBondPairs = reinterpret_cast<CBondPair*>(pMemory + polymerBytes + beadBytes + bondBytes);
+
+	for(long i=0; i<total; i++)
+	{
+		new(pPolymers + i) CPolymer(polymerType, pBeads + i*beadTotal, pBonds + i*bondTotal, pBondPairs + i*bondPairTotal);
+	}
+
+	Block block = {pMemory, pPolymers, total, pBeads, total*beadTotal, pBonds, total*bondTotal, pBondPairs, total*bondPairTotal};
+	m_vBlocks.push_back(block);
+
+	return pPolymers;
+}
@@ -0,0 +1,76 @@
+// PolymerArena.h: interface for the CPolymerArena class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_POLYMERARENA_H__E2EA71AD_5659_4292_89A1_657229180651__INCLUDED_)
+#define AFX_POLYMERARENA_H__E2EA71AD_5659_4292_89A1_657229180651__INCLUDED_
+
+
+#include "xxBase.h"
+
+class CPolymerArena  
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CPolymerArena();
+
+	~CPolymerArena();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	CPolymer* AddPolymers(const CPolymer& polymerType, long total);
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+
+	// ****************************************
+	// Implementation
+
+protected:
+
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	CPolymerArena(const CPolymerArena& oldArena);
+	CPolymerArena& operator=(const CPolymerArena& rhs);
+
+	// ****************************************
+	// Data members
+
+private:
+
+	// Each block holds all the polymers of one type followed by their beads,
+	// bonds and bondpairs. We store the location and number of each kind of 
+	// object so that their destructors can be called before the memory is released.
+
+	struct Block
+	{
+		void*      pMemory;
+		CPolymer*  pPolymers;
+		long       total;
+		CBead*     pBeads;
+		long       beadTotal;
+		CBond*     pBonds;
+		long       bondTotal;
+		CBondPair* pBondPairs;
+		long       bondPairTotal;
+	};
+
+	xxBasevector<Block> m_vBlocks;
+};
+
+#endif // !defined(AFX_POLYMERARENA_H__E2EA71AD_5659_4292_89A1_657229180651__INCLUDED_)
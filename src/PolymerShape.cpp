@@ -0,0 +1,295 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// PolymerShape.cpp: implementation of the CPolymerShape class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "PolymerShape.h"
+
+// Characters that may appear in bead names and multipliers, and the operators
+// that define side branches and loops. These match the definitions used by
+// CInputData to validate bead and polymer names.
+
+const zString CPolymerShape::branchChar			   = "*";
+const zString CPolymerShape::loopChar			   = "/";
+const zString CPolymerShape::validNameChars		   = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+const zString CPolymerShape::validNumOpChars	   = "0123456789";
+const zString CPolymerShape::validSeparatorOpChars = "-_";
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class that compiles a polymer shape string, e.g., (H H (* (4 T)) H (4 T)),
+// into a flat sequence of instructions in a single pass over the string.
+// CInputData executes the instructions to create the beads and bonds of the 
+// polymer type, so the shape string is never re-parsed, and a multiplier
+// element is stored once however many times it repeats.
+//
+// The grammar is that described in CInputData::WriteDefaultControlDataFile():
+//
+//	shape    := "(" element+ ")"
+//	element  := beadname | "(" element+ ")" | "(" number element+ ")"
+//	            | "(" "*" branch ")" | "(" "/" number beadname ")"
+//	branch   := beadname | "(" beadname element* ")"
+//
+// Multipliers and operators may only appear as the first token inside a 
+// pair of brackets, every bead name must be in the map passed in, and a
+// multiplier or loop id must be greater than zero. Elements are separated
+// by spaces, but brackets and operators need not be. If the shape breaks
+// any of these rules the IsValid() flag is false and the instructions
+// should not be used.
+
+CPolymerShape::CPolymerShape(const zString shape, const StringLongMap& mBeadNames) : m_Shape(shape),
+									m_mBeadNames(mBeadNames),
+									m_bValid(false), m_bLinear(true),
+									m_TopElementTotal(0),
+									m_bFirstIsBead(false), m_bLastIsBead(false)
+{
+	size_t pos = 0;
+	zString token;
+
+	if(!NextToken(&pos, token) || token != "(")
+		return;
+
+	// The outermost brackets are handled here rather than in CompileSequence()
+	// so that we can record whether the first and last elements are bead names.
+
+	m_bValid = true;
+
+	size_t next = pos;
+
+	while(m_bValid && NextToken(&next, token) && token != ")")
+	{
+		const bool bBead = IsBeadName(token);
+
+		if(m_TopElementTotal == 0)
+			m_bFirstIsBead = bBead;
+
+		m_bLastIsBead = bBead;
+		m_TopElementTotal++;
+
+		m_bValid = CompileElement(&pos);
+		next = pos;
+	}
+
+	// The shape must contain at least one element and nothing may follow 
+	// its closing bracket.
+
+	if(token != ")" || m_TopElementTotal == 0 || NextToken(&next, token))
+		m_bValid = false;
+}
+
+CPolymerShape::~CPolymerShape()
+{
+
+}
+
+// Function showing if the first and last elements in the outermost brackets
+// are bead names. This is required when the polymer's head and tail are 
+// taken to be its first and last beads. A shape with only one element 
+// satisfies the test if that element is a bead name.
+
+bool CPolymerShape::HasBeadEnds() const
+{
+	return m_bFirstIsBead && (m_TopElementTotal == 1 || m_bLastIsBead);
+}
+
+// Function to return the number of times a bead name is written in the shape.
+// Multipliers are not expanded, so a bead in the element (4 B) counts once.
+// This is used to check that named head and tail beads are unique.
+
+long CPolymerShape::GetBeadNameCount(const zString name) const
+{
+	long total = 0;
+
+	for(cInstructionIterator iterIns=m_vInstructions.begin(); iterIns!=m_vInstructions.end(); iterIns++)
+	{
+		if((iterIns->op == opBead || iterIns->op == opLoop) && iterIns->name == name)
+			total++;
+	}
+
+	return total;
+}
+
+// Function to compile the element that starts at the current position in 
+// the shape string. A bead name is compiled directly; a compound element is
+// compiled according to its first token, and the position is left after
+// its closing bracket. Returns false if the element breaks the grammar.
+
+bool CPolymerShape::CompileElement(size_t* pPos)
+{
+	zString token;
+
+	if(!NextToken(pPos, token))
+		return false;
+	else if(IsBeadName(token))
+	{
+		Instruction bead = {opBead, 0, token};
+		m_vInstructions.push_back(bead);
+		return true;
+	}
+	else if(token != "(")		// multiplier, operator or bracket out of place
+		return false;
+
+	size_t next = *pPos;
+
+	if(!NextToken(&next, token))
+		return false;
+	else if(IsMultiplier(token))
+	{
+		// The instructions for the multiplied elements are stored once and
+		// the opEndRepeat instruction holds the index of its opRepeat so that
+		// they can be executed the required number of times.
+
+		*pPos = next;
+
+		const long repeatIndex = m_vInstructions.size();
+
+		Instruction repeat = {opRepeat, atol(token.c_str()), ""};
+		m_vInstructions.push_back(repeat);
+
+		if(repeat.arg < 1 || !CompileSequence(pPos))
+			return false;
+
+		Instruction endRepeat = {opEndRepeat, repeatIndex, ""};
+		m_vInstructions.push_back(endRepeat);
+	}
+	else if(token == branchChar)
+	{
+		// A side branch contains a single bead name or a compound element
+		// that starts with a bead name.
+
+		*pPos = next;
+		m_bLinear = false;
+
+		if(!NextToken(&next, token))
+			return false;
+		else if(token == "(" && !(NextToken(&next, token) && IsBeadName(token)))
+			return false;
+		else if(token != "(" && !IsBeadName(token))
+			return false;
+
+		Instruction branch = {opBranch, 0, ""};
+		m_vInstructions.push_back(branch);
+
+		if(!CompileElement(pPos))
+			return false;
+
+		Instruction endBranch = {opEndBranch, 0, ""};
+		m_vInstructions.push_back(endBranch);
+	}
+	else if(token == loopChar)
+	{
+		// A loop element contains its id and the bead name of the loop target
+
+		*pPos = next;
+		m_bLinear = false;
+
+		zString loopId;
+		zString beadName;
+
+		if(!NextToken(pPos, loopId) || !IsMultiplier(loopId) || atol(loopId.c_str()) < 1 ||
+		   !NextToken(pPos, beadName) || !IsBeadName(beadName))
+			return false;
+
+		Instruction loop = {opLoop, atol(loopId.c_str()), beadName};
+		m_vInstructions.push_back(loop);
+	}
+	else if(!CompileSequence(pPos))
+	{
+		return false;
+	}
+
+	return NextToken(pPos, token) && token == ")";
+}
+
+// Function to compile one or more elements up to, but not including, the 
+// closing bracket of the enclosing compound element.
+
+bool CPolymerShape::CompileSequence(size_t* pPos)
+{
+	zString token;
+	size_t next = *pPos;
+
+	long elementTotal = 0;
+
+	while(NextToken(&next, token) && token != ")")
+	{
+		if(!CompileElement(pPos))
+			return false;
+
+		next = *pPos;
+		elementTotal++;
+	}
+
+	return (elementTotal > 0 && token == ")");
+}
+
+// Function to read the next token from the shape string starting at the 
+// given position, and move the position past it. Tokens are brackets, the 
+// branch and loop operators, and runs of any other non-space characters. 
+// Returns false and an empty token at the end of the string.
+
+bool CPolymerShape::NextToken(size_t* pPos, zString& token) const
+{
+	const size_t start = m_Shape.find_first_not_of(' ', *pPos);
+
+	if(start == zString::npos)
+	{
+		*pPos = m_Shape.size();
+		token = "";
+		return false;
+	}
+
+	const char first = m_Shape[start];
+
+	if(first == '(' || first == ')' || first == branchChar[0] || first == loopChar[0])
+	{
+		token  = first;
+		*pPos  = start + 1;
+	}
+	else
+	{
+		size_t end = m_Shape.find_first_of(" ()*/", start);
+
+		if(end == zString::npos)
+			end = m_Shape.size();
+
+		token = m_Shape.substr(start, end - start);
+		*pPos = end;
+	}
+
+	return true;
+}
+
+// Function to check that a token is a valid bead name that has been defined.
+// The naming rules are the same as in CInputData::IsNameValid().
+
+bool CPolymerShape::IsBeadName(const zString token) const
+{
+	if(token.empty() || token.find_first_not_of(validNameChars) != zString::npos ||
+	   validNumOpChars.find(token[0]) != zString::npos ||
+	   validSeparatorOpChars.find(token[0]) != zString::npos)
+		return false;
+
+	return m_mBeadNames.find(token) != m_mBeadNames.end();
+}
+
+bool CPolymerShape::IsMultiplier(const zString token) const
+{
+	return !token.empty() && token.find_first_not_of(validNumOpChars) == zString::npos;
+}
@@ -0,0 +1,109 @@
+// PolymerShape.h: interface for the CPolymerShape class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_POLYMERSHAPE_H__0A56D25C_60AE_45EA_8B02_676A34AF0151__INCLUDED_)
+#define AFX_POLYMERSHAPE_H__0A56D25C_60AE_45EA_8B02_676A34AF0151__INCLUDED_
+
+
+#include "xxBase.h"
+
+class CPolymerShape : public xxBase
+{
+	// ****************************************
+	// Nested classes and types
+public:
+
+	// Instructions that the shape string is compiled into. Each bead name in the
+	// shape becomes an opBead instruction; multiplier, branch and loop elements
+	// become instructions that bracket the instructions of their contents.
+
+	enum OpCode { opBead, opRepeat, opEndRepeat, opBranch, opEndBranch, opLoop };
+
+	struct Instruction
+	{
+		OpCode  op;
+		long    arg;	// Multiplier for opRepeat, loop id for opLoop, index of opRepeat for opEndRepeat
+		zString name;	// Bead name for opBead and opLoop
+	};
+
+	typedef xxBasevector<Instruction>::const_iterator cInstructionIterator;
+
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CPolymerShape(const zString shape, const StringLongMap& mBeadNames);
+
+	virtual ~CPolymerShape();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline bool IsValid()    const {return m_bValid;}
+	inline bool IsLinear()   const {return m_bLinear;}
+
+	inline const xxBasevector<Instruction>& GetInstructions() const {return m_vInstructions;}
+
+	bool HasBeadEnds() const;
+	long GetBeadNameCount(const zString name) const;
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+
+	// ****************************************
+	// Implementation
+
+protected:
+
+
+
+	// ****************************************
+	// Private functions
+private:
+
+	bool CompileElement(size_t* pPos);
+	bool CompileSequence(size_t* pPos);
+	bool NextToken(size_t* pPos, zString& token) const;
+
+	bool IsBeadName(const zString token) const;
+	bool IsMultiplier(const zString token) const;
+
+	// ****************************************
+	// Data members
+
+private:
+
+	static const zString branchChar;
+	static const zString loopChar;
+	static const zString validNameChars;
+	static const zString validNumOpChars;
+	static const zString validSeparatorOpChars;
+
+	const zString        m_Shape;
+	const StringLongMap& m_mBeadNames;
+
+	bool m_bValid;		// Flag showing if the shape obeys the grammar
+	bool m_bLinear;		// Flag showing if the shape has no branches or loops
+
+	long m_TopElementTotal;		// Number of elements in the outermost brackets
+	bool m_bFirstIsBead;		// Flags showing if the first and last of them are bead names
+	bool m_bLastIsBead;
+
+	xxBasevector<Instruction> m_vInstructions;
+};
+
+#endif // !defined(AFX_POLYMERSHAPE_H__0A56D25C_60AE_45EA_8B02_676A34AF0151__INCLUDED_)
@@ -37,7 +37,7 @@ protected:
 				 zString head, zString tail);
 
 private:
-	static long m_PolymerTypeTotal;
+	static SimThreadLocal long m_PolymerTypeTotal;
 
 	zString m_Name;
 	zString m_Shape;
@@ -32,6 +32,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "LogBuilderError.h"	// needed to output any error messages
 #include "LogVelDistMessage.h"	// needed to output the initial velocity distribution
 
+#include <thread>
+
 
 
 // Uncomment the next flag to recreate the previous (wrong) normalisation for the
@@ -44,6 +46,145 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 // #define PreRandomBuilderSimBoxCheck 1
 
+// We use an anonymous namespace to hide the function that places a block of
+// polymers for CRandomBuilder::AssembleInStreams(). Each polymer draws its 
+// random numbers from its own stream so the result does not depend on which
+// thread places it. The bead velocities are stored as momenta here and 
+// normalised afterwards, and the sum of each polymer's bead velocities is 
+// returned in vVCM so that the CM velocity can be summed in a fixed order.
+//
+// The bead speed is taken from the same Maxwell distribution as the serial
+// builder uses, but evaluated directly at the randomly-chosen point instead 
+// of from a table: CBuilder::MaxwellDist() generates the points
+// v(j) = sqrt(2*ln(n/(n-j-1))) for j < n-1, with the last one repeated.
+
+namespace
+{
+	void PlaceRandomPolymers(const CInitialState& riState, const PolymerVector& vPolymers,
+							 const std::vector<uint64_t>& vSeeds, long maxwellPointNo,
+							 double coordErrorLimit, long first, long last, zDoubleVector& vVCM)
+	{
+		const double dMaxwellPointNo = static_cast<double>(maxwellPointNo);
+
+		for(long ip=first; ip<last; ip++)
+		{
+			uint64_t state = vSeeds[ip];
+
+			double vcm[3] = {0.0, 0.0, 0.0};
+			double xp[3];
+			double vp[3];
+
+			const BeadVector& vBeads = vPolymers[ip]->GetBeads();
+
+			for(cBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+			{
+				long index = static_cast<long>(dMaxwellPointNo*CCNTCell::GetStreamRandomNo(state));
+				if(index > maxwellPointNo - 2)
+					index = maxwellPointNo - 2;
+
+				const double vmag = sqrt(2.0*log(dMaxwellPointNo/(dMaxwellPointNo - static_cast<double>(index) - 1.0)));
+
+				xp[0] = riState.GetSimBoxBulkXLength()*CCNTCell::GetStreamRandomNo(state);
+				xp[1] = riState.GetSimBoxBulkYLength()*CCNTCell::GetStreamRandomNo(state);
+
+				if(riState.GetSimBoxXLength() - xp[0] < coordErrorLimit)
+					xp[0] = 0.0;
+				if(riState.GetSimBoxYLength() - xp[1] < coordErrorLimit)
+					xp[1] = 0.0;
+
+#if SimDimension == 3
+
+				xp[2] = riState.GetSimBoxBulkZLength()*CCNTCell::GetStreamRandomNo(state);
+
+				if(riState.GetSimBoxZLength() - xp[2] < coordErrorLimit)
+					xp[2] = 0.0;
+
+				const double vtheta = acos(1.0-2.0*CCNTCell::GetStreamRandomNo(state));
+				const double vphi   = xxBase::m_globalTwoPI*CCNTCell::GetStreamRandomNo(state);
+
+				vp[0] = vmag*sin(vtheta)*cos(vphi);
+				vp[1] = vmag*sin(vtheta)*sin(vphi);
+				vp[2] = vmag*cos(vtheta);
+
+#elif SimDimension == 2
+
+				xp[2] = 0.0;
+
+				const double vphi = xxBase::m_globalTwoPI*CCNTCell::GetStreamRandomNo(state);
+
+				vp[0] = vmag*cos(vphi);
+				vp[1] = vmag*sin(vphi);
+				vp[2] = 0.0;
+
+#endif
+
+				vcm[0] += vp[0];
+				vcm[1] += vp[1];
+				vcm[2] += vp[2];
+
+				(*iterBead)->SetXPos(xp[0]);
+				(*iterBead)->SetYPos(xp[1]);
+				(*iterBead)->SetZPos(xp[2]);
+				(*iterBead)->SetunPBCXPos(xp[0]);
+				(*iterBead)->SetunPBCYPos(xp[1]);
+				(*iterBead)->SetunPBCZPos(xp[2]);
+				(*iterBead)->SetInitialXPos(xp[0]);
+				(*iterBead)->SetInitialYPos(xp[1]);
+				(*iterBead)->SetInitialZPos(xp[2]);
+				(*iterBead)->SetXMom(vp[0]);
+				(*iterBead)->SetYMom(vp[1]);
+				(*iterBead)->SetZMom(vp[2]);
+			}
+
+			// Move bonded beads that are too far apart closer together as in
+			// the serial builder
+
+			const BondVector& vBonds = vPolymers[ip]->GetBonds();
+
+			for(cBondVectorIterator iterBond=vBonds.begin(); iterBond!=vBonds.end(); iterBond++)
+			{
+				CAbstractBead* const pHead = (*iterBond)->GetHead();
+				CAbstractBead* const pTail = (*iterBond)->GetTail();
+
+				double rdiff[3];
+				rdiff[0] = pTail->GetXPos() - pHead->GetXPos();
+				rdiff[1] = pTail->GetYPos() - pHead->GetYPos();
+				rdiff[2] = pTail->GetZPos() - pHead->GetZPos();
+
+				const double rmag = sqrt(rdiff[0]*rdiff[0] + rdiff[1]*rdiff[1] + rdiff[2]*rdiff[2]);
+
+				if(fabs(rdiff[0]) > 1.0)
+				{
+					const double x = pHead->GetXPos() + rdiff[0]/rmag;
+					pTail->SetXPos(x);
+					pTail->SetunPBCXPos(x);
+					pTail->SetInitialXPos(x);
+				}
+
+				if(fabs(rdiff[1]) > 1.0)
+				{
+					const double y = pHead->GetYPos() + rdiff[1]/rmag;
+					pTail->SetYPos(y);
+					pTail->SetunPBCYPos(y);
+					pTail->SetInitialYPos(y);
+				}
+
+				if(fabs(rdiff[2]) > 1.0)
+				{
+					const double z = pHead->GetZPos() + rdiff[2]/rmag;
+					pTail->SetZPos(z);
+					pTail->SetunPBCZPos(z);
+					pTail->SetInitialZPos(z);
+				}
+			}
+
+			vVCM[3*ip]   = vcm[0];
+			vVCM[3*ip+1] = vcm[1];
+			vVCM[3*ip+2] = vcm[2];
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -85,6 +226,10 @@ bool CRandomBuilder::Assemble(CInitialState& riState)
 	{
 		AssignWallBeadCoords(riState);
 	}
+	else if(riState.GetAssemblyThreadNo() > 0)
+	{
+		return AssembleInStreams(riState);
+	}
 
 	// Arrange other beads in a random configuration and set their velocities 
 	// from a Maxwell distribution in each dimension with a mean value and 
@@ -414,6 +559,142 @@ bool CRandomBuilder::Assemble(CInitialState& riState)
 	return true;
 }
 
+// Private function used instead of the serial algorithm above when the user 
+// has specified the number of threads to use to assemble the initial state.
+// The polymers are divided into contiguous blocks that are placed 
+// concurrently, each polymer using a random number stream derived from the
+// simulation's RNG seed and its id. The resulting state is the same for any 
+// number of threads, but differs from that created by the serial algorithm.
+// Walls are not supported, and Assemble() uses the serial algorithm if one
+// is present. The bead velocities are then shifted to remove the CM velocity
+// and normalised to the temperature as above.
+
+bool CRandomBuilder::AssembleInStreams(CInitialState& riState)
+{
+	const PolymerVector& vPolymers = riState.GetPolymers();
+	const long polymerTotal = vPolymers.size();
+	const long beadTotal    = riState.GetBeadTotal();
+
+	if(beadTotal == 0)
+		return true;
+
+	// The stream seeds must be created on this thread because the RNG 
+	// state is thread-local
+
+	std::vector<uint64_t> vSeeds(polymerTotal);
+
+	for(long ip=0; ip<polymerTotal; ip++)
+	{
+		vSeeds[ip] = CCNTCell::GetRandomStreamSeed(vPolymers[ip]->GetId());
+	}
+
+	const long maxwellPointNo = (beadTotal > m_MaxwellPointNo ? beadTotal : m_MaxwellPointNo);
+
+	zDoubleVector vVCM(3*polymerTotal, 0.0);
+
+	long threadTotal = riState.GetAssemblyThreadNo();
+	if(threadTotal > polymerTotal)
+		threadTotal = polymerTotal;
+
+	if(threadTotal <= 1)
+	{
+		PlaceRandomPolymers(riState, vPolymers, vSeeds, maxwellPointNo, m_CoordErrorLimit, 0, polymerTotal, vVCM);
+	}
+	else
+	{
+		std::vector<std::thread> vWorkers;
+
+		for(long it=0; it<threadTotal; it++)
+		{
+			const long first = (it*polymerTotal)/threadTotal;
+			const long last  = ((it+1)*polymerTotal)/threadTotal;
+
+			vWorkers.push_back(std::thread(PlaceRandomPolymers, std::cref(riState), std::cref(vPolymers), 
+										   std::cref(vSeeds), maxwellPointNo, m_CoordErrorLimit,
+										   first, last, std::ref(vVCM)));
+		}
+
+		for(std::vector<std::thread>::iterator iterWorker=vWorkers.begin(); iterWorker!=vWorkers.end(); iterWorker++)
+		{
+			iterWorker->join();
+		}
+	}
+
+	long i;
+	double vcm[3]    = {0.0, 0.0, 0.0};
+	double vmean[3]  = {0.0, 0.0, 0.0};
+	double v2mean[3] = {0.0, 0.0, 0.0};
+	double var[3];
+
+	for(long ip=0; ip<polymerTotal; ip++)
+	{
+		vcm[0] += vVCM[3*ip];
+		vcm[1] += vVCM[3*ip+1];
+		vcm[2] += vVCM[3*ip+2];
+	}
+
+	for(i=0; i<3; i++)
+	{
+		vcm[i] /= static_cast<double>(beadTotal);
+	}
+
+	const BeadVector& vBeads = riState.GetBeads();
+	cBeadVectorIterator iterBead;
+
+	double vtotal = 0.0;
+
+	for(iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	{
+		const double vx = (*iterBead)->GetXMom() - vcm[0];
+		const double vy = (*iterBead)->GetYMom() - vcm[1];
+		const double vz = (*iterBead)->GetZMom() - vcm[2];
+
+		(*iterBead)->SetXMom(vx);
+		(*iterBead)->SetYMom(vy);
+		(*iterBead)->SetZMom(vz);
+
+		vtotal += vx*vx + vy*vy + vz*vz;
+	}
+
+#if SimDimension == 2
+	vtotal = sqrt(vtotal/static_cast<double>(2*beadTotal));
+#elif SimDimension == 3
+	vtotal = sqrt(vtotal/static_cast<double>(3*beadTotal));
+#endif
+
+	const double vscale = sqrt(riState.GetkT())/vtotal;
+
+	for(iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	{
+		const double vx = vscale*(*iterBead)->GetXMom();
+		const double vy = vscale*(*iterBead)->GetYMom();
+		const double vz = vscale*(*iterBead)->GetZMom();
+
+		(*iterBead)->SetXMom(vx);
+		(*iterBead)->SetYMom(vy);
+		(*iterBead)->SetZMom(vz);
+
+		vmean[0] += vx;
+		vmean[1] += vy;
+		vmean[2] += vz;
+
+		v2mean[0] += vx*vx;
+		v2mean[1] += vy*vy;
+		v2mean[2] += vz*vz;
+	}
+
+	for(i=0; i<3; i++)
+	{
+		vmean[i]  =  vmean[i]/static_cast<double>(beadTotal);
+		v2mean[i] = v2mean[i]/static_cast<double>(beadTotal);
+		var[i]    = v2mean[i] - vmean[i]*vmean[i];
+	}
+
+	new CLogVelDistMessage(0, riState.GetkT(), vmean, v2mean, var);
+
+	return true;
+}
+
 // Virtual function to assemble beads into a random initial configuration for
 // a parallel simulation. It differs from the above serial function in that 
 // we assign the initial bead velocities from a Maxwell distribution defined for
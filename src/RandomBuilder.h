@@ -18,6 +18,10 @@ public:
 	virtual bool Assemble(CInitialState& riState);
 	virtual bool AssembleP(CInitialState& riState);
 
+private:
+
+	bool AssembleInStreams(CInitialState& riState);
+
 };
 
 #endif // !defined(AFX_RANDOMBUILDER_H__A2FACF43_3F61_11D3_820E_0060088AD300__INCLUDED_)
@@ -30,7 +30,7 @@ public:
 	inline double	GetDepth()		const {return m_Depth;}
 	inline double	GetHeight()		const {return m_Height;}
 	inline double	GetVolume()		const {return m_Volume;}
-	inline BeadList GetBeads() const {return m_lBeads;}
+	inline const BeadList& GetBeads() const {return m_lBeads;}
 
 	inline void     AddBead(CAbstractBead* pBead) {m_lBeads.push_back(pBead);}
 
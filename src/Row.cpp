@@ -58,12 +58,11 @@ CRow::CRow(const CSlice& rSlice, long rowIndex) : CRegion(0), m_X(0), m_Y(0), m_
 
 	// Sort the beads in the slice into the row. 
 
-	// A copy of the slice's BeadList is defined here because the for loops 
-	// seem to fail when the slice's GetBeads() function is used directly. 
+	// We iterate over the slice's own bead container rather than a copy of it.
 	// An iterator is declared because some machines do not allow
 	// a redeclaration of the loop counter in different loops. 
 
-	BeadList lBeads = rSlice.GetBeads();
+	const BeadList& lBeads = rSlice.GetBeads();
 	cBeadListIterator iterBead;
 
 	if(rSlice.GetYNormal() == 1)		// Slice has Y normal so Row normal is X
@@ -35,12 +35,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 
 CRowProfile::CRowProfile(CSlice* const pSlice, long rowTotal) : m_pSlice(pSlice) 
 {	
-	// A copy of the slice's BeadList is defined here because the for loops 
-	// seem to fail when the slice's GetBeads() function is used directly. 
+	// We iterate over the slice's own bead container rather than a copy of it:
+	// the rows only store pointers to the beads so nothing in the slice changes.
 	// An iterator is declared because some machines do not allow
 	// a redeclaration of the loop counter in different loops. 
 
-	BeadList lBeads = pSlice->GetBeads();
+	const BeadList& lBeads = pSlice->GetBeads();
 	cBeadListIterator iterBead;
 
 	long xNormal = 0;
@@ -53,12 +53,14 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "Row.h"
 #include "Slice.h"
 #include "StressGridCell.h"
+#include "PerformanceState.h"
 
 // SimBox command headers: note that excluded commands are below
 
 #include "ccExtendTotalTime.h"
 #include "ccGravityOff.h"
 #include "ccGravityOn.h"
+#include "ccMakeNanoparticleRigid.h"
 #include "ccRenormaliseMomenta.h"
 #include "ccSetBondStiffness.h"
 #include "ccSetBondStrength.h"
@@ -221,6 +223,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "LogExtendTotalTime.h"
 #include "LogFreezeBeadsInSlice.h"
 #include "LogFreezeBeadsInSphericalShell.h"
+#include "LogMakeNanoparticleRigid.h"
 #include "LogMCAcceptanceRate.h"
 #include "LogRestoreBeadType.h"
 #include "LogRestoreOriginalBeadType.h"
@@ -246,10 +249,333 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "LogToggleDPDBeadThermostat.h"
 #endif
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 
 	using std::cout;
 	using std::mem_fun;
 
+namespace
+{
+	// Bonded interactions whose energy depends on the position of one bead, used
+	// by the checkerboard MC relaxation to calculate the energy change when only
+	// that bead moves. The bond pairs also need the bonds that do not contain the
+	// bead to be up to date, and the partner beads are those whose positions
+	// enter any of these terms.
+
+	struct MCBeadTerms
+	{
+		MCBeadTerms() : bActive(false) {}
+
+		bool				bActive;		// Bead belongs to a polymer being relaxed
+		BondVector			vBonds;			// Bonds containing the bead
+		BondVector			vRefreshBonds;	// Other bonds in the bead's bond pairs
+		BondPairVector		vBondPairs;		// Bond pairs containing the bead
+		AbstractBeadVector	vPartners;		// Other beads in any of these terms
+	};
+
+	// Data shared by all threads during the checkerboard MC relaxation. It is 
+	// only read while the cells are being relaxed.
+
+	struct MCCheckerboardContext
+	{
+		const CNTCellVector*			pCells;
+		const std::vector<MCBeadTerms>*	pvTerms;		// Indexed by bead id
+		long	cellNo[3];
+		double	cellWidth[3];
+		double	boxLength[3];
+		double	twoMaxStep;
+		double	beta;
+	};
+
+	// Reusable barrier that holds the MC threads until all of them have 
+	// finished one stage of a sweep.
+
+	class MCThreadBarrier
+	{
+	public:
+		explicit MCThreadBarrier(long count) : m_Count(count), m_Waiting(0), m_Generation(0)
+		{
+		}
+
+		void Wait()
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+
+			const long generation = m_Generation;
+
+			if(++m_Waiting == m_Count)
+			{
+				m_Waiting = 0;
+				m_Generation++;
+				m_Condition.notify_all();
+			}
+			else
+			{
+				m_Condition.wait(lock, [this, generation] {return m_Generation != generation;});
+			}
+		}
+
+	private:
+		std::mutex				m_Mutex;
+		std::condition_variable	m_Condition;
+		const long				m_Count;
+		long					m_Waiting;
+		long					m_Generation;
+	};
+
+	void AddUniqueBond(BondVector& rBonds, CBond* pBond)
+	{
+		if(std::find(rBonds.begin(), rBonds.end(), pBond) == rBonds.end())
+			rBonds.push_back(pBond);
+	}
+
+	void AddUniqueBead(AbstractBeadVector& rBeads, CAbstractBead* pBead)
+	{
+		if(std::find(rBeads.begin(), rBeads.end(), pBead) == rBeads.end())
+			rBeads.push_back(pBead);
+	}
+
+	// Return the bonded energy of the terms that depend on one bead's position.
+	// The CBond::AddPotentialEnergy() function stores the bond vector used by
+	// the bond pairs, so the bonds must be evaluated first.
+
+	double MCBondedEnergy(const MCBeadTerms& rTerms)
+	{
+		double pe = 0.0;
+
+		for(cBondVectorIterator iterBond=rTerms.vRefreshBonds.begin(); iterBond!=rTerms.vRefreshBonds.end(); iterBond++)
+		{
+			(*iterBond)->AddPotentialEnergy();
+		}
+
+		for(cBondVectorIterator iterBond=rTerms.vBonds.begin(); iterBond!=rTerms.vBonds.end(); iterBond++)
+		{
+			pe += (*iterBond)->AddPotentialEnergy();
+		}
+
+		for(cBondPairVectorIterator iterBP=rTerms.vBondPairs.begin(); iterBP!=rTerms.vBondPairs.end(); iterBP++)
+		{
+			pe += (*iterBP)->AddPotentialEnergy();
+		}
+
+		return pe;
+	}
+
+	void MCCellCoords(const MCCheckerboardContext& rContext, const double pos[3], long coords[3])
+	{
+		for(short int i=0; i<3; i++)
+		{
+			coords[i] = static_cast<long>(pos[i]/rContext.cellWidth[i]);
+
+			if(coords[i] >= rContext.cellNo[i])
+				coords[i] = rContext.cellNo[i] - 1;
+			else if(coords[i] < 0)
+				coords[i] = 0;
+		}
+	}
+
+	// Return true if two cells are the same or adjacent, allowing for the PBCs.
+
+	bool IsMCNeighbourCell(const MCCheckerboardContext& rContext, const long first[3], const long second[3])
+	{
+		for(short int i=0; i<3; i++)
+		{
+			const long diff = labs(first[i] - second[i]);
+
+			if(diff > 1 && rContext.cellNo[i] - diff > 1)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Return true if all the partner beads of a moving bead are in the given 
+	// cell or those adjacent to it.
+
+	bool AreMCPartnersLocal(const MCCheckerboardContext& rContext, const MCBeadTerms& rTerms, const long coords[3])
+	{
+		double pos[3];
+		long   partnerCoords[3];
+
+		for(cAbstractBeadVectorIterator iterBead=rTerms.vPartners.begin(); iterBead!=rTerms.vPartners.end(); iterBead++)
+		{
+			pos[0] = (*iterBead)->GetXPos();
+			pos[1] = (*iterBead)->GetYPos();
+			pos[2] = (*iterBead)->GetZPos();
+
+			MCCellCoords(rContext, pos, partnerCoords);
+
+			if(!IsMCNeighbourCell(rContext, coords, partnerCoords))
+				return false;
+		}
+
+		return true;
+	}
+
+	// Attempt a single MC move of a bead using four random numbers in [0,1): 
+	// three for the displacement and one for the Metropolis test. The energy 
+	// change is exact because it includes the bead's interactions with all beads 
+	// in the neighbouring cells and all bonded terms that contain it.
+	//
+	// If bLocal is true the move must keep the bead and its partners within the
+	// cells adjacent to both its old and new cells, otherwise it is rejected.
+	// It allows moves in cells separated by at least four cells to run 
+	// concurrently as none of them reads or writes the same beads or cells.
+	// The restriction is symmetric, as the partners are checked against both
+	// cells: a move from the old to the new position is allowed exactly when 
+	// the reverse move is. The displacement is drawn uniformly from a cube, so
+	// each restricted Metropolis move satisfies detailed balance. A sweep 
+	// applies such moves one after another, each of which leaves the Boltzmann
+	// distribution stationary, so the sweep does too.
+
+	bool MCTrialMove(const MCCheckerboardContext& rContext, CAbstractBead* pBead, const MCBeadTerms& rTerms,
+					 const double rn[4], bool bLocal)
+	{
+		double oldPos[3];
+		double newPos[3];
+		double deltaPos[3];
+		double oldunPBCPos[3];
+		long   oldCoords[3];
+		long   newCoords[3];
+
+		oldPos[0] = pBead->GetXPos();
+		oldPos[1] = pBead->GetYPos();
+		oldPos[2] = pBead->GetZPos();
+
+		oldunPBCPos[0] = pBead->GetunPBCXPos();
+		oldunPBCPos[1] = pBead->GetunPBCYPos();
+		oldunPBCPos[2] = pBead->GetunPBCZPos();
+
+		deltaPos[0] = rContext.twoMaxStep*(0.5 - rn[0]);
+		deltaPos[1] = rContext.twoMaxStep*(0.5 - rn[1]);
+#if SimDimension == 2
+		deltaPos[2] = 0.0;
+#elif SimDimension == 3
+		deltaPos[2] = rContext.twoMaxStep*(0.5 - rn[2]);
+#endif
+
+		for(short int i=0; i<3; i++)
+		{
+			newPos[i] = oldPos[i] + deltaPos[i];
+
+			if( newPos[i] >= rContext.boxLength[i] )
+				newPos[i] -= rContext.boxLength[i];
+			else if( newPos[i] < 0.0 )
+				newPos[i] += rContext.boxLength[i];
+		}
+
+		MCCellCoords(rContext, oldPos, oldCoords);
+		MCCellCoords(rContext, newPos, newCoords);
+
+		if(bLocal && (!IsMCNeighbourCell(rContext, oldCoords, newCoords) || 
+			          !AreMCPartnersLocal(rContext, rTerms, oldCoords) ||
+			          !AreMCPartnersLocal(rContext, rTerms, newCoords)))
+		{
+			return false;
+		}
+
+		const CNTCellVector& rCells = *rContext.pCells;
+
+		CCNTCell* const pInitialCell = rCells[rContext.cellNo[0]*(rContext.cellNo[1]*oldCoords[2] + oldCoords[1]) + oldCoords[0]];
+		CCNTCell* const pFinalCell	 = rCells[rContext.cellNo[0]*(rContext.cellNo[1]*newCoords[2] + newCoords[1]) + newCoords[0]];
+
+		const double initialPE = pInitialCell->GetNeighbourhoodPotentialEnergy(pBead) + MCBondedEnergy(rTerms);
+
+		pBead->SetXPos(newPos[0]);
+		pBead->SetYPos(newPos[1]);	
+		pBead->SetZPos(newPos[2]);
+
+		pBead->SetunPBCXPos(oldunPBCPos[0]+deltaPos[0]);
+		pBead->SetunPBCYPos(oldunPBCPos[1]+deltaPos[1]);	
+		pBead->SetunPBCZPos(oldunPBCPos[2]+deltaPos[2]);
+
+		const double finalPE = pFinalCell->GetNeighbourhoodPotentialEnergy(pBead) + MCBondedEnergy(rTerms);
+		const double deltaPE = rContext.beta*(finalPE - initialPE);
+
+		if(deltaPE > 0.0 && exp(-deltaPE) < rn[3])
+		{
+			pBead->SetXPos(oldPos[0]);
+			pBead->SetYPos(oldPos[1]);
+			pBead->SetZPos(oldPos[2]);
+
+			pBead->SetunPBCXPos(oldunPBCPos[0]);
+			pBead->SetunPBCYPos(oldunPBCPos[1]);
+			pBead->SetunPBCZPos(oldunPBCPos[2]);
+
+			return false;
+		}
+
+		if(pFinalCell != pInitialCell)
+		{
+			pInitialCell->RemoveBeadFromCell(pBead);
+			pFinalCell->AddBeadtoCell(pBead);
+		}
+
+		return true;
+	}
+
+	// Attempt one move of each bead that is in a cell at the start of the call
+	// using the cell's own random number stream. Beads whose partners are not
+	// all in adjacent cells cannot be moved concurrently with other cells and 
+	// are added to rDeferred so that they can be moved later on one thread.
+
+	long MCRelaxCell(const MCCheckerboardContext& rContext, CCNTCell* pCell, uint64_t stream, AbstractBeadVector& rDeferred)
+	{
+		const std::vector<MCBeadTerms>& rvTerms = *rContext.pvTerms;
+
+		AbstractBeadVector vBeads;
+		vBeads.assign(pCell->GetBeads().begin(), pCell->GetBeads().end());
+
+		const long coords[3] = {pCell->GetBLXIndex(), pCell->GetBLYIndex(), pCell->GetBLZIndex()};
+
+		long   acceptCount = 0;
+		double rn[4];
+
+		for(cAbstractBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+		{
+			const long id = (*iterBead)->GetId();
+
+			if(id < 0 || id >= static_cast<long>(rvTerms.size()) || !rvTerms[id].bActive)
+				continue;
+
+			if(!AreMCPartnersLocal(rContext, rvTerms[id], coords))
+			{
+				rDeferred.push_back(*iterBead);
+				continue;
+			}
+
+			for(short int i=0; i<4; i++)
+			{
+				rn[i] = CCNTCell::GetStreamRandomNo(stream);
+			}
+
+			if(MCTrialMove(rContext, *iterBead, rvTerms[id], rn, true))
+				acceptCount++;
+		}
+
+		return acceptCount;
+	}
+
+	// Return the number of colours needed along one dimension of the CNT cell
+	// lattice so that cells of the same colour are at least four cells apart 
+	// allowing for the PBCs. It is the smallest divisor of the cell number that 
+	// is at least four, or the cell number itself if there is none.
+
+	long MCColourNo(long cellNo)
+	{
+		for(long colours=4; colours<cellNo; colours++)
+		{
+			if(cellNo%colours == 0)
+				return colours;
+		}
+
+		return cellNo;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -257,7 +583,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable holding a pointer to the single instance of CSimBox.
 // Note that it does not get assigned a value until the user creates the instance.
 
-CSimBox* CSimBox::m_pInstance = 0;
+SimThreadLocal CSimBox* CSimBox::m_pInstance = 0;
 
 // Public member function to create a single instance of the CSimBox class.
 
@@ -319,15 +645,10 @@ CSimBox::CSimBox(CSimState& simState, const ISimBox* const pISimBox) : ISimState
 									m_StressCellYNo(m_StressCellMultiplier*m_CNTYCellNo),
 									m_StressCellZNo(m_StressCellMultiplier*m_CNTZCellNo),
 									m_StressCellTotal(m_StressCellXNo*m_StressCellYNo*m_StressCellZNo),
-									m_PointTotal(100), 
-									m_InversePointTotal(1.0/static_cast<double>(m_PointTotal)),
-									m_InversePointTotalMinusOne(1.0/static_cast<double>(m_PointTotal-1)),
 									m_StressCellXWidth(m_CNTXCellWidth/static_cast<double>(m_StressCellMultiplier)),
 									m_StressCellYWidth(m_CNTYCellWidth/static_cast<double>(m_StressCellMultiplier)),
 									m_StressCellZWidth(m_CNTZCellWidth/static_cast<double>(m_StressCellMultiplier)),
-									m_pOldCell(0),
-	                                m_pNewCell(0),
-	                                m_StressWeight(0.0)
+	                                m_pPerformanceState(0)
 
 {
 #if EnableShadowSimBox == SimACNEnabled
@@ -415,6 +736,13 @@ CSimBox::CSimBox(CSimState& simState, const ISimBox* const pISimBox) : ISimState
 	m_vWallBeads	= simState.GetWallBeads();
 	m_vGravityBeads	= simState.GetGravityBeads();
 
+	// Collect the bonds and bondpairs of all polymers into flat vectors so that
+	// the bonded force loops do not have to traverse the polymers every step.
+	// The bonds internal to polymers do not change after the SimBox is created 
+	// in the serial code, so the vectors are only rebuilt if the polymers are.
+
+	BuildFlatBondVectors();
+
 	// Construct the CNT cell network and partition the beads amongst the cells.
 	// We distribute the wall beads here if the SimState shows that the wall has
 	// been turned on. This is set by the CInputData object from the control data
@@ -464,8 +792,6 @@ CSimBox::CSimBox(CSimState& simState, const ISimBox* const pISimBox) : ISimState
 		
 	for(long i=0; i<3; i++)
 	{
-	    m_rprime[i]          = 0.0;
-		m_dr[i]              = 0.0;
 		m_LocalStress[3*i]   = 0.0;
 		m_LocalStress[3*i+1] = 0.0;
 		m_LocalStress[3*i+2] = 0.0;
@@ -592,6 +918,14 @@ CSimBox::~CSimBox()
 	}
 #endif
 
+	// Close the performance log if it is open
+
+	if(m_pPerformanceState)
+	{
+		delete m_pPerformanceState;
+		m_pPerformanceState = 0;
+	}
+
 	// Delete all CNT cells created using new in the CSimBox::MakeCNTCells
 	// function. As we store pointers to the cells and not the objects
 	// themselves we only have to delete them once.
@@ -967,17 +1301,44 @@ CCNTCell* CSimBox::GetCNTCellFromCoords(double r[3]) const
 //  
 //  3	Update velocity of all beads from old and new values of the force (UpdateMom())
 //
+//  4	Apply the Shardlow or Lowe-Andersen pairwise thermostat to the new 
+//		velocities if one is selected in the control data file (UpdatePairThermostat())
 //
 
 void CSimBox::Evolve()
 {
 	CNTCellIterator iterCell;  // used in all three loops below
 
+	// Rigid nanoparticles set their beads' momenta so that UpdatePos() moves
+	// them to their new rigid-body positions.
+
+	const double dt = GetISimBox()->GetStepSize();
+
+	for(NanoparticleIterator iterNano=m_Nanoparticles.begin(); iterNano!=m_Nanoparticles.end(); iterNano++)
+	{
+		if((*iterNano)->IsRigid())
+		{
+			(*iterNano)->UpdateRigidPos(dt);
+		}
+	}
+
+	// The RESPA scheme integrates the polymer bond forces over several substeps
+	// and leaves each bead's displacement in m_dPos for UpdatePos() to apply.
+
+	if(CCNTCell::GetRESPASubstepNo() > 1)
+	{
+		IntegrateRESPA();
+
+		EndPhase(CPerformanceState::BondForces);
+	}
+
 	for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	{
 		(*iterCell)->UpdatePos();
 	} 
 
+	EndPhase(CPerformanceState::UpdatePos);
+
 	// Next calculate the forces between all pairs of beads in NN CNT cells
 	// that can potentially interact. First, we tell the CMonitor to zero the
 	// stress tensor arrays prior to generating new data. The function is
@@ -989,14 +1350,35 @@ void CSimBox::Evolve()
     // If the density-dependent DPDLG force is enabled and is being used
     // for the given input file, we first calculate the local bead density around
     // every bead in the SimBox and then call the UpdateLGForce() function to 
-    // calculate the new force instead of the standard UpdateForce().
+    // calculate the new force instead of the standard UpdateForce(). The density
+    // sweep adds each pair's contribution to both beads, so all densities are
+    // zeroed first, and it caches the interacting pairs for the force pass.
 
 	ZeroSliceStress();
 
+#if EnableLeanBeadStorage == SimMiscEnabled
+	CAbstractBead::ZeroTotalStress();
+#endif
+
+	// The bead energies are only used when the history state is sampled, so
+	// the force calculation is asked to sum the pair potential energy on those
+	// steps alone, and only if energy output is on.
+
+#if SimIdentifier != BD
+	const bool bSumEnergy = IsEnergyOutputOn() && TimeToSample();
+
+	CCNTCell::SetPotentialSum(bSumEnergy);
+#endif
+
 #if EnableDPDLG == ExperimentEnabled
 
     if(IsDPDLG())
     {
+	    for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
+	    {
+		    (*iterCell)->ZeroLGDensity();
+	    } 
+
 	    for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	    {
 		    (*iterCell)->UpdateLGDensity();
@@ -1024,6 +1406,8 @@ void CSimBox::Evolve()
 
 #endif
 
+	EndPhase(CPerformanceState::UpdateForce);
+
 	// Add in the forces between bonded beads and the stiff bond force. Note that
 	// AddBondPairForces() must be called after AddBondForces() because it relies
 	// on the bond lengths having already been calculated in CBond::AddForce().
@@ -1031,6 +1415,8 @@ void CSimBox::Evolve()
 	AddBondForces();
 	AddBondPairForces();
 
+	EndPhase(CPerformanceState::BondForces);
+
 #if EnableShadowSimBox == SimACNEnabled
 	// Add in the forces due to active bonds and polymers if any exist.
 	// We check the ISimState to see if active bonds are present in the simulation,
@@ -1046,6 +1432,8 @@ void CSimBox::Evolve()
 	if(IsBeadChargeOn())
 		AddChargedBeadForces();
 
+	EndPhase(CPerformanceState::ActiveCharged);
+
 	// Execute any active command targets. These may be targetted by commands
 	// that turn on an effect, such as applying a force, that is updated
 	// at each timestep. The effect persists until another command turns it off.
@@ -1081,6 +1469,8 @@ void CSimBox::Evolve()
 	if(IsGravityOn())
 		AddBodyForce();
 
+	EndPhase(CPerformanceState::Targets);
+
 	// Finally update the velocities of the beads using the old and new values for
 	// the forces. Note that even simulation types (such as Brownian Dynamics) that
     // do not use the bead velocities need to call this function as it calls the
@@ -1091,27 +1481,52 @@ void CSimBox::Evolve()
 		(*iterCell)->UpdateMom();
 	} 
 
+	// If the dissipative and random forces are integrated by a pairwise 
+	// thermostat (Shardlow or Lowe-Andersen) instead of the velocity Verlet 
+	// scheme, apply it to the new momenta now. This must follow UpdateMom() 
+	// for all cells as each pair can span two cells.
+
+#if SimIdentifier == DPD
+	if(CCNTCell::IsPairThermostatOn())
+	{
+		for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
+		{
+			(*iterCell)->UpdatePairThermostat();
+		} 
+	}
+#endif
+
+	// Replace the momenta of beads in rigid nanoparticles with their rigid-body 
+	// values now that the new forces on them are known.
+
+	for(NanoparticleIterator iterNano=m_Nanoparticles.begin(); iterNano!=m_Nanoparticles.end(); iterNano++)
+	{
+		if((*iterNano)->IsRigid())
+		{
+			(*iterNano)->UpdateRigidMom(dt);
+		}
+	}
+
 	// Calculate the total KE and PE if required for output to the history state.
 	// Zero the energy sums first and add the bond contributions using the monitor 
 	// function ZeroTotalEnergy(), then iterate over all CNT cells adding 
-	// the bead kinetic and potential energies. Note that the CNT cells call
-	// the monitor function AddBeadEnergy() directly. We have to pass in two
-	// dummy parameters for now
+	// the bead kinetic energies and the potential energies summed during the
+	// force calculation above. Note that the CNT cells call the monitor function
+	// AddBeadEnergy() directly.
 
 #if SimIdentifier != BD
-	double kinetic = 0.0;
-	double potential = 0.0;
-
-	if(IsEnergyOutputOn())
+	if(bSumEnergy)
 	{
 		ZeroTotalEnergy();
 
 		for(cCNTCellIterator cIterCell=m_vCNTCells.begin(); cIterCell!=m_vCNTCells.end(); cIterCell++)
 		{
-			(*cIterCell)->UpdateTotalEnergy(&kinetic, &potential);
+			(*cIterCell)->AddForceEnergy();
 		} 
 	}
 #endif
+
+	EndPhase(CPerformanceState::UpdateMom);
 }
 
 // Function to evolve the state of all beads in a parallel simulation forward 
@@ -1194,6 +1609,11 @@ void CSimBox::EvolveP()
 #if EnableParallelSimBox == SimMPSEnabled
 
     m_pParallel->UpdatePos();
+
+#if EnableLeanBeadStorage == SimMiscEnabled
+	CAbstractBead::ZeroTotalStress();
+#endif
+
     m_pParallel->UpdateForce();
 
 	// Execute any active command targets. These may be targetted by commands
@@ -1294,6 +1714,12 @@ void CSimBox::Run()
         }
         else
         {
+		    // If the TogglePerformanceOutput command is active, the wall-clock
+		    // time spent in each phase of the step is accumulated and written
+		    // to the performance log periodically.
+
+		    UpdatePerformanceState();
+
 		    // Execute commands prior to updating simulation state because additional
 		    // forces may be generated by the commands. First, we execute any active 
             // command groups so that they can add their payloads to the commands
@@ -1311,11 +1737,14 @@ void CSimBox::Run()
 			    UpdateRenormalisedMom();
 		    }
 #endif
+		    EndPhase(CPerformanceState::Commands);
 
 		    Evolve();
 
 		    CNTCellCheck();		// check beads are in correct CNT cells
 
+		    EndPhase(CPerformanceState::CNTCellCheck);
+
 		    // Sample the simulation state to construct observables, check if any
 		    // events have happened and update the state of all processes.
 		    // Note that events that happen faster than SamplePeriod steps
@@ -1336,6 +1765,8 @@ void CSimBox::Run()
     			SaveProcessState();
 		    }
 
+		    EndPhase(CPerformanceState::Sample);
+
 		    if(TimeToDisplay())
 		    {
     			SaveCurrentState();
@@ -1345,10 +1776,53 @@ void CSimBox::Run()
 		    {
     			SaveRestartState();
 		    }
+
+		    if(m_pPerformanceState)
+		    {
+			    m_pPerformanceState->EndPhase(CPerformanceState::SaveState);
+			    m_pPerformanceState->EndStep(m_SimTime, CCNTCell::GetPairCheckTotal(), CCNTCell::GetMigrationTotal());
+		    }
         }
 	}
 }
 
+// Function to create or destroy the performance log so that it matches the
+// flag in the CSimState, and to mark the start of the current timestep's 
+// first phase. It is called at the start of every serial timestep so that 
+// the TogglePerformanceOutput command takes effect on the following step.
+
+void CSimBox::UpdatePerformanceState()
+{
+	if(IsPerformanceOutputOn() && !m_pPerformanceState)
+	{
+		m_pPerformanceState = new CPerformanceState(GetRunId(), m_SimTime, GetPerformancePeriod(),
+													CCNTCell::GetPairCheckTotal(), CCNTCell::GetMigrationTotal());
+	}
+	else if(!IsPerformanceOutputOn() && m_pPerformanceState)
+	{
+		delete m_pPerformanceState;
+		m_pPerformanceState = 0;
+	}
+
+	CCNTCell::SetPairCount(m_pPerformanceState != 0);
+
+	if(m_pPerformanceState)
+	{
+		m_pPerformanceState->StartPhase();
+	}
+}
+
+// Function to charge the time since the previous phase ended to the given
+// phase of the timestep. It does nothing if the performance log is off.
+
+void CSimBox::EndPhase(long phase)
+{
+	if(m_pPerformanceState)
+	{
+		m_pPerformanceState->EndPhase(phase);
+	}
+}
+
 // Function to check that the beads in each CNT cell belong there. If the timestep
 // is too large, or a bead's velocity is too high, it is possible for a bead to
 // move across a whole cell in one timestep and have coordinates outside the extent
@@ -1376,59 +1850,457 @@ void CSimBox::CNTCellCheck()
 
 void CSimBox::AddBondForces()
 {
-	if(IsBondStressAdded())
+	if(CCNTCell::GetRESPASubstepNo() > 1)
+	{
+		// IntegrateRESPA() has already added the forces of the polymer bonds,
+		// so only their stress contributions are needed here. The beads' 
+		// stress was zeroed in UpdateForce() after the substeps added to it.
+
+		if(IsBondStressAdded())
+		{
+			for(BondVectorIterator iterBond=m_vFlatBonds.begin(); iterBond!=m_vFlatBonds.end(); iterBond++)
+			{
+				(*iterBond)->AddStress();
+
+				AddBondStress(*iterBond);
+			}
+		}
+		else
+		{
+			for(BondVectorIterator iterBond=m_vFlatBonds.begin(); iterBond!=m_vFlatBonds.end(); iterBond++)
+			{
+				(*iterBond)->AddStress();
+			}
+		}
+	}
+	else
+	{
+		// The bond kernel adds the forces; the stress is added afterwards in 
+		// polymer order as CBond::AddForce() would have added it.
+
+		EvaluateBondKernel();
+
+		if(IsBondStressAdded())
+		{
+			for(BondVectorIterator iterBond=m_vFlatBonds.begin(); iterBond!=m_vFlatBonds.end(); iterBond++)
+			{
+				(*iterBond)->AddStress();
+
+				AddBondStress(*iterBond);
+			}
+		}
+		else
+		{
+			for(BondVectorIterator iterBond=m_vFlatBonds.begin(); iterBond!=m_vFlatBonds.end(); iterBond++)
+			{
+				(*iterBond)->AddStress();
+			}
+		}
+	}
+    
+    // Add bond forces that bind polymers into nanoparticles. These are dynamically-created but stored in 
+    // their owning CNanoparticle instances instead of in the general polymerised bond container.
+
+	for(NanoparticleIterator iterNano=m_Nanoparticles.begin(); iterNano!=m_Nanoparticles.end(); iterNano++)
+    {
+        (*iterNano)->AddBondForces();
+    }    
+
+	// Next add in the forces due to dynamically-created bonds that are not contained
+	// in any single polymer or nanoparticle. Note that we should check whether the bond stress is to
+	// be added to the analysis of the stress profile. The container is held by the
+	// initial state and only grows when commands polymerise targets, so we iterate
+	// it in place instead of copying it every time step.
+
+	const BondVector& rPolymerisedBonds = GetAllPolymerisedBonds();
+
+	for(cBondVectorIterator citerBond=rPolymerisedBonds.begin(); citerBond!=rPolymerisedBonds.end(); citerBond++)
+	{
+		(*citerBond)->AddForce();
+	}
+}
+
+// Function to add the 3-body forces due to stiff bonds to those beads that are 
+// in polymers containing CBondPairs. We loop over the flat bondpair vector 
+// similarly to the bond force calculation above.
+
+void CSimBox::AddBondPairForces()
+{
+	if(CCNTCell::GetRESPASubstepNo() > 1)
+	{
+		if(IsBondPairStressAdded())
+		{
+			for(BondPairVectorIterator iterBP=m_vFlatBondPairs.begin(); iterBP!=m_vFlatBondPairs.end(); iterBP++)
+			{
+				AddBondPairStress(*iterBP);
+			}
+		}
+	}
+	else if(IsBondPairStressAdded())
+	{
+		for(BondPairVectorIterator iterBP=m_vFlatBondPairs.begin(); iterBP!=m_vFlatBondPairs.end(); iterBP++)
+		{
+			(*iterBP)->AddForce();
+
+			AddBondPairStress(*iterBP);
+		}
+	}
+	else
+	{
+		for(BondPairVectorIterator iterBP=m_vFlatBondPairs.begin(); iterBP!=m_vFlatBondPairs.end(); iterBP++)
+		{
+			(*iterBP)->AddForce();
+		}
+	}
+}
+
+// Private function to copy the bonds and bondpairs of all non-wall polymers into 
+// flat vectors used by AddBondForces() and AddBondPairForces(). The polymers are
+// visited in order so that consecutive bonds act on nearby beads in memory, and 
+// the forces are summed in the same order as the original per-polymer loops.
+
+void CSimBox::BuildFlatBondVectors()
+{
+	m_vFlatBonds.clear();
+	m_vFlatBondPairs.clear();
+
+	long bondTotal     = 0;
+	long bondPairTotal = 0;
+
+	for(cPolymerVectorIterator citerPoly=m_vAllPolymers.begin(); citerPoly!=m_vAllPolymers.end(); citerPoly++)
+	{
+		bondTotal     += (*citerPoly)->GetBonds().size();
+		bondPairTotal += (*citerPoly)->GetBondPairs().size();
+	}
+
+	m_vFlatBonds.reserve(bondTotal);
+	m_vFlatBondPairs.reserve(bondPairTotal);
+
+	for(cPolymerVectorIterator citerPoly=m_vAllPolymers.begin(); citerPoly!=m_vAllPolymers.end(); citerPoly++)
+	{
+		const BondVector&     rBonds     = (*citerPoly)->GetBonds();
+		const BondPairVector& rBondPairs = (*citerPoly)->GetBondPairs();
+
+		m_vFlatBonds.insert(m_vFlatBonds.end(), rBonds.begin(), rBonds.end());
+		m_vFlatBondPairs.insert(m_vFlatBondPairs.end(), rBondPairs.begin(), rBondPairs.end());
+	}
+
+	// The RESPA scheme only integrates the beads that the flat bonds act on.
+	// A bondpair's beads all belong to its two bonds, so the bonds suffice.
+
+	m_vRESPABeads.clear();
+	m_vRESPABeads.reserve(2*bondTotal);
+
+	for(cBondVectorIterator citerBond=m_vFlatBonds.begin(); citerBond!=m_vFlatBonds.end(); citerBond++)
+	{
+		m_vRESPABeads.push_back((*citerBond)->GetHead());
+		m_vRESPABeads.push_back((*citerBond)->GetTail());
+	}
+
+	std::sort(m_vRESPABeads.begin(), m_vRESPABeads.end());
+	m_vRESPABeads.erase(std::unique(m_vRESPABeads.begin(), m_vRESPABeads.end()), m_vRESPABeads.end());
+
+	BuildBondKernel();
+}
+
+// Private function to build the index arrays used by EvaluateBondKernel(). 
+// Each distinct bead acted on by the flat bonds is given an index, and each
+// bond is stored as the indices of its head and tail beads. The bonds are 
+// stably sorted by type so that bonds of the same type occupy a contiguous
+// range of the arrays, and m_vKernelSlot maps each flat bond back to its
+// position so that the forces can be added in polymer order. The arrays 
+// only depend on the bond topology and are rebuilt with the flat vectors.
+
+void CSimBox::BuildBondKernel()
+{
+	const long bondTotal = m_vFlatBonds.size();
+
+	m_vKernelBeads.clear();
+	m_vKernelBeads.reserve(2*bondTotal);
+
+	for(cBondVectorIterator citerBond=m_vFlatBonds.begin(); citerBond!=m_vFlatBonds.end(); citerBond++)
+	{
+		m_vKernelBeads.push_back((*citerBond)->GetHead());
+		m_vKernelBeads.push_back((*citerBond)->GetTail());
+	}
+
+	std::sort(m_vKernelBeads.begin(), m_vKernelBeads.end());
+	m_vKernelBeads.erase(std::unique(m_vKernelBeads.begin(), m_vKernelBeads.end()), m_vKernelBeads.end());
+
+	zLongVector vOrder(bondTotal);
+
+	for(long i=0; i<bondTotal; i++)
+	{
+		vOrder.at(i) = i;
+	}
+
+	const BondVector& rBonds = m_vFlatBonds;
+
+	std::stable_sort(vOrder.begin(), vOrder.end(), [&rBonds](long a, long b) {return rBonds.at(a)->GetType() < rBonds.at(b)->GetType();});
+
+	m_vKernelBonds.resize(bondTotal);
+	m_vKernelHead.resize(bondTotal);
+	m_vKernelTail.resize(bondTotal);
+	m_vKernelSlot.resize(bondTotal);
+	m_vKernelTypeStart.clear();
+
+	for(long k=0; k<bondTotal; k++)
+	{
+		CBond* const pBond = m_vFlatBonds.at(vOrder.at(k));
+
+		if(k == 0 || pBond->GetType() != m_vKernelBonds.at(k-1)->GetType())
+		{
+			m_vKernelTypeStart.push_back(k);
+		}
+
+		m_vKernelBonds.at(k) = pBond;
+		m_vKernelHead.at(k)  = std::lower_bound(m_vKernelBeads.begin(), m_vKernelBeads.end(), pBond->GetHead()) - m_vKernelBeads.begin();
+		m_vKernelTail.at(k)  = std::lower_bound(m_vKernelBeads.begin(), m_vKernelBeads.end(), pBond->GetTail()) - m_vKernelBeads.begin();
+		m_vKernelSlot.at(vOrder.at(k)) = k;
+	}
+
+	m_vKernelTypeStart.push_back(bondTotal);
+
+	m_vKernelXPos.resize(m_vKernelBeads.size());
+	m_vKernelYPos.resize(m_vKernelBeads.size());
+	m_vKernelZPos.resize(m_vKernelBeads.size());
+
+	m_vKernelSprConst.resize(bondTotal);
+	m_vKernelUnStrLen.resize(bondTotal);
+	m_vKernelDX.resize(bondTotal);
+	m_vKernelDY.resize(bondTotal);
+	m_vKernelDZ.resize(bondTotal);
+	m_vKernelLength.resize(bondTotal);
+	m_vKernelFX.resize(bondTotal);
+	m_vKernelFY.resize(bondTotal);
+	m_vKernelFZ.resize(bondTotal);
+}
+
+// Private function to add the forces of the flat bonds using the index arrays
+// built by BuildBondKernel(). It replaces a call of CBond::AddForce() for 
+// every flat bond and gives identical results. The beads' unPBC coordinates 
+// and the bond parameters, which commands may change, are first gathered into
+// contiguous arrays. The bond vectors and forces are then evaluated one type
+// group at a time in a loop with no pointer chasing or aliasing, which the
+// compiler can vectorise, and finally written back to the bonds and beads in
+// polymer order using CBond::ApplyForce(). No stress is added here.
+
+void CSimBox::EvaluateBondKernel()
+{
+	const long beadTotal = m_vKernelBeads.size();
+	const long bondTotal = m_vKernelBonds.size();
+
+	if(bondTotal == 0)
+		return;
+
+	double* const pX = &m_vKernelXPos[0];
+	double* const pY = &m_vKernelYPos[0];
+	double* const pZ = &m_vKernelZPos[0];
+
+	for(long j=0; j<beadTotal; j++)
+	{
+		const CAbstractBead* const pBead = m_vKernelBeads[j];
+
+		pX[j] = pBead->GetunPBCXPos();
+		pY[j] = pBead->GetunPBCYPos();
+		pZ[j] = pBead->GetunPBCZPos();
+	}
+
+	for(long k=0; k<bondTotal; k++)
+	{
+		m_vKernelSprConst[k] = m_vKernelBonds[k]->GetSprConst();
+		m_vKernelUnStrLen[k] = m_vKernelBonds[k]->GetUnStrLength();
+	}
+
+	const long*   const pHead    = &m_vKernelHead[0];
+	const long*   const pTail    = &m_vKernelTail[0];
+	const double* const pSprConst = &m_vKernelSprConst[0];
+	const double* const pUnStrLen = &m_vKernelUnStrLen[0];
+
+	double* const pDX  = &m_vKernelDX[0];
+	double* const pDY  = &m_vKernelDY[0];
+	double* const pDZ  = &m_vKernelDZ[0];
+	double* const pLen = &m_vKernelLength[0];
+	double* const pFX  = &m_vKernelFX[0];
+	double* const pFY  = &m_vKernelFY[0];
+	double* const pFZ  = &m_vKernelFZ[0];
+
+	for(long group=0; group+1<static_cast<long>(m_vKernelTypeStart.size()); group++)
+	{
+		const long first = m_vKernelTypeStart[group];
+		const long last  = m_vKernelTypeStart[group+1];
+
+		for(long k=first; k<last; k++)
+		{
+			const double dx  = pX[pHead[k]] - pX[pTail[k]];
+			const double dy  = pY[pHead[k]] - pY[pTail[k]];
+			const double dz  = pZ[pHead[k]] - pZ[pTail[k]];
+			const double len = sqrt(dx*dx + dy*dy + dz*dz);
+
+			pDX[k]  = dx;
+			pDY[k]  = dy;
+			pDZ[k]  = dz;
+			pLen[k] = len;
+			pFX[k]  = pSprConst[k]*(pUnStrLen[k] - len)*dx/len;
+			pFY[k]  = pSprConst[k]*(pUnStrLen[k] - len)*dy/len;
+			pFZ[k]  = pSprConst[k]*(pUnStrLen[k] - len)*dz/len;
+		}
+	}
+
+	for(long i=0; i<bondTotal; i++)
+	{
+		const long k = m_vKernelSlot[i];
+
+		m_vFlatBonds[i]->ApplyForce(pDX[k], pDY[k], pDZ[k], pLen[k], pFX[k], pFY[k], pFZ[k]);
+	}
+}
+
+// Private function to add the forces of the polymer bonds and bondpairs, but 
+// not their stress, for the RESPA substeps. As in the single timestep 
+// integration, the bondpairs rely on the bond lengths set by CBond::AddForce().
+
+void CSimBox::AddRESPABondForces()
+{
+	EvaluateBondKernel();
+
+	for(BondPairVectorIterator iterBP=m_vFlatBondPairs.begin(); iterBP!=m_vFlatBondPairs.end(); iterBP++)
+	{
+		(*iterBP)->AddForce();
+	}
+}
+
+// Private function to integrate the beads over one timestep using the RESPA
+// (reversible reference system propagator) scheme. The polymer bond and 
+// bondpair forces are stiff but cheap, so they are treated as fast forces and
+// integrated with velocity-Verlet over k substeps of size dt/k; all other 
+// forces are slow and are applied as half kicks at the start and end of the 
+// outer step. The slow force on bonded beads is the one left in m_Force at the
+// end of the previous step, which therefore excludes the bond forces.
+//
+// This function does the work of the first half of CCNTCell::UpdatePos() for 
+// every movable bead: it stores the old momentum and force, sets the
+// intermediate velocity used by the DPD dissipative force and stores the 
+// displacement over the whole step in m_dPos. For bonded beads the 
+// displacement is that produced by the substeps, which move the beads' unPBC 
+// coordinates because these are what the bond forces use. The unPBC 
+// coordinates are restored afterwards so that UpdatePos() can apply the 
+// displacement to both sets of coordinates and migrate beads between cells.
+//
+// The bonded beads' m_oldMom is set so that UpdateMom() produces the correct 
+// final momentum from the old slow force and the new slow force in m_Force.
+// Their intermediate velocity follows the same lambda prediction as other
+// beads but uses the momentum reached at the end of the substeps.
+
+void CSimBox::IntegrateRESPA()
+{
+	const double dt      = CCNTCell::GetStepSize();
+	const double halfdt  = CCNTCell::GetHalfStepSize();
+	const double lamdt   = CCNTCell::GetLambdaStepSize();
+	const double substeps = static_cast<double>(CCNTCell::GetRESPASubstepNo());
+	const double subdt     = dt/substeps;
+	const double halfsubdt = halfdt/substeps;
+
+	for(CNTCellIterator iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	{
-		for(PolymerVectorIterator iterPoly=m_vAllPolymers.begin(); iterPoly!=m_vAllPolymers.end(); iterPoly++)
+		const BeadList& rBeads = (*iterCell)->GetBeads();
+
+		for(cBeadListIterator citerBead=rBeads.begin(); citerBead!=rBeads.end(); citerBead++)
 		{
-			(*iterPoly)->AddBondForces(this);
+			CAbstractBead* const pBead = *citerBead;
+
+			if(pBead->GetMovable())
+			{
+				for(short int i=0; i<3; i++)
+				{
+					pBead->m_oldMom[i]   = pBead->m_Mom[i];
+					pBead->m_oldForce[i] = pBead->m_Force[i];
+					pBead->m_dPos[i]     = dt*pBead->m_Mom[i] + dt*halfdt*pBead->m_Force[i];
+					pBead->m_Mom[i]      = pBead->m_oldMom[i] + lamdt*pBead->m_oldForce[i];
+					pBead->m_Force[i]    = 0.0;
+				}
+			}
 		}
 	}
-	else
+
+	// Bonded beads receive the first slow half kick and start their 
+	// displacement from zero. The fast forces at the start of the step are 
+	// recalculated because m_Force only holds the slow forces.
+
+	AbstractBeadVectorIterator iterBead;
+
+	for(iterBead=m_vRESPABeads.begin(); iterBead!=m_vRESPABeads.end(); iterBead++)
 	{
-		for(PolymerVectorIterator iterPoly=m_vAllPolymers.begin(); iterPoly!=m_vAllPolymers.end(); iterPoly++)
+		CAbstractBead* const pBead = *iterBead;
+
+		for(short int i=0; i<3; i++)
 		{
-			(*iterPoly)->AddBondForces();
+			if(pBead->GetMovable())
+			{
+				pBead->m_Mom[i]  = pBead->m_oldMom[i] + halfdt*pBead->m_oldForce[i];
+				pBead->m_dPos[i] = 0.0;
+			}
+			pBead->m_Force[i] = 0.0;
 		}
 	}
-    
-    // Add bond forces that bind polymers into nanoparticles. These are dynamically-created but stored in 
-    // their owning CNanoparticle instances instead of in the general polymerised bond container.
 
-	for(NanoparticleIterator iterNano=m_Nanoparticles.begin(); iterNano!=m_Nanoparticles.end(); iterNano++)
-    {
-        (*iterNano)->AddBondForces();
-    }    
+	AddRESPABondForces();
 
-	// Next add in the forces due to dynamically-created bonds that are not contained
-	// in any single polymer or nanoparticle. Note that we should check whether the bond stress is to
-	// be added to the analysis of the stress profile.
+	for(long step=0; step<CCNTCell::GetRESPASubstepNo(); step++)
+	{
+		for(iterBead=m_vRESPABeads.begin(); iterBead!=m_vRESPABeads.end(); iterBead++)
+		{
+			CAbstractBead* const pBead = *iterBead;
 
-	BondVector vBonds = GetAllPolymerisedBonds();
+			if(pBead->GetMovable())
+			{
+				for(short int i=0; i<3; i++)
+				{
+					pBead->m_Mom[i] += halfsubdt*pBead->m_Force[i];
 
-	for(BondVectorIterator iterBond=vBonds.begin(); iterBond!=vBonds.end(); iterBond++)
-	{
-		(*iterBond)->AddForce();
-	}
-}
+					const double dx = subdt*pBead->m_Mom[i];
 
-// Function to add the 3-body forces due to stiff bonds to those beads that are 
-// in polymers containing CBondPairs. We loop over the polymer vector similarly to
-// the bond force calculation above.
+					pBead->m_unPBCPos[i] += dx;
+					pBead->m_dPos[i]     += dx;
+				}
+			}
 
-void CSimBox::AddBondPairForces()
-{
-	if(IsBondPairStressAdded())
-	{
-		for(PolymerVectorIterator iterPoly=m_vAllPolymers.begin(); iterPoly!=m_vAllPolymers.end(); iterPoly++)
+			pBead->m_Force[0] = 0.0;
+			pBead->m_Force[1] = 0.0;
+			pBead->m_Force[2] = 0.0;
+		}
+
+		AddRESPABondForces();
+
+		for(iterBead=m_vRESPABeads.begin(); iterBead!=m_vRESPABeads.end(); iterBead++)
 		{
-			(*iterPoly)->AddBondPairForces(this);
+			CAbstractBead* const pBead = *iterBead;
+
+			if(pBead->GetMovable())
+			{
+				pBead->m_Mom[0] += halfsubdt*pBead->m_Force[0];
+				pBead->m_Mom[1] += halfsubdt*pBead->m_Force[1];
+				pBead->m_Mom[2] += halfsubdt*pBead->m_Force[2];
+			}
 		}
 	}
-	else
+
+	// Fold the fast forces into m_oldMom, set the intermediate velocity and
+	// undo the substep displacements of the unPBC coordinates. The forces are 
+	// zeroed so that UpdateForce() can sum the slow forces for this step.
+
+	for(iterBead=m_vRESPABeads.begin(); iterBead!=m_vRESPABeads.end(); iterBead++)
 	{
-		for(PolymerVectorIterator iterPoly=m_vAllPolymers.begin(); iterPoly!=m_vAllPolymers.end(); iterPoly++)
+		CAbstractBead* const pBead = *iterBead;
+
+		for(short int i=0; i<3; i++)
 		{
-			(*iterPoly)->AddBondPairForces();
+			if(pBead->GetMovable())
+			{
+				pBead->m_oldMom[i]    = pBead->m_Mom[i] - halfdt*pBead->m_oldForce[i];
+				pBead->m_Mom[i]       = pBead->m_oldMom[i] + lamdt*pBead->m_oldForce[i];
+				pBead->m_unPBCPos[i] -= pBead->m_dPos[i];
+			}
+			pBead->m_Force[i] = 0.0;
 		}
 	}
 }
@@ -2756,6 +3628,36 @@ void CSimBox::AddPolymersInCell(const xxCommand *const pCommand)
 #endif
 }
 
+// Command handler function to convert a nanoparticle into a rigid body. Its
+// beads then move together as one body and its internal bonds are no longer
+// evaluated. Rigid nanoparticles are only integrated in the serial code, so
+// the command fails in a parallel run, as it does if the id is unknown. It 
+// also fails if the RESPA scheme is in use, because IntegrateRESPA() moves 
+// the bonded beads independently and would break up the rigid body.
+
+void CSimBox::MakeNanoparticleRigid(const xxCommand* const pCommand)
+{
+	const ccMakeNanoparticleRigid* const pCmd = dynamic_cast<const ccMakeNanoparticleRigid*>(pCommand);
+
+#if EnableParallelSimBox == SimMPSEnabled
+	if(xxParallelBase::GlobalGetRank() == 0)
+	{
+		new CLogCommandFailed(m_SimTime, pCmd);
+	}
+#else
+	CNanoparticle* const pNano = (CCNTCell::GetRESPASubstepNo() > 1 ? 0 : GetNanoparticle(pCmd->GetNanoparticleId()));
+
+	if(pNano && pNano->MakeRigid(GetSimBoxXLength(), GetSimBoxYLength(), GetSimBoxZLength()))
+	{
+		new CLogMakeNanoparticleRigid(m_SimTime, pNano->GetId(), pNano->GetBeadTotal());
+	}
+	else
+	{
+		new CLogCommandFailed(m_SimTime, pCmd);
+	}
+#endif
+}
+
 // Function to implement a selection command that collects polymers of the 
 // specified types throughout the SimBox and moves them so that their heads
 // lie within a specified CNT slice and their bodies are randomly distributed
@@ -3048,16 +3950,33 @@ void CSimBox::RunMCRelaxation()
 {
 	long  AcceptCount = 0;
 
-	for(long MCSimTime=1; MCSimTime<=m_TotalMCTime; MCSimTime++)
-	{
-		AcceptCount+= MCPolymerRelaxation(m_vAllPolymers);
+	// If threads are requested, and there are enough CNT cells for each one to
+	// have distinct neighbours, relax non-adjacent cells concurrently. 
+	// Otherwise move one bead at a time through all polymers.
 
-		// Now do the same for the wall polymers (if any).
-		// Note that if no wall is present the function should return false.
+#if SimDimension == 2
+	const bool bCheckerboard = m_MCThreadNo > 0 && m_CNTXCellNo > 2 && m_CNTYCellNo > 2;
+#elif SimDimension == 3
+	const bool bCheckerboard = m_MCThreadNo > 0 && m_CNTXCellNo > 2 && m_CNTYCellNo > 2 && m_CNTZCellNo > 2;
+#endif
 
-		if(IsWallPolymerFlexible())
+	if(bCheckerboard)
+	{
+		AcceptCount = MCCheckerboardRelaxation();
+	}
+	else
+	{
+		for(long MCSimTime=1; MCSimTime<=m_TotalMCTime; MCSimTime++)
 		{
-			AcceptCount+= MCPolymerRelaxation(m_vWallPolymers);
+			AcceptCount+= MCPolymerRelaxation(m_vAllPolymers);
+
+			// Now do the same for the wall polymers (if any).
+			// Note that if no wall is present the function should return false.
+
+			if(IsWallPolymerFlexible())
+			{
+				AcceptCount+= MCPolymerRelaxation(m_vWallPolymers);
+			}
 		}
 	}
 
@@ -3126,6 +4045,10 @@ void CSimBox::RunMCRelaxation()
 
 	CNTCellIterator iterCell;
 
+#if EnableLeanBeadStorage == SimMiscEnabled
+	CAbstractBead::ZeroTotalStress();
+#endif
+
 	for(iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
 	{
 		(*iterCell)->UpdateForce();
@@ -3780,6 +4703,234 @@ long CSimBox::MCPolymerRelaxation(PolymerVector& rPolymers)
 	return AcceptCount;
 }
 
+// Function to relax all polymers by MC moving beads in non-adjacent CNT cells
+// concurrently. The cells are coloured so that cells of the same colour are
+// at least four cells apart, allowing for the PBCs. Each sweep relaxes the 
+// cells of each colour in turn, with the cells of one colour shared between
+// m_MCThreadNo threads. A bead can only move to an adjacent cell, and its
+// energy depends on beads at most one cell further away, so the moves in 
+// cells of the same colour never see each other's changes. Each cell draws 
+// its random numbers from its own stream whose seed depends only on the RNG
+// seed, the sweep and the cell, so the result does not depend on the number
+// of threads.
+//
+// Each trial move uses the exact energy change of the bead: its interactions
+// with all beads in the surrounding cells plus only those bonds and bond 
+// pairs that contain it. Beads whose bonded partners are not in adjacent 
+// cells are moved on the calling thread at the end of the sweep, followed by
+// the wall polymers if they are flexible.
+//
+// The function returns the number of accepted moves. The caller must ensure 
+// that there are at least three CNT cells in each dimension.
+
+long CSimBox::MCCheckerboardRelaxation()
+{
+	// Collect the bonded terms that depend on each bead in the polymers
+
+	long maxId = 0;
+
+	for(PolymerVectorIterator iterPoly=m_vAllPolymers.begin(); iterPoly!=m_vAllPolymers.end(); iterPoly++)
+	{
+		for(BeadVectorIterator iterBead=(*iterPoly)->GetBeads().begin(); iterBead!=(*iterPoly)->GetBeads().end(); iterBead++)
+		{
+			if((*iterBead)->GetId() > maxId)
+				maxId = (*iterBead)->GetId();
+		}
+	}
+
+	std::vector<MCBeadTerms> vTerms(maxId + 1);
+
+	for(PolymerVectorIterator iterPoly=m_vAllPolymers.begin(); iterPoly!=m_vAllPolymers.end(); iterPoly++)
+	{
+		for(BeadVectorIterator iterBead=(*iterPoly)->GetBeads().begin(); iterBead!=(*iterPoly)->GetBeads().end(); iterBead++)
+		{
+			vTerms.at((*iterBead)->GetId()).bActive = true;
+		}
+
+		for(BondVectorIterator iterBond=(*iterPoly)->GetBonds().begin(); iterBond!=(*iterPoly)->GetBonds().end(); iterBond++)
+		{
+			CAbstractBead* const pHead = (*iterBond)->GetHead();
+			CAbstractBead* const pTail = (*iterBond)->GetTail();
+
+			vTerms.at(pHead->GetId()).vBonds.push_back(*iterBond);
+			vTerms.at(pTail->GetId()).vBonds.push_back(*iterBond);
+			AddUniqueBead(vTerms.at(pHead->GetId()).vPartners, pTail);
+			AddUniqueBead(vTerms.at(pTail->GetId()).vPartners, pHead);
+		}
+
+		for(BondPairVectorIterator iterBP=(*iterPoly)->GetBondPairs().begin(); iterBP!=(*iterPoly)->GetBondPairs().end(); iterBP++)
+		{
+			CBond* const aBonds[2] = {(*iterBP)->GetFirst(), (*iterBP)->GetSecond()};
+
+			AbstractBeadVector vBPBeads;
+			AddUniqueBead(vBPBeads, aBonds[0]->GetHead());
+			AddUniqueBead(vBPBeads, aBonds[0]->GetTail());
+			AddUniqueBead(vBPBeads, aBonds[1]->GetHead());
+			AddUniqueBead(vBPBeads, aBonds[1]->GetTail());
+
+			for(AbstractBeadVectorIterator iterBead=vBPBeads.begin(); iterBead!=vBPBeads.end(); iterBead++)
+			{
+				MCBeadTerms& rTerms = vTerms.at((*iterBead)->GetId());
+
+				rTerms.vBondPairs.push_back(*iterBP);
+
+				for(short int i=0; i<2; i++)
+				{
+					if(aBonds[i]->GetHead() != *iterBead && aBonds[i]->GetTail() != *iterBead)
+						AddUniqueBond(rTerms.vRefreshBonds, aBonds[i]);
+				}
+
+				for(AbstractBeadVectorIterator iterBead2=vBPBeads.begin(); iterBead2!=vBPBeads.end(); iterBead2++)
+				{
+					if(*iterBead2 != *iterBead)
+						AddUniqueBead(rTerms.vPartners, *iterBead2);
+				}
+			}
+		}
+	}
+
+	// Colour the CNT cells and group the cells of each colour together
+
+#if SimDimension == 2
+	const long colourNo[3] = {MCColourNo(m_CNTXCellNo), MCColourNo(m_CNTYCellNo), 1};
+#elif SimDimension == 3
+	const long colourNo[3] = {MCColourNo(m_CNTXCellNo), MCColourNo(m_CNTYCellNo), MCColourNo(m_CNTZCellNo)};
+#endif
+
+	std::vector<CNTCellVector> vColourCells(colourNo[0]*colourNo[1]*colourNo[2]);
+
+	for(CNTCellIterator iterCell=m_vCNTCells.begin(); iterCell!=m_vCNTCells.end(); iterCell++)
+	{
+		const long colour = (*iterCell)->GetBLXIndex()%colourNo[0] + 
+						    colourNo[0]*((*iterCell)->GetBLYIndex()%colourNo[1] + colourNo[1]*((*iterCell)->GetBLZIndex()%colourNo[2]));
+
+		vColourCells.at(colour).push_back(*iterCell);
+	}
+
+	// Use no more threads than there are cells of one colour. The calling
+	// thread does the share of thread 0 and the serial parts of each sweep.
+
+	const long cellTotal = static_cast<long>(m_vCNTCells.size());
+	const long threadNo  = std::max(1L, std::min(m_MCThreadNo, static_cast<long>(vColourCells.front().size())));
+
+	MCCheckerboardContext context;
+	context.pCells		 = &m_vCNTCells;
+	context.pvTerms		 = &vTerms;
+	context.cellNo[0]	 = m_CNTXCellNo;
+	context.cellNo[1]	 = m_CNTYCellNo;
+	context.cellNo[2]	 = m_CNTZCellNo;
+	context.cellWidth[0] = m_CNTXCellWidth;
+	context.cellWidth[1] = m_CNTYCellWidth;
+	context.cellWidth[2] = m_CNTZCellWidth;
+	context.boxLength[0] = GetSimBoxXLength();
+	context.boxLength[1] = GetSimBoxYLength();
+	context.boxLength[2] = GetSimBoxZLength();
+	context.twoMaxStep	 = 2.0*m_MaxMCStep;
+	context.beta		 = 1.0/GetkT();
+
+#if SimDimension == 2
+	context.cellNo[2]	 = 1;
+	context.cellWidth[2] = GetSimBoxZLength();
+#endif
+
+	CCNTCell::MDPotentialState potentialState;
+	CCNTCell::GetMDPotentialState(potentialState);
+
+	std::vector<uint64_t>			vSeeds(cellTotal);
+	std::vector<AbstractBeadVector>	vDeferred(cellTotal);
+	std::vector<long>				vAcceptCount(threadNo, 0);
+
+	MCThreadBarrier barrier(threadNo);
+
+	auto worker = [&](long thread)
+	{
+		if(thread > 0)
+		{
+			CCNTCell::SetMDPotentialState(potentialState);
+		}
+
+		for(long MCSimTime=0; MCSimTime<m_TotalMCTime; MCSimTime++)
+		{
+			if(thread == 0)
+			{
+				for(long cell=0; cell<cellTotal; cell++)
+				{
+					vSeeds[cell] = CCNTCell::GetRandomStreamSeed(MCSimTime*cellTotal + cell);
+				}
+			}
+
+			barrier.Wait();
+
+			for(std::vector<CNTCellVector>::const_iterator iterColour=vColourCells.begin(); iterColour!=vColourCells.end(); iterColour++)
+			{
+				const long size  = static_cast<long>(iterColour->size());
+				const long first = (thread*size)/threadNo;
+				const long last  = ((thread + 1)*size)/threadNo;
+
+				for(long i=first; i<last; i++)
+				{
+					const long cell = iterColour->at(i)->GetId();
+
+					vAcceptCount[thread] += MCRelaxCell(context, iterColour->at(i), vSeeds[cell], vDeferred[cell]);
+				}
+
+				barrier.Wait();
+			}
+
+			// Move the deferred beads and the wall polymers on the calling thread
+
+			if(thread == 0)
+			{
+				double rn[4];
+
+				for(std::vector<AbstractBeadVector>::iterator iterDeferred=vDeferred.begin(); iterDeferred!=vDeferred.end(); iterDeferred++)
+				{
+					for(AbstractBeadVectorIterator iterBead=iterDeferred->begin(); iterBead!=iterDeferred->end(); iterBead++)
+					{
+						for(short int i=0; i<4; i++)
+						{
+							rn[i] = CCNTCell::GetRandomNo();
+						}
+
+						if(MCTrialMove(context, *iterBead, vTerms[(*iterBead)->GetId()], rn, false))
+							vAcceptCount[0]++;
+					}
+
+					iterDeferred->clear();
+				}
+
+				if(IsWallPolymerFlexible())
+				{
+					vAcceptCount[0] += MCPolymerRelaxation(m_vWallPolymers);
+				}
+			}
+		}
+	};
+
+	std::vector<std::thread> vThreads;
+
+	for(long thread=1; thread<threadNo; thread++)
+	{
+		vThreads.push_back(std::thread(worker, thread));
+	}
+
+	worker(0);
+
+	for(std::vector<std::thread>::iterator iterThread=vThreads.begin(); iterThread!=vThreads.end(); iterThread++)
+	{
+		iterThread->join();
+	}
+
+	long acceptCount = 0;
+
+	for(long thread=0; thread<threadNo; thread++)
+	{
+		acceptCount += vAcceptCount[thread];
+	}
+
+	return acceptCount;
+}
+
 // Function to add charge to a specified bead type. It wraps each bead with a 
 // CBeadChargeWrapper object so that all beads of the type experience an 
 // interaction due to their charge. Several bead types can be charged, but the
@@ -4216,6 +5367,10 @@ void CSimBox::RestoreOriginalBeadType(const xxCommand* const pCommand)
 // zeroes the old values of bead momenta and force to prevent huge forces
 // being generated out of the time step change.
 //
+// In the serial code, a step that the integrator cannot use, such as one that
+// makes the Lowe-Andersen collision probability exceed unity, is refused and
+// the command is logged as failed.
+//
 
 void CSimBox::SetTimeStepSize(const xxCommand* const pCommand)
 {
@@ -4232,6 +5387,12 @@ void CSimBox::SetTimeStepSize(const xxCommand* const pCommand)
 
 #else
 
+	if(!CCNTCell::IsTimeStepAllowed(pCmd->GetTimeStep()))
+	{
+		new CLogCommandFailed(m_SimTime, pCmd);
+		return;
+	}
+
 	IModifyIntegration()->SetTimeStep(pCmd->GetTimeStep());
 
 	// Zero bead data - not implemented yet
@@ -5873,85 +7034,112 @@ void CSimBox::MakeStressCells()
 //
 // The equation of the line is:  r(lambda) = rp + lambda*(rq - rp),  where lambda = 0 to 1
 //
-// We divide the line into a fixed number of segments and add the stress to the cells that contain each segment.  We include both end-points 
-// explicitly so the actual number of segments is one less than the number of points.
-//
-// Double-counting is prevented by storing each CNT cell as we add the stress and only adding the stress to a cell if it is different from the old one. As we are
-// iterating over a straight line that is shorter than the size of the simulation box this is ok.
+// Each cell crossed by the line receives the stress weighted by the fraction of the line that lies inside it, as required by the
+// Irving-Kirkwood contour. We find the cells and fractions exactly by walking through the grid from the cell containing rp to the
+// cell containing rq (Amanatides and Woo, Eurographics 1987): for each dimension we store the value of lambda at which the line
+// next crosses a cell boundary and the increment in lambda between successive boundaries, and at each step move into the 
+// neighbouring cell across the nearest boundary. The number of steps is the number of boundaries between the end cells, so 
+// only the cells actually crossed are visited. Segments lying outside the stress grid are ignored.
 
 void CSimBox::AddWeightedStressToLinearCells(double rp[3], double rq[3], double stress[9])
 {
 #if EnableStressTensorSphere == SimMiscEnabled
 
-    long i;    // counter used several times below
-    for(i=0; i<3; i++)
-	{
-	    m_rprime[i] = rp[i];
-	    m_dr[i]     = (rq[i] - rp[i])*m_InversePointTotalMinusOne;
-	}
-	
-	m_pOldCell = GetStressCellFromCoords(rp);
-	m_pNewCell = GetStressCellFromCoords(rq);
-			
-	if(m_pNewCell != m_pOldCell)
+	const double width[3]  = {m_StressCellXWidth, m_StressCellYWidth, m_StressCellZWidth};
+	const long   cellNo[3] = {m_StressCellXNo, m_StressCellYNo, m_StressCellZNo};
+
+	long   cell[3];			// Indices of the current cell in each dimension
+	long   lastCell[3];		// Indices of the cell containing rq
+	long   step[3];			// Direction of travel through the grid
+	double lambdaNext[3];	// Value of lambda at the next cell boundary
+	double lambdaDelta[3];	// Increment in lambda between cell boundaries
+
+	long crossingTotal = 0;
+
+	for(long i=0; i<3; i++)
 	{
-//		std::cout << " ******************** " << zEndl;
-//		std::cout << "Starting iteration over vector joining cells " << m_pOldCell->GetId() << " and " << m_pNewCell->GetId() << zEndl;
-		
-	    m_StressWeight  = 0.0;
-		
-        for(i=0; i<m_PointTotal; i++)
-	    {        
-	        m_pNewCell = GetStressCellFromCoords(m_rprime);
-		
-		    if(m_pNewCell != m_pOldCell)
-		    {
-		        // Weight the stress tensor by the old cell's fraction of the vector and add it to the local stress tensor;
-			    // then reset the weight counter
-			    for(long j=0; j<9; j++)
-			    {
-			        m_LocalStress[j] = m_StressWeight*stress[j];
-			    }
-			
-//			    std::cout << " Adding stress to cell " << m_pOldCell->GetId() << " with weight " << m_StressWeight << zEndl;
-//				std::cout << m_LocalStress[0] << " " << m_LocalStress[1] << " " << m_LocalStress[2] << zEndl;
-//				std::cout << m_LocalStress[3] << " " << m_LocalStress[4] << " " << m_LocalStress[5] << zEndl;
-//				std::cout << m_LocalStress[6] << " " << m_LocalStress[7] << " " << m_LocalStress[8] << zEndl;
-				
-		        m_pOldCell->AddStress(m_LocalStress);
-			    m_pOldCell = m_pNewCell;
-			    m_StressWeight = m_InversePointTotal;
-		    }
-		    else
-		    {
-		        m_StressWeight += m_InversePointTotal;
-		    }
-	
-	        m_rprime[0] += m_dr[0];
-	        m_rprime[1] += m_dr[1];
-	        m_rprime[2] += m_dr[2];
-	    }
-	
-	    // Add the stress to the final cell on the vector as it will not have been done inside the loop
-	
-	    for(i=0; i<9; i++)
-	    {
-		    m_LocalStress[i] = m_StressWeight*stress[i];
-	    }
-		
-//		std::cout << " Adding stress to cell " << m_pOldCell->GetId() << " with weight " << m_StressWeight << zEndl;
-//		std::cout << m_LocalStress[0] << " " << m_LocalStress[1] << " " << m_LocalStress[2] << zEndl;
-//		std::cout << m_LocalStress[3] << " " << m_LocalStress[4] << " " << m_LocalStress[5] << zEndl;
-//		std::cout << m_LocalStress[6] << " " << m_LocalStress[7] << " " << m_LocalStress[8] << zEndl;
-	    m_pOldCell->AddStress(m_LocalStress);
+		const double dr = rq[i] - rp[i];
+
+		cell[i]     = static_cast<long>(floor(rp[i]/width[i]));
+		lastCell[i] = static_cast<long>(floor(rq[i]/width[i]));
+
+		if(dr > 0.0)
+		{
+			step[i]        = 1;
+			lambdaNext[i]  = (static_cast<double>(cell[i] + 1)*width[i] - rp[i])/dr;
+			lambdaDelta[i] = width[i]/dr;
+		}
+		else if(dr < 0.0)
+		{
+			step[i]        = -1;
+			lambdaNext[i]  = (static_cast<double>(cell[i])*width[i] - rp[i])/dr;
+			lambdaDelta[i] = -width[i]/dr;
+		}
+		else
+		{
+			step[i]        = 0;
+			lambdaNext[i]  = 2.0;	// Never reached as lambda <= 1
+			lambdaDelta[i] = 0.0;
+		}
+
+		// Boundaries beyond the final cell are never crossed, even if rounding
+		// puts them inside the line
+
+		if(cell[i] == lastCell[i])
+		{
+			lambdaNext[i] = 2.0;
+		}
+
+		crossingTotal += labs(lastCell[i] - cell[i]);
 	}
-	else
+
+	double lambda = 0.0;
+
+	for(long crossing=0; crossing<=crossingTotal; crossing++)
 	{
-	    // Both points are in the same cell so we add the whole stress
-		
-	    m_pOldCell->AddStress(stress);	
+		// Find the dimension whose boundary is crossed next. On the last segment 
+		// the line ends inside the current cell.
+
+		long next = 0;
+		if(lambdaNext[1] < lambdaNext[next])
+			next = 1;
+		if(lambdaNext[2] < lambdaNext[next])
+			next = 2;
+
+		double lambdaEnd = 1.0;
+
+		if(crossing < crossingTotal)
+		{
+			lambdaEnd = lambdaNext[next];
+
+			// Rounding can place a boundary fractionally outside the line
+
+			if(lambdaEnd > 1.0)
+				lambdaEnd = 1.0;
+			else if(lambdaEnd < lambda)
+				lambdaEnd = lambda;
+		}
+
+		if(0 <= cell[0] && cell[0] < cellNo[0] &&
+		   0 <= cell[1] && cell[1] < cellNo[1] &&
+		   0 <= cell[2] && cell[2] < cellNo[2])
+		{
+			const double weight = lambdaEnd - lambda;
+
+			for(long j=0; j<9; j++)
+			{
+				m_LocalStress[j] = weight*stress[j];
+			}
+
+			m_vStressCells[cellNo[0]*(cellNo[1]*cell[2] + cell[1]) + cell[0]]->AddStress(m_LocalStress);
+		}
+
+		lambda = lambdaEnd;
+
+		cell[next]       += step[next];
+		lambdaNext[next]  = (cell[next] == lastCell[next]) ? 2.0 : lambdaNext[next] + lambdaDelta[next];
 	}
-		
+
 #endif
 }
 
@@ -6286,7 +7474,7 @@ PolymerVector CSimBox::GetPolymersInRectangularRegion(double x, double y, double
 
 // Function to create a new CNanoparticle instance wrapped around a set of CBond instances. The nanoparticles are identified by 
 // a unique integer that is just the number of nanoparticles created. Note that there is no way to modify a nanoparticle after 
-// creation, unlike for Command Targets. Hence, we do not provide functions to delete or alter nanoparticles.
+// creation, unlike for Command Targets, except to make it rigid. Hence, we do not provide functions to delete or alter nanoparticles.
 
 bool CSimBox::CreateNanoparticle(BondVector vBonds)
 {
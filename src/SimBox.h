@@ -15,6 +15,7 @@
 // Forward declarations
 
 class CNanoparticle;
+class CPerformanceState;
 
 
 #if EnableParallelSimBox == SimMPSEnabled
@@ -549,6 +550,7 @@ private:
 	virtual void								  GravityOff(const xxCommand* const pCommand);
 	virtual void								 LinearForce(const xxCommand* const pCommand);
 	virtual void						 LinearForceOnTarget(const xxCommand* const pCommand);
+	virtual void					   MakeNanoparticleRigid(const xxCommand* const pCommand);
 	virtual void						 MovePolymersToSlice(const xxCommand* const pCommand);
 	virtual void								 RadialForce(const xxCommand* const pCommand);
 	virtual void						 RadialForceOnTarget(const xxCommand* const pCommand);
@@ -637,9 +639,18 @@ private:
 	void AddBodyForce();			// Add the external body force to all affected beads
 	void AddBondForces();			// Add bond forces to the beads in polymers
 	void AddBondPairForces();		// Add 3-body bond forces to the beads in polymers
+	void BuildFlatBondVectors();	// Collect all polymer bonds and bondpairs into flat vectors
+	void BuildBondKernel();			// Index the flat bonds' beads in arrays grouped by bond type
+	void EvaluateBondKernel();		// Add the flat bond forces using the index arrays
+	void AddRESPABondForces();		// Add the forces of the flat bonds and bondpairs only
+	void IntegrateRESPA();			// Integrate the polymer bond forces over RESPA substeps
 	void AddChargedBeadForces();	// Add the screened charge force to charged beads
 	void UpdateRenormalisedMom();	// Normalises the momenta to the imposed temperature
 	long MCPolymerRelaxation(PolymerVector& rPolymers);	// Relaxes a set of polymers using MC
+	long MCCheckerboardRelaxation();	// Relaxes all polymers using MC on non-adjacent CNT cells concurrently
+
+	void UpdatePerformanceState();	// Create or destroy the performance log to match the CSimState
+	void EndPhase(long phase);		// Charge elapsed time to a phase of the timestep
 
     // Functions to evolve a parallel simulation
 
@@ -647,7 +658,7 @@ private:
 
 private:
 
-	static CSimBox* m_pInstance;	// Pointer to the single instance of the CSimBox class
+	static SimThreadLocal CSimBox* m_pInstance;	// Pointer to the single instance of the CSimBox class
 
 #if EnableShadowSimBox == SimACNEnabled
     // Pointer to the shadow SimBox if it has been created and ACN functionality 
@@ -724,6 +735,32 @@ private:
 	PolymerVector		m_vAllPolymers;			// Vector of non-wall polymers
 	PolymerVector		m_vWallPolymers;		// Vector of wall polymers
 
+	BondVector			m_vFlatBonds;			// Bonds of all non-wall polymers in polymer order
+	BondPairVector		m_vFlatBondPairs;		// Bondpairs of all non-wall polymers in polymer order
+	AbstractBeadVector	m_vRESPABeads;			// Beads acted on by the flat bonds and bondpairs
+
+	// Index arrays used by the bond kernel. The bonds are grouped by type, and
+	// each group occupies a contiguous range of the per-bond arrays.
+
+	AbstractBeadVector	m_vKernelBeads;			// Distinct beads acted on by the flat bonds
+	BondVector			m_vKernelBonds;			// Flat bonds sorted by type
+	zLongVector			m_vKernelTypeStart;		// Offset of each bond type group plus the end
+	zLongVector			m_vKernelHead;			// Index of each bond's head bead in m_vKernelBeads
+	zLongVector			m_vKernelTail;			// Index of each bond's tail bead in m_vKernelBeads
+	zLongVector			m_vKernelSlot;			// Kernel index of each flat bond in polymer order
+	zDoubleVector		m_vKernelXPos;			// unPBC bead coordinates gathered each step
+	zDoubleVector		m_vKernelYPos;
+	zDoubleVector		m_vKernelZPos;
+	zDoubleVector		m_vKernelSprConst;		// Bond parameters gathered each step
+	zDoubleVector		m_vKernelUnStrLen;
+	zDoubleVector		m_vKernelDX;			// Bond vectors, lengths and forces
+	zDoubleVector		m_vKernelDY;
+	zDoubleVector		m_vKernelDZ;
+	zDoubleVector		m_vKernelLength;
+	zDoubleVector		m_vKernelFX;
+	zDoubleVector		m_vKernelFY;
+	zDoubleVector		m_vKernelFZ;
+
 	zLongVector			m_vChargedBeadTypes;	// Types of charged beads
 	zLongVector			m_vChargedBeadTotals;	// No of each charged bead type
 	
@@ -735,20 +772,13 @@ private:
     const long         m_StressCellZNo;
 	const long         m_StressCellTotal;
 	
-	const long         m_PointTotal;                 // Number of points along line joining two interacting beads at which stress is assigned
-	const double       m_InversePointTotal;          
-	const double       m_InversePointTotalMinusOne;  // Number of segments along line joining two interacting beads: one less because we include both endpoints
     const double       m_StressCellXWidth;
     const double       m_StressCellYWidth;           // Width of the stress grid cells in each dimension
     const double       m_StressCellZWidth;
 	
 	
-	CStressGridCell*   m_pOldCell;
-	CStressGridCell*   m_pNewCell;
-	double             m_StressWeight;               // Fraction of stress added to each CNT cell along a vector joining two points
-	double             m_rprime[3];
-	double             m_dr[3];
-	double             m_LocalStress[9];
+	CPerformanceState* m_pPerformanceState;          // Per-phase timings of the serial timestep loop; null when off
+	double             m_LocalStress[9];             // Fraction of a stress tensor added to one stress grid cell
     double             m_StressOrigin[3];           // Origin used to transform the stress from Cartesian to spherical polar coordinates
 
     StressCellVector   m_vStressCells;              // Vector of cells holding the local stress tensor in curvilinear coordinates
@@ -117,6 +117,21 @@
 #include "mpi.h"
 #endif
 
+// ***********************
+// Concurrent serial simulations in one process. The singletons and class-wide
+// tables that hold the state of a running simulation are declared SimThreadLocal,
+// so each thread that creates a CExperiment sees its own copies and several
+// independent runs can share a process. Disabling the flag restores plain
+// static members for compilers without thread_local support.
+
+#define SimThreadedRuns SimulationEnabled
+
+#if SimThreadedRuns == SimulationEnabled
+	#define SimThreadLocal thread_local
+#else
+	#define SimThreadLocal
+#endif
+
 
 
 // ***********************
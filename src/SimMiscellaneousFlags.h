@@ -11,6 +11,9 @@
 //	20/3/06    Baseline version.
 //  04/05/06   I copied the CW55MAC flags to XCMAC.
 //  04/05/10   I added a flag to toggle the calculation of the stress tensor in non-cartesian coordinate systems.
+//             Added a flag to toggle the debug count of bead-bead interactions in the force loops.
+//             Added a flag to select the lean bead layout that keeps the stress and initial position out of the beads.
+//             Added a flag to keep the initial bead positions, and so the bead MSDs, in the lean bead layout.
 // **********************************************************************
 
 #define SimMiscEnabled	1
@@ -18,4 +21,7 @@
 
 	#define EnableMiscClasses               SimMiscEnabled
 	#define EnableStressTensorSphere        SimMiscDisabled
+	#define EnableBeadForceCounter          SimMiscDisabled
+	#define EnableLeanBeadStorage           SimMiscDisabled
+	#define EnableLeanBeadMSD               SimMiscDisabled
 
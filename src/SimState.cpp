@@ -53,6 +53,8 @@ CSimState::CSimState(ISimulation* pISim, const CInputData& rInputData) : m_pISim
 													m_bIsBondStressAdded(true),
 													m_bIsBondPairStressAdded(true),
 													m_bEnergyOutput(false),
+													m_bPerformanceOutput(false),
+													m_PerformancePeriod(0),
 													m_bIsDPDBeadConsForceZero(false),
 													m_bIsDPDBeadForceZero(false),
 													m_bIsDPDBeadThermostatZero(false),
@@ -73,6 +75,11 @@ CSimState::CSimState(ISimulation* pISim, const CInputData& rInputData) : m_pISim
 								   rInputData.GetCutOffRadius(), 
 								   rInputData.GetkT());
 
+#if SimIdentifier == DPD
+	CCNTCell::SetIntegrator(rInputData.GetIntegrator(), rInputData.GetCollisionRate());
+	CCNTCell::SetRESPASubsteps(rInputData.GetRESPASubstepNo());
+#endif
+
 	CCNTCell::SetSimBoxLengths( rInputData.GetCNTXCellNo(), 
 								rInputData.GetCNTYCellNo(), 
 								rInputData.GetCNTZCellNo(),
@@ -185,6 +192,8 @@ CSimState::CSimState(const CInputData& rInputData) : m_pISimulation(0),
 													m_bIsBondStressAdded(true),
 													m_bIsBondPairStressAdded(true),
 													m_bEnergyOutput(false),
+													m_bPerformanceOutput(false),
+													m_PerformancePeriod(0),
 													m_bIsDPDBeadConsForceZero(false),
 													m_bIsDPDBeadForceZero(false),
 													m_bIsDPDBeadThermostatZero(false),
@@ -205,6 +214,11 @@ CSimState::CSimState(const CInputData& rInputData) : m_pISimulation(0),
 								   rInputData.GetCutOffRadius(), 
 								   rInputData.GetkT());
 
+#if SimIdentifier == DPD
+	CCNTCell::SetIntegrator(rInputData.GetIntegrator(), rInputData.GetCollisionRate());
+	CCNTCell::SetRESPASubsteps(rInputData.GetRESPASubstepNo());
+#endif
+
 	CCNTCell::SetSimBoxLengths( rInputData.GetCNTXCellNo(), 
 								rInputData.GetCNTYCellNo(), 
 								rInputData.GetCNTZCellNo(),
@@ -375,6 +389,16 @@ void CSimState::SetEnergyOutput(bool bEnergy)
 	m_bEnergyOutput = bEnergy;
 }
 
+// Function to set a flag showing whether the wall-clock time spent in each
+// phase of the timestep loop should be written to the performance log
+// every period steps. It is toggled using the TogglePerformanceOutput command.
+
+void CSimState::SetPerformanceOutput(bool bPerformance, long period)
+{
+	m_bPerformanceOutput = bPerformance;
+	m_PerformancePeriod  = period;
+}
+
 // Function to toggle the bead contribution to the stress tensor analysis
 // on and off.
 
@@ -79,11 +79,13 @@ public:
 	// CAnalysisState
 	inline long   GetTotalTime()			const {return m_rAnalysisState.GetTotalTime();}
 	inline long   GetTotalMCTime()			const {return m_rAnalysisState.GetTotalMCTime();}
+	inline long   GetMCThreadNo()			const {return m_rAnalysisState.GetMCThreadNo();}
 	inline long	  GetSamplePeriod()			const {return m_rAnalysisState.GetSamplePeriod();}
 	inline long	  GetAnalysisPeriod()		const {return m_rAnalysisState.GetAnalysisPeriod();}
 	inline long   GetDensityPeriod()		const {return m_rAnalysisState.GetDensityPeriod();}
 	inline long	  GetDisplayPeriod()		const {return m_rAnalysisState.GetDisplayPeriod();}
 	inline long	  GetRestartPeriod()		const {return m_rAnalysisState.GetRestartPeriod();}
+	inline double GetSnapshotPrecision()	const {return m_rAnalysisState.GetSnapshotPrecision();}
 	inline long	  GetGridXCellNo()			const {return m_rAnalysisState.GetGridXCellNo();}
 	inline long	  GetGridYCellNo()			const {return m_rAnalysisState.GetGridYCellNo();}
 	inline long	  GetGridZCellNo()			const {return m_rAnalysisState.GetGridZCellNo();}
@@ -184,6 +186,12 @@ public:
 
 	inline bool IsEnergyOutputOn()			const {return m_bEnergyOutput;}
 
+	// Functions showing whether per-phase timings are written to the 
+	// performance log and how many steps are averaged per line
+
+	inline bool IsPerformanceOutputOn()		const {return m_bPerformanceOutput;}
+	inline long GetPerformancePeriod()		const {return m_PerformancePeriod;}
+
 	// DPD only functions
 
 	inline bool IsDPDBeadForceZero()		const {return m_bIsDPDBeadForceZero;}
@@ -207,6 +215,7 @@ public:
 	void SetDensityPeriod(long period);
 	void SetDisplayPeriod(long period);
 	void SetEnergyOutput(bool bEnergy);
+	void SetPerformanceOutput(bool bPerformance, long period);
 	void SetGravityOn(bool bGravity);
 	void SetRenormaliseMomenta(bool bRenormalise);
 	void SetRestartPeriod(long period);
@@ -313,6 +322,12 @@ private:
 
 	bool m_bEnergyOutput;
 
+	// Flag showing whether the timestep loop is instrumented and the number
+	// of steps averaged per line of the performance log
+
+	bool m_bPerformanceOutput;
+	long m_PerformancePeriod;
+
 	// ****************************************
 	// DPD only data
 
@@ -49,7 +49,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Note that it does not get assigned a value until the user creates the
 // instance.
 
-ISimulation* CSimulation::m_pInstance = 0;
+SimThreadLocal ISimulation* CSimulation::m_pInstance = 0;
 
 // Public member function to create a single instance of the CSimulation class.
 
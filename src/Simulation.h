@@ -56,7 +56,7 @@ public:
 
 private:
 
-	static ISimulation* m_pInstance;		
+	static SimThreadLocal ISimulation* m_pInstance;		
 
 	
 	// ****************************************
@@ -23,295 +23,52 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "ISimBox.h"
 #include "CNTCell.h"
 #include "AbstractBead.h"
-#include "aaRegionToType.h"	// Needed for aaBeadXPos() etc function objects
-
-
-// STL using declarations
-
-	using std::remove_if;
 
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
 
-// Constructor used when the grid slices are smaller or larger than the CNT cells 
-// in the normal direction: we pass in the coordinates of the grid slice and the
-// indices of the two CNT cell slices that contain, or bound, the grid slice.
-
-CSlice::CSlice(long sliceIndex, long lowerCNTSliceIndex, long upperCNTSliceIndex, 
-			   double lowerSliceCoord, double upperSliceCoord, 
-			   long xNormal, long yNormal, long zNormal, 
-		       const ISimBox* const pISimBox) : CRegion(sliceIndex), m_X(xNormal), m_Y(yNormal), m_Z(zNormal),
-												m_CNTRowsInSlice(0)
-{
-	// The slices store the set of beads that occur in the SimBox whose coordinates fall
-	// within their boundaries. We access the bead lists stored in the CNTCells via
-	// their CAbstractCell base class. But note that the bead lists are not const so 
-	// we have to take care not to change any data in the beads.
-	//
-	// It is distasteful that we have to repeat the code for calculating the bead lists,
-	// but the cell sizes may vary between dimensions so we cannot factor it out.
-
-	long cellIndex, i, j, k;
-
-	if(xNormal == 1)
-	{
-		m_CNTRowsInSlice = pISimBox->GetCNTZCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's bead container
-		// if their x coordinate lies within the grid slice range specified by
-		// (lowerSliceCoord, upperSliceCoord). We copy the whole CNT cell's bead list
-		// to a local list and then remove those elements outside the range.
-		// Note that the CNTSliceIndex loop only is only executed once or twice
-		// depending on whether the grid slice overlaps a CNT slice boundary or not.
-
-		for(long int CNTSliceIndex=lowerCNTSliceIndex; CNTSliceIndex<=upperCNTSliceIndex; CNTSliceIndex++)
-		{
-			for(j=0; j<pISimBox->GetCNTYCellNo(); j++)
-			{
-				for(k=0; k<pISimBox->GetCNTZCellNo(); k++)
-				{
-					cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*k + j) + CNTSliceIndex;
-
-					BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-					// Remove beads whose x coordinates are outside the grid slice's 
-					// boundaries. We use the remove_if() algorithm that requires
-					// a predicate to determine if an element should be removed from the
-					// container. We define function objects that take a CAbstractBead*
-					// argument and compare the bead's X, Y or Z coordinate with a 
-					// specified value, returning true if the coordinate is less than
-					// (aaBeadZPosLess) or greater than (aaBeadZPosGreater) the value.
-					// We check for equality because if the slice width is commensurate 
-					// with the box size some beads may have coordinates exactly on the 
-					// upper CNT cell boundary and the lower boundary is included in the current cell.
-					// Note that remove_if returns an iterator to the last valid
-					// element but the container retains its original size. The elements
-					// following the returned iterator position are undefined.
-
-					BeadListIterator lastBead1 = remove_if(rBeadList.begin(), rBeadList.end(), aaBeadXPosLess(lowerSliceCoord) );
-					BeadListIterator lastBead2 = remove_if(rBeadList.begin(), lastBead1,	   aaBeadXPosGreaterEqual(upperSliceCoord) );
-
-					copy(rBeadList.begin(), lastBead2, back_inserter(m_lBeads));
-				}
-			}
-		}
-
-		m_Width	= pISimBox->GetSimBoxYLength();
-		m_Depth	= pISimBox->GetSimBoxZLength();
-	}
-	else if(yNormal == 1)
-	{
-		m_CNTRowsInSlice = pISimBox->GetCNTXCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's bead container
-		// if their y coordinate lies within the grid slice range specified by
-		// (lowerSliceCoord, upperSliceCoord). We copy the whole CNT cell's bead list
-		// to a local list and then remove those elements outside the range.
-		// Note that the CNTSliceIndex loop only is only executed once or twice
-		// depending on whether the grid slice overlaps a CNT slice boundary or not.
-
-		for(long int CNTSliceIndex=lowerCNTSliceIndex; CNTSliceIndex<=upperCNTSliceIndex; CNTSliceIndex++)
-		{
-			for(i=0; i<pISimBox->GetCNTXCellNo(); i++)
-			{
-				for(k=0; k<pISimBox->GetCNTZCellNo(); k++)
-				{
-					cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*k + CNTSliceIndex) + i;
-
-					BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-					// Remove beads whose y coordinates are outside the grid slice's 
-					// boundaries. We use the remove_if() algorithm that requires
-					// a predicate to determine if an element should be removed from the
-					// container. We define function objects that take a CAbstractBead*
-					// argument and compare the bead's X, Y or Z coordinate with a 
-					// specified value, returning true if the coordinate is less than
-					// (aaBeadZPosLess) or greater than (aaBeadZPosGreater) the value.
-					// We check for equality because if the slice width is commensurate 
-					// with the box size some beads may have coordinates exactly on the 
-					// upper CNT cell boundary and the lower boundary is included in the current cell.
-					// Note that remove_if returns an iterator to the last valid
-					// element but the container retains its original size. The elements
-					// following the returned iterator position are undefined.
-
-					BeadListIterator lastBead1 = remove_if(rBeadList.begin(), rBeadList.end(), aaBeadYPosLess(lowerSliceCoord) );
-					BeadListIterator lastBead2 = remove_if(rBeadList.begin(), lastBead1,	   aaBeadYPosGreaterEqual(upperSliceCoord) );
-
-					copy(rBeadList.begin(), lastBead2, back_inserter(m_lBeads));
-				}
-			}
-		}
-
-		m_Width	= pISimBox->GetSimBoxZLength();
-		m_Depth	= pISimBox->GetSimBoxXLength();
-	}
-	else if(zNormal == 1)
-	{
-		m_CNTRowsInSlice = pISimBox->GetCNTYCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's bead container
-		// if their z coordinate lies within the grid slice range specified by
-		// (lowerSliceCoord, upperSliceCoord). We copy the whole CNT cell's bead list
-		// to a local list and then remove those elements outside the range.
-		// Note that the CNTSliceIndex loop only is only executed once or twice
-		// depending on whether the grid slice overlaps a CNT slice boundary or not.
-
-		for(long int CNTSliceIndex=lowerCNTSliceIndex; CNTSliceIndex<=upperCNTSliceIndex; CNTSliceIndex++)
-		{
-			for(i=0; i<pISimBox->GetCNTXCellNo(); i++)
-			{
-				for(j=0; j<pISimBox->GetCNTYCellNo(); j++)
-				{
-					cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*CNTSliceIndex + j) + i;
-
-					BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-					// Remove beads whose z coordinates are outside the grid slice's 
-					// boundaries. We use the remove_if() algorithm that requires
-					// a predicate to determine if an element should be removed from the
-					// container. We define function objects that take a CAbstractBead*
-					// argument and compare the bead's X, Y or Z coordinate with a 
-					// specified value, returning true if the coordinate is less than
-					// (aaBeadZPosLess) or greater than (aaBeadZPosGreater) the value.
-					// We check for equality because if the slice width is commensurate 
-					// with the box size some beads may have coordinates exactly on the 
-					// upper CNT cell boundary and the lower boundary is included in the current cell.
-					// Note that remove_if returns an iterator to the last valid
-					// element but the container retains its original size. The elements
-					// following the returned iterator position are undefined.
-
-					BeadListIterator lastBead1 = remove_if(rBeadList.begin(), rBeadList.end(), aaBeadZPosLess(lowerSliceCoord) );
-					BeadListIterator lastBead2 = remove_if(rBeadList.begin(), lastBead1,	   aaBeadZPosGreaterEqual(upperSliceCoord) );
-
-					copy(rBeadList.begin(), lastBead2, back_inserter(m_lBeads));
-				}
-			}
-		}
-
-		m_Width	= pISimBox->GetSimBoxXLength();
-		m_Depth	= pISimBox->GetSimBoxYLength();
-	}
-
-// Output the bead z coordinates to check their distribution. We use the transform
-// algorithm and the function object aaBeadZPos() to transform the list of
-// CAbstractBeads into a vector of doubles.
-
-//	std::vector<double> zCoordinates;
-//	zCoordinates.resize(m_lBeads.size());
-
-//	std::transform(m_lBeads.begin(), m_lBeads.end(), zCoordinates.begin(), aaBeadZPos());
-
-//	for(zDoubleVectorIterator id=zCoordinates.begin(); id!=zCoordinates.end(); id++)
-//	{
-//		double zvalue = *id;
-//	}
-
-	// Set base class members that depend on the above calculations. It would be nice
-	// if they could set automatically in the functions that call them, but that would
-	// be inefficient when they are called many times.
-
-	m_Height	= upperSliceCoord - lowerSliceCoord;
-	m_Volume    = m_Width*m_Depth*m_Height;
-}
-
-
 // Constructor used when the grid slices have exactly the same width as the
 // CNT cells in the normal direction. The beads contained in all CNT cells 
 // in the specified slice (whose normal is passed in by argument) are just 
-// copied to the grid slice's local store.
+// appended to the grid slice's local store.
 
 CSlice::CSlice(long sliceIndex, long xNormal, long yNormal, long zNormal, 
 		       const ISimBox* const pISimBox) : CRegion(sliceIndex), m_X(xNormal), m_Y(yNormal), m_Z(zNormal),
 												m_CNTRowsInSlice(0)
 {
-	// The slices store the set of beads that occur in the SimBox whose coordinates fall
-	// within their boundaries. We access the bead lists stored in the CNTCells via
-	// their CAbstractCell base class. But note that the bead lists are not const so 
-	// we have to take care not to change any data in the beads.
-	//
-	// It is distasteful that we have to repeat the code for calculating the bead lists,
-	// but the cell sizes may vary between dimensions so we cannot factor it out.
+	const long normal = GetNormalAxis();
 
-	long cellIndex, i, j, k;
-
-	if(xNormal == 1)
+	if(normal >= 0)
 	{
-		m_CNTRowsInSlice = pISimBox->GetCNTZCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's beads
-
-		for(j=0; j<pISimBox->GetCNTYCellNo(); j++)
-		{
-			for(k=0; k<pISimBox->GetCNTZCellNo(); k++)
-			{
-				cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*k + j) + sliceIndex;
-
-				// I need a local copy of the bead container here because the back_inserter()
-				// call seems to fail if I pass in the pISimBox pointer. It might
-				// be too many nested function calls.
-
-				BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-				copy(rBeadList.begin(), rBeadList.end(), back_inserter(m_lBeads));
-			}
-		}
-
-		m_Width		= pISimBox->GetSimBoxYLength();
-		m_Depth		= pISimBox->GetSimBoxZLength();
-		m_Height	= pISimBox->GetCNTXCellWidth();
+		SetSliceGeometry(normal, pISimBox);
+		AddCNTSliceBeads(normal, sliceIndex, pISimBox);
 	}
-	else if(yNormal == 1)
-	{
-		m_CNTRowsInSlice = pISimBox->GetCNTXCellNo();
 
-		// Loop over the CNT cells adding their beads to the slice's bead container
+	m_Volume   = m_Width*m_Depth*m_Height;
+}
 
-		for(i=0; i<pISimBox->GetCNTXCellNo(); i++)
-		{
-			for(k=0; k<pISimBox->GetCNTZCellNo(); k++)
-			{
-				cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*k + sliceIndex) + i;
 
-				BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
+// Constructor used by the CSliceProfile to create an empty slice spanning the
+// grid coordinates (lowerSliceCoord, upperSliceCoord) in the normal direction.
+// The profile sorts the beads into all of its slices in a single pass over the
+// CNT cells instead of having each slice scan the cells separately.
 
-				copy(rBeadList.begin(), rBeadList.end(), back_inserter(m_lBeads));
-			}
-		}
+CSlice::CSlice(long sliceIndex, double lowerSliceCoord, double upperSliceCoord,
+			   long xNormal, long yNormal, long zNormal, 
+			   const ISimBox* const pISimBox) : CRegion(sliceIndex), m_X(xNormal), m_Y(yNormal), m_Z(zNormal),
+												m_CNTRowsInSlice(0)
+{
+	const long normal = GetNormalAxis();
 
-		m_Width		= pISimBox->GetSimBoxZLength();
-		m_Depth		= pISimBox->GetSimBoxXLength();
-		m_Height	= pISimBox->GetCNTYCellWidth();
-	}
-	else if(zNormal == 1)
+	if(normal >= 0)
 	{
-		m_CNTRowsInSlice = pISimBox->GetCNTYCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's bead container
-
-		for(i=0; i<pISimBox->GetCNTXCellNo(); i++)
-		{
-			for(j=0; j<pISimBox->GetCNTYCellNo(); j++)
-			{
-				cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*sliceIndex + j) + i;
-
-				BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-				copy(rBeadList.begin(), rBeadList.end(), back_inserter(m_lBeads));
-			}
-		}
-
-		m_Width		= pISimBox->GetSimBoxXLength();
-		m_Depth		= pISimBox->GetSimBoxYLength();
-		m_Height	= pISimBox->GetCNTZCellWidth();
+		SetSliceGeometry(normal, pISimBox);
 	}
 
-	// Set base class members that depend on the above calculations. It would be nice
-	// if they could set automatically in the functions that call them, but that would
-	// be inefficient when they are called many times.
-
-	m_Volume   = m_Width*m_Depth*m_Height;
+	m_Height	= upperSliceCoord - lowerSliceCoord;
+	m_Volume    = m_Width*m_Depth*m_Height;
 }
 
 
@@ -328,86 +85,20 @@ CSlice::CSlice(long xCoord, long yCoord, long zCoord,
 		       const ISimBox* const pISimBox) : CRegion(0), m_X(xCoord), m_Y(yCoord), m_Z(zCoord),
 												m_CNTRowsInSlice(0)
 {
-	// The slices store the set of beads that occur in the SimBox whose coordinates fall
-	// within their boundaries. We access the bead lists stored in the CNTCells via
-	// their CAbstractCell base class. But note that the bead lists are not const so 
-	// we have to take care not to change any data in the beads.
-	//
-	// It is distasteful that we have to repeat the code for calculating the bead lists,
-	// but the cell sizes may vary between dimensions so we cannot factor it out.
-
-	long cellIndex, i, j, k;
-
 	if(xCoord > 0)
 	{
-		xCoord--;
-		m_CNTRowsInSlice = pISimBox->GetCNTZCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's beads
-
-		for(j=0; j<pISimBox->GetCNTYCellNo(); j++)
-		{
-			for(k=0; k<pISimBox->GetCNTZCellNo(); k++)
-			{
-				cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*k + j) + xCoord;
-
-				// I need a local copy of the bead container here because the back_inserter()
-				// call seems to fail if I pass in the pISimBox pointer. It might
-				// be too many nested function calls.
-
-				BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-				copy(rBeadList.begin(), rBeadList.end(), back_inserter(m_lBeads));
-			}
-		}
-		m_Width		= pISimBox->GetSimBoxYLength();
-		m_Depth		= pISimBox->GetSimBoxZLength();
-		m_Height	= pISimBox->GetCNTXCellWidth();
+		SetSliceGeometry(0, pISimBox);
+		AddCNTSliceBeads(0, xCoord-1, pISimBox);
 	}
 	else if(yCoord > 0)
 	{
-		yCoord--;
-		m_CNTRowsInSlice = pISimBox->GetCNTXCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's bead container
-
-		for(i=0; i<pISimBox->GetCNTXCellNo(); i++)
-		{
-			for(k=0; k<pISimBox->GetCNTZCellNo(); k++)
-			{
-				cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*k + yCoord) + i;
-
-				BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-
-				copy(rBeadList.begin(), rBeadList.end(), back_inserter(m_lBeads));
-			}
-		}
-		m_Width		= pISimBox->GetSimBoxZLength();
-		m_Depth		= pISimBox->GetSimBoxXLength();
-		m_Height	= pISimBox->GetCNTYCellWidth();
+		SetSliceGeometry(1, pISimBox);
+		AddCNTSliceBeads(1, yCoord-1, pISimBox);
 	}
 	else if(zCoord > 0)
 	{
-		zCoord--;
-		m_CNTRowsInSlice = pISimBox->GetCNTYCellNo();
-
-		// Loop over the CNT cells adding their beads to the slice's bead container
-
-		for(i=0; i<pISimBox->GetCNTXCellNo(); i++)
-		{
-			for(j=0; j<pISimBox->GetCNTYCellNo(); j++)
-			{
-				cellIndex = pISimBox->GetCNTXCellNo()*(pISimBox->GetCNTYCellNo()*zCoord + j) + i;
-
-				BeadList rBeadList = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
-
-				copy(rBeadList.begin(), rBeadList.end(), back_inserter(m_lBeads));
-			}
-		}
-		m_Width		= pISimBox->GetSimBoxXLength();
-		m_Depth		= pISimBox->GetSimBoxYLength();
-		m_Height	= pISimBox->GetCNTZCellWidth();
+		SetSliceGeometry(2, pISimBox);
+		AddCNTSliceBeads(2, zCoord-1, pISimBox);
 	}
 	else
 	{
@@ -437,3 +128,76 @@ CSlice::CSlice(const CSlice& oldSlice) : CRegion(oldSlice)
 CSlice::~CSlice()
 {
 }
+
+// Private function to convert the slice normal into an axis index: 0, 1, 2
+// for the X, Y, Z directions respectively, or -1 if no normal is set.
+
+long CSlice::GetNormalAxis() const
+{
+	if(m_X == 1)
+		return 0;
+	else if(m_Y == 1)
+		return 1;
+	else if(m_Z == 1)
+		return 2;
+	else
+		return -1;
+}
+
+// Private function to set the slice's width, depth and default height from the
+// SimBox and CNT cell dimensions for a slice whose normal lies along the given axis.
+// The width and depth are taken cyclically from the remaining two axes so that
+// the row normal and long axis used by CRow and CRowProfile are unchanged.
+
+void CSlice::SetSliceGeometry(long normal, const ISimBox* const pISimBox)
+{
+	if(normal == 0)
+	{
+		m_CNTRowsInSlice = pISimBox->GetCNTZCellNo();
+		m_Width		= pISimBox->GetSimBoxYLength();
+		m_Depth		= pISimBox->GetSimBoxZLength();
+		m_Height	= pISimBox->GetCNTXCellWidth();
+	}
+	else if(normal == 1)
+	{
+		m_CNTRowsInSlice = pISimBox->GetCNTXCellNo();
+		m_Width		= pISimBox->GetSimBoxZLength();
+		m_Depth		= pISimBox->GetSimBoxXLength();
+		m_Height	= pISimBox->GetCNTYCellWidth();
+	}
+	else
+	{
+		m_CNTRowsInSlice = pISimBox->GetCNTYCellNo();
+		m_Width		= pISimBox->GetSimBoxXLength();
+		m_Depth		= pISimBox->GetSimBoxYLength();
+		m_Height	= pISimBox->GetCNTZCellWidth();
+	}
+}
+
+// Private function to append the beads in all CNT cells of one CNT slice to the
+// grid slice. The CNT cell bead lists are read in place: only the bead pointers
+// are copied. The cells are visited in the same order as the original
+// per-axis loops so that the order of beads in the slice is unchanged.
+
+void CSlice::AddCNTSliceBeads(long normal, long CNTSliceIndex, const ISimBox* const pISimBox)
+{
+	const long cellNo[3] = {pISimBox->GetCNTXCellNo(), pISimBox->GetCNTYCellNo(), pISimBox->GetCNTZCellNo()};
+
+	const long outer = (normal == 0 ? 1 : 0);
+	const long inner = (normal == 2 ? 1 : 2);
+
+	long n[3];
+	n[normal] = CNTSliceIndex;
+
+	for(n[outer] = 0; n[outer] < cellNo[outer]; n[outer]++)
+	{
+		for(n[inner] = 0; n[inner] < cellNo[inner]; n[inner]++)
+		{
+			const long cellIndex = cellNo[0]*(cellNo[1]*n[2] + n[1]) + n[0];
+
+			const BeadList& rBeads = pISimBox->GetCNTCells()[cellIndex]->GetBeads();
+
+			m_lBeads.insert(m_lBeads.end(), rBeads.begin(), rBeads.end());
+		}
+	}
+}
@@ -17,16 +17,15 @@ class CSlice : public CRegion
 {
 public:
 
-	// Constructor for use when grid slice width < or > CNT cell width
+	// Constructor for use when grid slice width = CNT cell width
 
-	CSlice(long sliceIndex, long lowerCNTSliceIndex, long upperCNTSliceIndex,
-		   double lowerSliceCoord, double upperSliceCoord, 
-		   long xNormal, long yNormal, long zNormal, 
+	CSlice(long sliceIndex, long xNormal, long yNormal, long zNormal, 
 		   const ISimBox* const pISimBox);
 
-	// Constructor for use when grid slice width = CNT cell width
+	// Constructor for an empty slice whose beads are added by a CSliceProfile
 
-	CSlice(long sliceIndex, long xNormal, long yNormal, long zNormal, 
+	CSlice(long sliceIndex, double lowerSliceCoord, double upperSliceCoord,
+		   long xNormal, long yNormal, long zNormal, 
 		   const ISimBox* const pISimBox);
 
 	// Alternative constructor used in force target commands
@@ -43,6 +42,11 @@ public:
 	inline long GetZNormal()		const {return m_Z;}
 	inline long GetCNTRowsInSlice() const {return m_CNTRowsInSlice;}
 
+private:
+	long GetNormalAxis() const;
+	void SetSliceGeometry(long normal, const ISimBox* const pISimBox);
+	void AddCNTSliceBeads(long normal, long CNTSliceIndex, const ISimBox* const pISimBox);
+
 private:
 	long m_X;				// Normal defining slice orientation
 	long m_Y;
@@ -19,6 +19,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "SimDefs.h"
 #include "SliceProfile.h"
 #include "ISimBox.h"
+#include "CNTCell.h"
+#include "AbstractBead.h"
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -36,7 +38,7 @@ CSliceProfile::CSliceProfile()
 // given direction. Each slice object is then added to the CProfile<> base class
 // to be stored in the set of regions for that profile object. A region may be
 // either a CSlice, CRow or CCell (or any later additional volumes).
-// Note that each slice is responsible for collecting its own beads from the
+// Note that the profile collects the beads for all of its slices from the
 // ISimBox interface.
 
 CSliceProfile::CSliceProfile(long sliceTotal, long xNormal, long yNormal, long zNormal, 
@@ -45,88 +47,108 @@ CSliceProfile::CSliceProfile(long sliceTotal, long xNormal, long yNormal, long z
 	// Start at the bottom of the SimBox with the CNT and slice coordinates
 	// equal to 0.0. Set the width of the grid slices from the SimBox size in the 
 	// direction of the slice normal and the total number of slices. Then store
-	// the grid slice width and the CNT cell width so that we can call the
-	// CSlice constructor independently of the normal direction.
-	// Create the slice object and add it to the profile via its
-	// CRegion base class. The slices are deleted by the base class.
+	// the grid slice width and the number of CNT cells so that we can bin the beads
+	// independently of the normal direction. The slice objects are added to 
+	// the profile via their CRegion base class and deleted by the base class.
 
 	double sliceWidth	 = 0.0;
-	double CNTSliceWidth = 0.0;
 	long   CNTSliceTotal = 0;
 
 	if(xNormal == 1)
 	{
 		sliceWidth		= pISimBox->GetSimBoxXLength()/static_cast<double>(sliceTotal);
-		CNTSliceWidth	= pISimBox->GetCNTXCellWidth();
 		CNTSliceTotal	= pISimBox->GetCNTXCellNo();
 	}
 	else if(yNormal == 1)
 	{
 		sliceWidth		= pISimBox->GetSimBoxYLength()/static_cast<double>(sliceTotal);
-		CNTSliceWidth	= pISimBox->GetCNTYCellWidth();
 		CNTSliceTotal	= pISimBox->GetCNTYCellNo();
 	}
 	else
 	{
 		sliceWidth		= pISimBox->GetSimBoxZLength()/static_cast<double>(sliceTotal);
-		CNTSliceWidth	= pISimBox->GetCNTZCellWidth();
 		CNTSliceTotal	= pISimBox->GetCNTZCellNo();
 	}
 
-	// Call the appropriate CSlice constructor to handle the creation of a slice 
-	// depending on whether its width is the same, less than, or greater than 
-	// the CNT cells in the appropriate normal direction. We pass in the 
-	// coordinates of the lower and upper boundaries of the grid slice and the 
-	// indices pointing to the CNT cells that contain these boundaries.
+	// Create empty slices covering the SimBox and then sort the beads into them
+	// in a single pass over the CNT cells. Previously each slice scanned the CNT 
+	// cells that bound it and copied their bead lists, so a profile finer than the 
+	// CNT cells read every cell several times. When the grid slices have the same 
+	// width as the CNT cells, whole cell bead lists are appended to the slice that
+	// contains the cell; otherwise, each bead is binned using its coordinate in the
+	// normal direction.
 
-	const double invCNTSliceWidth = 1.0/CNTSliceWidth;
+	for(long sliceIndex=0; sliceIndex<sliceTotal; sliceIndex++)
+	{
+		// Calculate the slice boundaries by multiplying the width by the number of 
+		// slices. We don't use a manual increment because multiple additions leads 
+		// to loss of accuracy. For example, a slice width of 0.6 when added 10 times
+		// leads to a coordinate value of 6.0 to 15 dp but when this is cast to a 
+		// long integer it rounds down to 5.
 
-	double lowerSliceCoord = 0.0;
-	double upperSliceCoord = 0.0;
+		const double lowerSliceCoord = static_cast<double>(sliceIndex)*sliceWidth;
+		const double upperSliceCoord = static_cast<double>(sliceIndex+1)*sliceWidth;
 
-	CSlice* pSlice = NULL;
+		AddRegion(new CSlice(sliceIndex, lowerSliceCoord, upperSliceCoord, xNormal, yNormal, zNormal, pISimBox));
+	}
 
-	for(long sliceIndex=0; sliceIndex<sliceTotal; sliceIndex++)
+	const long CNTXCellNo = pISimBox->GetCNTXCellNo();
+	const long CNTYCellNo = pISimBox->GetCNTYCellNo();
+	const CNTCellVector& rCells = pISimBox->GetCNTCells();
+
+	const double invSliceWidth = 1.0/sliceWidth;
+
+	// Compare the slice and cell counts rather than their widths, as the widths
+	// are computed differently and may not be exactly equal.
+
+	const bool   bWholeCells   = (sliceTotal == CNTSliceTotal);
+
+	for(long cellIndex=0; cellIndex<static_cast<long>(rCells.size()); cellIndex++)
 	{
-		// Calculate upperSliceCoord by multiplying the width by the number of slices. 
-		// We don't use a manual increment at the end of the loop because multiple 
-		// additions leads to loss of accuracy.
-		// For example, a slice width of 0.6 when added 10 times leads to a
-		// coordinate value of 6.0 to 15 dp but when this is cast to a long integer
-		// it rounds down to 5. The difference 6.0-upperSliceCoord is 8.8e-16.
-		// But this is sufficient to change the cast.
-
-		upperSliceCoord = static_cast<double>(sliceIndex+1)*sliceWidth;
-
-		long lowerCNTSliceIndex = static_cast<long>(lowerSliceCoord*invCNTSliceWidth);
-		long upperCNTSliceIndex = static_cast<long>(upperSliceCoord*invCNTSliceWidth);
-		
-		// If the upper CNT slice index points to the edge of the SimBox, reduce
-		// it by one because CNT cells are numbered (0, N-1).
-
-		if(upperCNTSliceIndex == CNTSliceTotal)
-			upperCNTSliceIndex--;
-
-		if(sliceWidth < CNTSliceWidth)
-		{
-			pSlice = new CSlice(sliceIndex, lowerCNTSliceIndex, upperCNTSliceIndex, 
-								lowerSliceCoord, upperSliceCoord, xNormal, yNormal, zNormal, pISimBox);
-		}
-		else if(sliceWidth > CNTSliceWidth)
+		const BeadList& rBeads = rCells[cellIndex]->GetBeads();
+
+		if(bWholeCells)
 		{
-			pSlice = new CSlice(sliceIndex, lowerCNTSliceIndex, upperCNTSliceIndex,
-								lowerSliceCoord, upperSliceCoord, xNormal, yNormal, zNormal, pISimBox);
+			long CNTSliceIndex = 0;
+
+			if(xNormal == 1)
+				CNTSliceIndex = cellIndex%CNTXCellNo;
+			else if(yNormal == 1)
+				CNTSliceIndex = (cellIndex/CNTXCellNo)%CNTYCellNo;
+			else
+				CNTSliceIndex = cellIndex/(CNTXCellNo*CNTYCellNo);
+
+			for(cBeadListIterator citerBead=rBeads.begin(); citerBead!=rBeads.end(); citerBead++)
+			{
+				GetRegion(CNTSliceIndex)->AddBead(*citerBead);
+			}
 		}
 		else
 		{
-			pSlice = new CSlice(sliceIndex, xNormal, yNormal, zNormal, pISimBox);
-		}
+			for(cBeadListIterator citerBead=rBeads.begin(); citerBead!=rBeads.end(); citerBead++)
+			{
+				double coord = 0.0;
 
-		AddRegion(pSlice);
+				if(xNormal == 1)
+					coord = (*citerBead)->GetXPos();
+				else if(yNormal == 1)
+					coord = (*citerBead)->GetYPos();
+				else
+					coord = (*citerBead)->GetZPos();
 
-		lowerSliceCoord = upperSliceCoord;
-	}
+				long sliceIndex = static_cast<long>(coord*invSliceWidth);
 
+				// Guard against round-off for beads lying on the SimBox boundaries
+
+				if(sliceIndex < 0)
+					sliceIndex = 0;
+				else if(sliceIndex >= sliceTotal)
+					sliceIndex = sliceTotal - 1;
+
+				GetRegion(sliceIndex)->AddBead(*citerBead);
+			}
+		}
+	}
 }
 
 CSliceProfile::~CSliceProfile()
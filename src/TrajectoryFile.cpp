@@ -0,0 +1,218 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// TrajectoryFile.cpp: implementation of the CTrajectoryFile class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "TrajectoryFile.h"
+#include "AbstractBead.h"
+#include "CoordinateCodec.h"
+#include "CurrentState.h"
+
+#include <cstring>
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+const char* const CTrajectoryFile::m_TrajectoryMagic = "DPDTRJ01";
+const char* const CTrajectoryFile::m_CompressedMagic = "DPDTRZ01";
+const char* const CTrajectoryFile::m_IndexMagic      = "DPDTRX01";
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class that writes bead coordinates to a single append-only binary
+// trajectory file, dmpctj.<runId>, instead of one text snapshot file per
+// CCurrentState. It is used by the CMonitor when the default current state
+// format is "Trajectory". Each frame contains only the beads that are visible 
+// at the time it is written, so the existing bead display commands select 
+// the subset of beads stored.
+//
+// A companion index file, dmpctx.<runId>, holds a fixed-size record for each 
+// frame giving its time, byte offset and number of beads. The index record 
+// is written after the frame data and both streams are flushed, so a reader 
+// never sees a frame that is only partially written even while the 
+// simulation is running. The CTrajectoryReader class maps both files into 
+// memory for random access to the frames.
+//
+// If the precision is positive, the trajectory is compressed. Each frame's 
+// coordinates are quantised to the precision and encoded by a CCoordinateCodec,
+// and the frame also stores the beads' display ids. The CMonitor does this 
+// when the default current state format is "CompressedTrajectory".
+
+CTrajectoryFile::CTrajectoryFile(const zString runId, double lx, double ly, double lz, double precision) : m_TrajectoryStream((xxBase::GetTJPrefix() + runId).c_str(), std::ios::out | std::ios::binary | std::ios::trunc),
+																			m_IndexStream((xxBase::GetTXPrefix() + runId).c_str(), std::ios::out | std::ios::binary | std::ios::trunc),
+																			m_Offset(0),
+																			m_FrameTotal(0),
+																			m_bIOSuccess(true),
+																			m_pCodec(0)
+{
+	if(precision > 0.0)
+	{
+		m_pCodec = new CCoordinateCodec(lx, ly, lz, precision);
+	}
+
+	FileHeader fileHeader;
+	std::memcpy(fileHeader.magic, (m_pCodec ? m_CompressedMagic : m_TrajectoryMagic), sizeof(fileHeader.magic));
+	fileHeader.box[0] = lx;
+	fileHeader.box[1] = ly;
+	fileHeader.box[2] = lz;
+
+	IndexHeader indexHeader;
+	std::memcpy(indexHeader.magic, m_IndexMagic, sizeof(indexHeader.magic));
+
+	m_TrajectoryStream.write(reinterpret_cast<const char*>(&fileHeader), sizeof(FileHeader));
+	m_IndexStream.write(reinterpret_cast<const char*>(&indexHeader), sizeof(IndexHeader));
+
+	m_TrajectoryStream.flush();
+	m_IndexStream.flush();
+
+	m_Offset     = sizeof(FileHeader);
+	m_bIOSuccess = m_TrajectoryStream.good() && m_IndexStream.good();
+}
+
+CTrajectoryFile::~CTrajectoryFile()
+{
+	if(m_pCodec)
+	{
+		delete m_pCodec;
+		m_pCodec = 0;
+	}
+
+	m_TrajectoryStream.close();
+	m_IndexStream.close();
+}
+
+// Function to append a frame holding the visible beads in the container to 
+// the trajectory. It returns false if the files could not be written, after 
+// which no further frames are added.
+
+bool CTrajectoryFile::AddFrame(long time, const AbstractBeadVector& vBeads)
+{
+	if(!m_bIOSuccess)
+		return false;
+
+	if(m_pCodec)
+		return AddCompressedFrame(time, vBeads);
+
+	m_vIds.clear();
+	m_vTypes.clear();
+	m_vCoords.clear();
+
+	for(cAbstractBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	{
+		if((*iterBead)->GetVisible())
+		{
+			m_vIds.push_back((*iterBead)->GetId());
+			m_vTypes.push_back((*iterBead)->GetType());
+			m_vCoords.push_back((*iterBead)->GetXPos());
+			m_vCoords.push_back((*iterBead)->GetYPos());
+			m_vCoords.push_back((*iterBead)->GetZPos());
+		}
+	}
+
+	FrameHeader frameHeader;
+	frameHeader.time      = time;
+	frameHeader.beadTotal = static_cast<int64_t>(m_vIds.size());
+
+	IndexRecord record;
+	record.time      = frameHeader.time;
+	record.offset    = m_Offset;
+	record.beadTotal = frameHeader.beadTotal;
+
+	m_TrajectoryStream.write(reinterpret_cast<const char*>(&frameHeader), sizeof(FrameHeader));
+
+	if(!m_vIds.empty())
+	{
+		m_TrajectoryStream.write(reinterpret_cast<const char*>(&m_vIds[0]),    m_vIds.size()*sizeof(int64_t));
+		m_TrajectoryStream.write(reinterpret_cast<const char*>(&m_vTypes[0]),  m_vTypes.size()*sizeof(int64_t));
+		m_TrajectoryStream.write(reinterpret_cast<const char*>(&m_vCoords[0]), m_vCoords.size()*sizeof(double));
+	}
+	m_TrajectoryStream.flush();
+
+	// Only index the frame once its data are on disk
+
+	if(m_TrajectoryStream.good())
+	{
+		m_IndexStream.write(reinterpret_cast<const char*>(&record), sizeof(IndexRecord));
+		m_IndexStream.flush();
+	}
+
+	m_bIOSuccess = m_TrajectoryStream.good() && m_IndexStream.good();
+
+	if(m_bIOSuccess)
+	{
+		m_Offset += sizeof(FrameHeader) + m_vIds.size()*(2*sizeof(int64_t) + 3*sizeof(double));
+		m_FrameTotal++;
+	}
+
+	return m_bIOSuccess;
+}
+
+// Private function to append a frame to a compressed trajectory. The layout
+// is the same as for an uncompressed frame except that the bead data are 
+// replaced by the length of the encoded frame and the frame itself.
+
+bool CTrajectoryFile::AddCompressedFrame(long time, const AbstractBeadVector& vBeads)
+{
+	m_pCodec->Clear();
+
+	for(cAbstractBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	{
+		if((*iterBead)->GetVisible())
+		{
+			m_pCodec->AddBead((*iterBead)->GetId(), (*iterBead)->GetType(), 
+							  CCurrentState::GetBeadDisplayId((*iterBead)->GetId()),
+							  (*iterBead)->GetXPos(), (*iterBead)->GetYPos(), (*iterBead)->GetZPos());
+		}
+	}
+
+	m_pCodec->Encode(m_vFrame);
+
+	FrameHeader frameHeader;
+	frameHeader.time      = time;
+	frameHeader.beadTotal = m_pCodec->GetBeadTotal();
+
+	const int64_t frameLength = static_cast<int64_t>(m_vFrame.size());
+
+	IndexRecord record;
+	record.time      = frameHeader.time;
+	record.offset    = m_Offset;
+	record.beadTotal = frameHeader.beadTotal;
+
+	m_TrajectoryStream.write(reinterpret_cast<const char*>(&frameHeader), sizeof(FrameHeader));
+	m_TrajectoryStream.write(reinterpret_cast<const char*>(&frameLength), sizeof(int64_t));
+	m_TrajectoryStream.write(reinterpret_cast<const char*>(&m_vFrame[0]), m_vFrame.size());
+	m_TrajectoryStream.flush();
+
+	if(m_TrajectoryStream.good())
+	{
+		m_IndexStream.write(reinterpret_cast<const char*>(&record), sizeof(IndexRecord));
+		m_IndexStream.flush();
+	}
+
+	m_bIOSuccess = m_TrajectoryStream.good() && m_IndexStream.good();
+
+	if(m_bIOSuccess)
+	{
+		m_Offset += sizeof(FrameHeader) + sizeof(int64_t) + frameLength;
+		m_FrameTotal++;
+	}
+
+	return m_bIOSuccess;
+}
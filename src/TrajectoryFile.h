@@ -0,0 +1,117 @@
+// TrajectoryFile.h: interface for the CTrajectoryFile class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_TRAJECTORYFILE_H__383A0E58_61C2_4A22_BA27_E652E912B3D1__INCLUDED_)
+#define AFX_TRAJECTORYFILE_H__383A0E58_61C2_4A22_BA27_E652E912B3D1__INCLUDED_
+
+
+#include "xxBase.h"
+
+#include <stdint.h>
+
+class CCoordinateCodec;
+
+class CTrajectoryFile : public xxBase
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CTrajectoryFile(const zString runId, double lx, double ly, double lz, double precision);
+
+	virtual ~CTrajectoryFile();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	// Layout of the trajectory and index files. All values are written in the
+	// byte order of the machine that ran the simulation.
+	//
+	// Trajectory file: FileHeader followed by the frames. Each frame is a 
+	// FrameHeader followed by the ids of its N beads, their types, and their 
+	// coordinates stored as N (x,y,z) triples. In a compressed trajectory, 
+	// whose header has the tag m_CompressedMagic, the FrameHeader is instead 
+	// followed by the length of the frame encoded by a CCoordinateCodec and 
+	// the encoded frame, which also holds the beads' display ids.
+	//
+	// Index file: IndexHeader followed by one IndexRecord per frame, so the
+	// record for frame i is at a fixed offset and gives the frame's position 
+	// in the trajectory file.
+
+	struct FileHeader
+	{
+		char   magic[8];
+		double box[3];
+	};
+
+	struct FrameHeader
+	{
+		int64_t time;
+		int64_t beadTotal;
+	};
+
+	struct IndexHeader
+	{
+		char magic[8];
+	};
+
+	struct IndexRecord
+	{
+		int64_t time;
+		int64_t offset;
+		int64_t beadTotal;
+	};
+
+	static const char* const m_TrajectoryMagic;
+	static const char* const m_CompressedMagic;
+	static const char* const m_IndexMagic;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline bool IsFileStateOk() const {return m_bIOSuccess;}
+	inline long GetFrameTotal()  const {return m_FrameTotal;}
+	inline bool IsCompressed()   const {return m_pCodec != 0;}
+
+	bool AddFrame(long time, const AbstractBeadVector& vBeads);
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+	// ****************************************
+	// Private functions
+private:
+
+	CTrajectoryFile(const CTrajectoryFile& oldFile);
+	CTrajectoryFile& operator=(const CTrajectoryFile& rhs);
+
+	bool AddCompressedFrame(long time, const AbstractBeadVector& vBeads);
+
+	// ****************************************
+	// Data members
+private:
+
+	zOutFileStream m_TrajectoryStream;	// Frame data
+	zOutFileStream m_IndexStream;		// Fixed-size record per frame
+	int64_t        m_Offset;			// Byte offset of the next frame
+	long           m_FrameTotal;		// Number of frames written
+	bool           m_bIOSuccess;		// false once a write has failed
+
+	// Buffers reused for each frame to avoid reallocation
+
+	xxBasevector<int64_t> m_vIds;
+	xxBasevector<int64_t> m_vTypes;
+	xxBasevector<double>  m_vCoords;
+
+	CCoordinateCodec*           m_pCodec;	// Encodes frames of a compressed trajectory, or 0
+	xxBasevector<unsigned char> m_vFrame;
+};
+
+#endif // !defined(AFX_TRAJECTORYFILE_H__383A0E58_61C2_4A22_BA27_E652E912B3D1__INCLUDED_)
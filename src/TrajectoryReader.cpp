@@ -0,0 +1,236 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// TrajectoryReader.cpp: implementation of the CTrajectoryReader class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "TrajectoryReader.h"
+#include "CoordinateCodec.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+// Class that provides random access to the frames of a trajectory written by
+// a CTrajectoryFile. Both the trajectory and its index are mapped read-only 
+// into memory, so locating a frame is a lookup of a fixed-size index record 
+// and its bead ids, types and coordinates are returned as pointers into the 
+// mapping without being copied or parsed.
+//
+// The number of frames is fixed when the reader is constructed. If the files
+// are still being written by a running simulation, only the frames whose 
+// index records and data are both complete are visible; a new reader must 
+// be created to see frames added later.
+//
+// Compressed trajectories are recognised by their header. Their frames are 
+// decoded into a CCoordinateCodec instead of being returned as pointers.
+
+CTrajectoryReader::CTrajectoryReader(const zString trajectoryFileName, const zString indexFileName) : m_pTrajectory(0), m_pIndex(0),
+																	m_TrajectorySize(0), m_IndexSize(0),
+																	m_FrameTotal(0),
+																	m_bCompressed(false),
+																	m_bValid(false)
+{
+	m_pTrajectory = MapFile(trajectoryFileName, &m_TrajectorySize);
+	m_pIndex      = MapFile(indexFileName, &m_IndexSize);
+
+	if(m_pTrajectory && m_pIndex &&
+	   m_TrajectorySize >= sizeof(CTrajectoryFile::FileHeader) &&
+	   m_IndexSize      >= sizeof(CTrajectoryFile::IndexHeader) &&
+	   (std::memcmp(m_pTrajectory, CTrajectoryFile::m_TrajectoryMagic, 8) == 0 ||
+	    std::memcmp(m_pTrajectory, CTrajectoryFile::m_CompressedMagic, 8) == 0) &&
+	   std::memcmp(m_pIndex,      CTrajectoryFile::m_IndexMagic, 8) == 0)
+	{
+		m_bValid      = true;
+		m_bCompressed = (std::memcmp(m_pTrajectory, CTrajectoryFile::m_CompressedMagic, 8) == 0);
+
+		// Count the frames whose data lie wholly within the trajectory file
+
+		const long recordTotal = static_cast<long>((m_IndexSize - sizeof(CTrajectoryFile::IndexHeader))/sizeof(CTrajectoryFile::IndexRecord));
+
+		while(m_FrameTotal < recordTotal)
+		{
+			const CTrajectoryFile::IndexRecord* const pRecord = GetIndexRecord(m_FrameTotal);
+
+			if(pRecord->offset < static_cast<int64_t>(sizeof(CTrajectoryFile::FileHeader)) || pRecord->beadTotal < 0)
+				break;
+
+			uint64_t frameEnd = static_cast<uint64_t>(pRecord->offset) + sizeof(CTrajectoryFile::FrameHeader);
+
+			if(m_bCompressed)
+			{
+				if(frameEnd + sizeof(int64_t) > m_TrajectorySize || GetCompressedFrameLength(m_FrameTotal) < 0)
+					break;
+
+				frameEnd += sizeof(int64_t) + static_cast<uint64_t>(GetCompressedFrameLength(m_FrameTotal));
+			}
+			else
+			{
+				frameEnd += static_cast<uint64_t>(pRecord->beadTotal)*(2*sizeof(int64_t) + 3*sizeof(double));
+			}
+
+			if(frameEnd > m_TrajectorySize)
+				break;
+
+			m_FrameTotal++;
+		}
+	}
+}
+
+CTrajectoryReader::~CTrajectoryReader()
+{
+	UnmapFile(m_pTrajectory, m_TrajectorySize);
+	UnmapFile(m_pIndex, m_IndexSize);
+}
+
+// Private static helper functions to map a whole file read-only into memory 
+// and release it. MapFile() returns 0 if the file cannot be opened or is empty.
+
+const char* CTrajectoryReader::MapFile(const zString fileName, size_t* pSize)
+{
+	*pSize = 0;
+
+	const int fd = open(fileName.c_str(), O_RDONLY);
+
+	if(fd < 0)
+		return 0;
+
+	struct stat fileStat;
+
+	void* pData = MAP_FAILED;
+
+	if(fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+	{
+		pData = mmap(0, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	}
+
+	close(fd);	// The mapping remains valid after the descriptor is closed
+
+	if(pData == MAP_FAILED)
+		return 0;
+
+	*pSize = static_cast<size_t>(fileStat.st_size);
+
+	return static_cast<const char*>(pData);
+}
+
+void CTrajectoryReader::UnmapFile(const char* pData, size_t size)
+{
+	if(pData)
+	{
+		munmap(const_cast<char*>(pData), size);
+	}
+}
+
+const CTrajectoryFile::FileHeader* CTrajectoryReader::GetFileHeader() const
+{
+	return reinterpret_cast<const CTrajectoryFile::FileHeader*>(m_pTrajectory);
+}
+
+const CTrajectoryFile::IndexRecord* CTrajectoryReader::GetIndexRecord(long frame) const
+{
+	return reinterpret_cast<const CTrajectoryFile::IndexRecord*>(m_pIndex + sizeof(CTrajectoryFile::IndexHeader)) + frame;
+}
+
+double CTrajectoryReader::GetSimBoxXLength() const
+{
+	return m_bValid ? GetFileHeader()->box[0] : 0.0;
+}
+
+double CTrajectoryReader::GetSimBoxYLength() const
+{
+	return m_bValid ? GetFileHeader()->box[1] : 0.0;
+}
+
+double CTrajectoryReader::GetSimBoxZLength() const
+{
+	return m_bValid ? GetFileHeader()->box[2] : 0.0;
+}
+
+// Functions to return the data for a frame. An invalid frame number returns
+// a time of -1, no beads and null pointers.
+
+long CTrajectoryReader::GetFrameTime(long frame) const
+{
+	if(frame < 0 || frame >= m_FrameTotal)
+		return -1;
+
+	return static_cast<long>(GetIndexRecord(frame)->time);
+}
+
+long CTrajectoryReader::GetFrameBeadTotal(long frame) const
+{
+	if(frame < 0 || frame >= m_FrameTotal)
+		return 0;
+
+	return static_cast<long>(GetIndexRecord(frame)->beadTotal);
+}
+
+const int64_t* CTrajectoryReader::GetFrameBeadIds(long frame) const
+{
+	if(frame < 0 || frame >= m_FrameTotal || m_bCompressed)
+		return 0;
+
+	return reinterpret_cast<const int64_t*>(m_pTrajectory + GetIndexRecord(frame)->offset + sizeof(CTrajectoryFile::FrameHeader));
+}
+
+const int64_t* CTrajectoryReader::GetFrameBeadTypes(long frame) const
+{
+	if(frame < 0 || frame >= m_FrameTotal || m_bCompressed)
+		return 0;
+
+	return GetFrameBeadIds(frame) + GetIndexRecord(frame)->beadTotal;
+}
+
+const double* CTrajectoryReader::GetFrameCoordinates(long frame) const
+{
+	if(frame < 0 || frame >= m_FrameTotal || m_bCompressed)
+		return 0;
+
+	return reinterpret_cast<const double*>(GetFrameBeadTypes(frame) + GetIndexRecord(frame)->beadTotal);
+}
+
+// Private function to return the length of an encoded frame in a compressed
+// trajectory. The caller must check that the length lies within the file.
+
+int64_t CTrajectoryReader::GetCompressedFrameLength(long frame) const
+{
+	int64_t length = 0;
+
+	std::memcpy(&length, m_pTrajectory + GetIndexRecord(frame)->offset + sizeof(CTrajectoryFile::FrameHeader), sizeof(int64_t));
+
+	return length;
+}
+
+// Function to decode a frame of a compressed trajectory into the codec. It
+// returns false for an invalid frame number, an uncompressed trajectory or 
+// a frame that cannot be decoded.
+
+bool CTrajectoryReader::DecodeFrame(long frame, CCoordinateCodec& rCodec) const
+{
+	if(frame < 0 || frame >= m_FrameTotal || !m_bCompressed)
+		return false;
+
+	const char* const pFrame = m_pTrajectory + GetIndexRecord(frame)->offset + sizeof(CTrajectoryFile::FrameHeader) + sizeof(int64_t);
+
+	return rCodec.Decode(reinterpret_cast<const unsigned char*>(pFrame), static_cast<size_t>(GetCompressedFrameLength(frame)));
+}
@@ -0,0 +1,87 @@
+// TrajectoryReader.h: interface for the CTrajectoryReader class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_TRAJECTORYREADER_H__D24F05E1_13EC_443E_8502_4906E7051F6D__INCLUDED_)
+#define AFX_TRAJECTORYREADER_H__D24F05E1_13EC_443E_8502_4906E7051F6D__INCLUDED_
+
+
+#include "TrajectoryFile.h"
+
+class CCoordinateCodec;
+
+class CTrajectoryReader : public xxBase
+{
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	CTrajectoryReader(const zString trajectoryFileName, const zString indexFileName);
+
+	virtual ~CTrajectoryReader();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline bool IsValid()       const {return m_bValid;}
+	inline long GetFrameTotal() const {return m_FrameTotal;}
+	inline bool IsCompressed()  const {return m_bCompressed;}
+
+	double GetSimBoxXLength() const;
+	double GetSimBoxYLength() const;
+	double GetSimBoxZLength() const;
+
+	// Frames are numbered from 0. The arrays returned point directly into the
+	// mapped file and remain valid for the lifetime of the reader. The
+	// coordinates are stored as (x,y,z) triples for each bead in the frame.
+	// The arrays are null for a compressed trajectory, whose frames must be
+	// decoded by DecodeFrame().
+
+	long           GetFrameTime(long frame)      const;
+	long           GetFrameBeadTotal(long frame) const;
+	const int64_t* GetFrameBeadIds(long frame)   const;
+	const int64_t* GetFrameBeadTypes(long frame) const;
+	const double*  GetFrameCoordinates(long frame) const;
+
+	bool DecodeFrame(long frame, CCoordinateCodec& rCodec) const;
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+	// ****************************************
+	// Private functions
+private:
+
+	CTrajectoryReader(const CTrajectoryReader& oldReader);
+	CTrajectoryReader& operator=(const CTrajectoryReader& rhs);
+
+	static const char* MapFile(const zString fileName, size_t* pSize);
+	static void UnmapFile(const char* pData, size_t size);
+
+	const CTrajectoryFile::FileHeader*  GetFileHeader() const;
+	const CTrajectoryFile::IndexRecord* GetIndexRecord(long frame) const;
+	int64_t GetCompressedFrameLength(long frame) const;
+
+	// ****************************************
+	// Data members
+private:
+
+	const char* m_pTrajectory;		// Mapped trajectory file
+	const char* m_pIndex;			// Mapped index file
+	size_t      m_TrajectorySize;	// Sizes of the mappings in bytes
+	size_t      m_IndexSize;
+	long        m_FrameTotal;		// Number of complete frames in both files
+	bool        m_bCompressed;		// true if the frames were encoded by a CCoordinateCodec
+	bool        m_bValid;			// true if both files were mapped and their headers recognised
+};
+
+#endif // !defined(AFX_TRAJECTORYREADER_H__D24F05E1_13EC_443E_8502_4906E7051F6D__INCLUDED_)
@@ -634,7 +634,7 @@ public:
 
 	long operator() (CCNTCell* pRegion) const
 	{
-		const BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		long beadsOfType = count_if(lBeads.begin(), lBeads.end(), aaBeadType(m_BeadType));
 
@@ -700,7 +700,7 @@ public:
 
 	double operator() (CCell* pRegion) const
 	{
-		BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		long beadsOfType = count_if(lBeads.begin(), lBeads.end(), aaBeadType(m_BeadType));
 
@@ -732,7 +732,7 @@ public:
 	
 	double operator() (CCell* pRegion) const
 	{
-		BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		double beadTotal = 0.0;
 		double CMPos	 = 0.0;
@@ -769,7 +769,7 @@ public:
 	
 	double operator() (CCell* pRegion) const
 	{
-		BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		double beadTotal = 0.0;
 		double CMPos	 = 0.0;
@@ -806,7 +806,7 @@ public:
 	
 	double operator() (CCell* pRegion) const
 	{
-		BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		double beadTotal = 0.0;
 		double CMPos	 = 0.0;
@@ -859,7 +859,7 @@ public:
 	
 	aaVector* operator() (CCell* pRegion) const
 	{
-		BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		double beadTotal = 0.0;
 		double X		 = 0.0;
@@ -919,7 +919,7 @@ public:
 
 	aaScalar* operator() (CSlice* pRegion) const
 	{
-		BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		long beadsOfType = count_if(lBeads.begin(), lBeads.end(), aaBeadType(m_BeadType));
 
@@ -954,7 +954,7 @@ public:
 
 	aaVector* operator() (CSlice* pRegion) const
 	{
-		BeadList lBeads = pRegion->GetBeads();
+		const BeadList& lBeads = pRegion->GetBeads();
 
 		double beadTotal = 0.0;
 		double beadXMom	 = 0.0;
@@ -54,7 +54,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable holding a pointer to the single instance of aeActiveSimBox.
 // Note that it does not get assigned a value until the user creates the instance.
 
-aeActiveSimBox* aeActiveSimBox::m_pInstance = 0;
+SimThreadLocal aeActiveSimBox* aeActiveSimBox::m_pInstance = 0;
 
 // Public member function to create a single instance of the CSimBox class.
 
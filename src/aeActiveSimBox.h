@@ -42,7 +42,7 @@ public:
 
 private:
 
-	static aeActiveSimBox* m_pInstance;
+	static SimThreadLocal aeActiveSimBox* m_pInstance;
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -31,7 +31,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // for example, a receptor-ligand pair (only one bond per polymer) and 
 // filamentous actin (arbitrary number of bonds per polymer).
 
-long aeArp23Bond::m_ActiveBondsPerPolymer = 1000;
+SimThreadLocal long aeArp23Bond::m_ActiveBondsPerPolymer = 1000;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -31,12 +31,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // Static member variable and function definitions
 //////////////////////////////////////////////////////////////////////
 
-long   aeCNTCell::m_CNTXCellNo			= 0;
-long   aeCNTCell::m_CNTYCellNo			= 0;
-long   aeCNTCell::m_CNTZCellNo			= 0;
-double aeCNTCell::m_CNTXCellWidth		= 0.0;
-double aeCNTCell::m_CNTYCellWidth		= 0.0;
-double aeCNTCell::m_CNTZCellWidth		= 0.0;
+SimThreadLocal long   aeCNTCell::m_CNTXCellNo			= 0;
+SimThreadLocal long   aeCNTCell::m_CNTYCellNo			= 0;
+SimThreadLocal long   aeCNTCell::m_CNTZCellNo			= 0;
+SimThreadLocal double aeCNTCell::m_CNTXCellWidth		= 0.0;
+SimThreadLocal double aeCNTCell::m_CNTYCellWidth		= 0.0;
+SimThreadLocal double aeCNTCell::m_CNTZCellWidth		= 0.0;
 
 // Static function to define the number and sizes of the active network's CNT cells.
 //
@@ -27,12 +27,12 @@ public:
 
 public:
 
-	static long m_CNTXCellNo;
-	static long m_CNTYCellNo;
-	static long m_CNTZCellNo;
-	static double m_CNTXCellWidth;
-	static double m_CNTYCellWidth;
-	static double m_CNTZCellWidth;
+	static SimThreadLocal long m_CNTXCellNo;
+	static SimThreadLocal long m_CNTYCellNo;
+	static SimThreadLocal long m_CNTZCellNo;
+	static SimThreadLocal double m_CNTXCellWidth;
+	static SimThreadLocal double m_CNTYCellWidth;
+	static SimThreadLocal double m_CNTZCellWidth;
 
 
 	// ****************************************
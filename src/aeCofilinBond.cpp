@@ -33,7 +33,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // for example, a receptor-ligand pair (only two bonds per polymer) and 
 // filamentous actin (arbitrary number of bonds per polymer).
 
-long aeCofilinBond::m_ActiveBondsPerPolymer = 2;
+SimThreadLocal long aeCofilinBond::m_ActiveBondsPerPolymer = 2;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
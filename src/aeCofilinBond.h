@@ -25,7 +25,7 @@ public:
 
 private:
 
-	static long	m_ActiveBondsPerPolymer;
+	static SimThreadLocal long	m_ActiveBondsPerPolymer;
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
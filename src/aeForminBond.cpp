@@ -35,7 +35,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // for example, a receptor-ligand pair (only one bond per polymer) and 
 // filamentous actin (arbitrary number of bonds per polymer).
 
-long aeForminBond::m_ActiveBondsPerPolymer = 1;
+SimThreadLocal long aeForminBond::m_ActiveBondsPerPolymer = 1;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -35,7 +35,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // for example, a receptor-ligand pair (only one bond per polymer) and 
 // filamentous actin (arbitrary number of bonds per polymer).
 
-long aeReceptorBond::m_ActiveBondsPerPolymer = 2;
+SimThreadLocal long aeReceptorBond::m_ActiveBondsPerPolymer = 2;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
@@ -40,7 +40,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // for example, a receptor-ligand pair (only one bond per polymer) and 
 // filamentous actin (arbitrary number of bonds per polymer).
 
-long aefActinBond::m_ActiveBondsPerPolymer = 1000;
+SimThreadLocal long aefActinBond::m_ActiveBondsPerPolymer = 1000;
 
 // Parameters setting the probabilities of an actin monomer's bound ATP
 // making a transition between its allowed states. These values apply
@@ -48,17 +48,17 @@ long aefActinBond::m_ActiveBondsPerPolymer = 1000;
 // internal state does not influence their behaviour. They must be
 // set by command.
 //
-double aefActinBond::m_ATPHydrolysisProb       = 0.0;  // Probability of ATP hydrolysis
-double aefActinBond::m_ADPReleasePiProb        = 0.0;  // Probability of releasing Pi
-double aefActinBond::m_ADPPhosphorylationProb  = 0.0;  // Probability of phosphorylation
+SimThreadLocal double aefActinBond::m_ATPHydrolysisProb       = 0.0;  // Probability of ATP hydrolysis
+SimThreadLocal double aefActinBond::m_ADPReleasePiProb        = 0.0;  // Probability of releasing Pi
+SimThreadLocal double aefActinBond::m_ADPPhosphorylationProb  = 0.0;  // Probability of phosphorylation
 
 
-double aefActinBond::m_HeadBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament head
-double aefActinBond::m_TailBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament tail
-double aefActinBond::m_HeadADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at head
-double aefActinBond::m_TailADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
-double aefActinBond::m_HeadADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at head
-double aefActinBond::m_TailADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at tail
+SimThreadLocal double aefActinBond::m_HeadBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament head
+SimThreadLocal double aefActinBond::m_TailBasalOffRate    = 0.0;      // Probability for ATP monomer to detach from filament tail
+SimThreadLocal double aefActinBond::m_HeadADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at head
+SimThreadLocal double aefActinBond::m_TailADPPiMultiplier = 0.0;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
+SimThreadLocal double aefActinBond::m_HeadADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at head
+SimThreadLocal double aefActinBond::m_TailADPMultiplier   = 0.0;      // Multiplier applied to basal rate when Pi is released at tail
 
 
 // Function to set the probability of the transitions ATP --> ADP-Pi
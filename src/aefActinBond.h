@@ -39,18 +39,18 @@ public:
 
 private:
 
-	static long	m_ActiveBondsPerPolymer;
-
-    static double m_ATPHydrolysisProb;       // Probability of ATP hydrolysis
-    static double m_ADPReleasePiProb;        // Probability of releasing Pi
-    static double m_ADPPhosphorylationProb;  // Probability of phosphorylation
-
-    static double m_HeadBasalOffRate;         // Probability for ATP monomer to detach from filament head
-    static double m_TailBasalOffRate;         // Probability for ATP monomer to detach from filament tail
-    static double m_HeadADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at head
-    static double m_TailADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
-    static double m_HeadADPMultiplier;        // Multiplier applied to basal rate when Pi is released at head
-    static double m_TailADPMultiplier;        // Multiplier applied to basal rate when Pi is released at tail
+	static SimThreadLocal long	m_ActiveBondsPerPolymer;
+
+    static SimThreadLocal double m_ATPHydrolysisProb;       // Probability of ATP hydrolysis
+    static SimThreadLocal double m_ADPReleasePiProb;        // Probability of releasing Pi
+    static SimThreadLocal double m_ADPPhosphorylationProb;  // Probability of phosphorylation
+
+    static SimThreadLocal double m_HeadBasalOffRate;         // Probability for ATP monomer to detach from filament head
+    static SimThreadLocal double m_TailBasalOffRate;         // Probability for ATP monomer to detach from filament tail
+    static SimThreadLocal double m_HeadADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at head
+    static SimThreadLocal double m_TailADPPiMultiplier;      // Multiplier applied to basal rate when ATP is hydrolysed at tail
+    static SimThreadLocal double m_HeadADPMultiplier;        // Multiplier applied to basal rate when Pi is released at head
+    static SimThreadLocal double m_TailADPMultiplier;        // Multiplier applied to basal rate when Pi is released at tail
 
     // ****************************************
 	// PVFs that must be overridden by all derived classes
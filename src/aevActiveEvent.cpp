@@ -46,7 +46,7 @@ zInStream& operator>>(zInStream& is, aevActiveEvent& event)
 
 // Static member variable holding the number of events created.
 
-long aevActiveEvent::m_EventTotal = 0;
+SimThreadLocal long aevActiveEvent::m_EventTotal = 0;
 
 long aevActiveEvent::GetEventTotal()
 {
@@ -0,0 +1,77 @@
+// ccMakeNanoparticleRigid.h: interface for the ccMakeNanoparticleRigid class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_CCMAKENANOPARTICLERIGID_H__AE417E11_D7FB_4CF1_9FFA_60F821230674__INCLUDED_)
+#define AFX_CCMAKENANOPARTICLERIGID_H__AE417E11_D7FB_4CF1_9FFA_60F821230674__INCLUDED_
+
+
+#include "xxCommand.h"
+
+class ccMakeNanoparticleRigid : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	ccMakeNanoparticleRigid(long executionTime);
+	ccMakeNanoparticleRigid(const ccMakeNanoparticleRigid& oldCommand);
+
+	virtual ~ccMakeNanoparticleRigid();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	// The following pure virtual functions must be provided by all derived classes
+	// so that they may have data read into them given only an xxCommand pointer,
+	// respond to the SimBox's request to execute and return the name of the command.
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetNanoparticleId() const {return m_NanoparticleId;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	long  m_NanoparticleId;		// Id of the nanoparticle to make rigid
+};
+
+#endif // !defined(AFX_CCMAKENANOPARTICLERIGID_H__AE417E11_D7FB_4CF1_9FFA_60F821230674__INCLUDED_)
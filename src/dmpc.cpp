@@ -45,6 +45,11 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
    If a runId of an existing simulation is specified the old output files are 
    overwritten.
   
+   In the serial code, a first argument of the form -jN runs the following
+   runIds concurrently on N threads, e.g., for a parameter sweep. Each thread
+   has its own copy of the simulation state, so the runs must not depend on
+   each other's output as they are executed in no particular order.
+  
    Error codes
    ***********
   
@@ -54,6 +59,7 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
    3 = Parallel simulation failed: Unable to initialise MPI
    4 = Parallel simulation failed: Unable to finalize MPI
    5 = Parallel batch simulation failed
+   6 = Serial threaded runs failed: -jN needs N >= 1 and at least one runId
    
  ********************************************************************** */
 
@@ -61,6 +67,12 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 #include "SimDefs.h"
 #include "Experiment.h"
 
+#if SimMPS == SimulationDisabled && SimThreadedRuns == SimulationEnabled
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#endif
+
 int main(int argc, char* argv[])
 {
     zString runId;
@@ -199,8 +211,64 @@ int main(int argc, char* argv[])
 		// the error code is replaced by the successful value.
 		// If we reach here in the parallel code, it is an error as we only
 		// allow a single run on multiple processors.
-		
-		for(int i=1; i<argc; i++)
+
+		int  firstRun    = 1;
+		long threadTotal = 1;
+
+#if SimThreadedRuns == SimulationEnabled
+		if(argv[1][0] == '-' && argv[1][1] == 'j')
+		{
+			firstRun    = 2;
+			threadTotal = atol(argv[1] + 2);
+
+			if(argc < 3 || threadTotal < 1)
+			{
+				std::cout << "Usage: " << argv[0] << " -jN runId [runId ...] with N >= 1" << zEndl;
+				firstRun    = argc;
+				threadTotal = 1;
+				errCode     = 6;
+			}
+		}
+
+		if(threadTotal > 1)
+		{
+			// Each worker thread takes the next unclaimed runId until none
+			// remain. The simulation singletons are thread-local, so every
+			// CExperiment created here is independent of the others.
+
+			std::atomic<int>  nextRun(firstRun);
+			std::atomic<long> failedRuns(0);
+			std::vector<std::thread> workers;
+
+			for(long t=0; t<threadTotal; t++)
+			{
+				workers.push_back(std::thread([&nextRun, &failedRuns, argc, argv]()
+				{
+					for(int i=nextRun++; i<argc; i=nextRun++)
+					{
+						IExperiment* pIExpt = CExperiment::Instance("epstd", zString(argv[i]), true);
+						if(!pIExpt->Run())
+						{
+							failedRuns++;
+						}
+						delete pIExpt;
+					}
+				}));
+			}
+
+			for(std::vector<std::thread>::iterator iterWorker=workers.begin(); iterWorker!=workers.end(); iterWorker++)
+			{
+				iterWorker->join();
+			}
+
+			if(failedRuns > 0)
+			{
+				errCode = 2;
+			}
+		}
+		else
+#endif
+		for(int i=firstRun; i<argc; i++)
 		{
 			runId.assign(argv[i]);
 
@@ -120,6 +120,24 @@ void mcSetCurrentStateDefaultFormatImpl::SetCurrentStateDefaultFormat(const xxCo
         pMon->m_DefaultCurrentStateFormat = "SolventFreeAndPovray";
             
             new CLogSetCurrentStateDefaultFormat(pMon->GetCurrentTime(), pMon->m_DefaultCurrentStateFormat);
+    }
+    else if(format == "Trajectory")
+    {
+        pMon->m_DefaultCurrentStateFormat = "Trajectory";
+
+        new CLogSetCurrentStateDefaultFormat(pMon->GetCurrentTime(), pMon->m_DefaultCurrentStateFormat);
+    }
+    else if(format == "Compressed")
+    {
+        pMon->m_DefaultCurrentStateFormat = "Compressed";
+
+        new CLogSetCurrentStateDefaultFormat(pMon->GetCurrentTime(), pMon->m_DefaultCurrentStateFormat);
+    }
+    else if(format == "CompressedTrajectory")
+    {
+        pMon->m_DefaultCurrentStateFormat = "CompressedTrajectory";
+
+        new CLogSetCurrentStateDefaultFormat(pMon->GetCurrentTime(), pMon->m_DefaultCurrentStateFormat);
     }
 	else
 	{
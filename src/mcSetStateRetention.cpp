@@ -0,0 +1,165 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// mcSetStateRetention.cpp: implementation of the mcSetStateRetention class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "mcSetStateRetention.h"
+#include "ISimCmd.h"
+#include "InputData.h"
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// Static member variable containing the identifier for this command. 
+// The static member function GetType() is invoked by the xxCommandObject 
+// to compare the type read from the control data file with each
+// xxCommand-derived class so that it can create the appropriate object 
+// to hold the command data.
+
+const zString mcSetStateRetention::m_Type = "SetStateRetention";
+
+const zString mcSetStateRetention::GetType()
+{
+	return m_Type;
+}
+
+// We use an anonymous namespace to wrap the call to the factory object
+// so that it is not accessible from outside this file. The identifying
+// string for the command is stored in the m_Type static member variable.
+//
+// Note that the Create() function is not a member function of the
+// command class but a global function hidden in the namespace.
+
+namespace
+{
+	xxCommand* Create(long executionTime) {return new mcSetStateRetention(executionTime);}
+
+	const zString id = mcSetStateRetention::GetType();
+
+	const bool bRegistered = acfCommandFactory::Instance()->Register(id, Create);
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+mcSetStateRetention::mcSetStateRetention(long executionTime) : xxCommand(executionTime),
+										m_CurrentStates(0), m_DensityStates(1)
+{
+}
+
+mcSetStateRetention::mcSetStateRetention(const mcSetStateRetention& oldCommand) : xxCommand(oldCommand),
+										m_CurrentStates(oldCommand.m_CurrentStates),
+										m_DensityStates(oldCommand.m_DensityStates)
+{
+}
+
+mcSetStateRetention::mcSetStateRetention(long executionTime, bool bLog, long currentStates, long densityStates) : xxCommand(executionTime, bLog),
+										m_CurrentStates(currentStates),
+										m_DensityStates(densityStates)
+{
+}
+
+
+mcSetStateRetention::~mcSetStateRetention()
+{
+}
+
+// Member functions to read/write the data specific to the command.
+//
+// Arguments
+// *********
+//
+//	m_CurrentStates		Number of most recent current state snapshots that 
+//						are kept in memory when current state analysis is on
+//	m_DensityStates		Number of most recent density grid samples kept in memory
+//
+// A value of zero means that all states are kept.
+
+zOutStream& mcSetStateRetention::put(zOutStream& os) const
+{
+#if EnableXMLCommands == SimXMLEnabled
+
+	// XML output
+	putXMLStartTags(os);
+	os << "<CurrentStates>" << m_CurrentStates << "</CurrentStates>" << zEndl;
+	os << "<DensityStates>" << m_DensityStates << "</DensityStates>" << zEndl;
+	putXMLEndTags(os);
+
+#elif EnableXMLCommands == SimXMLDisabled
+
+	// ASCII output 
+	putASCIIStartTags(os);
+	os << m_CurrentStates << " " << m_DensityStates;
+	putASCIIEndTags(os);
+
+#endif
+
+	return os;
+}
+
+zInStream& mcSetStateRetention::get(zInStream& is)
+{
+	is >> m_CurrentStates >> m_DensityStates;
+
+	if(!is.good() || m_CurrentStates < 0 || m_DensityStates < 0)
+	   SetCommandValid(false);
+
+	return is;
+}
+
+// Non-static function to return the type of the command
+
+const zString mcSetStateRetention::GetCommandType() const
+{
+	return m_Type;
+}
+
+// Function to return a pointer to a copy of the current command.
+
+const xxCommand* mcSetStateRetention::GetCommand() const
+{
+	return new mcSetStateRetention(*this);
+}
+
+
+// Implementation of the command that is sent by the SimBox to each xxCommand
+// object to see if it is the right time for it to carry out its operation.
+// We return a boolean so that the SimBox can see if the command executed or not
+// as this may be useful for considering several commands. 
+
+bool mcSetStateRetention::Execute(long simTime, ISimCmd* const pISimCmd) const
+{
+	if(simTime == GetExecutionTime())
+	{
+		pISimCmd->SetStateRetention(this);
+		return true;
+	}
+	else
+		return false;
+}
+
+// Function to check that the retention limits are valid: this has been
+// validated above.
+
+bool mcSetStateRetention::IsDataValid(const CInputData& riData) const
+{
+
+	return true;
+}
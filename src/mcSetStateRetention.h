@@ -0,0 +1,92 @@
+// mcSetStateRetention.h: interface for the mcSetStateRetention class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCSETSTATERETENTION_H__F303AFB4_282E_4385_A4FA_0AFB5F2E0730__INCLUDED_)
+#define AFX_MCSETSTATERETENTION_H__F303AFB4_282E_4385_A4FA_0AFB5F2E0730__INCLUDED_
+
+
+// Forward declarations
+
+class ISimCmd;
+
+
+#include "xxCommand.h"
+
+class mcSetStateRetention : public xxCommand 
+{
+	// ****************************************
+	// Construction/Destruction: base class has protected constructor
+public:
+
+	mcSetStateRetention(long executionTime);
+	mcSetStateRetention(const mcSetStateRetention& oldCommand);
+
+	// Constructor for use when executing the command internally
+
+	mcSetStateRetention(long executionTime, bool bLog, long currentStates, long densityStates);
+
+	virtual ~mcSetStateRetention();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+	
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	// The following pure virtual functions must be provided by all derived classes
+	// so that they may have data read into them given only an xxCommand pointer,
+	// respond to the SimBox's request to execute and return the name of the command.
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetCurrentStates()	const {return m_CurrentStates;}
+	inline long GetDensityStates()	const {return m_DensityStates;}
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	virtual const zString GetCommandType() const;
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	long m_CurrentStates;	// No of current state snapshots kept in memory (0 = all)
+	long m_DensityStates;	// No of density grid samples kept in memory (0 = all)
+};
+
+#endif // !defined(AFX_MCSETSTATERETENTION_H__F303AFB4_282E_4385_A4FA_0AFB5F2E0730__INCLUDED_)
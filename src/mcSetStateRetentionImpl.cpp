@@ -0,0 +1,65 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// mcSetStateRetentionImpl.cpp: implementation of the mcSetStateRetentionImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "mcSetStateRetentionImpl.h"
+#include "mcSetStateRetention.h"
+#include "Monitor.h"
+#include "LogSetStateRetention.h"
+#include "LogCommandFailed.h"
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+mcSetStateRetentionImpl::mcSetStateRetentionImpl()
+{
+}
+
+mcSetStateRetentionImpl::~mcSetStateRetentionImpl()
+{
+
+}
+
+// Command handler function to change the number of CCurrentState and 
+// CDensityState objects that the Monitor keeps in memory. Older states 
+// are destroyed as new ones are saved so that long runs have a bounded 
+// memory footprint. The states are always written to file first, so this 
+// only affects the data available to analyses that run during the simulation.
+
+void mcSetStateRetentionImpl::SetStateRetention(const xxCommand* const pCommand)
+{
+	const mcSetStateRetention* const pCmd = dynamic_cast<const mcSetStateRetention*>(pCommand);
+
+	const long currentStates = pCmd->GetCurrentStates();
+	const long densityStates = pCmd->GetDensityStates();
+
+	CMonitor* const pMon = dynamic_cast<CMonitor*>(this);
+
+    if(pMon->InternalSetStateRetention(currentStates, densityStates))
+    {
+	    if(pCmd->IsExecutionLogged())
+	    {
+			new CLogSetStateRetention(pMon->GetCurrentTime(), currentStates, densityStates);
+	    }	
+    }
+    else
+    {
+		 new CLogCommandFailed(pMon->GetCurrentTime(), pCmd);
+    }
+}
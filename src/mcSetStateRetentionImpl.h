@@ -0,0 +1,61 @@
+// mcSetStateRetentionImpl.h: interface for the mcSetStateRetentionImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCSETSTATERETENTIONIMPL_H__A14FDD6D_2F0F_4B7D_865D_B457B51B5DC3__INCLUDED_)
+#define AFX_MCSETSTATERETENTIONIMPL_H__A14FDD6D_2F0F_4B7D_865D_B457B51B5DC3__INCLUDED_
+
+
+// Forward declarations
+
+class xxCommand;
+
+#include "IMonitorCmd.h"
+
+class mcSetStateRetentionImpl : public virtual IMonitorCmd
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	mcSetStateRetentionImpl();
+
+	virtual ~mcSetStateRetentionImpl();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void SetStateRetention(const xxCommand* const pCommand);
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+};
+
+#endif // !defined(AFX_MCSETSTATERETENTIONIMPL_H__A14FDD6D_2F0F_4B7D_865D_B457B51B5DC3__INCLUDED_)
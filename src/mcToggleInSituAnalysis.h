@@ -0,0 +1,71 @@
+// mcToggleInSituAnalysis.h: interface for the mcToggleInSituAnalysis class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCTOGGLEINSITUANALYSIS_H__BCB13DBF_7C0A_4D42_A654_F3795CBD782D__INCLUDED_)
+#define AFX_MCTOGGLEINSITUANALYSIS_H__BCB13DBF_7C0A_4D42_A654_F3795CBD782D__INCLUDED_
+
+
+// Forward declarations
+
+class ISimCmd;
+
+
+#include "xxCommand.h"
+
+class mcToggleInSituAnalysis : public xxCommand  
+{
+	// ****************************************
+	// Construction/Destruction: protected constructor declared below
+public:
+	mcToggleInSituAnalysis(long executionTime);
+	mcToggleInSituAnalysis(const mcToggleInSituAnalysis& oldCommand);
+
+	virtual ~mcToggleInSituAnalysis();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+
+	// ****************************************
+	// Public access functions
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const zString GetCommandType() const;
+
+	static const zString GetType();	// Return the type of command
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+	// ****************************************
+	// Protected local functions
+
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+};
+
+#endif // !defined(AFX_MCTOGGLEINSITUANALYSIS_H__BCB13DBF_7C0A_4D42_A654_F3795CBD782D__INCLUDED_)
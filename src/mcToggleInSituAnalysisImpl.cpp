@@ -0,0 +1,69 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// mcToggleInSituAnalysisImpl.cpp: implementation of the mcToggleInSituAnalysisImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "mcToggleInSituAnalysisImpl.h"
+#include "mcToggleInSituAnalysis.h"
+#include "Monitor.h"
+#include "InSituAnalysis.h"
+#include "LogToggleInSituAnalysis.h"
+
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+mcToggleInSituAnalysisImpl::mcToggleInSituAnalysisImpl()
+{
+}
+
+mcToggleInSituAnalysisImpl::~mcToggleInSituAnalysisImpl()
+{
+
+}
+
+// Command handler function to toggle on or off the analysis of aggregates on a
+// background thread. When it is on, aggregates that can be updated from a 
+// snapshot of the bead data are analysed while the simulation continues, and
+// they write their state files from the analysis thread. At present these are
+// only micelles and clusters: bilayers, regions and density fields are still 
+// analysed in the timestep loop. Turning it off waits for any outstanding 
+// analysis to finish and destroys the thread.
+//
+// The default is to analyse all aggregates in the timestep loop.
+
+void mcToggleInSituAnalysisImpl::ToggleInSituAnalysis(const xxCommand* const pCommand)
+{
+//	const mcToggleInSituAnalysis* const pCmd = dynamic_cast<const mcToggleInSituAnalysis*>(pCommand);
+
+	CMonitor* pMon = dynamic_cast<CMonitor*>(this);
+
+	if(pMon->m_pInSituAnalysis)
+	{
+		delete pMon->m_pInSituAnalysis;
+		pMon->m_pInSituAnalysis = 0;
+	}
+	else
+	{
+		pMon->m_pInSituAnalysis = new CInSituAnalysis();
+	}
+
+	// This command cannot fail
+
+	new CLogToggleInSituAnalysis(pMon->GetCurrentTime(), pMon->m_pInSituAnalysis != 0);
+}
@@ -0,0 +1,62 @@
+// mcToggleInSituAnalysisImpl.h: interface for the mcToggleInSituAnalysisImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCTOGGLEINSITUANALYSISIMPL_H__4017DCC7_AAE7_4937_A88A_16C195760BE7__INCLUDED_)
+#define AFX_MCTOGGLEINSITUANALYSISIMPL_H__4017DCC7_AAE7_4937_A88A_16C195760BE7__INCLUDED_
+
+
+// Forward declarations
+
+class xxCommand;
+
+#include "IMonitorCmd.h"
+
+
+class mcToggleInSituAnalysisImpl : public virtual IMonitorCmd
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	mcToggleInSituAnalysisImpl();
+
+	virtual ~mcToggleInSituAnalysisImpl();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void ToggleInSituAnalysis(const xxCommand* const pCommand);
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+};
+
+#endif // !defined(AFX_MCTOGGLEINSITUANALYSISIMPL_H__4017DCC7_AAE7_4937_A88A_16C195760BE7__INCLUDED_)
@@ -0,0 +1,155 @@
+/* **********************************************************************
+Copyright 2020  Dr. J. C. Shillcock and Prof. Dr. R. Lipowsky, Director at the Max Planck Institute (MPI) of Colloids and Interfaces; Head of Department Theory and Bio-Systems.
+
+Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+
+2. Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+
+3. Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+********************************************************************** */
+// mcTogglePerformanceOutput.cpp: implementation of the mcTogglePerformanceOutput class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#include "StdAfx.h"
+#include "SimDefs.h"
+#include "mcTogglePerformanceOutput.h"
+#include "ISimCmd.h"
+#include "InputData.h"
+
+//////////////////////////////////////////////////////////////////////
+// Global members
+//////////////////////////////////////////////////////////////////////
+
+// Static member variable containing the identifier for this command. 
+// The static member function GetType() is invoked by the xxCommandObject 
+// to compare the type read from the control data file with each
+// xxCommand-derived class so that it can create the appropriate object 
+// to hold the command data.
+
+const zString mcTogglePerformanceOutput::m_Type = "TogglePerformanceOutput";
+
+const zString mcTogglePerformanceOutput::GetType()
+{
+	return m_Type;
+}
+
+// We use an anonymous namespace to wrap the call to the factory object
+// so that it is not accessible from outside this file. The identifying
+// string for the command is stored in the m_Type static member variable.
+//
+// Note that the Create() function is not a member function of the
+// command class but a global function hidden in the namespace.
+
+namespace
+{
+	xxCommand* Create(long executionTime) {return new mcTogglePerformanceOutput(executionTime);}
+
+	const zString id = mcTogglePerformanceOutput::GetType();
+
+#if EnableMonitorCommand == SimCommandEnabled
+	const bool bRegistered = acfCommandFactory::Instance()->Register(id, Create);
+#endif
+}
+
+//////////////////////////////////////////////////////////////////////
+// Construction/Destruction
+//////////////////////////////////////////////////////////////////////
+
+mcTogglePerformanceOutput::mcTogglePerformanceOutput(long executionTime) : xxCommand(executionTime),
+																 m_Period(0)
+{
+}
+
+mcTogglePerformanceOutput::mcTogglePerformanceOutput(const mcTogglePerformanceOutput& oldCommand) : xxCommand(oldCommand),
+											m_Period(oldCommand.m_Period)
+{
+}
+
+mcTogglePerformanceOutput::~mcTogglePerformanceOutput()
+{
+}
+
+// Member functions to write/read the data specific to the command.
+// The sole datum for this command is the number of timesteps over which
+// the phase timings are averaged before a line is written to the 
+// performance log. It is ignored when the command turns the output off.
+
+zOutStream& mcTogglePerformanceOutput::put(zOutStream& os) const
+{
+#if EnableMonitorCommand == SimCommandEnabled
+#if EnableXMLCommands == SimXMLEnabled
+
+	// XML output
+	putXMLStartTags(os);
+	os << "<Period>" << m_Period << "</Period>" << zEndl;
+	putXMLEndTags(os);
+
+#elif EnableXMLCommands == SimXMLDisabled
+
+	// ASCII output 
+	putASCIIStartTags(os);
+	os << m_Period;
+	putASCIIEndTags(os);
+
+#endif
+#endif
+
+	return os;
+}
+
+zInStream& mcTogglePerformanceOutput::get(zInStream& is)
+{
+#if EnableMonitorCommand == SimCommandEnabled
+	is >> m_Period;
+
+	if(!is.good() || m_Period < 1)
+		SetCommandValid(false);
+#endif
+
+	return is;
+}
+
+// Implementation of the command that is sent by the SimBox to each xxCommand
+// object to see if it is the right time for it to carry out its operation.
+// As for other monitor commands, it is passed to the ISimCmd interface first
+// and thence to the CMonitor.
+
+bool mcTogglePerformanceOutput::Execute(long simTime, ISimCmd* const pISimCmd) const
+{
+	if(simTime == GetExecutionTime())
+	{
+#if EnableMonitorCommand == SimCommandEnabled
+		pISimCmd->TogglePerformanceOutput(this);
+#endif
+		return true;
+	}
+	else
+		return false;
+}
+
+// Non-static function to return the type of the command
+
+const zString mcTogglePerformanceOutput::GetCommandType() const
+{
+	return m_Type;
+}
+
+// Function to return a pointer to a copy of the current command.
+
+const xxCommand* mcTogglePerformanceOutput::GetCommand() const
+{
+	return new mcTogglePerformanceOutput(*this);
+}
+
+// Function to check the command is valid: the period is checked to be
+// positive when it is read so we just return true.
+
+bool mcTogglePerformanceOutput::IsDataValid(const CInputData &riData) const
+{
+	return true;
+}
@@ -0,0 +1,66 @@
+// mcTogglePerformanceOutput.h: interface for the mcTogglePerformanceOutput class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCTOGGLEPERFORMANCEOUTPUT_H__36FB6132_09E9_4C3D_A5EC_D245BA2025BD__INCLUDED_)
+#define AFX_MCTOGGLEPERFORMANCEOUTPUT_H__36FB6132_09E9_4C3D_A5EC_D245BA2025BD__INCLUDED_
+
+
+// Forward declarations
+
+class ISimCmd;
+
+#include "xxCommand.h"
+
+class mcTogglePerformanceOutput : public xxCommand  
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+
+	mcTogglePerformanceOutput(long executionTime);
+	mcTogglePerformanceOutput(const mcTogglePerformanceOutput& oldCommand);
+
+	virtual ~mcTogglePerformanceOutput();
+
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+	static const zString GetType();	// Return the type of command
+
+private:
+
+	static const zString m_Type;	// Identifier used in control data file for command
+
+	// ****************************************
+	// Public access functions
+public:
+
+	inline long GetPeriod() const {return m_Period;}
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+
+public:
+	zOutStream& put(zOutStream& os) const;
+	zInStream&  get(zInStream& is);
+
+	virtual bool Execute(long simTime, ISimCmd* const pISimCmd) const;
+
+	virtual const xxCommand* GetCommand() const;
+
+	virtual bool IsDataValid(const CInputData& riData) const;
+
+protected:
+	virtual const zString GetCommandType() const;
+
+
+	// ****************************************
+	// Data members
+private:
+
+	long  m_Period;		// Number of steps averaged per line of the performance log
+};
+
+#endif // !defined(AFX_MCTOGGLEPERFORMANCEOUTPUT_H__36FB6132_09E9_4C3D_A5EC_D245BA2025BD__INCLUDED_)
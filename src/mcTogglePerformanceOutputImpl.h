@@ -0,0 +1,61 @@
+// mcTogglePerformanceOutputImpl.h: interface for the mcTogglePerformanceOutputImpl class.
+//
+//////////////////////////////////////////////////////////////////////
+
+#if !defined(AFX_MCTOGGLEPERFORMANCEOUTPUTIMPL_H__E0124778_649A_4BE1_A024_4F28B571A088__INCLUDED_)
+#define AFX_MCTOGGLEPERFORMANCEOUTPUTIMPL_H__E0124778_649A_4BE1_A024_4F28B571A088__INCLUDED_
+
+
+// Forward declarations
+
+class xxCommand;
+
+#include "IMonitorCmd.h"
+
+class mcTogglePerformanceOutputImpl : public virtual IMonitorCmd
+{
+public:
+	// ****************************************
+	// Construction/Destruction
+public:
+
+	mcTogglePerformanceOutputImpl();
+
+	virtual ~mcTogglePerformanceOutputImpl();
+	
+	// ****************************************
+	// Global functions, static member functions and variables
+public:
+
+
+	// ****************************************
+	// PVFs that must be overridden by all derived classes
+public:
+
+	// ****************************************
+	// Public access functions
+public:
+
+	void TogglePerformanceOutput(const xxCommand* const pCommand);
+
+
+	// ****************************************
+	// Protected local functions
+protected:
+
+	// ****************************************
+	// Implementation
+
+
+	// ****************************************
+	// Private functions
+private:
+
+
+	// ****************************************
+	// Data members
+private:
+
+};
+
+#endif // !defined(AFX_MCTOGGLEPERFORMANCEOUTPUTIMPL_H__E0124778_649A_4BE1_A024_4F28B571A088__INCLUDED_)
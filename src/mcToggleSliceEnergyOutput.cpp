@@ -56,7 +56,7 @@ namespace
 #endif
 }
 
-long mcToggleSliceEnergyOutput::m_CommandCounter = 0;
+SimThreadLocal long mcToggleSliceEnergyOutput::m_CommandCounter = 0;
 
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
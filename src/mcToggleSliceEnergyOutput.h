@@ -36,7 +36,7 @@ private:
 	// commands. We keep track of how many slice energy commands have been created
 	// using a static counter.
 
-	static long	m_CommandCounter;
+	static SimThreadLocal long	m_CommandCounter;
 
 	// ****************************************
 	// Public access functions
@@ -39,8 +39,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // ****************************************
 // Global members to return information about a parallel experiment
 
-long mpsSimBox::GlobalCellCellIntCounter = 0;
-long mpsSimBox::GlobalCellCounter = 0;
+SimThreadLocal long mpsSimBox::GlobalCellCellIntCounter = 0;
+SimThreadLocal long mpsSimBox::GlobalCellCounter = 0;
 
 
 //////////////////////////////////////////////////////////////////////
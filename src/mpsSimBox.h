@@ -51,8 +51,8 @@ public:
 
 public:
 
-    static long  GlobalCellCounter;
-    static long  GlobalCellCellIntCounter;
+    static SimThreadLocal long  GlobalCellCounter;
+    static SimThreadLocal long  GlobalCellCellIntCounter;
 
     static const long m_InitialEmptyPolymers = 1000;           // Initial number of empty polymer instances
     static const long m_InitialEmptyExtendedPolymers = 1000;   // Initial number of empty extended polymer instances
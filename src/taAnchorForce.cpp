@@ -140,13 +140,12 @@ void taAnchorForce::Execute(long simTime)
 	// debug checks
 	const zString label = GetLabel();
 
-	// We use a temporary vector to hold the target's beads because 
-	// applying begin() and end() to the GetBeads() function directly 
-	// yields null pointers.
+	// The target's beads are cached by the taForceDecorator base class so
+	// that we do not copy them every time step.
 
-	BeadVector vBeads = GetBeads();
+	const BeadVector& vBeads = GetTargetBeads();
 
-	for(BeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	for(cBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
 	{
 		// Find the point on the cylinder closest to the bead's coordinates
 
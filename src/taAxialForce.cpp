@@ -122,13 +122,12 @@ void taAxialForce::Execute(long simTime)
 	// debug checks
 	const zString label = GetLabel();
 
-	// We use a temporary vector to hold the target's beads because 
-	// applying begin() and end() to the GetBeads() function directly 
-	// yields null pointers.
+	// The target's beads are cached by the taForceDecorator base class so
+	// that we do not copy them every time step.
 
-	BeadVector vBeads = GetBeads();
+	const BeadVector& vBeads = GetTargetBeads();
 
-	for(BeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
+	for(cBeadVectorIterator iterBead=vBeads.begin(); iterBead!=vBeads.end(); iterBead++)
 	{
 		m_RelOX = (*iterBead)->GetXPos() - m_XCentre;
 		m_RelOY = (*iterBead)->GetYPos() - m_YCentre;
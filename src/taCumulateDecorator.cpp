@@ -69,6 +69,11 @@ BeadVector taCumulateDecorator::GetBeads() const
 	return GetInnerDecorator()->GetBeads();
 }
 
+bool taCumulateDecorator::IsMembershipDynamic() const
+{
+	return GetInnerDecorator()->IsMembershipDynamic();
+}
+
 long taCumulateDecorator::GetCurrentBeadType() const
 {
 	return GetInnerDecorator()->GetCurrentBeadType();
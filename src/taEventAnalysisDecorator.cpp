@@ -79,6 +79,11 @@ BeadVector taEventAnalysisDecorator::GetBeads() const
 	return GetInnerDecorator()->GetBeads();
 }
 
+bool taEventAnalysisDecorator::IsMembershipDynamic() const
+{
+	return GetInnerDecorator()->IsMembershipDynamic();
+}
+
 long taEventAnalysisDecorator::GetCurrentBeadType() const
 {
 	return GetInnerDecorator()->GetCurrentBeadType();
@@ -76,6 +76,11 @@ BeadVector taEventSourceDecorator::GetBeads() const
 	return GetInnerDecorator()->GetBeads();
 }
 
+bool taEventSourceDecorator::IsMembershipDynamic() const
+{
+	return GetInnerDecorator()->IsMembershipDynamic();
+}
+
 long taEventSourceDecorator::GetCurrentBeadType() const
 {
 	return GetInnerDecorator()->GetCurrentBeadType();
@@ -43,6 +43,7 @@ public:
 	virtual long GetBeadTotalForType(long type)	const;
 	virtual long GetBeadTotal()					const;
 	virtual BeadVector GetBeads()				const;
+	virtual bool IsMembershipDynamic()			const;
 
 	// ****************************************
 	// Functions implemented by CCommandTarget
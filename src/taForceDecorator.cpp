@@ -27,7 +27,8 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
 // command target being wrapped by the decorator, to the CCommandTargetNode
 // base class.
 
-taForceDecorator::taForceDecorator(const zString label, CCommandTargetNode* const pDec) : CCommandTargetNode(label, pDec), m_pBead(0)
+taForceDecorator::taForceDecorator(const zString label, CCommandTargetNode* const pDec) : CCommandTargetNode(label, pDec), m_pBead(0),
+																						   m_TargetBeadsChangeTotal(-1)
 
 {
 
@@ -37,7 +38,8 @@ taForceDecorator::taForceDecorator(const zString label, CCommandTargetNode* cons
 // decorator's label to the base class, and all remaining data must be set in 
 // the Read() function.
 
-taForceDecorator::taForceDecorator(const zString label) : CCommandTargetNode(label), m_pBead(0)
+taForceDecorator::taForceDecorator(const zString label) : CCommandTargetNode(label), m_pBead(0),
+																		   m_TargetBeadsChangeTotal(-1)
 {
 
 }
@@ -74,6 +76,11 @@ BeadVector taForceDecorator::GetBeads() const
 	return GetInnerDecorator()->GetBeads();
 }
 
+bool taForceDecorator::IsMembershipDynamic() const
+{
+	return GetInnerDecorator()->IsMembershipDynamic();
+}
+
 long taForceDecorator::GetCurrentBeadType() const
 {
 	return GetInnerDecorator()->GetCurrentBeadType();
@@ -135,3 +142,23 @@ void taForceDecorator::SetBeadPointer(const CBead *const pBead)
 {
 	m_pBead = pBead;
 }
+
+// Function used by derived classes to obtain the beads they apply forces to.
+// Collecting the beads from the wrapped target creates a new container on
+// each call, and for polymer and composite targets it also has to traverse
+// all their contents. As the membership of targets rarely changes, we keep
+// a copy here and only refresh it when the CCommandTargetNode base class
+// shows that some target's contents have changed. Targets whose contents are
+// computed on each call, such as the ACN targets, do not record their 
+// changes, so their beads are always collected afresh.
+
+const BeadVector& taForceDecorator::GetTargetBeads()
+{
+	if(IsMembershipDynamic() || m_TargetBeadsChangeTotal != GetMembershipChangeTotal())
+	{
+		m_vTargetBeads = GetBeads();
+		m_TargetBeadsChangeTotal = GetMembershipChangeTotal();
+	}
+
+	return m_vTargetBeads;
+}
@@ -44,6 +44,7 @@ public:
 	virtual long GetBeadTotalForType(long type)	const;
 	virtual long GetBeadTotal()					const;
 	virtual BeadVector GetBeads()				const;
+	virtual bool IsMembershipDynamic()			const;
 
 	// ****************************************
 	// Functions implemented by CCommandTarget
@@ -98,6 +99,11 @@ protected:
 	inline void AddBeadYForce(CBead* pBead, double fy) const {pBead->m_Force[1] += fy;}
 	inline void AddBeadZForce(CBead* pBead, double fz) const {pBead->m_Force[2] += fz;}
 
+	// Function returning the beads in the wrapped target from a local cache
+	// that is only refreshed when the contents of a command target change
+
+	const BeadVector& GetTargetBeads();
+
 
 
 	// ****************************************
@@ -114,7 +120,8 @@ protected:
 
 private:
 
-
+	BeadVector	m_vTargetBeads;			// Cached beads of the wrapped target
+	long		m_TargetBeadsChangeTotal;	// Membership change count when the cache was filled
 
 };
 
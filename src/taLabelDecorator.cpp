@@ -69,6 +69,11 @@ BeadVector taLabelDecorator::GetBeads() const
 	return GetInnerDecorator()->GetBeads();
 }
 
+bool taLabelDecorator::IsMembershipDynamic() const
+{
+	return GetInnerDecorator()->IsMembershipDynamic();
+}
+
 long taLabelDecorator::GetCurrentBeadType() const
 {
 	return GetInnerDecorator()->GetCurrentBeadType();
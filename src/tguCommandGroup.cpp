@@ -91,6 +91,8 @@ tguCommandGroup::tguCommandGroup(const tguCommandGroup& oldGroup) : xxBase(oldGr
 
 tguCommandGroup::~tguCommandGroup()
 {
+    ClearBindings();
+
   // Delete the command set if it still exists
 
     if(m_pCommandSet)
@@ -313,13 +315,17 @@ bool tguCommandGroup::ExecuteSequence(ISimState* const pISimState, long total, l
 // If the instantation and packing are successful, we return true, 
 // otherwise we return false.
 //
+// The command instance itself must be created anew each time as the ISimState
+// takes ownership of it, but the command's arguments are bound to the sources of
+// their values the first time it is instantiated. Subsequent executions only
+// refresh the arguments that are taken from a sequence, lattice or another
+// argument, and reuse the same argument instances for packing the command.
+// The bindings are discarded whenever the group's commands or arguments are modified.
+//
 // NOTE The argument "index" must be zero-based here.
 
 bool tguCommandGroup::InstantiateCommand(unsigned long index)
 {
-    bool bValid = true; // return value that shows if command instantiates ok
-    zString argSource = "constant";  // Error identifer for the automatic generation of an argument
-
     if(IsCommandActive(index))
     {
         const zString  cmdName = GetCommandNameFromZeroIndex(index);
@@ -330,177 +336,293 @@ bool tguCommandGroup::InstantiateCommand(unsigned long index)
 
         if(pCommand)
         {
-            // Now assemble the arguments to the command from the various containers
-            // for integers, reals and strings, and those arguments whose values 
-            // are copied from a different command/argument.
+            zString argName   = "";
+            zString argType   = "";
+            zString argSource = "constant";  // Error identifer for the automatic generation of an argument
 
-            zString hashedArgName = "";
-            zString argName = "";
-            zString argType = "";
+            bool bValid = BindCommand(index, argName, argType, argSource) &&
+                          UpdateBoundArguments(index, argName, argType, argSource);
 
-            // Local storage for the argument values
-            long     integerValue   = 0;
-            double   realValue      = 0.0;
-            zString  stringValue    = "";
+            // Finally pack the empty command instance with its arguments and add it
+            // to the local container instance. The argument instances belong to
+            // the bindings and are not deleted here.
 
-            // and iterators for the maps
-            StringLongIterator    iterIntegerArg;
-            StringDoubleIterator  iterRealArg;
-            StringStringIterator  iterStringArg;
+            if(bValid && pCommand->Pack(m_vBoundCommands.at(index)->vValues))
+            {
+                m_pCommandSet->AddCommand(pCommand);
+                return true;
+            }
+            else
+            {
+                // Issue a log message that the command failed to be instantiated,
+                // and distinguish between a failure here and a failure to pack
+                // the command's arguments.
 
+                if(bValid)
+                {
+                    new CLogcgtCommandPackingFailed(m_Time, GetName(), cmdName, m_vBoundCommands.at(index)->vNames);
+                }
+                else
+                {
+                    new CLogcgtCommandInstantiationFailed(m_Time, GetName(), cmdName, argName, argType, argSource);
+                }
 
-            zString hashedCmdName = GetHashedCommandName(index);
+                delete pCommand;
+                return false;
+            }
+        }
+        else
+        {
+            // Issue a log message that the command is unrecognised
+            new CLogcgtUnrecognisedCommand(m_Time, GetName(), cmdName);
+            return false;
+        }
+    }
+    else
+    {
+        return true;
+    }
+}
 
-            StringStringMMIterator iterCmdArg = m_mmCommandArgumentMap.find(hashedCmdName);
+// Function to resolve the source of each argument of the index-th command and
+// create the argument instances used to pack it. Constant arguments have their
+// values copied from the typed maps here, while the others are only identified
+// and are updated by UpdateBoundArguments(). If the command is already bound
+// we do nothing. If an argument has no type, or a constant argument has no value,
+// the binding is discarded and we return false with the offending argument's
+// name, type and source.
 
-            StringSequence argNames;
-            argNames.clear();
+bool tguCommandGroup::BindCommand(unsigned long index, zString& argName, zString& argType, zString& argSource)
+{
+    if(index >= m_vBoundCommands.size())
+    {
+        m_vBoundCommands.resize(m_Commands.size(), 0);
+    }
 
-            tguArgumentSequence vArguments;
-            vArguments.clear();
+    if(m_vBoundCommands.at(index))
+        return true;
 
-            if(iterCmdArg!=m_mmCommandArgumentMap.end())
-            {
-                while(bValid && iterCmdArg != m_mmCommandArgumentMap.upper_bound(hashedCmdName))
-                {
-                    argName = iterCmdArg->second;
- 
-                    hashedArgName = GetHashedArgumentName(index, argName);
-                    argType       = GetArgumentTypeFromHashedName(hashedArgName);
+    BoundCommand* const pBound = new BoundCommand();
 
-                    argNames.push_back(argName);
+    bool bValid = true;
 
-                    // First see if the argument has its value determined from
-                    // a sequence, a lattice or is linked to that of another argument, 
-                    // and, if so, update its value in the appropriate typed map 
-                    // before retrieving its value.
+    const zString hashedCmdName = GetHashedCommandName(index);
 
-                    if(IsArgumentFromSequence(hashedArgName))
-                    {
-                        if(!SetArgumentFromSequence(hashedArgName))
-                        {
-                            argSource = "sequence";
-                            bValid = false;
-                        }
-                    }
-                    else if(IsArgumentFromLatticeVector(hashedArgName))
-                    {
-                        if(!SetArgumentFromLatticeVector(hashedArgName))
-                        {
-                            argSource = "lattice vector";
-                            bValid = false;
-                        }
-                    }
-                    else if(IsArgumentLinked(hashedArgName))
-                    {
-                        if(!SetArgumentFromLinkedValue(hashedArgName))
-                        {
-                            argSource = "linked";
-                            bValid = false;
-                        }
-                    }
+    StringStringMMIterator iterCmdArg = m_mmCommandArgumentMap.find(hashedCmdName);
 
-                    if(argType == "integer")
-                    {
-                        iterIntegerArg = m_mIntegerArgumentMap.find(hashedArgName);
-                        if(iterIntegerArg != m_mIntegerArgumentMap.end())
-                        {
-                            integerValue = iterIntegerArg->second;
-                            vArguments.push_back(new tguConstantType(integerValue));
-                        }
-                        else
-                        {
-                            bValid = false;
-                        }
-                    }
-                    else if(argType == "real")
-                    {
-                        iterRealArg = m_mRealArgumentMap.find(hashedArgName);
-                        if(iterRealArg != m_mRealArgumentMap.end())
-                        {
-                            realValue = iterRealArg->second;
-                            vArguments.push_back(new tguConstantType(realValue));
-                        }
-                        else
-                        {
-                            bValid = false;
-                        }
-                    }
-                    else if(argType == "string")
-                    {
-                        iterStringArg = m_mStringArgumentMap.find(hashedArgName);
-                        if(iterStringArg != m_mStringArgumentMap.end())
-                        {
-                            stringValue = iterStringArg->second;
-                            vArguments.push_back(new tguConstantType(stringValue));
-                        }
-                        else
-                        {
-                            bValid = false;
-                        }
-                    }
-                    else
-                    {
-                        bValid = false;
-                    }
+    if(iterCmdArg!=m_mmCommandArgumentMap.end())
+    {
+        while(bValid && iterCmdArg != m_mmCommandArgumentMap.upper_bound(hashedCmdName))
+        {
+            BoundArgument arg;
 
-                    iterCmdArg++;
-                }
-            }
+            arg.name        = iterCmdArg->second;
+            arg.hashedName  = GetHashedArgumentName(index, arg.name);
+            arg.type        = 0;
+            arg.pGenerator  = 0;
+            arg.bLinked     = false;
+            arg.pValue      = 0;
 
-            // Finally pack the empty command instance with its arguments and add it
-            // to the local container instance
+            argName   = arg.name;
+            argType   = GetArgumentTypeFromHashedName(arg.hashedName);
+            argSource = "constant";
 
-            if(bValid && pCommand->Pack(vArguments))
-            {
-                m_pCommandSet->AddCommand(pCommand);
+            pBound->vNames.push_back(arg.name);
+
+            // Identify where the argument's value comes from. Lattice vectors
+            // only supply real values.
 
-                // Now delete the tguArgumentType instances used to pass arguments
-                // to the command to avoid a memory leak. We don't need to empty
-                // the container as it is a local variable.
+            if(IsArgumentFromSequence(arg.hashedName))
+            {
+                argSource = "sequence";
+                arg.pGenerator = m_mStringVariableArgMap.find(arg.hashedName)->second;
+            }
+            else if(IsArgumentFromLatticeVector(arg.hashedName))
+            {
+                argSource = "lattice vector";
+                arg.pGenerator = m_mStringVariableArgMap.find(arg.hashedName)->second;
 
-                for(tguArgumentIterator iterArg=vArguments.begin(); iterArg!=vArguments.end(); iterArg++)
+                if(argType != "real")
                 {
-                    delete *iterArg;
+                    bValid = false;
                 }
-                return true;
             }
-            else
+            else if(IsArgumentLinked(arg.hashedName))
             {
-                // Issue a log message that the command failed to be instantiated,
-                // and distinguish between a failure here and a failure to pack
-                // the command's arguments.
+                argSource = "linked";
+                arg.bLinked = true;
+            }
 
-                if(bValid)
+            if(bValid && argType == "integer")
+            {
+                arg.type   = 0;
+                arg.pValue = new tguConstantType(0L);
+
+                StringLongIterator iterArg = m_mIntegerArgumentMap.find(arg.hashedName);
+                if(iterArg != m_mIntegerArgumentMap.end())
                 {
-                    new CLogcgtCommandPackingFailed(m_Time, GetName(), cmdName, argNames);
+                    arg.pValue->SetValue(iterArg->second);
                 }
-                else
+                else if(!arg.pGenerator && !arg.bLinked)
                 {
-                    new CLogcgtCommandInstantiationFailed(m_Time, GetName(), cmdName, argName, argType, argSource);
+                    bValid = false;
                 }
+            }
+            else if(bValid && argType == "real")
+            {
+                arg.type   = 1;
+                arg.pValue = new tguConstantType(0.0);
 
+                StringDoubleIterator iterArg = m_mRealArgumentMap.find(arg.hashedName);
+                if(iterArg != m_mRealArgumentMap.end())
+                {
+                    arg.pValue->SetValue(iterArg->second);
+                }
+                else if(!arg.pGenerator && !arg.bLinked)
+                {
+                    bValid = false;
+                }
+            }
+            else if(bValid && argType == "string")
+            {
+                arg.type   = 2;
+                arg.pValue = new tguConstantType(zString(""));
 
-                // We also have to delete the created arguments here even though 
-                // the command failed to execute.
-                for(tguArgumentIterator iterArg=vArguments.begin(); iterArg!=vArguments.end(); iterArg++)
+                StringStringIterator iterArg = m_mStringArgumentMap.find(arg.hashedName);
+                if(iterArg != m_mStringArgumentMap.end())
                 {
-                    delete *iterArg;
+                    arg.pValue->SetValue(iterArg->second);
+                }
+                else if(!arg.pGenerator && !arg.bLinked)
+                {
+                    bValid = false;
                 }
-                return false;
             }
+            else
+            {
+                bValid = false;
+            }
+
+            if(arg.pValue)
+            {
+                pBound->vArguments.push_back(arg);
+                pBound->vValues.push_back(arg.pValue);
+            }
+
+            iterCmdArg++;
         }
-        else
+    }
+
+    if(bValid)
+    {
+        m_vBoundCommands.at(index) = pBound;
+    }
+    else
+    {
+        for(tguArgumentIterator iterArg=pBound->vValues.begin(); iterArg!=pBound->vValues.end(); iterArg++)
         {
-            // Issue a log message that the command is unrecognised
-            new CLogcgtUnrecognisedCommand(m_Time, GetName(), cmdName);
-            return false;
+            delete *iterArg;
         }
+        delete pBound;
     }
-    else
+
+    return bValid;
+}
+
+// Function to refresh the values of the index-th command's arguments that are
+// not constant. Sequence and lattice values are stored in the typed maps as well
+// as in the argument instances so that arguments linked to them see the new value.
+// Arguments are processed in the same order as they are packed so that linked
+// arguments within a command see the values for the current execution.
+
+bool tguCommandGroup::UpdateBoundArguments(unsigned long index, zString& argName, zString& argType, zString& argSource)
+{
+    BoundCommand* const pBound = m_vBoundCommands.at(index);
+
+    for(xxBasevector<BoundArgument>::iterator iterArg=pBound->vArguments.begin(); iterArg!=pBound->vArguments.end(); iterArg++)
     {
-        return true;
+        if(iterArg->pGenerator)
+        {
+            if(iterArg->type == 0)
+            {
+                long value = 0;
+                iterArg->pGenerator->GetNextValue(&value);
+                iterArg->pValue->SetValue(value);
+                m_mIntegerArgumentMap[iterArg->hashedName] = value;
+            }
+            else if(iterArg->type == 1)
+            {
+                double value = 0.0;
+                iterArg->pGenerator->GetNextValue(&value);
+                iterArg->pValue->SetValue(value);
+                m_mRealArgumentMap[iterArg->hashedName] = value;
+            }
+            else
+            {
+                zString value = "";
+                iterArg->pGenerator->GetNextValue(&value);
+                iterArg->pValue->SetValue(value);
+                m_mStringArgumentMap[iterArg->hashedName] = value;
+            }
+        }
+        else if(iterArg->bLinked)
+        {
+            bool bFound = SetArgumentFromLinkedValue(iterArg->hashedName);
+
+            if(bFound && iterArg->type == 0)
+            {
+                StringLongIterator iterValue = m_mIntegerArgumentMap.find(iterArg->hashedName);
+                bFound = (iterValue != m_mIntegerArgumentMap.end());
+                if(bFound)
+                    iterArg->pValue->SetValue(iterValue->second);
+            }
+            else if(bFound && iterArg->type == 1)
+            {
+                StringDoubleIterator iterValue = m_mRealArgumentMap.find(iterArg->hashedName);
+                bFound = (iterValue != m_mRealArgumentMap.end());
+                if(bFound)
+                    iterArg->pValue->SetValue(iterValue->second);
+            }
+            else if(bFound)
+            {
+                StringStringIterator iterValue = m_mStringArgumentMap.find(iterArg->hashedName);
+                bFound = (iterValue != m_mStringArgumentMap.end());
+                if(bFound)
+                    iterArg->pValue->SetValue(iterValue->second);
+            }
+
+            if(!bFound)
+            {
+                argName   = iterArg->name;
+                argType   = GetArgumentTypeFromHashedName(iterArg->hashedName);
+                argSource = "linked";
+                return false;
+            }
+        }
     }
+
+    return true;
+}
+
+// Function to discard the argument bindings of all commands in the group. It is
+// called whenever a command or argument is added or modified so that the next
+// execution binds the arguments again.
+
+void tguCommandGroup::ClearBindings()
+{
+    for(xxBasevector<BoundCommand*>::iterator iterCmd=m_vBoundCommands.begin(); iterCmd!=m_vBoundCommands.end(); iterCmd++)
+    {
+        if(*iterCmd)
+        {
+            for(tguArgumentIterator iterArg=(*iterCmd)->vValues.begin(); iterArg!=(*iterCmd)->vValues.end(); iterArg++)
+            {
+                delete *iterArg;
+            }
+            delete *iterCmd;
+        }
+    }
+
+    m_vBoundCommands.clear();
 }
 
 // ****************************************
@@ -521,6 +643,8 @@ bool tguCommandGroup::InstantiateCommand(unsigned long index)
 
 void tguCommandGroup::AddCommand(const zString cmdName, StringSequence argNames)
 {
+    ClearBindings();
+
     // Add the command to the commands container and a flag showing the command's
     // active status to the status container. It is crucial that both of these
     // containers have the same size as some functions only check the size
@@ -587,6 +711,8 @@ bool tguCommandGroup::ToggleCommandExecution(long cmdNo)
 
 void tguCommandGroup::SetArgumentToInteger(long cmdNo, const zString argName, long argValue)
 {
+    ClearBindings();
+
     --cmdNo;   // Make the index zero-based before accessing containers!
 
     zString cmdName = GetCommandNameFromZeroIndex(cmdNo);
@@ -611,6 +737,8 @@ void tguCommandGroup::SetArgumentToInteger(long cmdNo, const zString argName, lo
 
 void tguCommandGroup::SetArgumentToReal(long cmdNo, const zString argName, double argValue)
 {
+    ClearBindings();
+
     --cmdNo;   // Make the index zero-based before accessing containers!
     zString cmdName = GetCommandNameFromZeroIndex(cmdNo);
     zString hashedCmdName = GetHashedCommandName(cmdNo);
@@ -634,6 +762,8 @@ void tguCommandGroup::SetArgumentToReal(long cmdNo, const zString argName, doubl
 
 void tguCommandGroup::SetArgumentToString(long cmdNo, const zString argName, const zString argValue)
 {
+    ClearBindings();
+
     --cmdNo;   // Make the index zero-based before accessing containers!
     zString cmdName = GetCommandNameFromZeroIndex(cmdNo);
     zString hashedCmdName = GetHashedCommandName(cmdNo);
@@ -676,6 +806,8 @@ void tguCommandGroup::SetArgumentToString(long cmdNo, const zString argName, con
 
 void tguCommandGroup::SetArgumentToArgument(long cmdNo, const zString argName, long cmdNoSource, const zString argNameSource)
 {
+    ClearBindings();
+
     --cmdNo;   // Make the index zero-based before accessing containers!
     --cmdNoSource;   
 
@@ -725,6 +857,8 @@ void tguCommandGroup::SetArgumentToArgument(long cmdNo, const zString argName, l
 
 void tguCommandGroup::SetArgumentToIntegerSequence(long cmdNo, const zString argName, long initial, long delta)
 {
+    ClearBindings();
+
     --cmdNo;   // Make the index zero-based before accessing containers!
 
     // Create the hashed command/arg names
@@ -760,6 +894,8 @@ void tguCommandGroup::SetArgumentToIntegerSequence(long cmdNo, const zString arg
 
 void tguCommandGroup::SetArgumentToRealSequence(long cmdNo, const zString argName, double initial, double delta)
 {
+    ClearBindings();
+
     --cmdNo;   // Make the index zero-based before accessing containers!
 
     // Create the hashed command/arg names
@@ -799,6 +935,8 @@ void tguCommandGroup::SetArgumentToRealSequence(long cmdNo, const zString argNam
 
 void tguCommandGroup::SetArgumentToStringSequence(long cmdNo, const zString argName, const zString root)
 {
+    ClearBindings();
+
     --cmdNo;   // Make the index zero-based before accessing containers!
 
     // Create the hashed command/arg names
@@ -845,6 +983,8 @@ void tguCommandGroup::SetArgumentsTo2dTriangularLatticeVector(long xCmdNo, long
                                                                long xmax, long ymax, double xorigin, double yorigin, 
                                                                double lx, double ly)
 {
+    ClearBindings();
+
     --xCmdNo;   // Make the indices zero-based before accessing containers!
     --yCmdNo;   
 
@@ -906,6 +1046,8 @@ void tguCommandGroup::SetArgumentsTo2dRectangularLatticeVector(long xCmdNo, long
                                                                long xmax, long ymax, double xorigin, double yorigin, 
                                                                double lx, double ly)
 {
+    ClearBindings();
+
     --xCmdNo;   // Make the indices zero-based before accessing containers!
     --yCmdNo;   
 
@@ -960,6 +1102,8 @@ void tguCommandGroup::SetArgumentsTo2dRectangularLatticeVector(long xCmdNo, long
 void tguCommandGroup::SetArgumentsTo3dRectangularLatticeVector(long xCmdNo, long yCmdNo, long zCmdNo, const zString xArgName, const zString yArgName, const zString zArgName,
                                                   long xmax, long ymax, long zmax, double xorigin, double yorigin, double zorigin, double lx, double ly, double lz)
 {
+    ClearBindings();
+
     --xCmdNo;   // Make the indices zero-based before accessing containers!
     --yCmdNo;   
     --zCmdNo;   
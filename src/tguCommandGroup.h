@@ -10,6 +10,7 @@
 
 class ISimState;
 class tguCommands;
+class tguConstantType;
 
 #include "xxBase.h"
 
@@ -102,6 +103,13 @@ private:
 
     bool InstantiateCommand(unsigned long index);
 
+    // Functions that bind a command's arguments to the sources of their values
+    // so that repeated executions do not have to look them up again
+
+    bool BindCommand(unsigned long index, zString& argName, zString& argType, zString& argSource);
+    bool UpdateBoundArguments(unsigned long index, zString& argName, zString& argType, zString& argSource);
+    void ClearBindings();
+
     // Functions to get/set the status of the group's commands.
     // All commands must be valid before the group can be executed.
 
@@ -166,6 +174,28 @@ private:
 	// Data members
 private:
 
+    // Argument whose value source has been resolved. Constant arguments have
+    // their value stored once in pValue; arguments taken from a sequence or
+    // lattice (pGenerator) or linked to another argument are refreshed before
+    // each execution.
+
+    struct BoundArgument
+    {
+        zString          name;        // Placeholder name of the argument
+        zString          hashedName;  // Key into the typed maps
+        long             type;        // 0 integer, 1 real, 2 string
+        tguArgumentType* pGenerator;  // Sequence or lattice component, or 0
+        bool             bLinked;     // Value copied from another argument
+        tguConstantType* pValue;      // Value passed to the command's Pack()
+    };
+
+    struct BoundCommand
+    {
+        xxBasevector<BoundArgument> vArguments;
+        tguArgumentSequence         vValues;   // pValue of each argument in order
+        StringSequence              vNames;    // Argument names for log messages
+    };
+
     const zString      m_Name;    // Name of the command group
     bool               m_bActive; // Flag showing if the command group is active or inactive
     bool               m_bValid;  // Flag showing if all commands in the group are valid
@@ -190,6 +220,8 @@ private:
     StringStringMMap        m_mmCommandArgumentMap;   // Multimap holding (hashed command name, argument placeholder name) pairs
     StringStringMMap        m_mmArgumentArgumentMap;  // Multimap of source argument/destination argument placeholder name pairs
 
+    xxBasevector<BoundCommand*> m_vBoundCommands;     // Bound arguments of each command, or 0 if not yet bound
+
 };
 
 #endif // !defined(AFX_TGUCOMMANDGROUP_H__6AEB8958_DFCF_44D1_8A3C_4850A04F9BFB__INCLUDED_)
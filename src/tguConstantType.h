@@ -39,6 +39,12 @@ public:
 	// Public access functions
 public:
 
+    // Functions that replace the stored value so the instance can be reused
+
+    inline void SetValue(long value)    {m_Integer = value;}
+    inline void SetValue(double value)  {m_Real    = value;}
+    inline void SetValue(zString value) {m_String  = value;}
+
 
 	// ****************************************
 	// Protected local functions
@@ -62,6 +62,11 @@ const zString xxBase::GetAAPrefix()
     return GetFilePrefix()+"aa.";
 }
     
+const zString xxBase::GetACPrefix()
+{
+    return GetFilePrefix()+"ac.";
+}
+
 const zString xxBase::GetASPrefix()
 {
     return GetFilePrefix()+"as.";
@@ -122,6 +127,11 @@ const zString xxBase::GetOSPrefix()
     return GetFilePrefix()+"os.";
 }
     
+const zString xxBase::GetPFPrefix()
+{
+    return GetFilePrefix()+"pf.";
+}
+    
 const zString xxBase::GetPSPrefix()
 {
     return GetFilePrefix()+"ps.";
@@ -147,6 +157,16 @@ const zString xxBase::GetTADSPrefix()
     return GetFilePrefix()+"tads.";
 }
 
+const zString xxBase::GetTJPrefix()
+{
+    return GetFilePrefix()+"tj.";
+}
+
+const zString xxBase::GetTXPrefix()
+{
+    return GetFilePrefix()+"tx.";
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -1665,6 +1665,7 @@ public:			// static constants used in initialisation routines
     static const zString GetFilePrefix();
 
     static const zString GetAAPrefix();
+    static const zString GetACPrefix();
     static const zString GetASPrefix();
     static const zString GetCDFPrefix();
     static const zString GetCHPrefix();
@@ -1677,11 +1678,14 @@ public:			// static constants used in initialisation routines
     static const zString GetISPrefix();
     static const zString GetLSPrefix();
     static const zString GetOSPrefix();
+    static const zString GetPFPrefix();
     static const zString GetPSPrefix();
     static const zString GetPSDFPrefix();
     static const zString GetRAPrefix();
     static const zString GetRSPrefix();
 	static const zString GetTADSPrefix();
+    static const zString GetTJPrefix();
+    static const zString GetTXPrefix();
 
 public:
 
@@ -50,7 +50,7 @@ zInStream& operator>>(zInStream& is, xxCommand& command)
 
 // Static member variable holding the number of commands created.
 
-long xxCommand::m_CommandTotal = 0;
+SimThreadLocal long xxCommand::m_CommandTotal = 0;
 
 long xxCommand::GetCommandTotal()
 {
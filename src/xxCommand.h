@@ -48,7 +48,7 @@ public:
 	static long GetCommandTotal();
 	static void ZeroCommandTotal();
 
-	static long m_CommandTotal;	// Number of commands created
+	static SimThreadLocal long m_CommandTotal;	// Number of commands created
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -44,7 +44,7 @@ zInStream& operator>>(zInStream& is, xxEvent& event)
 
 // Static member variable holding the number of events created.
 
-long xxEvent::m_EventTotal = 0;
+SimThreadLocal long xxEvent::m_EventTotal = 0;
 
 long xxEvent::GetEventTotal()
 {
@@ -41,7 +41,7 @@ public:
 
 private:
 
-	static long m_EventTotal;		// Number of events created
+	static SimThreadLocal long m_EventTotal;		// Number of events created
 
 	// ****************************************
 	// PVS that must be overridden by all derived classes
@@ -61,7 +61,7 @@ zOutStream& operator<<(zOutStream& os, xxMessage& rMsg)
 
 // Static member variable holding the number of messages created.
 
-long   xxMessage::m_MessageTotal = 0;
+SimThreadLocal long xxMessage::m_MessageTotal = 0;
 
 // Static member function to return the total number of messages created.
 // We have to name it differently so that it does not clash with the 
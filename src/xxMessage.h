@@ -32,7 +32,7 @@ public:
 
 private:
 
-	static long m_MessageTotal;		// Total number of created messages
+	static SimThreadLocal long m_MessageTotal;		// Total number of created messages
 
 	// ****************************************
 	// PVFs that must be overridden by all derived classes
@@ -71,7 +71,7 @@ zInStream& operator>>(zInStream& is, xxProcess& process)
 
 // Static member variable holding the number of processes created.
 
-long xxProcess::m_ProcessTotal = 0;
+SimThreadLocal long xxProcess::m_ProcessTotal = 0;
 
 long xxProcess::GetProcessTotal()
 {